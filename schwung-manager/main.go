@@ -3298,6 +3298,7 @@ func main() {
 	mux.HandleFunc("POST /system/upgrade", app.handleSystemUpgrade)
 	mux.HandleFunc("GET /system/upgrade-status", app.handleUpgradeStatus)
 	mux.HandleFunc("GET /system/logs", app.handleSystemLogs)
+	mux.HandleFunc("GET /system/telemetry", app.handleSystemTelemetry)
 	// Audio behavior diagnostic capture (see audio_capture.go).
 	mux.HandleFunc("POST /system/audio-capture/arm", app.handleAudioCaptureArm)
 	mux.HandleFunc("POST /system/audio-capture/stop", app.handleAudioCaptureStop)
@@ -3334,7 +3335,7 @@ func main() {
 	// Module web UI assets (custom web_ui.html and related files).
 	mux.HandleFunc("GET /api/remote-ui/module-assets/{id}/{filepath...}", app.handleModuleWebUIAsset)
 
-	// Display server proxy (/mirror and /stream-auto).
+	// Display server proxy (/mirror, /stream-auto and /stream-bin).
 	displayProxy := &httputil.ReverseProxy{
 		Director: func(req *http.Request) {
 			req.URL.Scheme = "http"
@@ -3355,6 +3356,7 @@ func main() {
 	mux.Handle("GET /mirror", displayProxy)
 	mux.Handle("GET /mirror/", displayProxy)
 	mux.Handle("GET /stream-auto", displayProxy)
+	mux.Handle("GET /stream-bin", displayProxy)
 
 	// Apply middleware.  WebSocket paths bypass CSRF (upgrades don't carry tokens).
 	// SecurityHeaders runs outermost so headers are set even on responses
@@ -0,0 +1,210 @@
+package main
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"net/http"
+	"os"
+	"syscall"
+)
+
+// ShmTelemetry reads the shim's per-stage SPI timing histograms and the
+// ring of recent over-budget frames from /schwung-telemetry. The shim is
+// the only writer; counters only grow, so clients graph the difference
+// between two polls. Ring entries are copied under their seqlock.
+//
+// Layout must match telemetry_shm_t in src/host/shadow_telemetry.h. The
+// stage and bucket counts are read from the header so a rebuilt shim with
+// more stages is still parsed correctly.
+type ShmTelemetry struct {
+	data []byte
+}
+
+// Byte offsets into telemetry_shm_t.
+const (
+	telemOffMagic       = 0
+	telemOffVersion     = 4
+	telemOffStageCount  = 8
+	telemOffBucketCount = 12
+	telemOffRingSize    = 16
+	telemOffBudgetUs    = 20
+	telemOffOverrunUs   = 24
+	telemOffFrames      = 32 // uint64
+	telemOffOverruns    = 40 // uint64
+	telemOffRingWrite   = 48
+	telemOffNames       = 56
+
+	telemNameLen     = 16
+	telemHistHeader  = 24 // sum_us u64, count, max_us, last_us, reserved
+	telemFrameHeader = 24 // seq, reserved, frame u64, time_ns u64
+
+	telemMagic   = 0x4D4C4554
+	telemVersion = 1
+	telemNotRun  = 0xFFFFFFFF
+
+	// sizeof(telemetry_shm_t) for the current layout
+	shmTelemetrySize = 10424
+)
+
+const shmTelemetryPath = "/dev/shm/schwung-telemetry"
+
+// TelemetryStage is one stage's histogram since the shim started.
+type TelemetryStage struct {
+	Name    string   `json:"name"`
+	Count   uint32   `json:"count"`
+	SumUs   uint64   `json:"sum_us"`
+	MaxUs   uint32   `json:"max_us"`
+	LastUs  uint32   `json:"last_us"`
+	Buckets []uint32 `json:"buckets"`
+}
+
+// TelemetryOverrun is one over-budget frame with its stage breakdown
+// (nil = stage did not run that frame), in stage order.
+type TelemetryOverrun struct {
+	Frame   uint64    `json:"frame"`
+	TimeNs  uint64    `json:"time_ns"`
+	StageUs []*uint32 `json:"stage_us"`
+}
+
+// TelemetrySnapshot is what /system/telemetry returns.
+type TelemetrySnapshot struct {
+	Frames         uint64             `json:"frames"`
+	Overruns       uint64             `json:"overruns"`
+	BudgetUs       uint32             `json:"budget_us"`
+	OverrunUs      uint32             `json:"overrun_us"`
+	BucketFloorUs  []uint32           `json:"bucket_floor_us"`
+	Stages         []TelemetryStage   `json:"stages"`
+	RecentOverruns []TelemetryOverrun `json:"recent_overruns"`
+}
+
+// OpenShmTelemetry maps the telemetry segment read-only. Returns nil if the
+// shim has not created it (not on device, or shim not running yet).
+func OpenShmTelemetry() *ShmTelemetry {
+	f, err := os.Open(shmTelemetryPath)
+	if err != nil {
+		return nil
+	}
+	defer f.Close()
+
+	st, err := f.Stat()
+	if err != nil || st.Size() < shmTelemetrySize {
+		return nil
+	}
+	data, err := syscall.Mmap(int(f.Fd()), 0, int(st.Size()),
+		syscall.PROT_READ, syscall.MAP_SHARED)
+	if err != nil {
+		return nil
+	}
+	t := &ShmTelemetry{data: data}
+	if t.u32(telemOffMagic) != telemMagic || t.u32(telemOffVersion) != telemVersion {
+		t.Close()
+		return nil
+	}
+	return t
+}
+
+// Close unmaps the segment.
+func (t *ShmTelemetry) Close() {
+	if t.data != nil {
+		syscall.Munmap(t.data)
+		t.data = nil
+	}
+}
+
+func (t *ShmTelemetry) u32(off int) uint32 { return binary.LittleEndian.Uint32(t.data[off:]) }
+func (t *ShmTelemetry) u64(off int) uint64 { return binary.LittleEndian.Uint64(t.data[off:]) }
+
+// telemetryBucketFloor mirrors telemetry_bucket_floor() in shadow_telemetry.h.
+func telemetryBucketFloor(b int) uint32 {
+	if b < 8 {
+		return uint32(b)
+	}
+	msb := b/4 + 1
+	return 1<<msb | uint32(b&3)<<(msb-2)
+}
+
+// Snapshot copies the histograms and the readable part of the overrun ring.
+func (t *ShmTelemetry) Snapshot() TelemetrySnapshot {
+	stages := int(t.u32(telemOffStageCount))
+	buckets := int(t.u32(telemOffBucketCount))
+	ringSize := int(t.u32(telemOffRingSize))
+	histOff := telemOffNames + stages*telemNameLen
+	histSize := telemHistHeader + buckets*4
+	ringOff := histOff + stages*histSize
+	frameSize := telemFrameHeader + stages*4
+	if ringOff+ringSize*frameSize > len(t.data) {
+		return TelemetrySnapshot{}
+	}
+
+	s := TelemetrySnapshot{
+		Frames:    t.u64(telemOffFrames),
+		Overruns:  t.u64(telemOffOverruns),
+		BudgetUs:  t.u32(telemOffBudgetUs),
+		OverrunUs: t.u32(telemOffOverrunUs),
+	}
+	for b := 0; b < buckets; b++ {
+		s.BucketFloorUs = append(s.BucketFloorUs, telemetryBucketFloor(b))
+	}
+
+	for i := 0; i < stages; i++ {
+		nameOff := telemOffNames + i*telemNameLen
+		h := histOff + i*histSize
+		st := TelemetryStage{
+			Name:    cString(t.data[nameOff : nameOff+telemNameLen]),
+			SumUs:   t.u64(h),
+			Count:   t.u32(h + 8),
+			MaxUs:   t.u32(h + 12),
+			LastUs:  t.u32(h + 16),
+			Buckets: make([]uint32, buckets),
+		}
+		for b := 0; b < buckets; b++ {
+			st.Buckets[b] = t.u32(h + telemHistHeader + b*4)
+		}
+		s.Stages = append(s.Stages, st)
+	}
+
+	w := t.u32(telemOffRingWrite)
+	n := uint32(ringSize)
+	if w < n {
+		n = w
+	}
+	s.RecentOverruns = []TelemetryOverrun{}
+	for i := w - n; i != w; i++ {
+		e := ringOff + int(i%uint32(ringSize))*frameSize
+		seq := t.u32(e)
+		if seq == 0 || seq&1 != 0 {
+			continue
+		}
+		o := TelemetryOverrun{
+			Frame:   t.u64(e + 8),
+			TimeNs:  t.u64(e + 16),
+			StageUs: make([]*uint32, stages),
+		}
+		for k := 0; k < stages; k++ {
+			v := t.u32(e + telemFrameHeader + k*4)
+			if v != telemNotRun {
+				o.StageUs[k] = &v
+			}
+		}
+		if t.u32(e) != seq {
+			continue // overwritten while copying
+		}
+		s.RecentOverruns = append(s.RecentOverruns, o)
+	}
+	return s
+}
+
+// handleSystemTelemetry returns the current SPI timing snapshot as JSON for
+// live graphs. The segment is opened per request so the endpoint starts
+// working as soon as the shim comes up, without a manager restart.
+func (app *App) handleSystemTelemetry(w http.ResponseWriter, r *http.Request) {
+	w.Header().Set("Content-Type", "application/json")
+	t := OpenShmTelemetry()
+	if t == nil {
+		w.WriteHeader(http.StatusServiceUnavailable)
+		json.NewEncoder(w).Encode(map[string]string{"error": "telemetry not available (shim not running)"})
+		return
+	}
+	defer t.Close()
+	json.NewEncoder(w).Encode(t.Snapshot())
+}
@@ -0,0 +1,66 @@
+// Layout test for the /schwung-telemetry reader. Builds a segment by hand
+// with the offsets of telemetry_shm_t and checks Snapshot() decodes it.
+
+package main
+
+import (
+	"encoding/binary"
+	"testing"
+)
+
+func TestShmTelemetrySnapshot(t *testing.T) {
+	const stages, buckets, ring = 16, 64, 64
+	data := make([]byte, shmTelemetrySize)
+	le := binary.LittleEndian
+	le.PutUint32(data[telemOffMagic:], telemMagic)
+	le.PutUint32(data[telemOffVersion:], telemVersion)
+	le.PutUint32(data[telemOffStageCount:], stages)
+	le.PutUint32(data[telemOffBucketCount:], buckets)
+	le.PutUint32(data[telemOffRingSize:], ring)
+	le.PutUint32(data[telemOffBudgetUs:], 2902)
+	le.PutUint32(data[telemOffOverrunUs:], 2000)
+	le.PutUint64(data[telemOffFrames:], 1000)
+	le.PutUint64(data[telemOffOverruns:], 1)
+	le.PutUint32(data[telemOffRingWrite:], 1)
+	copy(data[telemOffNames:], "total")
+
+	histOff := telemOffNames + stages*telemNameLen
+	le.PutUint64(data[histOff:], 1500000)
+	le.PutUint32(data[histOff+8:], 1000)
+	le.PutUint32(data[histOff+12:], 5099)
+	le.PutUint32(data[histOff+telemHistHeader+40*4:], 1000)
+
+	ringOff := histOff + stages*(telemHistHeader+buckets*4)
+	frameSize := telemFrameHeader + stages*4
+	if ringOff+ring*frameSize != shmTelemetrySize {
+		t.Fatalf("layout size %d, want %d", ringOff+ring*frameSize, shmTelemetrySize)
+	}
+	le.PutUint32(data[ringOff:], 2) // seq: one completed write
+	le.PutUint64(data[ringOff+8:], 100)
+	for k := 0; k < stages; k++ {
+		le.PutUint32(data[ringOff+telemFrameHeader+k*4:], telemNotRun)
+	}
+	le.PutUint32(data[ringOff+telemFrameHeader:], 5099)
+
+	s := (&ShmTelemetry{data: data}).Snapshot()
+	if s.Frames != 1000 || s.Overruns != 1 || s.BudgetUs != 2902 {
+		t.Fatalf("header: %+v", s)
+	}
+	if len(s.Stages) != stages || s.Stages[0].Name != "total" || s.Stages[0].Count != 1000 ||
+		s.Stages[0].MaxUs != 5099 || s.Stages[0].Buckets[40] != 1000 {
+		t.Fatalf("stage 0: %+v", s.Stages[0])
+	}
+	if len(s.RecentOverruns) != 1 || s.RecentOverruns[0].Frame != 100 {
+		t.Fatalf("overruns: %+v", s.RecentOverruns)
+	}
+	o := s.RecentOverruns[0]
+	if o.StageUs[0] == nil || *o.StageUs[0] != 5099 || o.StageUs[1] != nil {
+		t.Fatalf("overrun stages: %v", o.StageUs)
+	}
+	// Spot-check the C bucket edges (telemetry_bucket_floor)
+	for b, want := range map[int]uint32{7: 7, 8: 8, 11: 14, 12: 16, 40: 2048, 63: 114688} {
+		if got := telemetryBucketFloor(b); got != want {
+			t.Errorf("bucket %d floor = %d, want %d", b, got, want)
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#!/usr/bin/env bash
+# Build the offline render harness and a native module tree for it.
+#
+# Unlike scripts/build.sh this compiles for the machine it runs on (x86_64
+# dev boxes or on-device aarch64), so chain, linein and freeverb can be
+# rendered and profiled without a Move. Output lands in build/render-harness/:
+#   build/render-harness/bin/render_harness
+#   build/render-harness/modules/chain/dsp.so (+ module.json)
+#   build/render-harness/modules/sound_generators/linein/
+#   build/render-harness/modules/audio_fx/freeverb/
+#
+# Third-party modules can be dropped into the same tree (native builds of
+# their dsp.so / <name>.so) and selected with --synth / --fxN.
+# Set CC to override the compiler and CFLAGS to override -O3.
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_ROOT="$(dirname "$SCRIPT_DIR")"
+CC="${CC:-cc}"
+CFLAGS="${CFLAGS:--g -O3}"
+
+cd "$REPO_ROOT"
+
+OUT=build/render-harness
+MOD="$OUT/modules"
+mkdir -p "$OUT/bin" "$MOD/chain" "$MOD/sound_generators/linein" "$MOD/audio_fx/freeverb"
+
+echo "Building chain DSP (native)..."
+$CC $CFLAGS -shared -fPIC \
+    src/modules/chain/dsp/chain_host.c \
+    src/host/unified_log.c \
+    -o "$MOD/chain/dsp.so" \
+    -Isrc \
+    -lm -ldl -lpthread
+cp src/modules/chain/module.json "$MOD/chain/"
+
+echo "Building line-in generator (native)..."
+$CC $CFLAGS -shared -fPIC \
+    src/modules/sound_generators/linein/linein.c \
+    -o "$MOD/sound_generators/linein/dsp.so" \
+    -Isrc \
+    -lm
+cp src/modules/sound_generators/linein/module.json "$MOD/sound_generators/linein/"
+
+echo "Building freeverb (native)..."
+$CC $CFLAGS -shared -fPIC \
+    src/modules/audio_fx/freeverb/freeverb.c \
+    -o "$MOD/audio_fx/freeverb/freeverb.so" \
+    -Isrc \
+    -lm
+cp src/modules/audio_fx/freeverb/module.json "$MOD/audio_fx/freeverb/"
+
+echo "Building render_harness..."
+$CC $CFLAGS -std=gnu11 -Wall -Wextra \
+    src/tools/render_harness.c \
+    src/host/shadow_mix.c \
+    -o "$OUT/bin/render_harness" \
+    -Isrc \
+    -lm -ldl
+
+echo "Done: $OUT/bin/render_harness --modules $MOD"
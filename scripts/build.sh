@@ -254,16 +254,37 @@ if needs_rebuild build/schwung-shim.so \
     src/host/shadow_chain_mgmt.c src/host/shadow_link_audio.c src/host/shadow_process.c \
     src/host/shadow_resample.c src/host/shadow_overlay.c src/host/shadow_pin_scanner.c \
     src/host/shadow_led_queue.c src/host/shadow_fd_trace.c src/host/shadow_state.c \
-    src/host/shadow_midi.c src/host/unified_log.c \
+    src/host/shadow_midi.c src/host/shadow_render_pool.c src/host/shadow_patch_loader.c src/host/shadow_telemetry.c src/host/unified_log.c \
+    src/host/shadow_mix.c src/host/shadow_mix.h \
+    src/host/shadow_skipback_codec.c src/host/shadow_skipback_codec.h \
+    src/host/shadow_midi_timing.c src/host/shadow_midi_timing.h \
+    src/host/shadow_drift.c src/host/shadow_drift.h \
     $SHIM_TTS_SRC \
     src/host/shadow_constants.h src/host/shadow_midi.h src/host/shadow_sampler.h \
     src/host/shadow_set_pages.h src/host/shadow_dbus.h src/host/shadow_chain_mgmt.h \
     src/host/shadow_chain_types.h src/host/shadow_link_audio.h src/host/shadow_process.h \
     src/host/shadow_resample.h src/host/shadow_overlay.h src/host/shadow_pin_scanner.h \
     src/host/shadow_led_queue.h src/host/shadow_fd_trace.h src/host/shadow_state.h \
+    src/host/shadow_render_pool.h src/host/shadow_patch_loader.h src/host/shadow_telemetry.h \
+    src/host/shadow_bulk_thread.h \
     src/host/plugin_api_v1.h src/host/unified_log.h src/host/tts_engine.h \
     src/host/link_audio.h; then
     echo "Building shim..."
+    # Mix kernels run on every SPI frame: always build them optimised
+    "${CROSS_PREFIX}gcc" -c -g -O3 -fPIC \
+        src/host/shadow_mix.c \
+        -o build/shadow_mix.o \
+        -Isrc
+    # Link Audio drift resampler runs per Move track on every SPI frame
+    "${CROSS_PREFIX}gcc" -c -g -O3 -fPIC \
+        src/host/shadow_drift.c \
+        -o build/shadow_drift.o \
+        -Isrc
+    # Skipback codec encodes every block and decodes minutes of audio per save
+    "${CROSS_PREFIX}gcc" -c -g -O3 -fPIC \
+        src/host/shadow_skipback_codec.c \
+        -o build/shadow_skipback_codec.o \
+        -Isrc
     "${CROSS_PREFIX}gcc" -g3 -shared -fPIC \
         -o build/schwung-shim.so \
         src/schwung_shim.c \
@@ -281,7 +302,9 @@ if needs_rebuild build/schwung-shim.so \
         src/host/shadow_led_queue.c \
         src/host/shadow_fd_trace.c \
         src/host/shadow_state.c \
-        src/host/shadow_midi.c \
+        src/host/shadow_midi.c src/host/shadow_midi_timing.c \
+        src/host/shadow_render_pool.c src/host/shadow_patch_loader.c src/host/shadow_telemetry.c \
+        build/shadow_mix.o build/shadow_skipback_codec.o build/shadow_drift.o \
         src/host/unified_log.c \
         $SHIM_TTS_SRC \
         $SHIM_DEFINES \
@@ -321,14 +344,16 @@ fi
 # Build Shadow UI host (uses shared display bindings from js_display.c)
 if needs_rebuild build/shadow/shadow_ui \
     src/shadow/shadow_ui.c src/host/js_display.c src/host/unified_log.c \
-    src/host/analytics.c \
-    src/host/js_display.h src/host/shadow_constants.h src/host/unified_log.h; then
+    src/host/analytics.c src/host/js_bytecode_cache.c \
+    src/host/js_display.h src/host/shadow_constants.h src/host/unified_log.h \
+    src/host/js_bytecode_cache.h; then
     echo "Building Shadow UI..."
     "${CROSS_PREFIX}gcc" -g -O3 \
         src/shadow/shadow_ui.c \
         src/host/js_display.c \
         src/host/unified_log.c \
         src/host/analytics.c \
+        src/host/js_bytecode_cache.c \
         -o build/shadow/shadow_ui \
         -Isrc -Isrc/lib \
         -Ilibs/quickjs/quickjs-2025-04-26 \
@@ -590,10 +615,12 @@ fi
 
 # Build display server (live display SSE streaming to browser)
 if needs_rebuild build/display-server \
-    src/host/display_server.c src/host/unified_log.c src/host/unified_log.h; then
+    src/host/display_server.c src/host/display_delta.c src/host/display_delta.h \
+    src/host/unified_log.c src/host/unified_log.h; then
     echo "Building display server..."
     "${CROSS_PREFIX}gcc" -g -O3 \
         src/host/display_server.c \
+        src/host/display_delta.c \
         src/host/unified_log.c \
         -o build/display-server \
         -Isrc -Isrc/host \
@@ -637,6 +664,19 @@ else
     echo "Skipping display_ctl (up to date)"
 fi
 
+# Build schwung-telemetry (reads the shim's SPI stage histograms from /schwung-telemetry)
+if needs_rebuild build/bin/schwung-telemetry \
+    src/tools/schwung_telemetry.c src/host/shadow_telemetry.h src/host/shadow_constants.h; then
+    echo "Building schwung-telemetry..."
+    "${CROSS_PREFIX}gcc" -g -O2 \
+        src/tools/schwung_telemetry.c \
+        -o build/bin/schwung-telemetry \
+        -Isrc \
+        -lrt
+else
+    echo "Skipping schwung-telemetry (up to date)"
+fi
+
 # Build jack_midi_connect (connects system:midi_capture_ext to RNBO patcher MIDI inputs)
 if needs_rebuild build/bin/jack_midi_connect \
     src/tools/jack_midi_connect.c; then
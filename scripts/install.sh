@@ -1182,6 +1182,10 @@ fi
 existing_link_audio=$(get_existing_feature "link_audio_enabled" "$link_audio_val")
 existing_display_mirror=$(get_existing_feature "display_mirror_enabled" "false")
 existing_ext_midi_remap=$(get_existing_feature "ext_midi_remap_enabled" "true")
+existing_parallel_render=$(get_existing_feature "parallel_render_enabled" "false")
+existing_async_patch_load=$(get_existing_feature "async_patch_load_enabled" "true")
+existing_skipback_compressed=$(get_existing_feature "skipback_compressed" "false")
+existing_sample_accurate_midi=$(get_existing_feature "sample_accurate_midi" "false")
 
 # Shadow UI trigger: prefer the new "shadow_ui_trigger" string key. If only the
 # legacy bool "long_press_shadow" exists, migrate (true→both, false→shift_vol).
@@ -1204,6 +1208,10 @@ features_json="{
   \"link_audio_enabled\": $existing_link_audio,
   \"display_mirror_enabled\": $existing_display_mirror,
   \"ext_midi_remap_enabled\": $existing_ext_midi_remap,
+  \"parallel_render_enabled\": $existing_parallel_render,
+  \"async_patch_load_enabled\": $existing_async_patch_load,
+  \"skipback_compressed\": $existing_skipback_compressed,
+  \"sample_accurate_midi\": $existing_sample_accurate_midi,
   \"shadow_ui_trigger\": \"$existing_trigger\"
 }"
 
@@ -78,6 +78,18 @@ mkdir -p /data/UserData/rnbo/config
 ln -sf "$BASE/modules/overtake/rnbo-runner/control-startup-shadow.json" \
     /data/UserData/rnbo/config/control-startup-shadow.json 2>/dev/null
 
+# --- Precompile UI scripts ---
+
+# shadow_ui loads <file>.qbc bytecode instead of compiling the source on each
+# start and module open. Rebuild the cache now so the first boot after an
+# update doesn't pay for it; modules installed later are cached on first load.
+if [ -x "$BASE/shadow/shadow_ui" ]; then
+    find "$BASE" -name '*.qbc' -exec rm -f {} \; 2>/dev/null
+    "$BASE/shadow/shadow_ui" --precompile "$BASE/shadow/shadow_ui.js" >/dev/null 2>&1 || true
+    find "$BASE/modules" -name 'ui*.js' -exec "$BASE/shadow/shadow_ui" --precompile {} \; >/dev/null 2>&1 || true
+    echo "post-update: UI scripts precompiled"
+fi
+
 # --- Clean stale ld.so.preload entries ---
 
 if [ -f /etc/ld.so.preload ] && grep -q 'schwung-shim.so' /etc/ld.so.preload; then
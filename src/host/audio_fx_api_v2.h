@@ -48,4 +48,16 @@ typedef struct audio_fx_api_v2 {
 /* Entry point function type */
 typedef audio_fx_api_v2_t* (*audio_fx_init_v2_fn)(const host_api_v1_t *host);
 
+/* Optional float32 block processing, exported alongside the v2 entry point
+ * and discovered via dlsym (like move_audio_fx_on_midi):
+ *
+ *   void move_audio_fx_process_block_f32(void *instance, float *audio_inout, int frames);
+ *
+ * Stereo interleaved float where 1.0 == int16 full scale (sample / 32768).
+ * Values may exceed +/-1.0; do not clamp - the host saturates once when the
+ * bus is converted back to int16. process_block must still be provided. */
+typedef void (*audio_fx_process_block_f32_fn)(void *instance, float *audio_inout, int frames);
+
+#define AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL "move_audio_fx_process_block_f32"
+
 #endif /* AUDIO_FX_API_V2_H */
@@ -0,0 +1,126 @@
+/* display_delta.c - Row delta encoding for the live display stream
+ * See display_delta.h for the message format. */
+
+#include <string.h>
+
+#include "display_delta.h"
+
+#define RUN_MAX 128     /* longest run one token covers */
+
+int display_delta_frame_size(int format)
+{
+    switch (format) {
+    case DISPLAY_DELTA_FMT_MONO1: return 1024;
+    case DISPLAY_DELTA_FMT_GRAY4: return 4096;
+    default: return 0;
+    }
+}
+
+static void write_header(uint8_t *out, int type, int format, int payload_len)
+{
+    out[0] = (uint8_t)type;
+    out[1] = (uint8_t)format;
+    out[2] = (uint8_t)(payload_len & 0xff);
+    out[3] = (uint8_t)(payload_len >> 8);
+}
+
+int display_delta_encode_key(uint8_t *out, int format, const uint8_t *frame)
+{
+    int size = display_delta_frame_size(format);
+    write_header(out, DISPLAY_DELTA_KEY, format, size);
+    memcpy(out + DISPLAY_DELTA_HDR_SIZE, frame, size);
+    return DISPLAY_DELTA_HDR_SIZE + size;
+}
+
+/* Tokens for one row's XOR. Returns bytes written. Every zero token covers
+ * at least two bytes except at the row end, so this stays under
+ * DISPLAY_DELTA_ROW_BYTES + 3. */
+static int encode_row(uint8_t *out, const uint8_t *prev, const uint8_t *cur)
+{
+    uint8_t x[DISPLAY_DELTA_ROW_BYTES];
+    int n = 0, i = 0;
+
+    for (int k = 0; k < DISPLAY_DELTA_ROW_BYTES; k++) x[k] = prev[k] ^ cur[k];
+
+    while (i < DISPLAY_DELTA_ROW_BYTES) {
+        int start = i;
+        if (x[i] == 0) {
+            while (i < DISPLAY_DELTA_ROW_BYTES && x[i] == 0 && i - start < RUN_MAX) i++;
+            out[n++] = (uint8_t)(0x80 | (i - start - 1));
+        } else {
+            /* Literal run; a single zero byte is cheaper kept inline than
+             * split into its own token */
+            while (i < DISPLAY_DELTA_ROW_BYTES && i - start < RUN_MAX) {
+                if (x[i] == 0 &&
+                    (i + 1 >= DISPLAY_DELTA_ROW_BYTES || x[i + 1] == 0)) break;
+                i++;
+            }
+            out[n++] = (uint8_t)(i - start - 1);
+            memcpy(out + n, x + start, i - start);
+            n += i - start;
+        }
+    }
+    return n;
+}
+
+int display_delta_encode_delta(uint8_t *out, int format,
+                               const uint8_t *prev, const uint8_t *cur)
+{
+    int size = display_delta_frame_size(format);
+    int rows = size / DISPLAY_DELTA_ROW_BYTES;
+    uint8_t row_buf[1 + DISPLAY_DELTA_ROW_BYTES + 3];
+    int n = DISPLAY_DELTA_HDR_SIZE;
+
+    for (int r = 0; r < rows; r++) {
+        int off = r * DISPLAY_DELTA_ROW_BYTES;
+        if (memcmp(prev + off, cur + off, DISPLAY_DELTA_ROW_BYTES) == 0) continue;
+        row_buf[0] = (uint8_t)r;
+        int len = 1 + encode_row(row_buf + 1, prev + off, cur + off);
+        if (n + len >= DISPLAY_DELTA_HDR_SIZE + size) return -1;
+        memcpy(out + n, row_buf, len);
+        n += len;
+    }
+    write_header(out, DISPLAY_DELTA_DELTA, format, n - DISPLAY_DELTA_HDR_SIZE);
+    return n;
+}
+
+int display_delta_apply(uint8_t *frame, int *format,
+                        const uint8_t *msg, int msg_len)
+{
+    if (msg_len < DISPLAY_DELTA_HDR_SIZE) return -1;
+    int type = msg[0], fmt = msg[1];
+    int len = msg[2] | (msg[3] << 8);
+    int size = display_delta_frame_size(fmt);
+    const uint8_t *p = msg + DISPLAY_DELTA_HDR_SIZE;
+
+    if (size == 0 || len != msg_len - DISPLAY_DELTA_HDR_SIZE) return -1;
+
+    if (type == DISPLAY_DELTA_KEY) {
+        if (len != size) return -1;
+        memcpy(frame, p, size);
+        *format = fmt;
+        return 0;
+    }
+    if (type != DISPLAY_DELTA_DELTA || fmt != *format) return -1;
+
+    int i = 0;
+    while (i < len) {
+        int row = p[i++];
+        if (row >= size / DISPLAY_DELTA_ROW_BYTES) return -1;
+        int o = row * DISPLAY_DELTA_ROW_BYTES;
+        int end = o + DISPLAY_DELTA_ROW_BYTES;
+        while (o < end) {
+            if (i >= len) return -1;
+            int t = p[i++];
+            int run = (t & 0x7f) + 1;
+            if (o + run > end) return -1;
+            if (t & 0x80) {
+                o += run;
+            } else {
+                if (i + run > len) return -1;
+                for (int k = 0; k < run; k++) frame[o++] ^= p[i++];
+            }
+        }
+    }
+    return 0;
+}
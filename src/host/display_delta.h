@@ -0,0 +1,60 @@
+/* display_delta.h - Row delta encoding for the live display stream
+ *
+ * display-server's /stream-bin endpoint sends the display as a sequence of
+ * binary messages, each a 4-byte header followed by its payload:
+ *
+ *   byte 0     type    DISPLAY_DELTA_KEY or DISPLAY_DELTA_DELTA
+ *   byte 1     format  DISPLAY_DELTA_FMT_MONO1 (1024-byte Move frame) or
+ *                      DISPLAY_DELTA_FMT_GRAY4 (4096-byte norns frame)
+ *   bytes 2-3  payload length, little-endian
+ *
+ * A keyframe's payload is the whole frame. A delta's payload lists only the
+ * 128-byte rows that changed since the previous frame, each as its row index
+ * followed by the XOR of old and new row in run-length tokens covering
+ * exactly 128 bytes:
+ *
+ *   0x80 | n   n + 1 unchanged bytes (XOR zero)
+ *   n < 0x80   n + 1 literal XOR bytes follow
+ *
+ * A delta only applies on top of the frame the same client was sent last, in
+ * the same format. The encoder refuses (returns -1) when the delta would be
+ * no smaller than the keyframe. Pure functions, no allocation. */
+
+#ifndef DISPLAY_DELTA_H
+#define DISPLAY_DELTA_H
+
+#include <stdint.h>
+
+#define DISPLAY_DELTA_KEY        0
+#define DISPLAY_DELTA_DELTA      1
+
+#define DISPLAY_DELTA_FMT_MONO1  0
+#define DISPLAY_DELTA_FMT_GRAY4  1
+
+#define DISPLAY_DELTA_HDR_SIZE   4
+#define DISPLAY_DELTA_ROW_BYTES  128
+#define DISPLAY_DELTA_MAX_FRAME  4096
+/* Largest message either encoder writes: a full gray4 keyframe */
+#define DISPLAY_DELTA_MAX_MSG    (DISPLAY_DELTA_HDR_SIZE + DISPLAY_DELTA_MAX_FRAME)
+
+/* Frame size for a format, 0 if unknown */
+int display_delta_frame_size(int format);
+
+/* Write a keyframe message for `frame` into out (DISPLAY_DELTA_MAX_MSG
+ * bytes). Returns the message length. */
+int display_delta_encode_key(uint8_t *out, int format, const uint8_t *frame);
+
+/* Write a delta message taking `prev` to `cur` (both in `format`) into out
+ * (DISPLAY_DELTA_MAX_MSG bytes). Returns the message length, or -1 if a
+ * keyframe is the smaller message. */
+int display_delta_encode_delta(uint8_t *out, int format,
+                               const uint8_t *prev, const uint8_t *cur);
+
+/* Apply one message to `frame` (DISPLAY_DELTA_MAX_FRAME bytes), the
+ * reference for the browser-side decoder. *format holds the format of the
+ * frame so far (-1 for none) and is updated by keyframes. Returns 0, or -1
+ * for a malformed message or a delta that does not match *format. */
+int display_delta_apply(uint8_t *frame, int *format,
+                        const uint8_t *msg, int msg_len);
+
+#endif /* DISPLAY_DELTA_H */
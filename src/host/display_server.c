@@ -5,12 +5,25 @@
  * Reads /dev/shm/schwung-display-live (1024 bytes, written by the shim)
  * and pushes base64-encoded frames to connected browser clients at ~30 Hz.
  *
+ * /stream-bin carries the same display as binary messages instead: a
+ * keyframe, then only the changed 128-byte rows of each frame, XOR and
+ * run-length encoded (display_delta.h). A fresh keyframe goes out every
+ * KEYFRAME_INTERVAL_MS and whenever a client missed a message. The
+ * embedded page uses it; /stream and /stream-auto stay for other readers.
+ *
+ * Every streaming client has its own send queue, drained as its socket
+ * accepts data. A frame that does not fit in a slow client's queue is
+ * dropped for that client only, so one stalled browser never holds up the
+ * others. With no streaming clients the loop sleeps in select() until a
+ * connection arrives.
+ *
  * Usage: display-server [port]   (default port 7681)
  */
 
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -23,6 +36,7 @@
 #include <time.h>
 #include <unistd.h>
 
+#include "display_delta.h"
 #include "norns_display_shm.h"
 #include "unified_log.h"
 
@@ -35,6 +49,9 @@
 #define SHM_RETRY_MS       2000
 #define CLIENT_BUF_SIZE    4096
 #define SSE_BUF_SIZE       7000
+#define CLIENT_OUT_SIZE    16384 /* per-client send queue, ~4 gray4 keyframes */
+#define KEYFRAME_INTERVAL_MS 2000
+#define CLIENT_STALL_MS    10000 /* queued output but nothing sent for this long */
 
 #define DISPLAY_LOG_SOURCE "display_server"
 
@@ -70,6 +87,7 @@ typedef enum {
     STREAM_MODE_NONE = 0,
     STREAM_MODE_LEGACY = 1,
     STREAM_MODE_AUTO = 2,
+    STREAM_MODE_BINARY = 3,
 } stream_mode_t;
 
 typedef enum {
@@ -84,6 +102,11 @@ typedef struct {
     int needs_initial_frame;
     char buf[CLIENT_BUF_SIZE];
     int buf_len;
+    uint8_t out[CLIENT_OUT_SIZE];   /* queued bytes not yet taken by the socket */
+    int out_len;
+    int synced;                     /* binary: holds our last frame, deltas apply */
+    long long last_key_ms;          /* binary: when its last keyframe was queued */
+    long long last_write_ms;        /* last time the socket took data */
 } client_t;
 
 static client_t clients[MAX_CLIENTS];
@@ -143,7 +166,7 @@ static const char HTML_PAGE[] =
     "  const d = img.data;\n"
     "  for (let page = 0; page < 8; page++) {\n"
     "    for (let col = 0; col < 128; col++) {\n"
-    "      const b = raw.charCodeAt(page * 128 + col);\n"
+    "      const b = raw[page * 128 + col];\n"
     "      for (let bit = 0; bit < 8; bit++) {\n"
     "        const y = page * 8 + bit;\n"
     "        const idx = (y * 128 + col) * 4;\n"
@@ -159,7 +182,7 @@ static const char HTML_PAGE[] =
     "  const d = img.data;\n"
     "  for (let y = 0; y < 64; y++) {\n"
     "    for (let x = 0; x < 128; x += 2) {\n"
-    "      const b = raw.charCodeAt(y * 64 + (x >> 1));\n"
+    "      const b = raw[y * 64 + (x >> 1)];\n"
     "      const left = ((b >> 4) & 0x0f) * 17;\n"
     "      const right = (b & 0x0f) * 17;\n"
     "      let idx = (y * 128 + x) * 4;\n"
@@ -183,28 +206,68 @@ static const char HTML_PAGE[] =
     "  }\n"
     "}\n"
     "\n"
-    "function connect() {\n"
-    "  const es = new EventSource('/stream-auto');\n"
-    "  es.onopen = () => {\n"
-    "    statusEl.textContent = 'connected';\n"
-    "    statusEl.className = 'connected';\n"
-    "  };\n"
-    "  es.onerror = () => {\n"
-    "    statusEl.textContent = 'disconnected - reconnecting...';\n"
-    "    statusEl.className = '';\n"
-    "  };\n"
-    "  es.onmessage = (e) => {\n"
-    "    let payload;\n"
-    "    try { payload = JSON.parse(e.data); } catch (_) { return; }\n"
-    "    const raw = atob(payload.data || '');\n"
-    "    if (payload.format === 'gray4' || payload.format === 'gray4_packed') {\n"
-    "      drawGray4(raw);\n"
-    "    } else {\n"
-    "      drawMono(raw);\n"
+    "function setConnected(ok) {\n"
+    "  statusEl.textContent = ok ? 'connected' : 'disconnected - reconnecting...';\n"
+    "  statusEl.className = ok ? 'connected' : '';\n"
+    "}\n"
+    "\n"
+    "/* /stream-bin: [type, format, len lo, len hi] + payload. Keyframes carry\n"
+    "   the frame; deltas carry changed 128-byte rows as row index + XOR\n"
+    "   run tokens (0x80|n: skip n+1, n: n+1 literal bytes). */\n"
+    "const frame = new Uint8Array(4096);\n"
+    "let frameFmt = -1;\n"
+    "\n"
+    "function applyMessage(type, fmt, p) {\n"
+    "  if (type === 0) {\n"
+    "    frame.set(p);\n"
+    "    frameFmt = fmt;\n"
+    "    return true;\n"
+    "  }\n"
+    "  if (fmt !== frameFmt) return false;\n"
+    "  let i = 0;\n"
+    "  while (i < p.length) {\n"
+    "    let o = p[i++] * 128;\n"
+    "    const end = o + 128;\n"
+    "    while (o < end) {\n"
+    "      const t = p[i++], run = (t & 0x7f) + 1;\n"
+    "      if (t & 0x80) { o += run; continue; }\n"
+    "      for (let k = 0; k < run; k++) frame[o++] ^= p[i++];\n"
     "    }\n"
-    "    ctx.putImageData(img, 0, 0);\n"
-    "    updateStatus(payload.source || payload.format || 'display');\n"
-    "  };\n"
+    "  }\n"
+    "  return true;\n"
+    "}\n"
+    "\n"
+    "async function connect() {\n"
+    "  let pending = new Uint8Array(0);\n"
+    "  try {\n"
+    "    const res = await fetch('/stream-bin', { cache: 'no-store' });\n"
+    "    if (!res.ok || !res.body) throw new Error('stream unavailable');\n"
+    "    setConnected(true);\n"
+    "    const reader = res.body.getReader();\n"
+    "    for (;;) {\n"
+    "      const { value, done } = await reader.read();\n"
+    "      if (done) break;\n"
+    "      const buf = new Uint8Array(pending.length + value.length);\n"
+    "      buf.set(pending);\n"
+    "      buf.set(value, pending.length);\n"
+    "      let off = 0, drew = false;\n"
+    "      while (buf.length - off >= 4) {\n"
+    "        const len = buf[off + 2] | (buf[off + 3] << 8);\n"
+    "        if (buf.length - off < 4 + len) break;\n"
+    "        const type = buf[off], fmt = buf[off + 1];\n"
+    "        if (applyMessage(type, fmt, buf.subarray(off + 4, off + 4 + len))) drew = true;\n"
+    "        off += 4 + len;\n"
+    "      }\n"
+    "      pending = buf.slice(off);\n"
+    "      if (drew) {\n"
+    "        if (frameFmt === 1) drawGray4(frame); else drawMono(frame);\n"
+    "        ctx.putImageData(img, 0, 0);\n"
+    "        updateStatus(frameFmt === 1 ? 'norns 4-bit' : 'move 1-bit');\n"
+    "      }\n"
+    "    }\n"
+    "  } catch (_) {}\n"
+    "  setConnected(false);\n"
+    "  setTimeout(connect, 1000);\n"
     "}\n"
     "connect();\n"
     "</script>\n"
@@ -233,6 +296,11 @@ static int norns_frame_is_live(const norns_display_shm_t *shm, long long now) {
     return age_ms >= 0 && age_ms <= NORNS_STALE_MS;
 }
 
+static int bin_format(auto_source_t source) {
+    return (source == AUTO_SOURCE_NORNS) ? DISPLAY_DELTA_FMT_GRAY4
+                                         : DISPLAY_DELTA_FMT_MONO1;
+}
+
 /* Close and clear a client slot */
 static void client_remove(int idx) {
     if (clients[idx].fd >= 0) {
@@ -243,6 +311,46 @@ static void client_remove(int idx) {
     clients[idx].fd = -1;
     clients[idx].stream_mode = STREAM_MODE_NONE;
     clients[idx].buf_len = 0;
+    clients[idx].out_len = 0;
+    clients[idx].synced = 0;
+}
+
+/* Write as much of a client's send queue as the socket takes right now.
+ * Returns -1 (client removed) on a socket error. */
+static int client_flush(int idx) {
+    client_t *c = &clients[idx];
+    int sent = 0;
+    while (sent < c->out_len) {
+        ssize_t n = write(c->fd, c->out + sent, c->out_len - sent);
+        if (n > 0) {
+            sent += (int)n;
+            c->last_write_ms = now_ms();
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            client_remove(idx);
+            return -1;
+        }
+    }
+    if (sent > 0) {
+        memmove(c->out, c->out + sent, c->out_len - sent);
+        c->out_len -= sent;
+    }
+    return 0;
+}
+
+/* Queue one whole message for a client and start sending it. Returns 1 if
+ * queued, 0 if it was dropped because the client is too far behind, -1 if
+ * the client is gone. */
+static int client_send(int idx, const void *data, int len) {
+    client_t *c = &clients[idx];
+    if (len > CLIENT_OUT_SIZE - c->out_len) return 0;
+    if (c->out_len == 0) c->last_write_ms = now_ms();
+    memcpy(c->out + c->out_len, data, len);
+    c->out_len += len;
+    return client_flush(idx) < 0 ? -1 : 1;
 }
 
 /* Send a complete HTTP response and close */
@@ -268,7 +376,26 @@ static void send_response(int idx, int code, const char *ctype,
 static void handle_http(int idx) {
     clients[idx].buf[clients[idx].buf_len] = '\0';
 
-    if (strncmp(clients[idx].buf, "GET /stream-auto", 16) == 0) {
+    if (strncmp(clients[idx].buf, "GET /stream-bin", 15) == 0) {
+        /* Unframed binary body, delimited by connection close */
+        const char *bin_header =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/octet-stream\r\n"
+            "Cache-Control: no-cache, no-transform\r\n"
+            "Connection: close\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "\r\n";
+        if (client_send(idx, bin_header, (int)strlen(bin_header)) > 0) {
+            /* Deltas are small; don't let Nagle hold them back */
+            int one = 1;
+            setsockopt(clients[idx].fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            clients[idx].stream_mode = STREAM_MODE_BINARY;
+            clients[idx].needs_initial_frame = 1;
+            LOG_INFO(DISPLAY_LOG_SOURCE, "binary client connected (slot %d)", idx);
+        } else {
+            client_remove(idx);
+        }
+    } else if (strncmp(clients[idx].buf, "GET /stream-auto", 16) == 0) {
         const char *sse_header =
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: text/event-stream\r\n"
@@ -276,7 +403,7 @@ static void handle_http(int idx) {
             "Connection: keep-alive\r\n"
             "Access-Control-Allow-Origin: *\r\n"
             "\r\n";
-        if (write(clients[idx].fd, sse_header, strlen(sse_header)) > 0) {
+        if (client_send(idx, sse_header, (int)strlen(sse_header)) > 0) {
             clients[idx].stream_mode = STREAM_MODE_AUTO;
             clients[idx].needs_initial_frame = 1;
             LOG_INFO(DISPLAY_LOG_SOURCE, "auto SSE client connected (slot %d)", idx);
@@ -292,7 +419,7 @@ static void handle_http(int idx) {
             "Connection: keep-alive\r\n"
             "Access-Control-Allow-Origin: *\r\n"
             "\r\n";
-        if (write(clients[idx].fd, sse_header, strlen(sse_header)) > 0) {
+        if (client_send(idx, sse_header, (int)strlen(sse_header)) > 0) {
             clients[idx].stream_mode = STREAM_MODE_LEGACY;
             clients[idx].needs_initial_frame = 1;
             LOG_INFO(DISPLAY_LOG_SOURCE, "legacy SSE client connected (slot %d)", idx);
@@ -369,6 +496,7 @@ int main(int argc, char *argv[]) {
     /* Large enough for 4096-byte base64 + JSON SSE framing. */
     char b64_buf[SSE_BUF_SIZE];
     char sse_buf[SSE_BUF_SIZE];
+    static uint8_t bin_buf[DISPLAY_DELTA_MAX_MSG];
 
     while (running) {
         /* Try to open shm if not yet mapped */
@@ -408,23 +536,41 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        /* Build fd_set for select */
-        fd_set rfds;
+        /* Build fd_sets for select */
+        fd_set rfds, wfds;
         FD_ZERO(&rfds);
+        FD_ZERO(&wfds);
         FD_SET(srv, &rfds);
         int maxfd = srv;
+        int n_streaming = 0;
 
         for (int i = 0; i < MAX_CLIENTS; i++) {
-            if (clients[i].fd >= 0 && clients[i].stream_mode == STREAM_MODE_NONE) {
+            if (clients[i].fd < 0) continue;
+            if (clients[i].stream_mode == STREAM_MODE_NONE) {
                 FD_SET(clients[i].fd, &rfds);
-                if (clients[i].fd > maxfd) maxfd = clients[i].fd;
+            } else {
+                n_streaming++;
+                if (clients[i].out_len > 0) FD_SET(clients[i].fd, &wfds);
             }
+            if (clients[i].fd > maxfd) maxfd = clients[i].fd;
         }
 
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = POLL_INTERVAL_MS * 1000;
-        int nready = select(maxfd + 1, &rfds, NULL, NULL, &tv);
+        /* Wake for the next push while anyone is streaming; otherwise only
+         * a new connection or request data can give us work */
+        struct timeval tv, *tvp = NULL;
+        if (n_streaming > 0) {
+            long long wait = last_push + POLL_INTERVAL_MS - now_ms();
+            if (wait < 0) wait = 0;
+            tv.tv_sec = wait / 1000;
+            tv.tv_usec = (wait % 1000) * 1000;
+            tvp = &tv;
+        }
+        int nready = select(maxfd + 1, &rfds, &wfds, NULL, tvp);
+        if (nready < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(DISPLAY_LOG_SOURCE, "select failed: %s", strerror(errno));
+            break;
+        }
 
         /* Accept new connections */
         if (nready > 0 && FD_ISSET(srv, &rfds)) {
@@ -437,6 +583,8 @@ int main(int argc, char *argv[]) {
                         clients[i].fd = cfd;
                         clients[i].stream_mode = STREAM_MODE_NONE;
                         clients[i].buf_len = 0;
+                        clients[i].out_len = 0;
+                        clients[i].synced = 0;
                         placed = 1;
                         break;
                     }
@@ -445,10 +593,14 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        /* Read from non-streaming clients */
+        /* Read from non-streaming clients, drain streaming clients' queues */
         for (int i = 0; i < MAX_CLIENTS; i++) {
-            if (clients[i].fd < 0 || clients[i].stream_mode != STREAM_MODE_NONE) continue;
-            if (nready > 0 && FD_ISSET(clients[i].fd, &rfds)) {
+            if (clients[i].fd < 0 || nready <= 0) continue;
+            if (clients[i].stream_mode != STREAM_MODE_NONE) {
+                if (FD_ISSET(clients[i].fd, &wfds)) client_flush(i);
+                continue;
+            }
+            if (FD_ISSET(clients[i].fd, &rfds)) {
                 int space = CLIENT_BUF_SIZE - clients[i].buf_len - 1;
                 if (space <= 0) { client_remove(i); continue; }
                 int n = read(clients[i].fd, clients[i].buf + clients[i].buf_len, space);
@@ -462,19 +614,116 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        /* Push display frames to SSE clients */
+        /* Push display frames to streaming clients */
         {
             long long now = now_ms();
-            if (now - last_push >= POLL_INTERVAL_MS) {
-                int legacy_changed = 0;
+            if (n_streaming > 0 && now - last_push >= POLL_INTERVAL_MS) {
+                int n_legacy = 0, n_auto = 0, n_bin = 0;
                 const uint8_t *auto_frame = NULL;
                 size_t auto_frame_size = 0;
                 const char *auto_format = NULL;
                 const char *auto_source_label = NULL;
                 auto_source_t auto_source = AUTO_SOURCE_NONE;
+                int key_len = 0;
 
                 last_push = now;
 
+                for (int i = 0; i < MAX_CLIENTS; i++) {
+                    if (clients[i].fd < 0) continue;
+                    if (clients[i].stream_mode == STREAM_MODE_LEGACY) n_legacy++;
+                    else if (clients[i].stream_mode == STREAM_MODE_AUTO) n_auto++;
+                    else if (clients[i].stream_mode == STREAM_MODE_BINARY) n_bin++;
+                }
+
+                /* Legacy stream: raw Move display, to clients past their
+                 * initial frame */
+                if (n_legacy > 0 && shm_ptr &&
+                    memcmp(shm_ptr, last_display, DISPLAY_SIZE) != 0) {
+                    int sse_len;
+                    memcpy(last_display, shm_ptr, DISPLAY_SIZE);
+                    (void)base64_encode(last_display, DISPLAY_SIZE, b64_buf);
+                    sse_len = snprintf(sse_buf, sizeof(sse_buf), "data: %s\n\n", b64_buf);
+                    for (int i = 0; i < MAX_CLIENTS; i++) {
+                        if (clients[i].fd < 0 || clients[i].stream_mode != STREAM_MODE_LEGACY ||
+                            clients[i].needs_initial_frame) continue;
+                        client_send(i, sse_buf, sse_len);
+                    }
+                }
+
+                static uint8_t norns_frame_copy[NORNS_FRAME_SIZE];
+                int norns_torn_read = 0;
+
+                if (n_auto + n_bin == 0) {
+                    /* Nobody wants the auto source this tick */
+                } else if (norns_frame_is_live(norns_shm_ptr, now)) {
+                    /* Snapshot frame_counter before and after reading frame
+                     * to detect torn reads */
+                    uint32_t counter_before = norns_shm_ptr->frame_counter;
+                    __sync_synchronize(); /* memory barrier */
+                    memcpy(norns_frame_copy, norns_shm_ptr->frame, NORNS_FRAME_SIZE);
+                    __sync_synchronize();
+                    uint32_t counter_after = norns_shm_ptr->frame_counter;
+                    if (counter_before != counter_after) {
+                        /* Frame was being written during our read - skip */
+                        norns_torn_read = 1;
+                    }
+                    if (!norns_torn_read) {
+                        auto_frame = norns_frame_copy;
+                        auto_frame_size = NORNS_FRAME_SIZE;
+                        auto_format = NORNS_DISPLAY_FORMAT;
+                        auto_source_label = "norns 4-bit";
+                        auto_source = AUTO_SOURCE_NORNS;
+                    }
+                } else if (shm_ptr) {
+                    auto_frame = shm_ptr;
+                    auto_frame_size = DISPLAY_SIZE;
+                    auto_format = "mono1_packed";
+                    auto_source_label = "move 1-bit";
+                    auto_source = AUTO_SOURCE_MOVE;
+                }
+
+                if (auto_frame) {
+                    int same_format =
+                        (auto_source == last_auto_source) &&
+                        (auto_frame_size == last_auto_size);
+                    int auto_changed =
+                        !same_format ||
+                        (memcmp(auto_frame, last_auto_frame, auto_frame_size) != 0);
+                    if (auto_changed) {
+                        int sse_len = 0, delta_len = -1;
+                        if (n_auto > 0) {
+                            (void)base64_encode(auto_frame, (int)auto_frame_size, b64_buf);
+                            sse_len = snprintf(sse_buf, sizeof(sse_buf),
+                                               "data: {\"format\":\"%s\",\"encoding\":\"base64\","
+                                               "\"width\":128,\"height\":64,\"source\":\"%s\","
+                                               "\"data\":\"%s\"}\n\n",
+                                               auto_format, auto_source_label, b64_buf);
+                            if (sse_len >= (int)sizeof(sse_buf)) sse_len = 0;
+                        }
+                        if (n_bin > 0 && same_format) {
+                            delta_len = display_delta_encode_delta(bin_buf,
+                                bin_format(last_auto_source), last_auto_frame, auto_frame);
+                        }
+                        for (int i = 0; i < MAX_CLIENTS; i++) {
+                            if (clients[i].fd < 0 || clients[i].needs_initial_frame) continue;
+                            if (clients[i].stream_mode == STREAM_MODE_AUTO) {
+                                if (sse_len > 0) client_send(i, sse_buf, sse_len);
+                            } else if (clients[i].stream_mode == STREAM_MODE_BINARY &&
+                                       clients[i].synced) {
+                                /* Anything but an in-interval delta goes
+                                 * out below as a keyframe */
+                                if (delta_len < 0 ||
+                                    now - clients[i].last_key_ms >= KEYFRAME_INTERVAL_MS ||
+                                    client_send(i, bin_buf, delta_len) == 0)
+                                    clients[i].synced = 0;
+                            }
+                        }
+                        memcpy(last_auto_frame, auto_frame, auto_frame_size);
+                        last_auto_size = auto_frame_size;
+                        last_auto_source = auto_source;
+                    }
+                }
+
                 /* Send initial frame to newly connected clients */
                 for (int i = 0; i < MAX_CLIENTS; i++) {
                     if (clients[i].fd < 0 || !clients[i].needs_initial_frame) continue;
@@ -486,8 +735,7 @@ int main(int argc, char *argv[]) {
                             int sse_len;
                             (void)base64_encode(shm_ptr, DISPLAY_SIZE, b64_buf);
                             sse_len = snprintf(sse_buf, sizeof(sse_buf), "data: %s\n\n", b64_buf);
-                            if (write(clients[i].fd, sse_buf, sse_len) <= 0)
-                                client_remove(i);
+                            client_send(i, sse_buf, sse_len);
                         }
                     } else if (clients[i].stream_mode == STREAM_MODE_AUTO) {
                         /* Send cached auto frame (norns or move) */
@@ -503,10 +751,8 @@ int main(int argc, char *argv[]) {
                                 "\"width\":128,\"height\":64,\"source\":\"%s\","
                                 "\"data\":\"%s\"}\n\n",
                                 fmt, src, b64_buf);
-                            if (sse_len < (int)sizeof(sse_buf)) {
-                                if (write(clients[i].fd, sse_buf, sse_len) <= 0)
-                                    client_remove(i);
-                            }
+                            if (sse_len < (int)sizeof(sse_buf))
+                                client_send(i, sse_buf, sse_len);
                         } else if (shm_ptr) {
                             /* No auto frame cached yet, fall back to mono */
                             int sse_len;
@@ -516,81 +762,36 @@ int main(int argc, char *argv[]) {
                                 "\"width\":128,\"height\":64,\"source\":\"move 1-bit\","
                                 "\"data\":\"%s\"}\n\n",
                                 b64_buf);
-                            if (sse_len < (int)sizeof(sse_buf)) {
-                                if (write(clients[i].fd, sse_buf, sse_len) <= 0)
-                                    client_remove(i);
-                            }
+                            if (sse_len < (int)sizeof(sse_buf))
+                                client_send(i, sse_buf, sse_len);
                         }
+                    } else if (clients[i].stream_mode == STREAM_MODE_BINARY) {
+                        clients[i].synced = 0;
                     }
                 }
 
-                if (shm_ptr && memcmp(shm_ptr, last_display, DISPLAY_SIZE) != 0) {
-                    memcpy(last_display, shm_ptr, DISPLAY_SIZE);
-                    legacy_changed = 1;
-                }
-
-                static uint8_t norns_frame_copy[NORNS_FRAME_SIZE];
-                int norns_torn_read = 0;
-
-                if (norns_frame_is_live(norns_shm_ptr, now)) {
-                    /* Snapshot frame_counter before and after reading frame
-                     * to detect torn reads */
-                    uint32_t counter_before = norns_shm_ptr->frame_counter;
-                    __sync_synchronize(); /* memory barrier */
-                    memcpy(norns_frame_copy, norns_shm_ptr->frame, NORNS_FRAME_SIZE);
-                    __sync_synchronize();
-                    uint32_t counter_after = norns_shm_ptr->frame_counter;
-                    if (counter_before != counter_after) {
-                        /* Frame was being written during our read - skip */
-                        norns_torn_read = 1;
-                    }
-                    if (!norns_torn_read) {
-                        auto_frame = norns_frame_copy;
-                        auto_frame_size = NORNS_FRAME_SIZE;
-                        auto_format = NORNS_DISPLAY_FORMAT;
-                        auto_source_label = "norns 4-bit";
-                        auto_source = AUTO_SOURCE_NORNS;
+                /* Keyframes for binary clients that are new, missed a
+                 * message, or are due one. A client whose queue is still
+                 * too full keeps waiting for the next tick. */
+                for (int i = 0; i < MAX_CLIENTS; i++) {
+                    if (clients[i].fd < 0 || clients[i].stream_mode != STREAM_MODE_BINARY ||
+                        clients[i].synced || last_auto_size == 0) continue;
+                    if (key_len == 0) {
+                        key_len = display_delta_encode_key(bin_buf,
+                            bin_format(last_auto_source), last_auto_frame);
                     }
-                } else if (shm_ptr) {
-                    auto_frame = shm_ptr;
-                    auto_frame_size = DISPLAY_SIZE;
-                    auto_format = "mono1_packed";
-                    auto_source_label = "move 1-bit";
-                    auto_source = AUTO_SOURCE_MOVE;
-                }
-
-                if (legacy_changed) {
-                    int sse_len;
-                    (void)base64_encode(last_display, DISPLAY_SIZE, b64_buf);
-                    sse_len = snprintf(sse_buf, sizeof(sse_buf), "data: %s\n\n", b64_buf);
-                    for (int i = 0; i < MAX_CLIENTS; i++) {
-                        if (clients[i].fd < 0 || clients[i].stream_mode != STREAM_MODE_LEGACY) continue;
-                        if (write(clients[i].fd, sse_buf, sse_len) <= 0) client_remove(i);
+                    if (client_send(i, bin_buf, key_len) > 0) {
+                        clients[i].synced = 1;
+                        clients[i].last_key_ms = now;
                     }
                 }
 
-                if (auto_frame) {
-                    int auto_changed =
-                        (auto_source != last_auto_source) ||
-                        (auto_frame_size != last_auto_size) ||
-                        (memcmp(auto_frame, last_auto_frame, auto_frame_size) != 0);
-                    if (auto_changed) {
-                        int sse_len;
-                        (void)base64_encode(auto_frame, (int)auto_frame_size, b64_buf);
-                        sse_len = snprintf(sse_buf, sizeof(sse_buf),
-                                           "data: {\"format\":\"%s\",\"encoding\":\"base64\","
-                                           "\"width\":128,\"height\":64,\"source\":\"%s\","
-                                           "\"data\":\"%s\"}\n\n",
-                                           auto_format, auto_source_label, b64_buf);
-                        if (sse_len < (int)sizeof(sse_buf)) {
-                            for (int i = 0; i < MAX_CLIENTS; i++) {
-                                if (clients[i].fd < 0 || clients[i].stream_mode != STREAM_MODE_AUTO) continue;
-                                if (write(clients[i].fd, sse_buf, sse_len) <= 0) client_remove(i);
-                            }
-                            memcpy(last_auto_frame, auto_frame, auto_frame_size);
-                            last_auto_size = auto_frame_size;
-                            last_auto_source = auto_source;
-                        }
+                /* A client that has taken nothing for a long time is gone */
+                for (int i = 0; i < MAX_CLIENTS; i++) {
+                    if (clients[i].fd < 0 || clients[i].out_len == 0) continue;
+                    if (now - clients[i].last_write_ms > CLIENT_STALL_MS) {
+                        LOG_INFO(DISPLAY_LOG_SOURCE, "client stalled (slot %d)", i);
+                        client_remove(i);
                     }
                 }
             }
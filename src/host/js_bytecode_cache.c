@@ -0,0 +1,194 @@
+/*
+ * js_bytecode_cache.c - Precompiled QuickJS bytecode for UI scripts
+ * See js_bytecode_cache.h for the cache policy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "quickjs-libc.h"
+#include "js_bytecode_cache.h"
+
+#define JS_BC_MAGIC "SQBC"
+#define JS_BC_FORMAT_VERSION 1
+
+/* Bytecode is only portable between identical QuickJS builds. Keep this in
+ * step with the vendored release under libs/quickjs; JS_ReadObject also
+ * rejects a BC_VERSION mismatch, which lands on the recompile path. */
+#define JS_BC_ENGINE "quickjs-2025-04-26"
+
+#define JS_BC_MAX_FILE (16 * 1024 * 1024)
+
+typedef struct {
+    char     magic[4];
+    uint32_t version;
+    char     engine[32];
+    uint32_t ptr_size;
+    uint32_t eval_flags;
+    uint64_t source_size;
+    uint64_t source_hash;   /* FNV-1a 64 of the source text */
+    uint32_t path_len;      /* source path (no NUL) follows the header, */
+    uint32_t bytecode_size; /* then the JS_WriteObject output */
+} js_bc_header_t;
+
+static uint64_t fnv1a64(const uint8_t *p, size_t n) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static void header_init(js_bc_header_t *h, const char *path, int eval_flags,
+                        size_t source_size, uint64_t source_hash) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, JS_BC_MAGIC, 4);
+    h->version = JS_BC_FORMAT_VERSION;
+    snprintf(h->engine, sizeof(h->engine), "%s", JS_BC_ENGINE);
+    h->ptr_size = sizeof(void *);
+    h->eval_flags = (uint32_t)eval_flags;
+    h->source_size = source_size;
+    h->source_hash = source_hash;
+    h->path_len = (uint32_t)strlen(path);
+}
+
+static int cache_path(char *out, size_t out_len, const char *path) {
+    int n = snprintf(out, out_len, "%s" JS_BC_CACHE_SUFFIX, path);
+    return (n > 0 && (size_t)n < out_len) ? 0 : -1;
+}
+
+/* Load the bytecode for `path` if the cache file matches `want`. Returns a
+ * malloc'd buffer (caller frees) or NULL. */
+static uint8_t *cache_read(const char *path, const js_bc_header_t *want,
+                           size_t *bytecode_len) {
+    char qbc[1024];
+    if (cache_path(qbc, sizeof(qbc), path) != 0) return NULL;
+
+    FILE *f = fopen(qbc, "rb");
+    if (!f) return NULL;
+
+    uint8_t *buf = NULL;
+    js_bc_header_t h;
+    char stored_path[1024];
+
+    if (fread(&h, sizeof(h), 1, f) != 1) goto out;
+    /* Every field but bytecode_size must match */
+    js_bc_header_t cmp = *want;
+    cmp.bytecode_size = h.bytecode_size;
+    if (memcmp(&h, &cmp, sizeof(h)) != 0) goto out;
+    if (h.bytecode_size == 0 || h.bytecode_size > JS_BC_MAX_FILE) goto out;
+    if (h.path_len >= sizeof(stored_path)) goto out;
+    if (fread(stored_path, 1, h.path_len, f) != h.path_len) goto out;
+    if (memcmp(stored_path, path, h.path_len) != 0) goto out;
+
+    uint32_t size = h.bytecode_size;
+    buf = malloc(size);
+    if (!buf) goto out;
+    if (fread(buf, 1, size, f) != size) {
+        free(buf);
+        buf = NULL;
+        goto out;
+    }
+    *bytecode_len = size;
+out:
+    fclose(f);
+    return buf;
+}
+
+/* Best effort: a read-only or full filesystem just means no cache */
+static void cache_write(const char *path, js_bc_header_t *h,
+                        const uint8_t *bytecode, size_t bytecode_len) {
+    char qbc[1024], tmp[1100];
+    if (cache_path(qbc, sizeof(qbc), path) != 0) return;
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", qbc, (int)getpid());
+
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return;
+    h->bytecode_size = (uint32_t)bytecode_len;
+    int ok = fwrite(h, sizeof(*h), 1, f) == 1 &&
+             fwrite(path, 1, h->path_len, f) == h->path_len &&
+             fwrite(bytecode, 1, bytecode_len, f) == bytecode_len;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok || rename(tmp, qbc) != 0) unlink(tmp);
+}
+
+JSValue js_bc_compile_file(JSContext *ctx, const char *path,
+                           const char *js_name, int eval_flags) {
+    size_t src_len;
+    uint8_t *src = js_load_file(ctx, &src_len, path);
+    if (!src) {
+        return JS_ThrowReferenceError(ctx, "could not load '%s'", path);
+    }
+    if (!js_name) js_name = path;
+
+    js_bc_header_t want;
+    header_init(&want, path, eval_flags, src_len, fnv1a64(src, src_len));
+
+    size_t bc_len = 0;
+    uint8_t *bc = cache_read(path, &want, &bc_len);
+    if (bc) {
+        JSValue val = JS_ReadObject(ctx, bc, bc_len, JS_READ_OBJ_BYTECODE);
+        free(bc);
+        if (!JS_IsException(val)) {
+            if (JS_VALUE_GET_TAG(val) == JS_TAG_MODULE &&
+                JS_ResolveModule(ctx, val) < 0) {
+                JS_FreeValue(ctx, val);
+                js_free(ctx, src);
+                return JS_EXCEPTION;
+            }
+            js_free(ctx, src);
+            return val;
+        }
+        /* Unreadable bytecode: drop the exception and recompile */
+        JS_FreeValue(ctx, JS_GetException(ctx));
+    }
+
+    JSValue val = JS_Eval(ctx, (const char *)src, src_len, js_name,
+                          eval_flags | JS_EVAL_FLAG_COMPILE_ONLY);
+    js_free(ctx, src);
+    if (JS_IsException(val)) return val;
+
+    uint8_t *out = JS_WriteObject(ctx, &bc_len, val, JS_WRITE_OBJ_BYTECODE);
+    if (out) {
+        cache_write(path, &want, out, bc_len);
+        js_free(ctx, out);
+    } else {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+    }
+    return val;
+}
+
+static int has_suffix(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+JSModuleDef *js_bc_module_loader(JSContext *ctx, const char *module_name,
+                                 void *opaque) {
+    if (has_suffix(module_name, ".so")) {
+        return js_module_loader(ctx, module_name, opaque);
+    }
+
+    JSValue func_val = js_bc_compile_file(ctx, module_name, NULL,
+                                          JS_EVAL_TYPE_MODULE);
+    if (JS_IsException(func_val)) return NULL;
+    js_module_set_import_meta(ctx, func_val, 1, 0);
+    /* the module is already referenced, so we must free it */
+    JSModuleDef *m = JS_VALUE_GET_PTR(func_val);
+    JS_FreeValue(ctx, func_val);
+    return m;
+}
+
+int js_bc_precompile(JSContext *ctx, const char *path, int eval_flags) {
+    JSValue val = js_bc_compile_file(ctx, path, NULL, eval_flags);
+    if (JS_IsException(val)) {
+        js_std_dump_error(ctx);
+        return -1;
+    }
+    JS_FreeValue(ctx, val);
+    return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * js_bytecode_cache.h - Precompiled QuickJS bytecode for UI scripts
+ *
+ * shadow_ui parses and compiles shadow_ui.js and its import graph on every
+ * start, and each module UI again when it is opened. This cache stores the
+ * compiled form next to the source as "<path>.qbc" and reads it back with
+ * JS_ReadObject instead of recompiling.
+ *
+ * A cache file is used only when its header matches the cache format
+ * version, the QuickJS release string and pointer size, the eval flags,
+ * the source path, and the source text's size and FNV-1a hash (mtime is
+ * not consulted: the source is always read). Anything else - a missing or
+ * stale file, a read-only directory, a JS_ReadObject failure - falls back
+ * to compiling the source, which then rewrites the cache (tmp file +
+ * rename). The cache is never required for correctness; deleting every
+ * .qbc is always safe.
+ */
+
+#ifndef JS_BYTECODE_CACHE_H
+#define JS_BYTECODE_CACHE_H
+
+#include "quickjs.h"
+
+#define JS_BC_CACHE_SUFFIX ".qbc"
+
+/* Compile the script or module at `path`, from its cache file when valid.
+ * Same result as JS_Eval(..., eval_flags | JS_EVAL_FLAG_COMPILE_ONLY):
+ * a function or a resolved module, not yet evaluated. `js_name` is the
+ * filename QuickJS records (NULL: path). On failure returns JS_EXCEPTION
+ * with an exception pending. */
+JSValue js_bc_compile_file(JSContext *ctx, const char *path,
+                           const char *js_name, int eval_flags);
+
+/* Module loader for JS_SetModuleLoaderFunc: js_module_loader with imported
+ * .js/.mjs files going through the cache. Native .so modules are passed
+ * through to js_module_loader. */
+JSModuleDef *js_bc_module_loader(JSContext *ctx, const char *module_name,
+                                 void *opaque);
+
+/* Compile `path` (and, for a module, its imports) into the cache without
+ * evaluating it. Returns 0 on success, -1 with the error printed. */
+int js_bc_precompile(JSContext *ctx, const char *path, int eval_flags);
+
+#endif /* JS_BYTECODE_CACHE_H */
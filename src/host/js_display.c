@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 
 /* STB implementations - must undefine after include to prevent double-inclusion
  * when js_display.h includes the same headers for type declarations */
@@ -21,62 +22,106 @@
 
 #include "js_display.h"
 
-/* Screen buffer - shared across all display functions */
-unsigned char js_display_screen_buffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+/* Screen buffer - shared across all display functions, in the packed
+ * layout the OLED takes (see js_display.h) */
+unsigned char js_display_screen_buffer[DISPLAY_BUFFER_SIZE] __attribute__((aligned(8)));
 
 /* Dirty flag - set when screen changes */
 int js_display_screen_dirty = 0;
 
+/* Dirty slices - a fresh process has never pushed anything */
+uint32_t js_display_dirty_slices = DISPLAY_ALL_SLICES;
+
 /* Global font - loaded on first use */
 static Font *g_font = NULL;
 
-/* Mark screen as needing update */
-static void mark_dirty(void) {
+#define PAGES (DISPLAY_HEIGHT / 8)
+
+typedef uint32_t __attribute__((may_alias, aligned(1))) fb_word_t;
+
+/* Mark bytes lo..hi (inclusive) of the screen buffer as changed */
+static void mark_dirty_bytes(int lo, int hi) {
+    int first = lo / DISPLAY_SLICE_BYTES;
+    int last = hi / DISPLAY_SLICE_BYTES;
+    js_display_dirty_slices |= ((2u << last) - 1) & ~((1u << first) - 1);
     js_display_screen_dirty = 1;
 }
 
+/* Unchecked pixel write; callers clip */
+static inline void put_pixel(int x, int y, int value) {
+    int idx = (y >> 3) * DISPLAY_WIDTH + x;
+    uint8_t bit = (uint8_t)(1u << (y & 7));
+    if (value) js_display_screen_buffer[idx] |= bit;
+    else js_display_screen_buffer[idx] &= (uint8_t)~bit;
+}
+
+/* Set or clear `mask` bits in columns x0..x1 of one page, a word at a time */
+static void fill_page_span(int page, int x0, int x1, uint8_t mask, int value) {
+    uint8_t *p = js_display_screen_buffer + page * DISPLAY_WIDTH;
+    int x = x0;
+    if (mask == 0xFF) {
+        memset(p + x0, value ? 0xFF : 0x00, (size_t)(x1 - x0 + 1));
+    } else {
+        uint32_t wmask = mask * 0x01010101u;
+        for (; x <= x1 && (x & 3); x++)
+            p[x] = value ? (uint8_t)(p[x] | mask) : (uint8_t)(p[x] & ~mask);
+        for (; x + 3 <= x1; x += 4) {
+            fb_word_t *w = (fb_word_t *)(p + x);
+            *w = value ? (*w | wmask) : (*w & ~wmask);
+        }
+        for (; x <= x1; x++)
+            p[x] = value ? (uint8_t)(p[x] | mask) : (uint8_t)(p[x] & ~mask);
+    }
+    mark_dirty_bytes(page * DISPLAY_WIDTH + x0, page * DISPLAY_WIDTH + x1);
+}
+
 /* ============================================================================
  * Core Display Functions
  * ============================================================================ */
 
 void js_display_clear(void) {
     memset(js_display_screen_buffer, 0, sizeof(js_display_screen_buffer));
-    mark_dirty();
+    js_display_dirty_slices = DISPLAY_ALL_SLICES;
+    js_display_screen_dirty = 1;
 }
 
 void js_display_set_pixel(int x, int y, int value) {
     if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) {
-        js_display_screen_buffer[y * DISPLAY_WIDTH + x] = value ? 1 : 0;
-        mark_dirty();
+        put_pixel(x, y, value);
+        int idx = (y >> 3) * DISPLAY_WIDTH + x;
+        mark_dirty_bytes(idx, idx);
     }
 }
 
 int js_display_get_pixel(int x, int y) {
     if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) {
-        return js_display_screen_buffer[y * DISPLAY_WIDTH + x] ? 1 : 0;
+        return (js_display_screen_buffer[(y >> 3) * DISPLAY_WIDTH + x] >> (y & 7)) & 1;
     }
     return 0;
 }
 
-void js_display_draw_rect(int x, int y, int w, int h, int value) {
+void js_display_fill_rect(int x, int y, int w, int h, int value) {
     if (w <= 0 || h <= 0) return;
-    for (int yi = y; yi < y + h; yi++) {
-        js_display_set_pixel(x, yi, value);
-        js_display_set_pixel(x + w - 1, yi, value);
-    }
-    for (int xi = x; xi < x + w; xi++) {
-        js_display_set_pixel(xi, y, value);
-        js_display_set_pixel(xi, y + h - 1, value);
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= DISPLAY_WIDTH ? DISPLAY_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= DISPLAY_HEIGHT ? DISPLAY_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    for (int page = y0 >> 3; page <= y1 >> 3; page++) {
+        int top = page == (y0 >> 3) ? (y0 & 7) : 0;
+        int bottom = page == (y1 >> 3) ? (y1 & 7) : 7;
+        uint8_t mask = (uint8_t)((0xFFu << top) & (0xFFu >> (7 - bottom)));
+        fill_page_span(page, x0, x1, mask, value);
     }
 }
 
-void js_display_fill_rect(int x, int y, int w, int h, int value) {
+void js_display_draw_rect(int x, int y, int w, int h, int value) {
     if (w <= 0 || h <= 0) return;
-    for (int yi = y; yi < y + h; yi++) {
-        for (int xi = x; xi < x + w; xi++) {
-            js_display_set_pixel(xi, yi, value);
-        }
-    }
+    js_display_fill_rect(x, y, w, 1, value);
+    js_display_fill_rect(x, y + h - 1, w, 1, value);
+    js_display_fill_rect(x, y, 1, h, value);
+    js_display_fill_rect(x + w - 1, y, 1, h, value);
 }
 
 void js_display_draw_line(int x0, int y0, int x1, int y1, int value) {
@@ -89,35 +134,80 @@ void js_display_draw_line(int x0, int y0, int x1, int y1, int value) {
 
     if (dx == 0) {
         int start = y0 < y1 ? y0 : y1;
-        int end = y0 < y1 ? y1 : y0;
-        for (int y = start; y <= end; y++) js_display_set_pixel(x0, y, value);
+        js_display_fill_rect(x0, start, 1, dy + 1, value);
         return;
     }
     if (dy == 0) {
         int start = x0 < x1 ? x0 : x1;
-        int end = x0 < x1 ? x1 : x0;
-        for (int x = start; x <= end; x++) js_display_set_pixel(x, y0, value);
+        js_display_fill_rect(start, y0, dx + 1, 1, value);
         return;
     }
 
     int err = dx - dy;
+    int lo = DISPLAY_BUFFER_SIZE, hi = -1;
     while (1) {
-        js_display_set_pixel(x0, y0, value);
+        if (x0 >= 0 && x0 < DISPLAY_WIDTH && y0 >= 0 && y0 < DISPLAY_HEIGHT) {
+            put_pixel(x0, y0, value);
+            int idx = (y0 >> 3) * DISPLAY_WIDTH + x0;
+            if (idx < lo) lo = idx;
+            if (idx > hi) hi = idx;
+        }
         if (x0 == x1 && y0 == y1) break;
         int e2 = 2 * err;
         if (e2 > -dy) { err -= dy; x0 += sx; }
         if (e2 < dx) { err += dx; y0 += sy; }
     }
+    if (hi >= 0) mark_dirty_bytes(lo, hi);
 }
 
 void js_display_fill_circle(int cx, int cy, int r, int value) {
-    for (int dy = -r; dy <= r; dy++) {
-        for (int dx = -r; dx <= r; dx++) {
-            if (dx * dx + dy * dy <= r * r) {
-                js_display_set_pixel(cx + dx, cy + dy, value);
+    /* One span per row: the widest dx with dx^2 + dy^2 <= r^2 */
+    int span = r;
+    for (int dy = 0; dy <= r; dy++) {
+        while (span * span + dy * dy > r * r) span--;
+        js_display_fill_rect(cx - span, cy - dy, 2 * span + 1, 1, value);
+        if (dy) js_display_fill_rect(cx - span, cy + dy, 2 * span + 1, 1, value);
+    }
+}
+
+/* Draw a w x h bitmap held in the screen layout (byte (row / 8) * stride +
+ * col) with its top-left at dx, dy: set bits are drawn in `color`, clear
+ * bits leave the screen alone. Each source byte lands on at most two pages. */
+static void blit_packed(const uint8_t *src, int stride, int w, int h, int dx, int dy, int color) {
+    if (!src || w <= 0 || h <= 0) return;
+    int x0 = dx < 0 ? -dx : 0;
+    int x1 = dx + w > DISPLAY_WIDTH ? DISPLAY_WIDTH - dx : w;
+    if (x0 >= x1 || dy >= DISPLAY_HEIGHT || dy + h <= 0) return;
+
+    int shift = dy & 7;
+    int page0 = (dy - shift) / 8;   /* floor, also for negative dy */
+    int src_pages = (h + 7) / 8;
+    int lo = DISPLAY_BUFFER_SIZE, hi = -1;
+
+    for (int sp = 0; sp < src_pages; sp++) {
+        uint8_t keep = sp == src_pages - 1 ? (uint8_t)(0xFFu >> ((8 - (h & 7)) & 7)) : 0xFF;
+        const uint8_t *row = src + sp * stride;
+        for (int half = 0; half < 2; half++) {
+            int page = page0 + sp + half;
+            if (page < 0 || page >= PAGES) continue;
+            if (half && !shift) continue;
+            uint8_t *dst = js_display_screen_buffer + page * DISPLAY_WIDTH;
+            for (int x = x0; x < x1; x++) {
+                uint8_t b = row[x] & keep;
+                b = half ? (uint8_t)(b >> (8 - shift)) : (uint8_t)(b << shift);
+                if (color) dst[dx + x] |= b;
+                else dst[dx + x] &= (uint8_t)~b;
             }
+            int base = page * DISPLAY_WIDTH + dx;
+            if (base + x0 < lo) lo = base + x0;
+            if (base + x1 - 1 > hi) hi = base + x1 - 1;
         }
     }
+    if (hi >= 0) mark_dirty_bytes(lo, hi);
+}
+
+void js_display_blit(const uint8_t *src, int w, int h, int dx, int dy, int color) {
+    blit_packed(src, w, w, h, dx, dy, color);
 }
 
 int js_display_draw_image(const char *filename, int dx, int dy, int threshold, int invert) {
@@ -136,35 +226,53 @@ int js_display_draw_image(const char *filename, int dx, int dy, int threshold, i
             unsigned char val = image[iy * w + ix];
             int lit = invert ? (val <= threshold) : (val > threshold);
             if (lit) {
-                js_display_screen_buffer[py * DISPLAY_WIDTH + px] = 1;
+                put_pixel(px, py, 1);
             }
         }
     }
 
     stbi_image_free(image);
-    mark_dirty();
+    js_display_dirty_slices = DISPLAY_ALL_SLICES;
+    js_display_screen_dirty = 1;
     return 1;
 }
 
+/* The buffer is already packed; this is a plain copy of the whole frame */
 void js_display_pack(uint8_t *dest) {
-    int i = 0;
-    for (int y = 0; y < DISPLAY_HEIGHT / 8; y++) {
-        for (int x = 0; x < DISPLAY_WIDTH; x++) {
-            int index = (y * DISPLAY_WIDTH * 8) + x;
-            unsigned char packed = 0;
-            for (int j = 0; j < 8; j++) {
-                int packIndex = index + j * DISPLAY_WIDTH;
-                packed |= js_display_screen_buffer[packIndex] << j;
-            }
-            dest[i++] = packed;
-        }
+    memcpy(dest, js_display_screen_buffer, DISPLAY_BUFFER_SIZE);
+}
+
+/* Copy only the slices drawn into since the last flush to dest, which
+ * holds the previous frame. Returns the slices copied. */
+uint32_t js_display_flush_slices(uint8_t *dest) {
+    uint32_t dirty = js_display_dirty_slices;
+    for (int s = 0; s < DISPLAY_SLICE_COUNT; s++) {
+        if (!(dirty & (1u << s))) continue;
+        int off = s * DISPLAY_SLICE_BYTES;
+        int len = off + DISPLAY_SLICE_BYTES > DISPLAY_BUFFER_SIZE ? DISPLAY_BUFFER_SIZE - off : DISPLAY_SLICE_BYTES;
+        memcpy(dest + off, js_display_screen_buffer + off, (size_t)len);
     }
+    js_display_dirty_slices = 0;
+    js_display_screen_dirty = 0;
+    return dirty;
 }
 
 /* ============================================================================
  * Font Loading
  * ============================================================================ */
 
+/* Repack a one-byte-per-pixel glyph into the screen layout for blitting */
+static unsigned char *pack_glyph(const unsigned char *data, int w, int h) {
+    unsigned char *packed = calloc((size_t)w * ((h + 7) / 8), 1);
+    if (!packed) return NULL;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (data[y * w + x]) packed[(y / 8) * w + x] |= (unsigned char)(1u << (y & 7));
+        }
+    }
+    return packed;
+}
+
 Font* js_display_load_font(const char *filename, int charSpacing) {
     int width, height, n;
     unsigned char *image = stbi_load(filename, &width, &height, &n, 4);
@@ -284,6 +392,7 @@ Font* js_display_load_font(const char *filename, int charSpacing) {
                 fc.data[y * glyphW + x] = image[idx + 3] > 0 ? 1 : 0;
             }
         }
+        fc.packed = pack_glyph(fc.data, glyphW, height);
         out->charData[cp] = fc;
     }
 
@@ -340,46 +449,139 @@ Font* js_display_load_ttf_font(const char *filename, int pixel_height) {
 }
 
 /* ============================================================================
- * Glyph Rendering
+ * TTF Glyph Atlas
  * ============================================================================ */
 
-int js_display_glyph_ttf(Font *fnt, char c, int sx, int sy, int color) {
+/* A TTF Font is one face at one pixel height, so each glyph only ever
+ * rasterises one way. The first draw or measure of a character rasterises
+ * it into a 1-bit strip in the screen layout; after that, text is blitted
+ * from the strip with cached advances and kerning and never touches
+ * stb_truetype. */
+
+#define TTF_KERN_FIRST   32     /* Kerning is cached for printable ASCII */
+#define TTF_KERN_COUNT   95
+#define TTF_KERN_UNKNOWN INT8_MIN
+
+typedef struct {
+    uint8_t ready;
+    int16_t atlas_x;     /* First strip column */
+    int16_t w, h;
+    int16_t xoff, yoff;  /* Bitmap box from the pen position and line top */
+    int16_t advance;
+} TtfGlyph;
+
+struct TtfAtlas {
+    TtfGlyph glyphs[256];
+    uint8_t *bits;       /* Page-major: byte page * cap + column */
+    int cols, cap, pages;
+    int8_t kern[TTF_KERN_COUNT][TTF_KERN_COUNT];
+};
+
+static struct TtfAtlas *ttf_atlas(Font *fnt) {
+    if (fnt->ttf_atlas) return fnt->ttf_atlas;
+    struct TtfAtlas *a = calloc(1, sizeof(*a));
+    if (!a) return NULL;
+    int bx0, by0, bx1, by1;
+    stbtt_GetFontBoundingBox(&fnt->ttf_info, &bx0, &by0, &bx1, &by1);
+    int rows = (int)((by1 - by0) * fnt->ttf_scale) + 2;
+    a->pages = (rows + 7) / 8;
+    memset(a->kern, TTF_KERN_UNKNOWN, sizeof(a->kern));
+    fnt->ttf_atlas = a;
+    return a;
+}
+
+/* Make room for w more strip columns */
+static int ttf_atlas_reserve(struct TtfAtlas *a, int w) {
+    if (a->cols + w <= a->cap) return 1;
+    int cap = a->cap ? a->cap : 256;
+    while (cap < a->cols + w) cap *= 2;
+    if (cap > INT16_MAX) return 0;
+    uint8_t *bits = calloc((size_t)cap * a->pages, 1);
+    if (!bits) return 0;
+    for (int p = 0; p < a->pages && a->bits; p++)
+        memcpy(bits + p * cap, a->bits + p * a->cap, (size_t)a->cols);
+    free(a->bits);
+    a->bits = bits;
+    a->cap = cap;
+    return 1;
+}
+
+static const TtfGlyph *ttf_glyph(Font *fnt, unsigned char c) {
+    static const TtfGlyph blank;
+    struct TtfAtlas *a = ttf_atlas(fnt);
+    if (!a) return &blank;
+    TtfGlyph *g = &a->glyphs[c];
+    if (g->ready) return g;
+    g->ready = 1;
+
     int advance = 0, lsb = 0;
     stbtt_GetCodepointHMetrics(&fnt->ttf_info, c, &advance, &lsb);
+    g->advance = (int16_t)(advance * fnt->ttf_scale);
 
     int x0, y0, x1, y1;
     stbtt_GetCodepointBitmapBox(&fnt->ttf_info, c, fnt->ttf_scale, fnt->ttf_scale, &x0, &y0, &x1, &y1);
-
     int w = x1 - x0;
     int h = y1 - y0;
-    if (w <= 0 || h <= 0) {
-        return sx + (int)(advance * fnt->ttf_scale);
-    }
+    if (h > a->pages * 8) h = a->pages * 8;
+    if (w <= 0 || h <= 0 || !ttf_atlas_reserve(a, w)) return g;
 
-    unsigned char *bitmap = malloc(w * h);
-    if (!bitmap) {
-        return sx + (int)(advance * fnt->ttf_scale);
-    }
-
-    stbtt_MakeCodepointBitmap(&fnt->ttf_info, bitmap, w, h, w, fnt->ttf_scale, fnt->ttf_scale, c);
-
-    int draw_y = sy + fnt->ttf_ascent + y0;
+    unsigned char *bitmap = malloc((size_t)w * (y1 - y0));
+    if (!bitmap) return g;
+    stbtt_MakeCodepointBitmap(&fnt->ttf_info, bitmap, w, y1 - y0, w, fnt->ttf_scale, fnt->ttf_scale, c);
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
-            int val = bitmap[y * w + x];
-            if (val > 64) {
-                js_display_set_pixel(sx + x + x0, draw_y + y, color);
-            }
+            if (bitmap[y * w + x] > 64)
+                a->bits[(y / 8) * a->cap + a->cols + x] |= (uint8_t)(1u << (y & 7));
         }
     }
     free(bitmap);
 
-    return sx + (int)(advance * fnt->ttf_scale);
+    g->atlas_x = (int16_t)a->cols;
+    g->w = (int16_t)w;
+    g->h = (int16_t)h;
+    g->xoff = (int16_t)x0;
+    g->yoff = (int16_t)(fnt->ttf_ascent + y0);
+    a->cols += w;
+    return g;
+}
+
+/* Pixels to add between a and b when b follows a */
+static int ttf_kern(Font *fnt, unsigned char a, unsigned char b) {
+    if (a < TTF_KERN_FIRST || a >= TTF_KERN_FIRST + TTF_KERN_COUNT ||
+        b < TTF_KERN_FIRST || b >= TTF_KERN_FIRST + TTF_KERN_COUNT) return 0;
+    struct TtfAtlas *at = ttf_atlas(fnt);
+    if (!at) return 0;
+    int8_t *k = &at->kern[a - TTF_KERN_FIRST][b - TTF_KERN_FIRST];
+    if (*k == TTF_KERN_UNKNOWN) {
+        float px = stbtt_GetCodepointKernAdvance(&fnt->ttf_info, a, b) * fnt->ttf_scale;
+        int v = (int)(px + (px >= 0 ? 0.5f : -0.5f));
+        if (v < TTF_KERN_UNKNOWN + 1) v = TTF_KERN_UNKNOWN + 1;
+        if (v > INT8_MAX) v = INT8_MAX;
+        *k = (int8_t)v;
+    }
+    return *k;
+}
+
+/* ============================================================================
+ * Glyph Rendering
+ * ============================================================================ */
+
+int js_display_glyph_ttf(Font *fnt, char c, int sx, int sy, int color) {
+    const TtfGlyph *g = ttf_glyph(fnt, (unsigned char)c);
+    if (g->w > 0) {
+        struct TtfAtlas *a = fnt->ttf_atlas;
+        blit_packed(a->bits + g->atlas_x, a->cap, g->w, g->h, sx + g->xoff, sy + g->yoff, color);
+    }
+    return sx + g->advance;
 }
 
 int js_display_glyph(Font *fnt, char c, int sx, int sy, int color) {
     FontChar fc = fnt->charData[(int)(unsigned char)c];
     if (!fc.data) return sx + fnt->charSpacing;
+    if (fc.packed) {
+        js_display_blit(fc.packed, fc.width, fc.height, sx, sy, color);
+        return sx + fc.width + fnt->charSpacing;
+    }
     for (int y = 0; y < fc.height; y++) {
         for (int x = 0; x < fc.width; x++) {
             if (fc.data[y * fc.width + x]) {
@@ -406,6 +608,7 @@ void js_display_print(int x, int y, const char *string, int color) {
     int cursor = x;
     for (size_t i = 0; i < strlen(string); i++) {
         if (g_font->is_ttf) {
+            if (i > 0) cursor += ttf_kern(g_font, (unsigned char)string[i - 1], (unsigned char)string[i]);
             cursor = js_display_glyph_ttf(g_font, string[i], cursor, y, color);
         } else {
             cursor = js_display_glyph(g_font, string[i], cursor, y, color);
@@ -425,9 +628,8 @@ int js_display_text_width(const char *string) {
     for (size_t i = 0; i < strlen(string); i++) {
         unsigned char c = (unsigned char)string[i];
         if (g_font->is_ttf) {
-            int advance = 0, lsb = 0;
-            stbtt_GetCodepointHMetrics(&g_font->ttf_info, c, &advance, &lsb);
-            width += (int)(advance * g_font->ttf_scale);
+            if (i > 0) width += ttf_kern(g_font, (unsigned char)string[i - 1], c);
+            width += ttf_glyph(g_font, c)->advance;
         } else {
             FontChar fc = g_font->charData[c];
             if (fc.data) {
@@ -445,42 +647,59 @@ int js_display_text_width(const char *string) {
  * ============================================================================ */
 
 #define FONT_CACHE_MAX 16
+#define TTF_DEFAULT_PIXEL_HEIGHT 12
 
+/* Bitmap fonts have one size (pixel_height 0); a TTF entry is one size of
+ * the face, glyph atlas included */
 typedef struct {
     char path[256];
+    int pixel_height;
     Font *font;
 } FontCacheEntry;
 
 static FontCacheEntry font_cache[FONT_CACHE_MAX];
 static int font_cache_count = 0;
 
-static Font* font_cache_get(const char *path) {
+static Font* font_cache_get(const char *path, int pixel_height) {
     for (int i = 0; i < font_cache_count; i++) {
-        if (strcmp(font_cache[i].path, path) == 0) {
+        if (font_cache[i].pixel_height == pixel_height &&
+            strcmp(font_cache[i].path, path) == 0) {
             return font_cache[i].font;
         }
     }
     return NULL;
 }
 
-static void font_cache_put(const char *path, Font *font) {
+static void font_cache_put(const char *path, int pixel_height, Font *font) {
     if (font_cache_count < FONT_CACHE_MAX) {
         strncpy(font_cache[font_cache_count].path, path, 255);
         font_cache[font_cache_count].path[255] = '\0';
+        font_cache[font_cache_count].pixel_height = pixel_height;
         font_cache[font_cache_count].font = font;
         font_cache_count++;
     }
 }
 
-int js_display_set_font(const char *path) {
-    Font *cached = font_cache_get(path);
+static int is_ttf_path(const char *path) {
+    size_t len = strlen(path);
+    return len > 4 && (strcasecmp(path + len - 4, ".ttf") == 0 ||
+                       strcasecmp(path + len - 4, ".otf") == 0);
+}
+
+int js_display_set_font(const char *path, int pixel_height) {
+    int ttf = is_ttf_path(path);
+    if (!ttf) pixel_height = 0;
+    else if (pixel_height <= 0) pixel_height = TTF_DEFAULT_PIXEL_HEIGHT;
+
+    Font *cached = font_cache_get(path, pixel_height);
     if (cached) {
         g_font = cached;
         return 1;
     }
-    Font *new_font = js_display_load_font(path, 1);
+    Font *new_font = ttf ? js_display_load_ttf_font(path, pixel_height)
+                         : js_display_load_font(path, 1);
     if (!new_font) return 0;
-    font_cache_put(path, new_font);
+    font_cache_put(path, pixel_height, new_font);
     g_font = new_font;
     return 1;
 }
@@ -605,7 +824,9 @@ JSValue js_display_bind_set_font(JSContext *ctx, JSValueConst this_val, int argc
     if (argc < 1) return JS_NewBool(ctx, 0);
     const char *path = JS_ToCString(ctx, argv[0]);
     if (!path) return JS_NewBool(ctx, 0);
-    int result = js_display_set_font(path);
+    int pixel_height = 0;
+    if (argc >= 2 && JS_ToInt32(ctx, &pixel_height, argv[1])) pixel_height = 0;
+    int result = js_display_set_font(path, pixel_height);
     JS_FreeCString(ctx, path);
     return JS_NewBool(ctx, result);
 }
@@ -651,7 +872,7 @@ void js_display_register_bindings(JSContext *ctx, JSValue global_obj) {
     JS_SetPropertyStr(ctx, global_obj, "draw_image",
         JS_NewCFunction(ctx, js_display_bind_draw_image, "draw_image", 5));
     JS_SetPropertyStr(ctx, global_obj, "set_font",
-        JS_NewCFunction(ctx, js_display_bind_set_font, "set_font", 1));
+        JS_NewCFunction(ctx, js_display_bind_set_font, "set_font", 2));
     JS_SetPropertyStr(ctx, global_obj, "get_font_height",
         JS_NewCFunction(ctx, js_display_bind_get_font_height, "get_font_height", 0));
 }
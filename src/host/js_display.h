@@ -18,9 +18,17 @@
 #define DISPLAY_HEIGHT 64
 #define DISPLAY_BUFFER_SIZE 1024  /* Packed: 128 * 64 / 8 */
 
+/* The screen buffer uses the device's packed layout: byte (y / 8) * 128 + x
+ * holds column x of rows y & ~7 .. (y & ~7) + 7, LSB = top row. The shim
+ * pushes it to the OLED in 172-byte slices; changes are tracked per slice. */
+#define DISPLAY_SLICE_BYTES 172
+#define DISPLAY_SLICE_COUNT 6
+#define DISPLAY_ALL_SLICES  ((1u << DISPLAY_SLICE_COUNT) - 1)
+
 /* Font character data */
 typedef struct FontChar {
-    unsigned char *data;
+    unsigned char *data;      /* One byte per pixel, row-major */
+    unsigned char *packed;    /* Same glyph in screen layout, for js_display_blit */
     int width;
     int height;
 } FontChar;
@@ -35,14 +43,19 @@ typedef struct Font {
     float ttf_scale;
     int ttf_ascent;
     int ttf_height;
+    struct TtfAtlas *ttf_atlas;   /* Rasterised TTF glyphs, filled on first use */
 } Font;
 
 /* Screen buffer - defined in js_display.c */
-extern unsigned char js_display_screen_buffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+extern unsigned char js_display_screen_buffer[DISPLAY_BUFFER_SIZE];
 
 /* Dirty flag - set when screen changes, host should check and clear */
 extern int js_display_screen_dirty;
 
+/* Slices (bit n = bytes n * DISPLAY_SLICE_BYTES...) written since the last
+ * js_display_flush_slices() */
+extern uint32_t js_display_dirty_slices;
+
 /* Core display functions */
 void js_display_clear(void);
 void js_display_set_pixel(int x, int y, int value);
@@ -54,12 +67,15 @@ void js_display_fill_circle(int cx, int cy, int r, int value);
 int  js_display_draw_image(const char *filename, int dx, int dy, int threshold, int invert);
 void js_display_print(int x, int y, const char *string, int color);
 int  js_display_text_width(const char *string);
+void js_display_blit(const uint8_t *src, int w, int h, int dx, int dy, int color);
 void js_display_pack(uint8_t *dest);
+uint32_t js_display_flush_slices(uint8_t *dest);
 
 /* Font loading and switching */
 Font* js_display_load_font(const char *filename, int charSpacing);
 Font* js_display_load_ttf_font(const char *filename, int pixel_height);
-int js_display_set_font(const char *path);
+/* .ttf/.otf paths load at pixel_height (0 = default); the cache keys on both */
+int js_display_set_font(const char *path, int pixel_height);
 int js_display_get_font_height(void);
 
 /* Glyph rendering */
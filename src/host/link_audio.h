@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include <pthread.h>
 #include <netinet/in.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 /* ============================================================================
  * LINK AUDIO INTERCEPTION AND PUBLISHING
@@ -74,13 +77,32 @@ typedef struct {
 /* Top-level shared memory structure */
 typedef struct {
     volatile uint32_t magic;       /* 0x4C415042 = "LAPB" - Link Audio Pub Buffer */
-    volatile uint32_t version;     /* structure version, currently 1 */
+    volatile uint32_t version;     /* structure version, currently 2 */
     volatile int      num_slots;   /* number of active slots */
+    /* Control channel to link-subscriber's publisher thread */
+    volatile uint32_t wake_seq;          /* futex: bumped after each block of ring writes */
+    volatile uint32_t publisher_waiting; /* 1 = publisher thread is blocked on wake_seq */
+    volatile uint32_t tempo_request_seq; /* bumped after tempo_request_bpm is written */
+    volatile uint32_t tempo_request_bpm; /* requested session tempo, BPM * 10000 */
     link_audio_pub_slot_t slots[LINK_AUDIO_PUB_SLOT_COUNT]; /* 0-3: per-track, 4: master */
 } link_audio_pub_shm_t;
 
 #define LINK_AUDIO_PUB_SHM_MAGIC   0x4C415042
-#define LINK_AUDIO_PUB_SHM_VERSION 1
+#define LINK_AUDIO_PUB_SHM_VERSION 2
+
+/* Wake the publisher thread. Producers call this once per block after
+ * their ring writes (and after posting a tempo request) instead of letting
+ * the subscriber poll. publisher_waiting keeps the caller off the syscall
+ * unless the thread is actually asleep: the thread raises it before
+ * re-checking wake_seq, producers bump wake_seq before taking the flag.
+ * Safe on the SPI thread. */
+static inline void link_audio_pub_kick(link_audio_pub_shm_t *shm)
+{
+    if (!shm) return;
+    __atomic_add_fetch(&shm->wake_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_exchange_n(&shm->publisher_waiting, 0, __ATOMIC_SEQ_CST))
+        syscall(SYS_futex, &shm->wake_seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
 
 /* Timing */
 #define LINK_AUDIO_SESSION_INTERVAL_MS     1000
@@ -9,7 +9,10 @@
  * Publisher side:
  *   Reads per-slot shadow audio from shared memory (written by the shim)
  *   and publishes it to the Link session via LinkAudioSink. This makes
- *   shadow slot audio visible to Live as Link Audio channels.
+ *   shadow slot audio visible to Live as Link Audio channels. A dedicated
+ *   thread sleeps on the shm's wake_seq futex and forwards each block as
+ *   soon as the shim kicks it; the same shm carries tempo requests from
+ *   the shadow UI.
  *
  * Running as a standalone process (not inside Move's LD_PRELOAD shim)
  * avoids the hook conflicts that caused SIGSEGV in the in-shim approach.
@@ -20,8 +23,8 @@
 #include <ableton/LinkAudio.hpp>
 
 #include <fcntl.h>
+#include <pthread.h>
 #include <sys/mman.h>
-#include <sys/stat.h>
 #include <unistd.h>
 
 #include <atomic>
@@ -105,7 +108,8 @@ static link_audio_pub_shm_t *open_pub_shm()
     close(fd);
 
     if (shm == MAP_FAILED) return nullptr;
-    if (shm->magic != LINK_AUDIO_PUB_SHM_MAGIC) {
+    if (shm->magic != LINK_AUDIO_PUB_SHM_MAGIC ||
+        shm->version != LINK_AUDIO_PUB_SHM_VERSION) {
         munmap(shm, sizeof(link_audio_pub_shm_t));
         return nullptr;
     }
@@ -145,6 +149,190 @@ struct SlotPublisher {
     bool was_active = false;
 };
 
+/* Block until wake_seq moves past *seen or timeout_ms passes. Raising
+ * publisher_waiting before the re-check pairs with link_audio_pub_kick(),
+ * so a kick is never lost between the check and the FUTEX_WAIT. */
+static void wait_pub_kick(link_audio_pub_shm_t *shm, uint32_t *seen, int timeout_ms)
+{
+    __atomic_store_n(&shm->publisher_waiting, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&shm->wake_seq, __ATOMIC_SEQ_CST) == *seen) {
+        struct timespec ts;
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+        syscall(SYS_futex, &shm->wake_seq, FUTEX_WAIT, *seen, &ts, nullptr, 0);
+    }
+    __atomic_store_n(&shm->publisher_waiting, 0, __ATOMIC_RELAXED);
+    *seen = __atomic_load_n(&shm->wake_seq, __ATOMIC_ACQUIRE);
+}
+
+/* Tempo override protocol: the shadow UI posts the set's BPM on set change;
+ * we propose it to the session — but only when numPeers() == 1 (Move
+ * alone), so we never clobber collaboration. */
+static void apply_tempo_request(ableton::LinkAudio &link, link_audio_pub_shm_t *shm,
+                                uint32_t *seen)
+{
+    uint32_t seq = __atomic_load_n(&shm->tempo_request_seq, __ATOMIC_ACQUIRE);
+    if (seq == *seen) return;
+    *seen = seq;
+
+    double bpm = __atomic_load_n(&shm->tempo_request_bpm, __ATOMIC_RELAXED) / 10000.0;
+    if (bpm < 20.0 || bpm > 999.0) return;
+
+    size_t peers = link.numPeers();
+    if (peers <= 1) {
+        /* peers==0: alone, or Move hasn't joined yet —
+         * our proposal will be the session tempo.
+         * peers==1: just Move — force the set's tempo. */
+        auto state = link.captureAppSessionState();
+        state.setTempo(bpm, link.clock().micros());
+        link.commitAppSessionState(state);
+        LOG_INFO(LINK_SUB_LOG_SOURCE,
+                 "tempo override applied: %.2f BPM (peers=%zu)",
+                 bpm, peers);
+    } else {
+        LOG_INFO(LINK_SUB_LOG_SOURCE,
+                 "tempo override skipped: %.2f BPM requested, peers=%zu",
+                 bpm, peers);
+    }
+}
+
+static void sink_name(int i, char *name, size_t len)
+{
+    if (i == LINK_AUDIO_PUB_MASTER_IDX)
+        snprintf(name, len, "Schwung-Master");
+    else
+        snprintf(name, len, "Schwung-%d", i + 1);
+}
+
+/* Read one slot's new blocks from shm and write them to its sink,
+ * creating/destroying the sink as the slot activates/deactivates */
+static void publish_slot(ableton::LinkAudio &link, link_audio_pub_slot_t *ps,
+                         SlotPublisher &sp, int i)
+{
+    bool is_active = ps->active != 0;
+    char name[32];
+
+    if (is_active && !sp.was_active) {
+        sink_name(i, name, sizeof(name));
+        try {
+            /* maxNumSamples: 128 frames * 2 channels = 256 samples */
+            sp.sink = new ableton::LinkAudioSink(link, name, 256);
+            LOG_INFO(LINK_SUB_LOG_SOURCE, "created sink %s", name);
+        } catch (...) {
+            LOG_ERROR(LINK_SUB_LOG_SOURCE, "failed to create sink %s", name);
+            sp.sink = nullptr;
+        }
+        sp.last_read_pos = ps->write_pos;
+        sp.was_active = true;
+    } else if (!is_active && sp.was_active) {
+        if (sp.sink) {
+            delete sp.sink;
+            sp.sink = nullptr;
+            sink_name(i, name, sizeof(name));
+            LOG_INFO(LINK_SUB_LOG_SOURCE, "destroyed sink %s", name);
+        }
+        sp.was_active = false;
+    }
+
+    /* Publish audio if sink exists and data is available */
+    if (!sp.sink || !is_active) return;
+
+    uint32_t wp = ps->write_pos;
+    __sync_synchronize();
+    uint32_t rp = sp.last_read_pos;
+    uint32_t avail = wp - rp;
+
+    /* Skip if no new data or if we've fallen too far behind */
+    if (avail == 0) return;
+    if (avail > LINK_AUDIO_PUB_SHM_RING_SAMPLES) {
+        /* Overrun — reset to current write position */
+        sp.last_read_pos = wp;
+        return;
+    }
+
+    /* Drain in 128-frame (256-sample) blocks */
+    while (avail >= LINK_AUDIO_PUB_BLOCK_SAMPLES) {
+        auto buffer = ableton::LinkAudioSink::BufferHandle(*sp.sink);
+        if (buffer) {
+            /* Copy 128 stereo frames from ring to sink buffer */
+            for (int s = 0; s < LINK_AUDIO_PUB_BLOCK_SAMPLES; s++) {
+                buffer.samples[s] = ps->ring[rp & LINK_AUDIO_PUB_SHM_RING_MASK];
+                rp++;
+            }
+
+            auto sessionState = link.captureAudioSessionState();
+            auto hostTime = std::chrono::microseconds(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+                ).count()
+            );
+            double beats = sessionState.beatAtTime(hostTime, 4.0);
+
+            buffer.commit(sessionState,
+                          beats,
+                          4.0,                        /* quantum */
+                          LINK_AUDIO_PUB_BLOCK_FRAMES, /* numFrames */
+                          2,                           /* stereo */
+                          44100);                      /* sampleRate */
+
+            g_buffers_published.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            /* No subscriber for this sink — advance read pointer anyway */
+            rp += LINK_AUDIO_PUB_BLOCK_SAMPLES;
+        }
+
+        avail = wp - rp;
+    }
+
+    sp.last_read_pos = rp;
+}
+
+/* Publisher thread: owns the pub shm mapping and every publisher sink.
+ * Sleeps on wake_seq, so each block reaches its sink one kick after the
+ * shim writes it instead of up to 10ms later. The 100ms timeout only
+ * bounds shutdown latency and picks up slot (de)activation while the
+ * shim isn't publishing. */
+static void publisher_thread_main(ableton::LinkAudio *link)
+{
+    pthread_setname_np(pthread_self(), "link-pub");
+
+    /* The shim creates the segment at startup; retry for ~10 minutes */
+    link_audio_pub_shm_t *pub_shm = nullptr;
+    for (int retries = 0; g_running && retries < 600; retries++) {
+        pub_shm = open_pub_shm();
+        if (pub_shm) break;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (!pub_shm) return;
+    LOG_INFO(LINK_SUB_LOG_SOURCE, "publisher shm opened");
+
+    /* Publisher sinks for shadow slots (4 per-track + 1 master) */
+    SlotPublisher slots[LINK_AUDIO_PUB_SLOT_COUNT];
+    /* Sync read positions to current write positions */
+    for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
+        slots[i].last_read_pos = pub_shm->slots[i].write_pos;
+    }
+
+    uint32_t wake_seen = __atomic_load_n(&pub_shm->wake_seq, __ATOMIC_ACQUIRE);
+    /* Only requests posted from now on count, so a leftover from before a
+     * subscriber restart doesn't replay and clobber the last-known tempo. */
+    uint32_t tempo_seen = __atomic_load_n(&pub_shm->tempo_request_seq, __ATOMIC_ACQUIRE);
+
+    while (g_running) {
+        apply_tempo_request(*link, pub_shm, &tempo_seen);
+        for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
+            publish_slot(*link, &pub_shm->slots[i], slots[i], i);
+        }
+        wait_pub_kick(pub_shm, &wake_seen, 100);
+    }
+
+    for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
+        delete slots[i].sink;
+        slots[i].sink = nullptr;
+    }
+    munmap(pub_shm, sizeof(link_audio_pub_shm_t));
+}
+
 int main()
 {
     std::signal(SIGTERM, signal_handler);
@@ -222,9 +410,6 @@ int main()
     ableton::LinkAudioSink dummySink(link, "Schwung-Ack", 256);
     LOG_INFO(LINK_SUB_LOG_SOURCE, "dummy sink created (triggers peer announcement)");
 
-    /* Publisher sinks for shadow slots (4 per-track + 1 master) */
-    SlotPublisher slots[LINK_AUDIO_PUB_SLOT_COUNT];
-
     /* Callback records channel IDs — source creation deferred to main loop */
     link.setChannelsChangedCallback([&]() {
         auto channels = link.channels();
@@ -245,66 +430,19 @@ int main()
     /* Active sources — managed in main loop only */
     std::vector<ableton::LinkAudioSource> sources;
 
-    /* Try to open publisher shared memory */
-    link_audio_pub_shm_t *pub_shm = nullptr;
-    int pub_shm_retries = 0;
+    /* Shadow audio and tempo requests are handled by the publisher thread */
+    std::thread publisher(publisher_thread_main, &link);
 
     uint64_t last_rx_count = 0;
     uint64_t last_tx_count = 0;
     int tick = 0;
 
-    /* Tempo override protocol: shim/UI writes desired BPM to this file on set
-     * change; we pick it up here and propose it to the session — but only when
-     * numPeers() == 1 (Move alone), so we never clobber collaboration. */
-    const char *DESIRED_TEMPO_PATH = "/data/UserData/schwung/desired-tempo";
-    /* Seed with the file's current mtime so a leftover from a previous session
-     * (only rewritten on set-switch, not on in-set tempo edits) doesn't replay
-     * and clobber the freshly-loaded last-tempo on boot. */
-    time_t last_desired_mtime = 0;
-    {
-        struct stat st;
-        if (stat(DESIRED_TEMPO_PATH, &st) == 0) last_desired_mtime = st.st_mtime;
-    }
-
     while (g_running) {
-        /* Use a shorter sleep to poll the publisher shm more frequently.
-         * The shim writes at ~344 Hz (every ~2.9ms). We poll at ~100 Hz
-         * which means ~3 render blocks accumulate between polls.
-         * The SDK handles the 128→125 repacketing internally. */
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        /* Only source management and stats are left on this loop;
+         * publishing is wake-driven on its own thread. */
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
         tick++;
 
-        /* Poll for tempo-override requests (set-change on device). */
-        {
-            struct stat st;
-            if (stat(DESIRED_TEMPO_PATH, &st) == 0 && st.st_mtime != last_desired_mtime) {
-                last_desired_mtime = st.st_mtime;
-                FILE *fp = fopen(DESIRED_TEMPO_PATH, "r");
-                if (fp) {
-                    double bpm = 0.0;
-                    if (fscanf(fp, "%lf", &bpm) == 1 && bpm >= 20.0 && bpm <= 999.0) {
-                        size_t peers = link.numPeers();
-                        if (peers <= 1) {
-                            /* peers==0: alone, or Move hasn't joined yet —
-                             * our proposal will be the session tempo.
-                             * peers==1: just Move — force the set's tempo. */
-                            auto state = link.captureAppSessionState();
-                            state.setTempo(bpm, link.clock().micros());
-                            link.commitAppSessionState(state);
-                            LOG_INFO(LINK_SUB_LOG_SOURCE,
-                                     "tempo override applied: %.2f BPM (peers=%zu)",
-                                     bpm, peers);
-                        } else {
-                            LOG_INFO(LINK_SUB_LOG_SOURCE,
-                                     "tempo override skipped: %.2f BPM requested, peers=%zu",
-                                     bpm, peers);
-                        }
-                    }
-                    fclose(fp);
-                }
-            }
-        }
-
         /* Create sources when channels change (every ~500ms worth of ticks) */
         if (g_channels_changed.exchange(false)) {
             std::vector<PendingChannel> pending;
@@ -474,115 +612,8 @@ int main()
             LOG_INFO(LINK_SUB_LOG_SOURCE, "%zu sources active", sources.size());
         }
 
-        /* Try to open publisher shm if not yet available */
-        if (!pub_shm && pub_shm_retries < 600) {
-            /* Retry every ~1 second (100 ticks * 10ms) */
-            if (tick % 100 == 0) {
-                pub_shm = open_pub_shm();
-                pub_shm_retries++;
-                if (pub_shm) {
-                    LOG_INFO(LINK_SUB_LOG_SOURCE, "publisher shm opened");
-                    /* Sync read positions to current write positions */
-                    for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
-                        slots[i].last_read_pos = pub_shm->slots[i].write_pos;
-                    }
-                }
-            }
-        }
-
-        /* --- Publisher: read from shm, write to sinks --- */
-        if (pub_shm) {
-            for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
-                link_audio_pub_slot_t *ps = &pub_shm->slots[i];
-                bool is_active = ps->active != 0;
-
-                /* Create/destroy sinks as slots activate/deactivate */
-                if (is_active && !slots[i].was_active) {
-                    char name[32];
-                    if (i == LINK_AUDIO_PUB_MASTER_IDX)
-                        snprintf(name, sizeof(name), "Schwung-Master");
-                    else
-                        snprintf(name, sizeof(name), "Schwung-%d", i + 1);
-                    try {
-                        /* maxNumSamples: 128 frames * 2 channels = 256 samples */
-                        slots[i].sink = new ableton::LinkAudioSink(link, name, 256);
-                        LOG_INFO(LINK_SUB_LOG_SOURCE, "created sink %s", name);
-                    } catch (...) {
-                        LOG_ERROR(LINK_SUB_LOG_SOURCE, "failed to create sink %s", name);
-                        slots[i].sink = nullptr;
-                    }
-                    slots[i].last_read_pos = ps->write_pos;
-                    slots[i].was_active = true;
-                } else if (!is_active && slots[i].was_active) {
-                    if (slots[i].sink) {
-                        delete slots[i].sink;
-                        slots[i].sink = nullptr;
-                        char name[32];
-                        if (i == LINK_AUDIO_PUB_MASTER_IDX)
-                            snprintf(name, sizeof(name), "Schwung-Master");
-                        else
-                            snprintf(name, sizeof(name), "Schwung-%d", i + 1);
-                        LOG_INFO(LINK_SUB_LOG_SOURCE, "destroyed sink %s", name);
-                    }
-                    slots[i].was_active = false;
-                }
-
-                /* Publish audio if sink exists and data is available */
-                if (!slots[i].sink || !is_active) continue;
-
-                uint32_t wp = ps->write_pos;
-                __sync_synchronize();
-                uint32_t rp = slots[i].last_read_pos;
-                uint32_t avail = wp - rp;
-
-                /* Skip if no new data or if we've fallen too far behind */
-                if (avail == 0) continue;
-                if (avail > LINK_AUDIO_PUB_SHM_RING_SAMPLES) {
-                    /* Overrun — reset to current write position */
-                    slots[i].last_read_pos = wp;
-                    continue;
-                }
-
-                /* Drain in 128-frame (256-sample) blocks */
-                while (avail >= LINK_AUDIO_PUB_BLOCK_SAMPLES) {
-                    auto buffer = ableton::LinkAudioSink::BufferHandle(*slots[i].sink);
-                    if (buffer) {
-                        /* Copy 128 stereo frames from ring to sink buffer */
-                        for (int s = 0; s < LINK_AUDIO_PUB_BLOCK_SAMPLES; s++) {
-                            buffer.samples[s] = ps->ring[rp & LINK_AUDIO_PUB_SHM_RING_MASK];
-                            rp++;
-                        }
-
-                        auto sessionState = link.captureAudioSessionState();
-                        auto hostTime = std::chrono::microseconds(
-                            std::chrono::duration_cast<std::chrono::microseconds>(
-                                std::chrono::steady_clock::now().time_since_epoch()
-                            ).count()
-                        );
-                        double beats = sessionState.beatAtTime(hostTime, 4.0);
-
-                        buffer.commit(sessionState,
-                                      beats,
-                                      4.0,                        /* quantum */
-                                      LINK_AUDIO_PUB_BLOCK_FRAMES, /* numFrames */
-                                      2,                           /* stereo */
-                                      44100);                      /* sampleRate */
-
-                        g_buffers_published.fetch_add(1, std::memory_order_relaxed);
-                    } else {
-                        /* No subscriber for this sink — advance read pointer anyway */
-                        rp += LINK_AUDIO_PUB_BLOCK_SAMPLES;
-                    }
-
-                    avail = wp - rp;
-                }
-
-                slots[i].last_read_pos = rp;
-            }
-        }
-
-        /* Log stats every 30 seconds (3000 ticks at 10ms) */
-        if (tick % 3000 == 0) {
+        /* Log stats every 30 seconds (300 ticks at 100ms) */
+        if (tick % 300 == 0) {
             uint64_t rx = g_buffers_received.load(std::memory_order_relaxed);
             uint64_t tx = g_buffers_published.load(std::memory_order_relaxed);
             if (rx != last_rx_count || tx != last_tx_count) {
@@ -595,17 +626,8 @@ int main()
     }
 
     /* Cleanup */
+    publisher.join();
     sources.clear();
-    for (int i = 0; i < LINK_AUDIO_PUB_SLOT_COUNT; i++) {
-        if (slots[i].sink) {
-            delete slots[i].sink;
-            slots[i].sink = nullptr;
-        }
-    }
-
-    if (pub_shm) {
-        munmap(pub_shm, sizeof(link_audio_pub_shm_t));
-    }
 
     LOG_INFO(LINK_SUB_LOG_SOURCE, "shutting down (rx=%llu tx=%llu)",
              (unsigned long long)g_buffers_received.load(),
@@ -219,4 +219,65 @@ typedef plugin_api_v2_t* (*move_plugin_init_v2_fn)(const host_api_v1_t *host);
 
 #define MOVE_PLUGIN_INIT_V2_SYMBOL "move_plugin_init_v2"
 
+/* Optional float32 render, exported alongside move_plugin_init_v2 and
+ * discovered via dlsym:
+ *
+ *   void move_plugin_render_block_f32(void *instance, float *out_interleaved_lr, int frames);
+ *
+ * Same contract as render_block, but writes stereo interleaved float where
+ * 1.0 == int16 full scale. Output is not clamped; the host saturates once
+ * at the end of the chain. render_block must still be provided. */
+typedef void (*move_plugin_render_block_f32_fn)(void *instance, float *out_interleaved_lr, int frames);
+
+#define MOVE_PLUGIN_RENDER_BLOCK_F32_SYMBOL "move_plugin_render_block_f32"
+
+/* Optional timestamped MIDI, exported alongside move_plugin_init_v2 and
+ * discovered via dlsym:
+ *
+ *   void move_plugin_on_midi_timed(void *instance, const uint8_t *msg, int len,
+ *                                  int source, int offset);
+ *
+ * Same contract as on_midi, but the event takes effect `offset` frames
+ * (0 <= offset < frames) into the next render_block call. Synths that
+ * don't export it get timed events through on_midi at the start of the
+ * block, as before. */
+typedef void (*move_plugin_on_midi_timed_fn)(void *instance, const uint8_t *msg, int len,
+                                             int source, int offset);
+
+#define MOVE_PLUGIN_ON_MIDI_TIMED_SYMBOL "move_plugin_on_midi_timed"
+
+/*
+ * Plugin API v3 - Typed parameter handles (optional extension)
+ *
+ * A v2 synth or v2 audio FX may additionally export
+ * MOVE_PLUGIN_PARAM_EXT_V3_SYMBOL. The host resolves a string key to a
+ * numeric id once, then writes float values by id on the render path —
+ * no snprintf/strtof/strcmp per block for smoothed or modulated params.
+ * Plugins without the symbol keep receiving set_param() strings.
+ */
+
+#define MOVE_PLUGIN_API_VERSION_3 3
+
+typedef struct plugin_param_ext_v3 {
+    uint32_t api_version;   /* MOVE_PLUGIN_API_VERSION_3 */
+
+    /* Resolve a parameter key to an id for this instance
+     * Returns: id >= 0 (valid for the instance lifetime), or -1 if the key
+     *          has no float fast path (host falls back to set_param)
+     * Called rarely (first write after a module load), may use strcmp.
+     */
+    int (*resolve_param)(void *instance, const char *key);
+
+    /* Set a resolved parameter. value uses the same units set_param would
+     * parse from its string (enum/int params receive the index as float).
+     * Called from the audio thread: must not allocate, lock or log.
+     */
+    void (*set_param_f)(void *instance, int id, float value);
+
+} plugin_param_ext_v3_t;
+
+typedef const plugin_param_ext_v3_t* (*move_plugin_param_ext_v3_fn)(void);
+
+#define MOVE_PLUGIN_PARAM_EXT_V3_SYMBOL "move_plugin_param_ext_v3"
+
 #endif /* MOVE_PLUGIN_API_V1_H */
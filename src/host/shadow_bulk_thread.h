@@ -0,0 +1,41 @@
+/* shadow_bulk_thread.h - Start background worker threads off the SPI core
+ *
+ * Threads started from the shim (often from inside the SPI callback) would
+ * otherwise inherit MoveOriginal's SCHED_FIFO 70 and its core. Loading,
+ * encoding, logging and file writes are bulk work, so they run as
+ * SCHED_OTHER on cores 0-2 and leave core 3 to the audio path.
+ *
+ * Include with _GNU_SOURCE defined (for the affinity and name calls). */
+
+#ifndef SHADOW_BULK_THREAD_H
+#define SHADOW_BULK_THREAD_H
+
+#include <pthread.h>
+#include <sched.h>
+
+#define SHADOW_BULK_THREAD_CORES 3   /* cores 0..2; core 3 is the SPI core */
+
+/* pthread_create() with bulk scheduling. `name` (max 15 chars) may be NULL.
+ * Returns pthread_create()'s result. */
+static inline int shadow_bulk_thread_create(pthread_t *thread,
+                                            void *(*fn)(void *), void *arg,
+                                            const char *name)
+{
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    struct sched_param sp = { .sched_priority = 0 };
+    pthread_attr_setschedparam(&attr, &sp);
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int c = 0; c < SHADOW_BULK_THREAD_CORES; c++) CPU_SET(c, &cpus);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+
+    int rc = pthread_create(thread, &attr, fn, arg);
+    pthread_attr_destroy(&attr);
+    if (rc == 0 && name) pthread_setname_np(*thread, name);
+    return rc;
+}
+
+#endif /* SHADOW_BULK_THREAD_H */
@@ -13,11 +13,13 @@
 #include <strings.h>  /* strcasecmp */
 
 #include "shadow_chain_mgmt.h"
+#include "shadow_ui_wake.h"
 #include "shadow_set_pages.h"
 #include "shadow_sampler.h"
 #include "shadow_dbus.h"
 #include "shadow_state.h"
 #include "shadow_midi.h"
+#include "shadow_patch_loader.h"
 #include "unified_log.h"
 
 /* ============================================================================
@@ -40,6 +42,7 @@ const plugin_api_v2_t *shadow_plugin_v2 = NULL;
 void (*shadow_chain_set_inject_audio)(void *instance, int16_t *buf, int frames) = NULL;
 void (*shadow_chain_set_external_fx_mode)(void *instance, int mode) = NULL;
 void (*shadow_chain_process_fx)(void *instance, int16_t *buf, int frames) = NULL;
+move_plugin_on_midi_timed_fn shadow_chain_on_midi_timed = NULL;
 host_api_v1_t shadow_host_api;
 
 /* Look up the slot owning a chain plugin instance and return its live
@@ -650,6 +653,7 @@ void shadow_master_fx_slot_unload(int slot) {
     s->instance = NULL;
     s->api = NULL;
     s->on_midi = NULL;
+    s->process_f32 = NULL;
     if (s->handle) {
         dlclose(s->handle);
         s->handle = NULL;
@@ -821,6 +825,7 @@ int shadow_master_fx_slot_load_with_config(int slot, const char *dsp_path, const
         typedef void (*fx_on_midi_fn)(void *, const uint8_t *, int, int);
         s->on_midi = (fx_on_midi_fn)dlsym(s->handle, "move_audio_fx_on_midi");
     }
+    s->process_f32 = (audio_fx_process_block_f32_fn)dlsym(s->handle, AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL);
 
     fprintf(stderr, "Shadow master FX[%d]: loaded %s\n", slot, dsp_path);
     return 0;
@@ -855,13 +860,15 @@ static void capture_debug_log(const char *msg) {
     }
 }
 
-void shadow_slot_load_capture(int slot, int patch_index) {
+/* Load a patch's capture rules via `instance` into `out`. Reads the patch
+ * file, so only call from the SPI path for legacy synchronous loads. */
+static void shadow_capture_load_for_instance(void *instance, int slot, int patch_index,
+                                             shadow_capture_rules_t *out) {
     char dbg[512];
     snprintf(dbg, sizeof(dbg), "shadow_slot_load_capture: slot=%d patch_index=%d", slot, patch_index);
     capture_debug_log(dbg);
 
-    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return;
-    if (!shadow_chain_slots[slot].instance) {
+    if (!instance) {
         capture_debug_log("  -> no instance");
         return;
     }
@@ -870,12 +877,12 @@ void shadow_slot_load_capture(int slot, int patch_index) {
         return;
     }
 
-    capture_clear(&shadow_chain_slots[slot].capture);
+    capture_clear(out);
 
     char key[32];
     char path[512];
     snprintf(key, sizeof(key), "patch_path_%d", patch_index);
-    int len = shadow_plugin_v2->get_param(shadow_chain_slots[slot].instance, key, path, sizeof(path));
+    int len = shadow_plugin_v2->get_param(instance, key, path, sizeof(path));
     snprintf(dbg, sizeof(dbg), "  -> get_param(%s) len=%d", key, len);
     capture_debug_log(dbg);
     if (len <= 0) return;
@@ -908,18 +915,18 @@ void shadow_slot_load_capture(int slot, int patch_index) {
     json[nread] = '\0';
     fclose(f);
 
-    capture_parse_json(&shadow_chain_slots[slot].capture, json);
+    capture_parse_json(out, json);
     free(json);
 
     /* Log capture rules summary */
     int has_notes = 0, has_ccs = 0;
     for (int b = 0; b < 16; b++) {
-        if (shadow_chain_slots[slot].capture.notes[b]) has_notes = 1;
-        if (shadow_chain_slots[slot].capture.ccs[b]) has_ccs = 1;
+        if (out->notes[b]) has_notes = 1;
+        if (out->ccs[b]) has_ccs = 1;
     }
     snprintf(dbg, sizeof(dbg), "  -> capture parsed: has_notes=%d has_ccs=%d", has_notes, has_ccs);
     capture_debug_log(dbg);
-    snprintf(dbg, sizeof(dbg), "  -> note 16 captured: %d", capture_has_note(&shadow_chain_slots[slot].capture, 16));
+    snprintf(dbg, sizeof(dbg), "  -> note 16 captured: %d", capture_has_note(out, 16));
     capture_debug_log(dbg);
     if (has_notes || has_ccs) {
         snprintf(dbg, sizeof(dbg), "Slot %d capture loaded: notes=%d ccs=%d",
@@ -928,6 +935,88 @@ void shadow_slot_load_capture(int slot, int patch_index) {
     }
 }
 
+void shadow_slot_load_capture(int slot, int patch_index) {
+    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return;
+    shadow_capture_load_for_instance(shadow_chain_slots[slot].instance, slot, patch_index,
+                                     &shadow_chain_slots[slot].capture);
+}
+
+/* ============================================================================
+ * Async patch loading (loader thread side)
+ * ============================================================================ */
+
+/* Build a fresh chain instance with `patch_index` loaded. Runs on the
+ * patch loader thread: everything here (dlopen, JSON, file reads) is what
+ * used to stall the SPI callback on a patch change. */
+static int shadow_patch_loader_build(int slot, int patch_index, patch_loader_result_t *out) {
+    if (!shadow_plugin_v2 || !shadow_plugin_v2->create_instance ||
+        !shadow_plugin_v2->set_param) return -1;
+
+    void *inst = shadow_plugin_v2->create_instance(SHADOW_CHAIN_MODULE_DIR, NULL);
+    if (!inst) return -1;
+
+    char buf[128];
+    int len;
+    if (shadow_plugin_v2->get_param) {
+        len = shadow_plugin_v2->get_param(inst, "patch_count", buf, sizeof(buf));
+        if (len > 0) {
+            buf[len < (int)sizeof(buf) ? len : (int)sizeof(buf) - 1] = '\0';
+            int patch_count = atoi(buf);
+            if (patch_count > 0 && patch_index >= patch_count) {
+                shadow_plugin_v2->destroy_instance(inst);
+                return -1;
+            }
+        }
+    }
+
+    char idx_str[16];
+    snprintf(idx_str, sizeof(idx_str), "%d", patch_index);
+    shadow_plugin_v2->set_param(inst, "load_patch", idx_str);
+    out->instance = inst;
+
+    if (shadow_plugin_v2->get_param) {
+        char key[32];
+        snprintf(key, sizeof(key), "patch_name_%d", patch_index);
+        len = shadow_plugin_v2->get_param(inst, key, buf, sizeof(buf));
+        if (len > 0) {
+            buf[len < (int)sizeof(buf) ? len : (int)sizeof(buf) - 1] = '\0';
+            strncpy(out->patch_name, buf, sizeof(out->patch_name) - 1);
+            out->patch_name[sizeof(out->patch_name) - 1] = '\0';
+        }
+
+        /* Same semantics as shadow_apply_patch_channels(), resolved here so
+         * the swap on the SPI thread is plain field copies. */
+        len = shadow_plugin_v2->get_param(inst, "patch:receive_channel", buf, sizeof(buf));
+        if (len > 0) {
+            buf[len < (int)sizeof(buf) ? len : (int)sizeof(buf) - 1] = '\0';
+            int recv_ch = atoi(buf);
+            if (recv_ch >= 0 && recv_ch <= 16) out->receive_channel = recv_ch;
+        }
+        len = shadow_plugin_v2->get_param(inst, "patch:forward_channel", buf, sizeof(buf));
+        if (len > 0) {
+            buf[len < (int)sizeof(buf) ? len : (int)sizeof(buf) - 1] = '\0';
+            int fwd_ch = atoi(buf);
+            if (fwd_ch >= -2 && fwd_ch <= 15) out->forward_channel = fwd_ch;
+        }
+        len = shadow_plugin_v2->get_param(inst, "synth:default_forward_channel", buf, sizeof(buf));
+        if (len > 0) {
+            buf[len < (int)sizeof(buf) ? len : (int)sizeof(buf) - 1] = '\0';
+            int default_fwd = atoi(buf);
+            if (default_fwd == -2 || (default_fwd >= 0 && default_fwd <= 15))
+                out->default_forward_channel = default_fwd;
+        }
+    }
+
+    shadow_capture_load_for_instance(inst, slot, patch_index, &out->capture);
+    return 0;
+}
+
+static void shadow_patch_loader_destroy(void *instance) {
+    if (instance && shadow_plugin_v2 && shadow_plugin_v2->destroy_instance) {
+        shadow_plugin_v2->destroy_instance(instance);
+    }
+}
+
 /* ============================================================================
  * Boot - Load Chain
  * ============================================================================ */
@@ -981,12 +1070,15 @@ int shadow_inprocess_load_chain(void) {
         dlsym(shadow_dsp_handle, "chain_set_external_fx_mode");
     shadow_chain_process_fx = (void (*)(void *, int16_t *, int))
         dlsym(shadow_dsp_handle, "chain_process_fx");
+    shadow_chain_on_midi_timed = (move_plugin_on_midi_timed_fn)
+        dlsym(shadow_dsp_handle, MOVE_PLUGIN_ON_MIDI_TIMED_SYMBOL);
 
-    unified_log("shim", LOG_LEVEL_INFO, "chain dlsym: inject=%p ext_fx_mode=%p process_fx=%p same_frame=%d",
+    unified_log("shim", LOG_LEVEL_INFO, "chain dlsym: inject=%p ext_fx_mode=%p process_fx=%p same_frame=%d midi_timed=%p",
             (void*)shadow_chain_set_inject_audio,
             (void*)shadow_chain_set_external_fx_mode,
             (void*)shadow_chain_process_fx,
-            (shadow_chain_set_external_fx_mode && shadow_chain_process_fx) ? 1 : 0);
+            (shadow_chain_set_external_fx_mode && shadow_chain_process_fx) ? 1 : 0,
+            (void*)shadow_chain_on_midi_timed);
 
     /* Set pages: read persisted page on boot */
     set_page_current = set_page_read_persisted();
@@ -1348,6 +1440,16 @@ int shadow_inprocess_load_chain(void) {
         host.launch_shadow_ui();
     }
     shadow_log("Shadow inprocess: chain loaded");
+
+    if (host.async_patch_load_enabled && *host.async_patch_load_enabled) {
+        patch_loader_host_t loader_host = {
+            .log = shadow_log,
+            .build = shadow_patch_loader_build,
+            .destroy = shadow_patch_loader_destroy,
+        };
+        patch_loader_init(&loader_host);
+        patch_loader_start();
+    }
     return 0;
 }
 
@@ -1382,6 +1484,8 @@ void shadow_inprocess_handle_ui_request(void) {
 
     /* Handle "none" special value */
     if (patch_index == SHADOW_PATCH_INDEX_NONE) {
+        /* Drop any async build still in flight for this slot */
+        if (patch_loader_pending(slot)) patch_loader_request(slot, -1);
         if (shadow_chain_slots[slot].fade.gain > 0.0f) {
             /* Slot is audible — defer clear until fade-out completes */
             shadow_chain_slots[slot].fade.target = 0.0f;
@@ -1409,6 +1513,18 @@ void shadow_inprocess_handle_ui_request(void) {
         return;
     }
 
+    /* Async path: build the new instance on the loader thread while the
+     * current patch keeps playing. shadow_process_fade_completions() fades
+     * out and swaps once the build is ready. */
+    if (patch_loader_running()) {
+        shadow_chain_slots[slot].fade.pending_patch = -1;
+        shadow_chain_slots[slot].fade.pending_clear = 0;
+        /* Undo a fade-out from a pending clear that this load supersedes */
+        if (shadow_chain_slots[slot].active) shadow_chain_slots[slot].fade.target = 1.0f;
+        patch_loader_request(slot, patch_index);
+        return;
+    }
+
     /* If slot is currently audible, defer load until fade-out completes */
     if (shadow_chain_slots[slot].fade.gain > 0.0f) {
         shadow_chain_slots[slot].fade.target = 0.0f;
@@ -1465,9 +1581,66 @@ void shadow_inprocess_handle_ui_request(void) {
  * Fade Completion Handler
  * ============================================================================ */
 
+/* Swap in instances built by the patch loader. Once a build is ready the
+ * slot fades out; at zero gain the new instance replaces the old one with
+ * plain pointer/field copies and the old one goes back to the loader for
+ * destruction. */
+static void shadow_swap_loaded_patches(void) {
+    for (int slot = 0; slot < SHADOW_CHAIN_INSTANCES; slot++) {
+        if (!patch_loader_ready(slot)) continue;
+        slot_fade_t *fade = &shadow_chain_slots[slot].fade;
+
+        if (fade->gain > 0.0f) {
+            fade->target = 0.0f;
+            continue;
+        }
+
+        patch_loader_result_t *r = patch_loader_take(slot);
+        if (!r) continue;
+
+        if (!r->ok || !r->instance) {
+            /* Build failed: keep the current patch and restore it */
+            if (shadow_chain_slots[slot].active) fade->target = 1.0f;
+            patch_loader_release(r, r->instance);
+            continue;
+        }
+
+        void *old_instance = shadow_chain_slots[slot].instance;
+        shadow_chain_slots[slot].instance = r->instance;
+        shadow_chain_slots[slot].patch_index = r->patch_index;
+        shadow_chain_slots[slot].active = 1;
+        if (r->patch_name[0]) {
+            memcpy(shadow_chain_slots[slot].patch_name, r->patch_name,
+                   sizeof(shadow_chain_slots[slot].patch_name));
+            shadow_chain_slots[slot].patch_name[sizeof(shadow_chain_slots[slot].patch_name) - 1] = '\0';
+        }
+        shadow_chain_slots[slot].capture = r->capture;
+        if (r->receive_channel == 0) {
+            shadow_chain_slots[slot].channel = -1;  /* All */
+        } else if (r->receive_channel >= 1) {
+            shadow_chain_slots[slot].channel = r->receive_channel - 1;
+        }
+        /* Same order as the synchronous loads: the synth's default forward
+         * channel fills in "auto", then the patch's own settings win. */
+        if (shadow_chain_slots[slot].forward_channel == -1 &&
+            r->default_forward_channel != PATCH_LOADER_CHANNEL_ABSENT) {
+            shadow_chain_slots[slot].forward_channel = r->default_forward_channel;
+        }
+        if (r->forward_channel != PATCH_LOADER_CHANNEL_ABSENT) {
+            shadow_chain_slots[slot].forward_channel = r->forward_channel;
+        }
+        shadow_ui_state_update_slot(slot);
+        fade->target = 1.0f;
+
+        patch_loader_release(r, old_instance);
+    }
+}
+
 void shadow_process_fade_completions(void) {
     if (!shadow_plugin_v2 || !shadow_plugin_v2->set_param) return;
 
+    if (patch_loader_running()) shadow_swap_loaded_patches();
+
     for (int slot = 0; slot < SHADOW_CHAIN_INSTANCES; slot++) {
         slot_fade_t *fade = &shadow_chain_slots[slot].fade;
 
@@ -1664,8 +1837,12 @@ void shadow_direct_set_param(uint8_t slot, const char *key, const char *value) {
     }
 }
 
+/* Request currently being dispatched: the /schwung-param mailbox, or the
+ * scratch copy of a batched ring request. */
+static shadow_param_t *shadow_param_active = NULL;
+
 int shadow_param_publish_response(uint32_t req_id) {
-    shadow_param_t *param = host.shadow_param_ptr ? *host.shadow_param_ptr : NULL;
+    shadow_param_t *param = shadow_param_active;
     if (!param) return 0;
     if (param->request_id != req_id) {
         return 0;
@@ -2202,10 +2379,9 @@ void shadow_master_fx_lfo_tick(int frames) {
     }
 }
 
-void shadow_inprocess_handle_param_request(void) {
-    shadow_param_t *shadow_param = host.shadow_param_ptr ? *host.shadow_param_ptr : NULL;
-    if (!shadow_param) return;
-
+/* Dispatch one get/set request held in `shadow_param`. Writes the result
+ * back into the same struct and publishes it via shadow_param_publish_response. */
+static void shadow_param_dispatch(shadow_param_t *shadow_param) {
     uint8_t req_type = shadow_param->request_type;
     if (req_type == 0) return;
     uint32_t req_id = shadow_param->request_id;
@@ -2216,7 +2392,7 @@ void shadow_inprocess_handle_param_request(void) {
         if (strncmp(key, "jack:", 5) == 0 ||
             strcmp(key, "suspend_overtake") == 0 ||
             strcmp(key, "passthrough") == 0) {
-            if (host.handle_param_special(req_type, req_id)) {
+            if (host.handle_param_special(shadow_param, req_type, req_id)) {
                 shadow_param_publish_response(req_id);
                 return;
             }
@@ -2339,7 +2515,7 @@ void shadow_inprocess_handle_param_request(void) {
                 strcmp(param_key, "system_link_enabled") == 0 ||
                 strncmp(param_key, "jack:", 5) == 0 ||
                 strcmp(param_key, "suspend_overtake") == 0) {
-                if (host.handle_param_special(req_type, req_id)) {
+                if (host.handle_param_special(shadow_param, req_type, req_id)) {
                     shadow_param_publish_response(req_id);
                     return;
                 }
@@ -2582,7 +2758,7 @@ void shadow_inprocess_handle_param_request(void) {
 
     /* Handle overtake DSP params - delegate to shim */
     if (strncmp(shadow_param->key, "overtake_dsp:", 13) == 0) {
-        if (host.handle_param_special && host.handle_param_special(req_type, req_id)) {
+        if (host.handle_param_special && host.handle_param_special(shadow_param, req_type, req_id)) {
             shadow_param_publish_response(req_id);
             return;
         }
@@ -2806,3 +2982,92 @@ void shadow_inprocess_handle_param_request(void) {
 
     shadow_param_publish_response(req_id);
 }
+
+void shadow_inprocess_handle_param_request(void) {
+    shadow_param_t *shadow_param = host.shadow_param_ptr ? *host.shadow_param_ptr : NULL;
+    if (!shadow_param || shadow_param->request_type == 0) return;
+
+    shadow_param_active = shadow_param;
+    shadow_param_dispatch(shadow_param);
+    shadow_param_active = NULL;
+}
+
+/* Scratch request for ring dispatch. Handlers may write up to
+ * SHADOW_PARAM_VALUE_LEN into value, so this mirrors the full mailbox. */
+static shadow_param_t shadow_param_ring_scratch;
+
+static uint64_t shadow_param_ring_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void shadow_inprocess_drain_param_ring(void) {
+    shadow_param_ring_t *ring = host.shadow_param_ring_ptr ? *host.shadow_param_ring_ptr : NULL;
+    if (!ring) return;
+
+    uint32_t tail = ring->req_tail;
+    uint32_t head = __atomic_load_n(&ring->req_head, __ATOMIC_ACQUIRE);
+    if (tail == head) return;
+
+    uint64_t t0 = shadow_param_ring_now_us();
+    shadow_param_t *p = &shadow_param_ring_scratch;
+
+    for (int n = 0; n < SHADOW_PARAM_RING_MAX_PER_FRAME && tail != head; n++) {
+        /* Backpressure: leave requests queued until the UI reads responses */
+        uint32_t resp_head = ring->resp_head;
+        if (resp_head - __atomic_load_n(&ring->resp_tail, __ATOMIC_ACQUIRE) >=
+            SHADOW_PARAM_RING_ENTRIES) break;
+
+        const shadow_param_ring_entry_t *req =
+            &ring->requests[tail & (SHADOW_PARAM_RING_ENTRIES - 1)];
+        uint32_t req_id = req->request_id;
+        p->request_type = req->request_type;
+        p->slot = req->slot;
+        p->request_id = req_id;
+        p->response_ready = 0;
+        p->error = 0;
+        p->result_len = 0;
+        memcpy(p->key, req->key, SHADOW_PARAM_KEY_LEN);
+        p->key[SHADOW_PARAM_KEY_LEN - 1] = '\0';
+        memcpy(p->value, req->value, SHADOW_PARAM_RING_VALUE_LEN);
+        p->value[SHADOW_PARAM_RING_VALUE_LEN - 1] = '\0';
+        tail++;
+        __atomic_store_n(&ring->req_tail, tail, __ATOMIC_RELEASE);
+
+        shadow_param_ring_entry_t *resp =
+            &ring->responses[resp_head & (SHADOW_PARAM_RING_ENTRIES - 1)];
+        resp->request_id = req_id;
+        resp->request_type = p->request_type;
+        resp->slot = p->slot;
+
+        if (p->request_type == 1 || p->request_type == 2) {
+            shadow_param_active = p;
+            shadow_param_dispatch(p);
+            shadow_param_active = NULL;
+            resp->error = p->error;
+            resp->result_len = p->result_len;
+            if (p->request_type == 2 && p->result_len >= SHADOW_PARAM_RING_VALUE_LEN) {
+                resp->error = SHADOW_PARAM_RING_ERR_TOO_LARGE;
+                resp->result_len = -1;
+                resp->value[0] = '\0';
+            } else if (p->request_type == 2 && p->result_len > 0) {
+                memcpy(resp->value, p->value, (size_t)p->result_len);
+                resp->value[p->result_len] = '\0';
+            } else {
+                resp->value[0] = '\0';
+            }
+        } else {
+            resp->error = 1;
+            resp->result_len = -1;
+            resp->value[0] = '\0';
+        }
+        memcpy(resp->key, p->key, SHADOW_PARAM_KEY_LEN);
+        __atomic_store_n(&ring->resp_head, resp_head + 1, __ATOMIC_RELEASE);
+
+        if (shadow_param_ring_now_us() - t0 >= SHADOW_PARAM_RING_BUDGET_US) break;
+    }
+
+    /* Responses are in; let the UI settle their promises now */
+    shadow_ui_wake(host.shadow_control_ptr ? *host.shadow_control_ptr : NULL);
+}
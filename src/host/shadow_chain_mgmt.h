@@ -48,6 +48,7 @@ typedef struct {
     char chain_params_cache[65536];  /* Cached chain_params to avoid file I/O in audio thread */
     int chain_params_cached;         /* 1 if cache is valid */
     void (*on_midi)(void *instance, const uint8_t *msg, int len, int source);  /* Optional MIDI handler */
+    audio_fx_process_block_f32_fn process_f32;  /* Optional float32 block entry point */
     int bypassed;                    /* 1 = skip this MFX slot (dry passthrough), 0 = active */
 } master_fx_slot_t;
 
@@ -59,6 +60,7 @@ typedef struct {
     /* Shared state pointers (owned by shim) */
     shadow_control_t **shadow_control_ptr;
     shadow_param_t **shadow_param_ptr;
+    shadow_param_ring_t **shadow_param_ring_ptr;
     shadow_ui_state_t **shadow_ui_state_ptr;
     uint8_t **global_mmap_addr_ptr;
 
@@ -69,13 +71,15 @@ typedef struct {
 
     /* Boot state */
     bool *shadow_ui_enabled;
+    bool *async_patch_load_enabled;  /* Build patch loads on the loader thread */
     int *startup_modwheel_countdown;
     int startup_modwheel_reset_frames;
 
     /* Param request: delegate shim-specific param prefixes (overtake_dsp, etc.)
-     * The shim callback reads/writes shadow_param->key/value/error/result_len directly.
+     * The shim callback reads/writes param->key/value/error/result_len directly
+     * (`param` is the /schwung-param mailbox or a batched ring request).
      * Returns 1 if handled, 0 if not. Caller publishes response if handled. */
-    int (*handle_param_special)(uint8_t req_type, uint32_t req_id);
+    int (*handle_param_special)(shadow_param_t *param, uint8_t req_type, uint32_t req_id);
 
     /* Tempo query — returns current BPM via sampler_get_bpm() fallback chain. */
     float (*get_bpm)(void);
@@ -101,6 +105,7 @@ extern const plugin_api_v2_t *shadow_plugin_v2;
 extern void (*shadow_chain_set_inject_audio)(void *instance, int16_t *buf, int frames);
 extern void (*shadow_chain_set_external_fx_mode)(void *instance, int mode);
 extern void (*shadow_chain_process_fx)(void *instance, int16_t *buf, int frames);
+extern move_plugin_on_midi_timed_fn shadow_chain_on_midi_timed;
 extern host_api_v1_t shadow_host_api;
 extern int shadow_inprocess_ready;
 
@@ -227,5 +232,7 @@ int shadow_handle_slot_param_set(int slot, const char *key, const char *value);
 int shadow_handle_slot_param_get(int slot, const char *key, char *buf, int buf_len);
 int shadow_param_publish_response(uint32_t req_id);
 void shadow_inprocess_handle_param_request(void);
+/* Drain batched requests from /schwung-param-ring (SPI thread, bounded per frame) */
+void shadow_inprocess_drain_param_ring(void);
 
 #endif /* SHADOW_CHAIN_MGMT_H */
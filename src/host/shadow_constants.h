@@ -34,6 +34,8 @@
 #define SHM_DISPLAY_LIVE    "/schwung-display-live"    /* Live display for remote viewer */
 #define SHM_WEB_PARAM_SET   "/schwung-web-param-set"   /* Web UI → shim param set ring */
 #define SHM_WEB_PARAM_NOTIFY "/schwung-web-param-notify" /* Shim → web UI param change ring */
+#define SHM_SHADOW_PARAM_RING "/schwung-param-ring"  /* Batched param request/response rings */
+#define SHM_SHADOW_TELEMETRY "/schwung-telemetry"  /* SPI stage histograms + overrun ring */
 
 /* ============================================================================
  * Audio Constants
@@ -51,6 +53,12 @@
  * MIDI_OUT must be bounded by this to avoid corrupting the display. */
 #define HW_MIDI_OUT_SIZE    80
 #define DISPLAY_BUFFER_SIZE 1024  /* 128x64 @ 1bpp = 1024 bytes */
+#define DISPLAY_SLICE_BYTES 172   /* OLED slice protocol: 5 x 172 + 164 bytes */
+#define DISPLAY_SLICE_COUNT 6
+/* /schwung-display: the frame, then a uint32 of slices the UI has rewritten
+ * since the shim last copied them (bit n = slice n) */
+#define SHADOW_DISPLAY_DIRTY_OFFSET DISPLAY_BUFFER_SIZE
+#define SHADOW_DISPLAY_SHM_SIZE     (DISPLAY_BUFFER_SIZE + 64)
 #define CONTROL_BUFFER_SIZE 72  /* bumped for sampler_source_request + sampler_silent (PR #61); leaves headroom in reserved[] */
 #define SHADOW_UI_BUFFER_SIZE     512
 #define SHADOW_PARAM_BUFFER_SIZE  65664  /* Large buffer for complex ui_hierarchy */
@@ -66,6 +74,12 @@
 #define WEB_PARAM_SET_ENTRIES 32     /* Max pending set requests */
 #define WEB_PARAM_NOTIFY_ENTRIES 64  /* Max pending change notifications */
 
+/* Batched param ring sizes (shadow UI ↔ shim) */
+#define SHADOW_PARAM_RING_ENTRIES   64     /* Per direction, power of two */
+#define SHADOW_PARAM_RING_VALUE_LEN 256    /* Larger values (ui_hierarchy, state) use /schwung-param */
+#define SHADOW_PARAM_RING_MAX_PER_FRAME 16 /* Requests the shim drains per SPI frame */
+#define SHADOW_PARAM_RING_BUDGET_US 300    /* ...or until this much frame time is spent */
+
 /* ============================================================================
  * Slot Configuration
  * ============================================================================ */
@@ -156,7 +170,9 @@ typedef struct shadow_control_t {
     volatile uint16_t skipback_seconds; /* Skipback rolling buffer length: 30/60/120/180/240/300 */
     volatile uint8_t resume_last_tool;  /* 1=JUMP_TO_TOOLS should resume the most-recently-suspended tool instead of opening the menu */
     volatile uint8_t midi_indicator_enabled; /* 1=draw "ccN" MIDI channel indicator while a note is held */
-    volatile uint8_t reserved[5];
+    volatile uint8_t ui_waiting;        /* 1=shadow UI is blocked on ui_wake_seq (see shadow_ui_wake.h) */
+    volatile uint8_t reserved[1];
+    volatile uint32_t ui_wake_seq;      /* Futex: bumped when the shim has work for the shadow UI */
 } shadow_control_t;
 
 /*
@@ -287,6 +303,36 @@ typedef struct web_param_notify_ring_t {
     web_param_notify_entry_t entries[WEB_PARAM_NOTIFY_ENTRIES];
 } web_param_notify_ring_t;
 
+/*
+ * Batched param rings — shadow UI writes requests, shim drains up to
+ * SHADOW_PARAM_RING_MAX_PER_FRAME per frame and answers on the response
+ * ring with the same request_id. Both rings are SPSC with free-running
+ * 32-bit head/tail counters (head written by the producer only).
+ * Unlike shadow_param_t, many requests can be in flight at once, so a
+ * 40-param preset recall costs a few frames instead of 40 round-trips.
+ */
+#define SHADOW_PARAM_RING_ERR_TOO_LARGE 0xFE  /* Response value did not fit */
+
+typedef struct shadow_param_ring_entry_t {
+    uint32_t request_id;
+    uint8_t request_type;            /* 1=set, 2=get (as shadow_param_t) */
+    uint8_t slot;
+    uint8_t error;                   /* Response: non-zero on error */
+    uint8_t reserved;
+    int32_t result_len;              /* Response: length of value, -1 on error */
+    char key[SHADOW_PARAM_KEY_LEN];
+    char value[SHADOW_PARAM_RING_VALUE_LEN];
+} shadow_param_ring_entry_t;
+
+typedef struct shadow_param_ring_t {
+    volatile uint32_t req_head;      /* Shadow UI increments after writing */
+    volatile uint32_t req_tail;      /* Shim increments after consuming */
+    volatile uint32_t resp_head;     /* Shim increments after writing */
+    volatile uint32_t resp_tail;     /* Shadow UI increments after consuming */
+    shadow_param_ring_entry_t requests[SHADOW_PARAM_RING_ENTRIES];
+    shadow_param_ring_entry_t responses[SHADOW_PARAM_RING_ENTRIES];
+} shadow_param_ring_t;
+
 /*
  * Screen reader message structure.
  * Supports both D-Bus announcements and on-device TTS.
@@ -356,7 +402,7 @@ typedef struct shadow_overlay_state_t {
     volatile uint8_t  set_page_active;            /* 1 = showing set page toast */
     volatile uint8_t  set_page_current;           /* Current page (0-7) */
     volatile uint8_t  set_page_total;             /* Total pages (8) */
-    volatile uint8_t  set_page_loading;           /* 1 = loading (pre-restart), 0 = loaded */
+    volatile uint8_t  set_page_loading;           /* SET_PAGE_STAGE_*: 0 = loaded, else switching */
     volatile uint16_t set_page_timeout;           /* Frames remaining for toast */
 
     /* Preroll state */
@@ -375,6 +421,7 @@ typedef struct shadow_overlay_state_t {
 typedef char shadow_control_size_check[(sizeof(shadow_control_t) == CONTROL_BUFFER_SIZE) ? 1 : -1];
 typedef char shadow_ui_state_size_check[(sizeof(shadow_ui_state_t) <= SHADOW_UI_BUFFER_SIZE) ? 1 : -1];
 typedef char shadow_param_size_check[(sizeof(shadow_param_t) <= SHADOW_PARAM_BUFFER_SIZE) ? 1 : -1];
+typedef char shadow_param_ring_pow2_check[((SHADOW_PARAM_RING_ENTRIES & (SHADOW_PARAM_RING_ENTRIES - 1)) == 0) ? 1 : -1];
 typedef char shadow_screenreader_size_check[(sizeof(shadow_screenreader_t) <= SHADOW_SCREENREADER_BUFFER_SIZE) ? 1 : -1];
 typedef char shadow_overlay_size_check[(sizeof(shadow_overlay_state_t) == SHADOW_OVERLAY_BUFFER_SIZE) ? 1 : -1];
 typedef char schwung_ext_midi_remap_size_check[(sizeof(schwung_ext_midi_remap_t) == 64) ? 1 : -1];
@@ -201,7 +201,7 @@ static void shadow_dbus_handle_text(const char *text)
     if (ctrl && strcasecmp(text, "Press wheel to shut down") == 0) {
         host.log("Shutdown prompt detected — saving state and dismissing shadow UI");
         ctrl->ui_flags |= SHADOW_UI_FLAG_SAVE_STATE;
-        host.save_state();
+        host.flush_state();
         if (*host.display_mode) {
             *host.display_mode = 0;
             ctrl->display_mode = 0;
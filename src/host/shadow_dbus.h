@@ -26,6 +26,7 @@
 typedef struct {
     void (*log)(const char *msg);
     void (*save_state)(void);
+    void (*flush_state)(void);
     void (*apply_mute)(int slot, int is_muted);
     void (*ui_state_update_slot)(int slot);
     void (*native_sampler_update)(const char *text);
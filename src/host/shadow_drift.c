@@ -0,0 +1,169 @@
+/* shadow_drift.c - Clock-drift compensation for Link Audio input
+ * See shadow_drift.h for the controller and resampler. */
+
+#include <math.h>
+#include <string.h>
+
+#include "shadow_drift.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && defined(SHADOW_DRIFT_ENABLE_NEON)
+#define SHADOW_DRIFT_NEON 1
+#include <arm_neon.h>
+#else
+#define SHADOW_DRIFT_NEON 0
+#endif
+
+#define PHASES        128
+#define CUTOFF        0.93     /* fraction of Nyquist (~20.5 kHz) */
+#define KAISER_BETA   9.0
+#define HALF_SPAN     (LA_DRIFT_TAPS / 2)
+
+/* Controller tuning, per 128-frame block. The fill error is low-passed
+ * over ~0.2 s to average out the 125-vs-128 packet sawtooth. KP alone
+ * pulls a fill error back with a ~2.3 s time constant; KI is set for a
+ * damping ratio of about 0.7. In steady state the ratio wobbles by well
+ * under 100 ppm (0.2 cents). */
+#define ERR_LP_BLOCKS 64.0
+#define KP            1.0e-5
+#define KI            6.5e-9
+
+#define MAX_SPAN ((int)(LA_DRIFT_MAX_FRAMES * (1.0 + LA_DRIFT_RATIO_MAX)) + LA_DRIFT_TAPS + 2)
+
+/* coef[p] is the kernel for fractional position p / PHASES; delta[p] is
+ * coef[p + 1] - coef[p] for the linear interpolation between phases. */
+static float coef[PHASES][LA_DRIFT_TAPS];
+static float delta[PHASES][LA_DRIFT_TAPS];
+static int tables_ready;
+
+static double bessel_i0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 40; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+static void kernel_row(double frac, double *row)
+{
+    double norm = 0.0;
+    for (int k = 0; k < LA_DRIFT_TAPS; k++) {
+        /* Tap k sits at frame LA_DRIFT_HISTORY_FRAMES before the output
+         * position, plus k, minus the fractional offset */
+        double x = (double)(k - LA_DRIFT_HISTORY_FRAMES) - frac;
+        double t = x / HALF_SPAN;
+        double w = (t <= -1.0 || t >= 1.0) ? 0.0
+                 : bessel_i0(KAISER_BETA * sqrt(1.0 - t * t)) / bessel_i0(KAISER_BETA);
+        double a = M_PI * CUTOFF * x;
+        double s = (fabs(a) < 1e-9) ? 1.0 : sin(a) / a;
+        row[k] = s * w;
+        norm += row[k];
+    }
+    /* Unity gain at DC for every phase */
+    for (int k = 0; k < LA_DRIFT_TAPS; k++) row[k] /= norm;
+}
+
+void la_drift_init_tables(void)
+{
+    if (tables_ready) return;
+    double row[PHASES + 1][LA_DRIFT_TAPS];
+    for (int p = 0; p <= PHASES; p++) kernel_row((double)p / PHASES, row[p]);
+    for (int p = 0; p < PHASES; p++) {
+        for (int k = 0; k < LA_DRIFT_TAPS; k++) {
+            coef[p][k] = (float)row[p][k];
+            delta[p][k] = (float)(row[p + 1][k] - row[p][k]);
+        }
+    }
+    tables_ready = 1;
+}
+
+void la_drift_reset(la_drift_t *d)
+{
+    memset(d, 0, sizeof(*d));
+    d->ratio = 1.0;
+}
+
+static double clampd(double v, double lo, double hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+double la_drift_control(la_drift_t *d, double err_frames)
+{
+    if (!d->primed) {
+        d->primed = 1;
+        d->err_lp = err_frames;
+    } else {
+        d->err_lp += (err_frames - d->err_lp) / ERR_LP_BLOCKS;
+    }
+    d->integ = clampd(d->integ + KI * d->err_lp, -LA_DRIFT_RATIO_MAX, LA_DRIFT_RATIO_MAX);
+    d->ratio = 1.0 + clampd(d->integ + KP * d->err_lp, -LA_DRIFT_RATIO_MAX, LA_DRIFT_RATIO_MAX);
+    return d->ratio;
+}
+
+int la_drift_frames_needed(const la_drift_t *d, int frames)
+{
+    if (frames <= 0) return 0;
+    return (int)(d->frac + (frames - 1) * d->ratio) + LA_DRIFT_TAPS;
+}
+
+static inline int16_t round_sat16(float v)
+{
+    long r = lroundf(v);
+    if (r > 32767) return 32767;
+    if (r < -32768) return -32768;
+    return (int16_t)r;
+}
+
+int la_drift_process(la_drift_t *d, const int16_t *ring, uint32_t mask,
+                     uint32_t rp, int16_t *out_lr, int frames)
+{
+    float l[MAX_SPAN], r[MAX_SPAN];
+
+    if (frames > LA_DRIFT_MAX_FRAMES) frames = LA_DRIFT_MAX_FRAMES;
+    int span = la_drift_frames_needed(d, frames);
+    for (int i = 0; i < span; i++) {
+        l[i] = ring[(rp + 2 * i) & mask];
+        r[i] = ring[(rp + 2 * i + 1) & mask];
+    }
+
+    for (int j = 0; j < frames; j++) {
+        double pos = d->frac + j * d->ratio;
+        int i = (int)pos;
+        float ph = (float)(pos - i) * PHASES;
+        int p = (int)ph;
+        if (p >= PHASES) p = PHASES - 1;
+        float pf = ph - p;
+        const float *c = coef[p], *dc = delta[p];
+        const float *xl = l + i, *xr = r + i;
+        float yl, yr;
+#if SHADOW_DRIFT_NEON
+        float32x4_t vpf = vdupq_n_f32(pf);
+        float32x4_t al = vdupq_n_f32(0.0f), ar = vdupq_n_f32(0.0f);
+        for (int k = 0; k < LA_DRIFT_TAPS; k += 4) {
+            float32x4_t h = vfmaq_f32(vld1q_f32(c + k), vld1q_f32(dc + k), vpf);
+            al = vfmaq_f32(al, h, vld1q_f32(xl + k));
+            ar = vfmaq_f32(ar, h, vld1q_f32(xr + k));
+        }
+        yl = vaddvq_f32(al);
+        yr = vaddvq_f32(ar);
+#else
+        yl = 0.0f;
+        yr = 0.0f;
+        for (int k = 0; k < LA_DRIFT_TAPS; k++) {
+            float h = c[k] + dc[k] * pf;
+            yl += h * xl[k];
+            yr += h * xr[k];
+        }
+#endif
+        out_lr[2 * j] = round_sat16(yl);
+        out_lr[2 * j + 1] = round_sat16(yr);
+    }
+
+    double end = d->frac + frames * d->ratio;
+    int used = (int)end;
+    d->frac = end - used;
+    return used;
+}
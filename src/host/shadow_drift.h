@@ -0,0 +1,68 @@
+/* shadow_drift.h - Clock-drift compensation for Link Audio input
+ *
+ * Move's per-track Link Audio reaches the shim through an SPSC ring fed by
+ * the link-subscriber sidecar at the Link session's clock, and is drained
+ * once per SPI block at the XMOS clock. The two drift apart by tens of ppm,
+ * so the ring fill wanders away from the latency-comp target. Dropping or
+ * duplicating whole frames to correct it clicks; this module instead reads
+ * the ring at a slightly adjusted rate:
+ *
+ *   controller  PI loop on the low-passed fill error (frames above target).
+ *               Its output is the resampling ratio: source frames consumed
+ *               per output frame, clamped to 1 +- LA_DRIFT_RATIO_MAX. The
+ *               integrator settles on the actual clock drift, so in steady
+ *               state the fill sits on target and the ratio stays put.
+ *   resampler   32-tap Kaiser-windowed sinc, 128 phases with linear
+ *               interpolation between them. Flat to 15 kHz at the int16
+ *               noise floor (~88 dB SNR on a half-scale sine), rolling off
+ *               above. Scalar; an aarch64 NEON kernel is opt-in with
+ *               -DSHADOW_DRIFT_ENABLE_NEON until it has been run on a
+ *               Move (test_link_audio_drift.sh builds both).
+ *
+ * The read position is fractional. The ring's read_pos points at the
+ * oldest frame the filter still needs, LA_DRIFT_HISTORY_FRAMES behind the
+ * output position, so the resampler never reads behind read_pos.
+ *
+ * Pure computation, no allocation: safe on the SPI thread. */
+
+#ifndef SHADOW_DRIFT_H
+#define SHADOW_DRIFT_H
+
+#include <stdint.h>
+
+#define LA_DRIFT_TAPS            32
+#define LA_DRIFT_HISTORY_FRAMES  (LA_DRIFT_TAPS / 2 - 1)
+#define LA_DRIFT_RATIO_MAX       0.003   /* +-3000 ppm, ~5 cents */
+#define LA_DRIFT_MAX_FRAMES      128     /* largest block la_drift_process accepts */
+
+typedef struct {
+    int    primed;
+    double frac;        /* fractional read position past ring read_pos, [0, 1) */
+    double ratio;       /* source frames per output frame */
+    double err_lp;      /* low-passed fill error, frames */
+    double integ;       /* integrator state (ratio - 1 contribution) */
+} la_drift_t;
+
+/* Build the filter table. Idempotent; call once before la_drift_process. */
+void la_drift_init_tables(void);
+
+void la_drift_reset(la_drift_t *d);
+
+/* Feed the fill error for this block (ring fill minus target, in frames)
+ * and return the ratio to resample it with. The first call after a reset
+ * seeds the low-pass with err instead of ramping up from 0. */
+double la_drift_control(la_drift_t *d, double err_frames);
+
+/* Source frames la_drift_process will read for `frames` output frames at
+ * the current ratio and phase. */
+int la_drift_frames_needed(const la_drift_t *d, int frames);
+
+/* Resample `frames` stereo frames (<= LA_DRIFT_MAX_FRAMES) from an
+ * interleaved int16 ring, starting at sample index `rp`, into out_lr.
+ * The caller must have at least la_drift_frames_needed() frames available
+ * from rp. Returns the number of source frames consumed (advance read_pos
+ * by twice that); the fractional remainder stays in d->frac. */
+int la_drift_process(la_drift_t *d, const int16_t *ring, uint32_t mask,
+                     uint32_t rp, int16_t *out_lr, int frames);
+
+#endif /* SHADOW_DRIFT_H */
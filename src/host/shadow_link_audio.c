@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "shadow_link_audio.h"
+#include "shadow_drift.h"
 #include "shadow_resample.h"  /* latency_comp_active */
 
 /* ============================================================================
@@ -40,26 +41,26 @@ static void la_avail_stats_reset(void) {
     }
 }
 
-/* Per-slot nudge counters for adaptive ring-fill correction. Rate-limit the
- * sample drop/duplicate operation to once every NUDGE_PERIOD reads, which
- * at ~344 reads/sec works out to ~0.3% rate change — still well below the
- * click threshold (one 22.7 µs sample skip every 47 ms) and below pitch-
- * shift audibility for transient program material. Dead band of ±256
- * samples (~2.9 ms) prevents jittering around the target. Convergence from
- * a 5 ms-off plateau takes ~5 s. Burst mode (drop/dup 8 frames per period
- * instead of 1) kicks in when error exceeds NUDGE_BURST_THRESHOLD so the
- * first second after engage gets us most of the way to target. */
-#define NUDGE_DEAD_BAND_SAMPLES 32
-#define NUDGE_PERIOD            16
-#define NUDGE_BURST_THRESHOLD   512
-#define NUDGE_BURST_FRAMES      8
-static uint32_t nudge_drop_counter[LINK_AUDIO_IN_SLOT_COUNT];
-static uint32_t nudge_dup_counter[LINK_AUDIO_IN_SLOT_COUNT];
-
-void link_audio_reset_nudge_state(void) {
+/* Per-slot drift compensation. While latency comp is active the reader
+ * resamples each slot through la_drift so the ring fill tracks
+ * LATENCY_COMP_TARGET_SAMPLES without dropping or repeating frames.
+ * `engaged` marks slots whose read_pos currently points at the filter's
+ * history (LA_DRIFT_HISTORY_FRAMES behind the output position) rather
+ * than at the next frame to play. SPI thread only, except the stats
+ * snapshot which the timing logger reads. */
+static la_drift_t la_drift[LINK_AUDIO_IN_SLOT_COUNT];
+static int la_drift_engaged[LINK_AUDIO_IN_SLOT_COUNT];
+static float la_drift_ppm[LINK_AUDIO_IN_SLOT_COUNT];
+static float la_drift_err[LINK_AUDIO_IN_SLOT_COUNT];
+
+void link_audio_reset_drift_state(void) {
+    /* Engagement is left alone: it describes where read_pos points, which
+     * a controller reset doesn't change */
     for (int i = 0; i < LINK_AUDIO_IN_SLOT_COUNT; i++) {
-        nudge_drop_counter[i] = 0;
-        nudge_dup_counter[i]  = 0;
+        la_drift_reset(&la_drift[i]);
+        float zero = 0.0f;
+        __atomic_store(&la_drift_ppm[i], &zero, __ATOMIC_RELAXED);
+        __atomic_store(&la_drift_err[i], &zero, __ATOMIC_RELAXED);
     }
 }
 
@@ -71,7 +72,8 @@ void shadow_link_audio_init(void) {
     memset(&link_audio, 0, sizeof(link_audio));
     memset(shadow_slot_capture, 0, sizeof(shadow_slot_capture));
     la_avail_stats_reset();
-    link_audio_reset_nudge_state();
+    la_drift_init_tables();
+    link_audio_reset_drift_state();
 }
 
 void link_audio_reset_state(void) {
@@ -127,6 +129,60 @@ int link_audio_read_channel_shm(link_audio_in_shm_t *shm, int slot_idx,
         __atomic_fetch_add(&la_avail_count[slot_idx], 1, __ATOMIC_RELAXED);
     }
 
+    /* Engage / disengage the resampler. Its read_pos sits
+     * LA_DRIFT_HISTORY_FRAMES behind the output position; the frames
+     * behind read_pos are the ones just played, so stepping back onto
+     * them (and forward again on the way out) is seamless. */
+    la_drift_t *d = &la_drift[slot_idx];
+    if (latency_comp_active && !la_drift_engaged[slot_idx]) {
+        la_drift_engaged[slot_idx] = 1;
+        rp -= LA_DRIFT_HISTORY_FRAMES * 2;
+        avail += LA_DRIFT_HISTORY_FRAMES * 2;
+    } else if (!latency_comp_active && la_drift_engaged[slot_idx]) {
+        uint32_t skip = (uint32_t)(LA_DRIFT_HISTORY_FRAMES + (d->frac >= 0.5)) * 2;
+        if (skip > avail) skip = avail;
+        la_drift_reset(d);
+        la_drift_engaged[slot_idx] = 0;
+        rp += skip;
+        avail -= skip;
+        __atomic_store_n(&slot->read_pos, rp, __ATOMIC_RELEASE);
+    }
+
+    if (la_drift_engaged[slot_idx]) {
+        /* Catch-up still guards against a stalled consumer, but lands on
+         * the target fill so the controller doesn't have to refill. */
+        uint32_t target = LATENCY_COMP_TARGET_SAMPLES + LA_DRIFT_HISTORY_FRAMES * 2;
+        if (avail > need * 12) {
+            uint32_t new_rp = wp - target;
+            __atomic_fetch_add(&slot->catchup_samples_dropped,
+                               (new_rp - rp), __ATOMIC_RELAXED);
+            __atomic_fetch_add(&slot->catchup_count, 1, __ATOMIC_RELAXED);
+            rp = new_rp;
+            avail = target;
+            d->primed = 0;  /* re-seed the error low-pass, keep the drift estimate */
+        }
+
+        /* Fill error in frames, measured at the output position */
+        double err = (double)avail / 2.0 - LA_DRIFT_HISTORY_FRAMES - d->frac
+                   - LATENCY_COMP_TARGET_SAMPLES / 2;
+        double ratio = la_drift_control(d, err);
+        float ppm = (float)((ratio - 1.0) * 1e6), err_lp = (float)d->err_lp;
+        __atomic_store(&la_drift_ppm[slot_idx], &ppm, __ATOMIC_RELAXED);
+        __atomic_store(&la_drift_err[slot_idx], &err_lp, __ATOMIC_RELAXED);
+
+        uint32_t span = (uint32_t)la_drift_frames_needed(d, frames) * 2;
+        if (avail < span) {
+            __atomic_fetch_add(&slot->starve_count, 1, __ATOMIC_RELAXED);
+            /* Keep an engage rewind or catch-up jump made above */
+            __atomic_store_n(&slot->read_pos, rp, __ATOMIC_RELEASE);
+            return 0;
+        }
+        int used = la_drift_process(d, slot->ring, LINK_AUDIO_IN_RING_MASK,
+                                    rp, out_lr, frames);
+        __atomic_store_n(&slot->read_pos, rp + (uint32_t)used * 2, __ATOMIC_RELEASE);
+        return 1;
+    }
+
     if (avail < need) {
         __atomic_fetch_add(&slot->starve_count, 1, __ATOMIC_RELAXED);
         return 0;
@@ -147,75 +203,23 @@ int link_audio_read_channel_shm(link_audio_in_shm_t *shm, int slot_idx,
         rp = new_rp;
     }
 
-    /* Adaptive nudge toward LATENCY_COMP_TARGET_SAMPLES. Drops or duplicates
-     * stereo frames every NUDGE_PERIOD reads when outside the dead band.
-     * Burst mode (NUDGE_BURST_FRAMES at once) engages on first second after
-     * activate so we converge fast; otherwise single-frame steps. Only
-     * runs when latency_comp_active is latched (set on rebuild_from_la
-     * engage transition by the shim mixer). */
-    int delta_frames = 0;
-    /* delta_frames > 0 → duplicate that many frames; < 0 → drop that many */
-    if (latency_comp_active) {
-        uint32_t target = LATENCY_COMP_TARGET_SAMPLES;
-        if (avail > target + NUDGE_DEAD_BAND_SAMPLES) {
-            if (++nudge_drop_counter[slot_idx] >= NUDGE_PERIOD) {
-                nudge_drop_counter[slot_idx] = 0;
-                uint32_t error = avail - target;
-                int frames = (error > NUDGE_BURST_THRESHOLD)
-                             ? NUDGE_BURST_FRAMES : 1;
-                /* Cap drop so we don't shrink the read below the ring */
-                uint32_t skip_samples = (uint32_t)frames * 2;
-                if (avail >= need + skip_samples) {
-                    delta_frames = -frames;
-                    rp += skip_samples;
-                }
-            }
-            nudge_dup_counter[slot_idx] = 0;
-        } else if (avail + NUDGE_DEAD_BAND_SAMPLES < target) {
-            if (++nudge_dup_counter[slot_idx] >= NUDGE_PERIOD) {
-                nudge_dup_counter[slot_idx] = 0;
-                uint32_t error = target - avail;
-                int frames = (error > NUDGE_BURST_THRESHOLD)
-                             ? NUDGE_BURST_FRAMES : 1;
-                /* Need to keep at least 2 source samples in the read */
-                if (need > (uint32_t)frames * 2 + 2) {
-                    delta_frames = +frames;
-                }
-            }
-            nudge_drop_counter[slot_idx] = 0;
-        } else {
-            nudge_drop_counter[slot_idx] = 0;
-            nudge_dup_counter[slot_idx]  = 0;
-        }
-    } else {
-        nudge_drop_counter[slot_idx] = 0;
-        nudge_dup_counter[slot_idx]  = 0;
+    for (uint32_t i = 0; i < need; i++) {
+        out_lr[i] = slot->ring[(rp + i) & LINK_AUDIO_IN_RING_MASK];
     }
+    __sync_synchronize();
+    slot->read_pos = rp + need;
+    return 1;
+}
 
-    if (delta_frames > 0) {
-        /* Duplicate `delta_frames` frames: read (need - delta*2) samples,
-         * then repeat the last L/R pair to pad out. */
-        uint32_t pad_samples = (uint32_t)delta_frames * 2;
-        uint32_t read_n = need - pad_samples;
-        for (uint32_t i = 0; i < read_n; i++) {
-            out_lr[i] = slot->ring[(rp + i) & LINK_AUDIO_IN_RING_MASK];
-        }
-        int16_t last_l = out_lr[read_n - 2];
-        int16_t last_r = out_lr[read_n - 1];
-        for (uint32_t i = read_n; i < need; i += 2) {
-            out_lr[i]     = last_l;
-            out_lr[i + 1] = last_r;
-        }
-        __sync_synchronize();
-        slot->read_pos = rp + read_n;
-    } else {
-        for (uint32_t i = 0; i < need; i++) {
-            out_lr[i] = slot->ring[(rp + i) & LINK_AUDIO_IN_RING_MASK];
-        }
-        __sync_synchronize();
-        slot->read_pos = rp + need;
+void link_audio_get_drift_stats(int slot_idx, float *out_ppm, float *out_err_frames)
+{
+    float ppm = 0.0f, err = 0.0f;
+    if (slot_idx >= 0 && slot_idx < LINK_AUDIO_IN_SLOT_COUNT) {
+        __atomic_load(&la_drift_ppm[slot_idx], &ppm, __ATOMIC_RELAXED);
+        __atomic_load(&la_drift_err[slot_idx], &err, __ATOMIC_RELAXED);
     }
-    return 1;
+    if (out_ppm) *out_ppm = ppm;
+    if (out_err_frames) *out_err_frames = err;
 }
 
 void link_audio_drain_avail_stats(int slot_idx,
@@ -7,7 +7,8 @@
  *     and a few legacy gates)
  *   - shadow_slot_capture[] — per-slot post-FX buffer written by the
  *     render code and read by the publisher-SHM writer in schwung_shim.c
- *   - link_audio_read_channel_shm() — SPSC reader from /schwung-link-in
+ *   - link_audio_read_channel_shm() — SPSC reader from /schwung-link-in,
+ *     drift-compensated while latency comp is active
  */
 
 #ifndef SHADOW_LINK_AUDIO_H
@@ -39,17 +40,22 @@ void link_audio_reset_state(void);
 int link_audio_read_channel_shm(link_audio_in_shm_t *shm, int slot_idx,
                                 int16_t *out_lr, int frames);
 
-/* Latency compensation target — the steady-state ring fill we nudge toward
+/* Latency compensation target — the steady-state ring fill we steer toward
  * when `latency_comp_active` is set. 800 stereo samples ≈ 9.07 ms at
  * 44.1 kHz, chosen from on-device measurement: organically settled means
  * range 8–14 ms with worst-case bursts to ~18 ms, so 9 ms is below average
  * (saves latency) and well above producer jitter floor (~3 ms). */
 #define LATENCY_COMP_TARGET_SAMPLES 800
 
-/* Reset the nudge counters used by link_audio_read_channel_shm. Called
- * when latency comp engages so the first window of correction starts
- * from a known state. */
-void link_audio_reset_nudge_state(void);
+/* Reset the per-slot drift controllers used by link_audio_read_channel_shm
+ * (see shadow_drift.h). Called when latency comp engages so correction
+ * starts from a known state. */
+void link_audio_reset_drift_state(void);
+
+/* Current drift compensation for one slot: resampling ratio offset in ppm
+ * (positive = reading faster than 1:1) and the low-passed fill error in
+ * frames. Both 0 while latency comp is off. Informational only. */
+void link_audio_get_drift_stats(int slot_idx, float *out_ppm, float *out_err_frames);
 
 /* Drain shim-local read-time `avail` statistics for one slot (min/max/sum/
  * count over the window since the last drain). Used by the background
@@ -6,6 +6,7 @@
 #include <unistd.h>
 #include "shadow_midi.h"
 #include "shadow_chain_mgmt.h"
+#include "shadow_midi_timing.h"
 #include "shadow_led_queue.h"
 #include "shadow_overlay.h"  /* MIDI channel indicator globals */
 
@@ -48,9 +49,12 @@ static void canonicalize_for_ring(uint8_t *status, uint8_t *d1, uint8_t *d2)
     }
 }
 
+static void midi_route_refresh(void);
+
 void shadow_external_dispatch_tick(void)
 {
     g_dispatched_ext_tick++;
+    midi_route_refresh();
 }
 
 void shadow_external_dispatch_record(uint8_t status, uint8_t d1, uint8_t d2)
@@ -146,6 +150,7 @@ static void (*host_ui_state_update_slot)(int slot);
 static void (*host_master_fx_forward_midi)(const uint8_t *msg, int len, int source);
 static void (*host_queue_led)(uint8_t cin, uint8_t status, uint8_t d1, uint8_t d2);
 static void (*host_init_led_queue)(void);
+static move_plugin_on_midi_timed_fn *host_chain_on_midi_timed;
 
 /* Shared state pointers */
 static shadow_chain_slot_t *host_chain_slots;
@@ -181,6 +186,7 @@ void midi_routing_init(const midi_host_t *host)
     host_master_fx_forward_midi = host->master_fx_forward_midi;
     host_queue_led = host->queue_led;
     host_init_led_queue = host->init_led_queue;
+    host_chain_on_midi_timed = host->chain_on_midi_timed;
     host_chain_slots = host->chain_slots;
     host_plugin_v2 = host->plugin_v2;
     host_shadow_control = host->shadow_control;
@@ -200,6 +206,7 @@ void midi_routing_init(const midi_host_t *host)
     host_slot_fx_silence_frames = host->slot_fx_silence_frames;
 
     shadow_chain_transpose_reset();
+    midi_route_refresh();
 }
 
 /* ============================================================================
@@ -247,14 +254,13 @@ static void shadow_chain_transpose_reset(void)
  * all other channel-voice messages pass through unchanged.
  * Returns 1 if the message should be dispatched, 0 if a note-on would fall
  * outside 0-127 (and must be dropped without registering as held). */
-static int shadow_chain_apply_transpose(int slot, uint8_t *msg)
+static int shadow_chain_apply_transpose(int slot, int transpose, uint8_t *msg)
 {
     uint8_t type = msg[0] & 0xF0;
     if (type != 0x80 && type != 0x90 && type != 0xA0) return 1;
 
     uint8_t ch = msg[0] & 0x0F;
     uint8_t orig = msg[1];
-    int transpose = host_chain_slots[slot].transpose;
 
     /* Note-on with velocity > 0: apply current transpose and remember it. */
     if (type == 0x90 && msg[2] > 0) {
@@ -295,6 +301,159 @@ static int shadow_chain_apply_transpose(int slot, uint8_t *msg)
     return 1;
 }
 
+/* ============================================================================
+ * Routing table
+ * ============================================================================ */
+
+/* Slot config flattened into per-channel bitmasks, so dispatching an event
+ * is a couple of lookups instead of a walk over every slot's config.
+ * shadow_external_dispatch_tick() compares the live config with the key the
+ * current table was built from once per frame. Only a change rebuilds it,
+ * into the spare table, which is then published by pointer swap. A dispatch
+ * never sees a half-built table. */
+typedef struct {
+    int channel;
+    int forward_channel;
+    int transpose;
+    int active;
+    void *instance;
+} midi_route_key_t;
+
+typedef struct {
+    uint8_t ch_slots[16];       /* slots receiving each channel (incl. All) */
+    uint8_t direct_slots;       /* receive=All + forward=THRU, fed from MIDI_IN */
+    uint8_t active_slots;
+    uint8_t broadcast_slots;    /* active with an instance: audio FX broadcast */
+    uint8_t probe_slots;        /* instance but not active: lazy activation */
+    int8_t out_channel[SHADOW_CHAIN_INSTANCES];  /* -1 = keep the channel */
+    int8_t transpose[SHADOW_CHAIN_INSTANCES];
+    midi_route_key_t key[SHADOW_CHAIN_INSTANCES];
+} midi_route_table_t;
+
+static midi_route_table_t g_route_tables[2];
+static midi_route_table_t *g_route = NULL;
+
+/* Lazy activation probes call get_param with strings; a slot that comes up
+ * empty isn't probed again for this many frames (~23ms) */
+#define ROUTE_PROBE_INTERVAL_TICKS 8
+static uint32_t g_route_next_probe[SHADOW_CHAIN_INSTANCES];
+
+static void midi_route_read_keys(midi_route_key_t *key)
+{
+    memset(key, 0, sizeof(midi_route_key_t) * SHADOW_CHAIN_INSTANCES);
+    for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) {
+        key[i].channel = host_chain_slots[i].channel;
+        key[i].forward_channel = host_chain_slots[i].forward_channel;
+        key[i].transpose = host_chain_slots[i].transpose;
+        key[i].active = host_chain_slots[i].active;
+        key[i].instance = host_chain_slots[i].instance;
+    }
+}
+
+static void midi_route_build(midi_route_table_t *t, const midi_route_key_t *key)
+{
+    memset(t, 0, sizeof(*t));
+    memcpy(t->key, key, sizeof(t->key));
+    for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) {
+        const midi_route_key_t *k = &key[i];
+        uint8_t bit = (uint8_t)(1u << i);
+
+        if (k->channel == -1) {
+            for (int c = 0; c < 16; c++) t->ch_slots[c] |= bit;
+        } else if (k->channel >= 0 && k->channel <= 15) {
+            t->ch_slots[k->channel] |= bit;
+        }
+        if (k->channel == -1 && k->forward_channel == -2) t->direct_slots |= bit;
+        if (k->active) t->active_slots |= bit;
+        if (k->active && k->instance) t->broadcast_slots |= bit;
+        if (!k->active && k->instance) t->probe_slots |= bit;
+
+        /* Same rules as shadow_chain_remap_channel() */
+        if (k->forward_channel == -2) t->out_channel[i] = -1;
+        else if (k->forward_channel >= 0 && k->forward_channel <= 15) t->out_channel[i] = (int8_t)k->forward_channel;
+        else t->out_channel[i] = k->channel < 0 ? -1 : (int8_t)k->channel;
+
+        t->transpose[i] = (int8_t)k->transpose;
+    }
+}
+
+static void midi_route_publish(const midi_route_key_t *key)
+{
+    midi_route_table_t *next = (g_route == &g_route_tables[0]) ? &g_route_tables[1] : &g_route_tables[0];
+    midi_route_build(next, key);
+    __atomic_store_n(&g_route, next, __ATOMIC_RELEASE);
+    /* Config changed: give newly loaded slots a probe right away */
+    for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) g_route_next_probe[i] = g_dispatched_ext_tick;
+}
+
+static void midi_route_refresh(void)
+{
+    if (!host_chain_slots) return;
+    midi_route_key_t key[SHADOW_CHAIN_INSTANCES];
+    midi_route_read_keys(key);
+    if (g_route && memcmp(key, g_route->key, sizeof(key)) == 0) return;
+    midi_route_publish(key);
+}
+
+static inline const midi_route_table_t *midi_route(void)
+{
+    return __atomic_load_n(&g_route, __ATOMIC_ACQUIRE);
+}
+
+/* Lazy activation: any loaded component (synth, audio FX, or MIDI FX) is
+ * enough. MIDI-FX-only slots in Pre mode have no synth or audio FX but
+ * still need incoming MIDI to drive the FX and inject to Move. Returns 1 if
+ * the slot is active now. */
+static int midi_route_probe(const plugin_api_v2_t *pv2, int slot)
+{
+    if ((int32_t)(g_dispatched_ext_tick - g_route_next_probe[slot]) < 0) return 0;
+    g_route_next_probe[slot] = g_dispatched_ext_tick + ROUTE_PROBE_INTERVAL_TICKS;
+    if (!pv2 || !pv2->get_param || !host_chain_slots[slot].instance) return 0;
+
+    static const char *probe_keys[] = {
+        "synth_module", "fx1_module", "fx2_module",
+        "midi_fx1_module", "midi_fx2_module"
+    };
+    for (size_t k = 0; k < sizeof(probe_keys)/sizeof(probe_keys[0]); k++) {
+        char buf[64];
+        int len = pv2->get_param(host_chain_slots[slot].instance,
+                                  probe_keys[k], buf, sizeof(buf));
+        if (len <= 0) continue;
+        if (len < (int)sizeof(buf)) buf[len] = '\0';
+        else buf[sizeof(buf) - 1] = '\0';
+        if (buf[0] != '\0') {
+            host_chain_slots[slot].active = 1;
+            if (host_ui_state_update_slot)
+                host_ui_state_update_slot(slot);
+            midi_route_refresh();
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Wake slot from idle on any MIDI dispatch */
+static inline void midi_route_wake(int slot)
+{
+    if (host_slot_idle[slot] || host_slot_fx_idle[slot]) {
+        host_slot_idle[slot] = 0;
+        host_slot_silence_frames[slot] = 0;
+        host_slot_fx_idle[slot] = 0;
+        host_slot_fx_silence_frames[slot] = 0;
+    }
+}
+
+/* Active slots among `slots`, probing inactive ones that have an instance */
+static uint8_t midi_route_active(const plugin_api_v2_t *pv2, uint8_t slots)
+{
+    const midi_route_table_t *rt = midi_route();
+    uint8_t probe = slots & rt->probe_slots;
+    for (int i = 0; probe; i++, probe >>= 1) {
+        if (probe & 1) midi_route_probe(pv2, i);
+    }
+    return slots & midi_route()->active_slots;
+}
+
 /* ============================================================================
  * MIDI dispatch to chain slots
  * ============================================================================ */
@@ -329,60 +488,26 @@ void shadow_chain_dispatch_midi_to_slots(const uint8_t *pkt, int log_on, int *mi
         midi_indicator_active_notes = 0;
     }
 
-    for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) {
-        /* Skip direct-dispatch slots when processing MIDI_OUT.
-         * These slots get MIDI from MIDI_IN directly to preserve
-         * original channels for MPE. */
-        if (skip_direct &&
-            host_chain_slots[i].channel == -1 &&
-            host_chain_slots[i].forward_channel == -2)
-            continue;
+    const midi_route_table_t *rt = midi_route();
+    if (!rt) return;
 
-        /* Check channel match: slot receives this channel, or slot is set to All (-1) */
-        if (host_chain_slots[i].channel != (int)midi_ch && host_chain_slots[i].channel != -1)
-            continue;
+    /* Skip direct-dispatch slots when processing MIDI_OUT.
+     * These slots get MIDI from MIDI_IN directly to preserve
+     * original channels for MPE. */
+    uint8_t slots = rt->ch_slots[midi_ch];
+    if (skip_direct) slots &= (uint8_t)~rt->direct_slots;
+    slots = midi_route_active(pv2, slots);
+    rt = midi_route();
 
-        /* Lazy activation check — any loaded component (synth, audio FX,
-         * or MIDI FX) is enough to activate. MIDI-FX-only slots in Pre
-         * mode have no synth or audio FX but still need to dispatch
-         * incoming MIDI to drive the FX and inject to Move. */
-        if (!host_chain_slots[i].active) {
-            if (pv2 && pv2->get_param &&
-                host_chain_slots[i].instance) {
-                static const char *probe_keys[] = {
-                    "synth_module", "fx1_module", "fx2_module",
-                    "midi_fx1_module", "midi_fx2_module"
-                };
-                for (size_t k = 0; k < sizeof(probe_keys)/sizeof(probe_keys[0]); k++) {
-                    char buf[64];
-                    int len = pv2->get_param(host_chain_slots[i].instance,
-                                              probe_keys[k], buf, sizeof(buf));
-                    if (len <= 0) continue;
-                    if (len < (int)sizeof(buf)) buf[len] = '\0';
-                    else buf[sizeof(buf) - 1] = '\0';
-                    if (buf[0] != '\0') {
-                        host_chain_slots[i].active = 1;
-                        if (host_ui_state_update_slot)
-                            host_ui_state_update_slot(i);
-                        break;
-                    }
-                }
-            }
-            if (!host_chain_slots[i].active) continue;
-        }
-
-        /* Wake slot from idle on any MIDI dispatch */
-        if (host_slot_idle[i] || host_slot_fx_idle[i]) {
-            host_slot_idle[i] = 0;
-            host_slot_silence_frames[i] = 0;
-            host_slot_fx_idle[i] = 0;
-            host_slot_fx_silence_frames[i] = 0;
-        }
+    for (int i = 0; slots; i++, slots >>= 1) {
+        if (!(slots & 1)) continue;
+        midi_route_wake(i);
 
         /* Send MIDI to this slot */
         if (pv2 && pv2->on_midi) {
-            uint8_t msg[3] = { shadow_chain_remap_channel(i, pkt[1]), pkt[2], pkt[3] };
-            if (shadow_chain_apply_transpose(i, msg)) {
+            uint8_t st = rt->out_channel[i] < 0 ? pkt[1] : (uint8_t)((pkt[1] & 0xF0) | rt->out_channel[i]);
+            uint8_t msg[3] = { st, pkt[2], pkt[3] };
+            if (shadow_chain_apply_transpose(i, rt->transpose[i], msg)) {
                 pv2->on_midi(host_chain_slots[i].instance, msg, 3,
                              MOVE_MIDI_SOURCE_EXTERNAL);
             }
@@ -394,9 +519,9 @@ void shadow_chain_dispatch_midi_to_slots(const uint8_t *pkt, int log_on, int *mi
      * FX_BROADCAST only forwards to audio FX, not synth/MIDI FX, so this
      * is safe even for slots that already received normal MIDI dispatch. */
     if (pv2 && pv2->on_midi) {
-        for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) {
-            if (!host_chain_slots[i].active || !host_chain_slots[i].instance)
-                continue;
+        uint8_t bc = rt->broadcast_slots;
+        for (int i = 0; bc; i++, bc >>= 1) {
+            if (!(bc & 1)) continue;
             uint8_t msg[3] = { pkt[1], pkt[2], pkt[3] };
             pv2->on_midi(host_chain_slots[i].instance, msg, 3,
                          MOVE_MIDI_SOURCE_FX_BROADCAST);
@@ -671,9 +796,13 @@ void shadow_drain_midi_inject(void)
  * won't reach track instruments for pitched notes.
  *
  * The drain rate-limits to 8 packets/tick; callers should not burst more
- * than that per render block. Same-thread as the drain (both run in the
- * shim's SPI loop), so no extra synchronization is needed beyond the
- * existing ring pattern. */
+ * than that per render block. The drain runs on the SPI thread, but with
+ * the render pool enabled several slots may inject concurrently from
+ * worker threads during the render fan-out, so writers serialize on a
+ * spinlock. Render and drain never overlap (the pool joins before the
+ * SPI thread returns), so the drain itself needs no lock. */
+static volatile int chain_midi_inject_lock = 0;
+
 int shadow_chain_midi_inject(const uint8_t *msg, int len)
 {
     if (!msg || len != 4) return 0;
@@ -681,8 +810,11 @@ int shadow_chain_midi_inject(const uint8_t *msg, int len)
     shadow_midi_inject_t *shm = *host_shadow_midi_inject_shm;
     if (!shm) return 0;
 
+    while (__sync_lock_test_and_set(&chain_midi_inject_lock, 1)) { }
+
     int wr = shm->write_idx;
     if (wr + 4 > (int)SHADOW_MIDI_INJECT_BUFFER_SIZE) {
+        __sync_lock_release(&chain_midi_inject_lock);
         if (host_log) {
             char dbg[96];
             uint8_t type = msg[1] & 0xF0;
@@ -698,6 +830,7 @@ int shadow_chain_midi_inject(const uint8_t *msg, int len)
     shm->write_idx = (uint8_t)(wr + 4);
     __sync_synchronize();
     shm->ready++;
+    __sync_lock_release(&chain_midi_inject_lock);
     return 4;
 }
 
@@ -749,6 +882,35 @@ void shadow_drain_ui_midi_dsp(void)
  * Direct external MIDI dispatch (MPE passthrough)
  * ============================================================================ */
 
+/* ============================================================================
+ * Timestamped external MIDI
+ * ============================================================================ */
+
+/* One XMOS clock stamps all of MIDI_IN, so both cable-2 dispatchers share
+ * the estimator. Events are seen one SPI frame after they happened. */
+static midi_ts_clock_t g_ext_ts_clock;
+
+/* Sample offset for the cable-2 event at `ev` (8 bytes), or 0 when timed
+ * delivery is off or the event carries no timestamp */
+static int ext_event_offset(const uint8_t *ev)
+{
+    if (!host_chain_on_midi_timed || !*host_chain_on_midi_timed) return 0;
+    uint32_t ts;
+    memcpy(&ts, ev + 4, sizeof(ts));
+    if (ts == 0) return 0;
+    return midi_ts_clock_offset(&g_ext_ts_clock, ts, g_dispatched_ext_tick, MOVE_FRAMES_PER_BLOCK);
+}
+
+/* on_midi, or the timed variant when the event has an offset */
+static void ext_slot_on_midi(const plugin_api_v2_t *pv2, void *instance,
+                             const uint8_t *msg, int offset)
+{
+    if (offset > 0)
+        (*host_chain_on_midi_timed)(instance, msg, 3, MOVE_MIDI_SOURCE_EXTERNAL, offset);
+    else
+        pv2->on_midi(instance, msg, 3, MOVE_MIDI_SOURCE_EXTERNAL);
+}
+
 /* Dispatch external MIDI from MIDI_IN cable 2 directly to slots configured
  * for passthrough (receive=All, forward=THRU).  This bypasses Move's MIDI_OUT
  * so that notes and per-note expression data (pitch bend, CC, aftertouch)
@@ -761,15 +923,7 @@ void shadow_dispatch_direct_external_midi(void)
     if (!pv2 || !pv2->on_midi) return;
 
     /* Check whether any slot qualifies for direct dispatch. */
-    int has_direct = 0;
-    for (int i = 0; i < SHADOW_CHAIN_INSTANCES; i++) {
-        if (host_chain_slots[i].channel == -1 &&
-            host_chain_slots[i].forward_channel == -2) {
-            has_direct = 1;
-            break;
-        }
-    }
-    if (!has_direct) return;
+    if (!midi_route() || !midi_route()->direct_slots) return;
 
     uint8_t *in_src = *host_global_mmap_addr + MIDI_IN_OFFSET;
 
@@ -812,51 +966,26 @@ void shadow_dispatch_direct_external_midi(void)
          * identify them even after the MIDI_IN slot has been reused. */
         shadow_external_dispatch_record(status, d1, d2);
 
-        /* Dispatch to qualifying slots: receive=All, forward=THRU */
-        for (int s = 0; s < SHADOW_CHAIN_INSTANCES; s++) {
-            if (host_chain_slots[s].channel != -1 ||
-                host_chain_slots[s].forward_channel != -2)
-                continue;
+        int offset = ext_event_offset(&in_src[i]);
 
-            /* Lazy activation (same logic as main dispatch) */
-            if (!host_chain_slots[s].active) {
-                if (host_chain_slots[s].instance) {
-                    char buf[64];
-                    int len = pv2->get_param(host_chain_slots[s].instance,
-                                              "synth_module", buf, sizeof(buf));
-                    if (len > 0) {
-                        if (len < (int)sizeof(buf)) buf[len] = '\0';
-                        else buf[sizeof(buf) - 1] = '\0';
-                        if (buf[0] != '\0') {
-                            host_chain_slots[s].active = 1;
-                            if (host_ui_state_update_slot)
-                                host_ui_state_update_slot(s);
-                        }
-                    }
-                }
-                if (!host_chain_slots[s].active) continue;
-            }
-
-            /* Wake from idle */
-            if (host_slot_idle[s] || host_slot_fx_idle[s]) {
-                host_slot_idle[s] = 0;
-                host_slot_silence_frames[s] = 0;
-                host_slot_fx_idle[s] = 0;
-                host_slot_fx_silence_frames[s] = 0;
-            }
+        /* Dispatch to qualifying slots: receive=All, forward=THRU */
+        uint8_t slots = midi_route_active(pv2, midi_route()->direct_slots);
+        const midi_route_table_t *rt = midi_route();
+        for (int s = 0; slots; s++, slots >>= 1) {
+            if (!(slots & 1)) continue;
+            midi_route_wake(s);
 
             /* Send with original channel preserved (THRU mode) */
             uint8_t msg[3] = { status, d1, d2 };
-            if (shadow_chain_apply_transpose(s, msg)) {
-                pv2->on_midi(host_chain_slots[s].instance, msg, 3,
-                             MOVE_MIDI_SOURCE_EXTERNAL);
+            if (shadow_chain_apply_transpose(s, rt->transpose[s], msg)) {
+                ext_slot_on_midi(pv2, host_chain_slots[s].instance, msg, offset);
             }
         }
 
         /* Broadcast to audio FX on all active slots */
-        for (int s = 0; s < SHADOW_CHAIN_INSTANCES; s++) {
-            if (!host_chain_slots[s].active || !host_chain_slots[s].instance)
-                continue;
+        uint8_t bc = rt->broadcast_slots;
+        for (int s = 0; bc; s++, bc >>= 1) {
+            if (!(bc & 1)) continue;
             uint8_t msg[3] = { status, d1, d2 };
             pv2->on_midi(host_chain_slots[s].instance, msg, 3,
                          MOVE_MIDI_SOURCE_FX_BROADCAST);
@@ -881,7 +1010,7 @@ void shadow_dispatch_cable2_channeled_slots(void)
     if (!*host_shadow_inprocess_ready || !*host_global_mmap_addr) return;
 
     const plugin_api_v2_t *pv2 = *host_plugin_v2;
-    if (!pv2 || !pv2->on_midi) return;
+    if (!pv2 || !pv2->on_midi || !midi_route()) return;
 
     uint8_t *in_src = *host_global_mmap_addr + MIDI_IN_OFFSET;
 
@@ -919,48 +1048,21 @@ void shadow_dispatch_cable2_channeled_slots(void)
          * identify them even after the MIDI_IN slot has been reused. */
         shadow_external_dispatch_record(status, d1, d2);
 
+        int offset = ext_event_offset(&in_src[i]);
         uint8_t in_ch = status & 0x0F;
 
-        for (int s = 0; s < SHADOW_CHAIN_INSTANCES; s++) {
-            int slot_ch = host_chain_slots[s].channel;
-
-            /* Skip THRU slots — already handled by shadow_dispatch_direct_external_midi */
-            if (slot_ch == -1 && host_chain_slots[s].forward_channel == -2) continue;
-
-            /* Channel filter: -1 = receive all; >= 0 = specific channel */
-            if (slot_ch >= 0 && slot_ch != (int)in_ch) continue;
-
-            /* Lazy activation */
-            if (!host_chain_slots[s].active) {
-                if (host_chain_slots[s].instance) {
-                    char buf[64];
-                    int len = pv2->get_param(host_chain_slots[s].instance,
-                                              "synth_module", buf, sizeof(buf));
-                    if (len > 0) {
-                        if (len < (int)sizeof(buf)) buf[len] = '\0';
-                        else buf[sizeof(buf) - 1] = '\0';
-                        if (buf[0] != '\0') {
-                            host_chain_slots[s].active = 1;
-                            if (host_ui_state_update_slot)
-                                host_ui_state_update_slot(s);
-                        }
-                    }
-                }
-                if (!host_chain_slots[s].active) continue;
-            }
-
-            /* Wake from idle */
-            if (host_slot_idle[s] || host_slot_fx_idle[s]) {
-                host_slot_idle[s]          = 0;
-                host_slot_silence_frames[s] = 0;
-                host_slot_fx_idle[s]        = 0;
-                host_slot_fx_silence_frames[s] = 0;
-            }
+        /* Channel filter, skipping THRU slots — already handled by
+         * shadow_dispatch_direct_external_midi */
+        const midi_route_table_t *rt = midi_route();
+        uint8_t slots = midi_route_active(pv2, rt->ch_slots[in_ch] & (uint8_t)~rt->direct_slots);
+        rt = midi_route();
+        for (int s = 0; slots; s++, slots >>= 1) {
+            if (!(slots & 1)) continue;
+            midi_route_wake(s);
 
             uint8_t msg[3] = { status, d1, d2 };
-            if (shadow_chain_apply_transpose(s, msg))
-                pv2->on_midi(host_chain_slots[s].instance, msg, 3,
-                             MOVE_MIDI_SOURCE_EXTERNAL);
+            if (shadow_chain_apply_transpose(s, rt->transpose[s], msg))
+                ext_slot_on_midi(pv2, host_chain_slots[s].instance, msg, offset);
         }
     }
 }
@@ -74,6 +74,9 @@ typedef struct {
     void (*master_fx_forward_midi)(const uint8_t *msg, int len, int source);
     void (*queue_led)(uint8_t cin, uint8_t status, uint8_t d1, uint8_t d2);
     void (*init_led_queue)(void);
+    /* Chain's timed MIDI entry point; NULL dispatches external MIDI at the
+     * block start (sample_accurate_midi off) */
+    move_plugin_on_midi_timed_fn *chain_on_midi_timed;
     /* Shared state */
     shadow_chain_slot_t *chain_slots;
     const plugin_api_v2_t *volatile *plugin_v2;
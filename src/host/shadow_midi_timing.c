@@ -0,0 +1,119 @@
+/* shadow_midi_timing.c - Sample offsets for timestamped MIDI_IN events
+ * See shadow_midi_timing.h for the estimator. */
+
+#include <math.h>
+#include <string.h>
+
+#include "shadow_midi_timing.h"
+
+#define CALIB_BLOCKS 344            /* ~1s at 128 frames / 44.1kHz */
+#define CALIB_EVENTS 8
+#define MAX_TS_STEP (1 << 30)       /* a bigger jump means the clock reset */
+
+void midi_ts_clock_reset(midi_ts_clock_t *c)
+{
+    memset(c, 0, sizeof(*c));
+}
+
+static void anchor(midi_ts_clock_t *c, uint32_t ts, uint32_t block)
+{
+    midi_ts_clock_reset(c);
+    c->state = 1;
+    c->anchor_block = block;
+    c->last_ts = ts;
+    c->n = 1;
+    c->hull_count = 1;   /* (0, 0) */
+}
+
+static double edge_slope(const midi_ts_clock_t *c, int i)
+{
+    return (c->hull_y[i + 1] - c->hull_y[i]) / (c->hull_x[i + 1] - c->hull_x[i]);
+}
+
+/* Monotone chain: x never decreases, so a new point only ever pops
+ * vertices off the right end */
+static void hull_push(midi_ts_clock_t *c, double x, double y)
+{
+    int n = c->hull_count;
+    if (n > 0 && x == c->hull_x[n - 1]) {
+        if (y <= c->hull_y[n - 1]) return;
+        n--;
+    }
+    while (n >= 2) {
+        double cross = (c->hull_x[n - 1] - c->hull_x[n - 2]) * (y - c->hull_y[n - 2]) -
+                       (c->hull_y[n - 1] - c->hull_y[n - 2]) * (x - c->hull_x[n - 2]);
+        if (cross < 0.0) break;
+        n--;
+    }
+    if (n == MIDI_TS_HULL_POINTS) {
+        memmove(c->hull_x, c->hull_x + 1, (n - 1) * sizeof(double));
+        memmove(c->hull_y, c->hull_y + 1, (n - 1) * sizeof(double));
+        n--;
+    }
+    c->hull_x[n] = x;
+    c->hull_y[n] = y;
+    c->hull_count = n + 1;
+}
+
+int midi_ts_clock_offset(midi_ts_clock_t *c, uint32_t ts, uint32_t block, int frames)
+{
+    if (c->state == 0) {
+        anchor(c, ts, block);
+        return 0;
+    }
+
+    /* Timestamps only move forward; anything else is a new clock */
+    int32_t step = (int32_t)(ts - c->last_ts);
+    if (step < 0 || step > MAX_TS_STEP) {
+        anchor(c, ts, block);
+        return 0;
+    }
+    c->last_ts = ts;
+    c->ts += step;
+
+    /* Welford-style update of the fit; stays exact with large x and y */
+    uint32_t span = block - c->anchor_block;
+    double x = (double)span, y = (double)c->ts;
+    c->n += 1.0;
+    double dx = x - c->mean_x;
+    c->mean_x += dx / c->n;
+    c->mean_y += (y - c->mean_y) / c->n;
+    c->sxx += dx * (x - c->mean_x);
+    c->sxy += dx * (y - c->mean_y);
+
+    hull_push(c, x, y);
+
+    if (c->state == 1) {
+        if (span < CALIB_BLOCKS || c->n < CALIB_EVENTS || c->sxx <= 0.0) return 0;
+        c->state = 2;
+    }
+
+    double rate = c->sxy / c->sxx;
+    if (rate <= 0.0 || c->hull_count < 2) {
+        anchor(c, ts, block);
+        return 0;
+    }
+
+    /* Hull edge slopes fall from left to right. Find the vertex where they
+     * cross the fitted rate and take the longer of its two edges. */
+    int v = c->hull_count - 1;
+    for (int i = 0; i < c->hull_count - 1; i++) {
+        if (edge_slope(c, i) < rate) { v = i; break; }
+    }
+    int e;
+    if (v == 0) e = 0;
+    else if (v == c->hull_count - 1) e = v - 1;
+    else e = (c->hull_x[v] - c->hull_x[v - 1] > c->hull_x[v + 1] - c->hull_x[v]) ? v - 1 : v;
+    double slope = edge_slope(c, e);
+    /* An edge that disagrees with the fit is too short to trust yet */
+    if (!(slope > 0.0) || fabs(slope - rate) > 0.01 * rate) slope = rate;
+
+    /* Boundary line through the hull vertex; measured from there, x and y
+     * stay small enough for full double precision */
+    double top = (y - c->hull_y[v]) - slope * (x - c->hull_x[v]);
+    double pos = (top + slope) / slope;
+    int off = (int)(pos * frames);
+    if (off < 0) off = 0;
+    if (off >= frames) off = frames - 1;
+    return off;
+}
@@ -0,0 +1,52 @@
+/* shadow_midi_timing.h - Sample offsets for timestamped MIDI_IN events
+ *
+ * MIDI_IN events carry a 32-bit XMOS timestamp, but the shim only sees
+ * them once per 128-frame block, so dispatching on arrival quantizes every
+ * event to a block boundary (up to 2.9ms of jitter). The timestamp clock's
+ * rate and its phase against the SPI block boundaries aren't documented,
+ * so midi_ts_clock_t learns both from the events themselves:
+ *
+ *   rate   ticks per block: the least-squares slope of timestamp against
+ *          arrival block. Where in its block an event happened is noise of
+ *          at most one block around that line, which averages out.
+ *   phase  events that happened just before a block boundary lie on the
+ *          upper convex hull of (block, ts). The hull edge whose slope
+ *          matches the fitted rate is the boundary line; its slope is also
+ *          a much tighter rate estimate than the fit once it is long.
+ *
+ * An event's offset is its position within the block before it arrived:
+ * delivering it at that offset in the next render gives a constant one
+ * block of latency instead of jitter. Until the clock is calibrated (about
+ * a second of events) offsets are 0, i.e. the old behaviour. With dense
+ * input (MIDI clock, a played part) nearly all events land within a couple
+ * of frames after ten seconds or so.
+ *
+ * Pure computation, no allocation: safe on the SPI thread. */
+
+#ifndef SHADOW_MIDI_TIMING_H
+#define SHADOW_MIDI_TIMING_H
+
+#include <stdint.h>
+
+#define MIDI_TS_HULL_POINTS 64
+
+typedef struct {
+    int state;               /* 0 = empty, 1 = anchored, 2 = calibrated */
+    uint32_t anchor_block;
+    uint32_t last_ts;
+    int64_t ts;              /* unwrapped timestamp of the last event, relative to the anchor */
+    /* Running least-squares fit of ts against block (relative to the anchor) */
+    double n, mean_x, mean_y, sxx, sxy;
+    /* Upper convex hull of (block, ts), oldest vertex first */
+    double hull_x[MIDI_TS_HULL_POINTS], hull_y[MIDI_TS_HULL_POINTS];
+    int hull_count;
+} midi_ts_clock_t;
+
+void midi_ts_clock_reset(midi_ts_clock_t *c);
+
+/* Offset in [0, frames) at which an event with XMOS timestamp `ts` that
+ * arrived in block number `block` should be rendered. `block` counts SPI
+ * frames and must advance by one per frame. */
+int midi_ts_clock_offset(midi_ts_clock_t *c, uint32_t ts, uint32_t block, int frames);
+
+#endif /* SHADOW_MIDI_TIMING_H */
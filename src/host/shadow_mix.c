@@ -0,0 +1,310 @@
+/* shadow_mix.c - Block mixing kernels for the shim audio path
+ *
+ * Each kernel has a scalar body that handles the whole block (and the tail
+ * after the NEON loop). The NEON bodies use FCVTAS (vcvtaq_s32_f32), which
+ * rounds half away from zero exactly like lroundf(), so both builds produce
+ * the same samples up to float contraction differences (<= 1 LSB). */
+
+#include <math.h>
+#include <stdint.h>
+
+#include "shadow_mix.h"
+
+#if SHADOW_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+const char *shadow_mix_impl(void)
+{
+    return SHADOW_MIX_NEON ? "neon" : "scalar";
+}
+
+void shadow_mix_add_sat_i16(int16_t *dst, const int16_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), vld1q_s16(src + i)));
+    }
+#endif
+    for (; i < n; i++) dst[i] = sat16((int32_t)dst[i] + (int32_t)src[i]);
+}
+
+#if SHADOW_MIX_NEON
+/* round(s * gain) for 8 int16 samples, returned as two int32x4 halves */
+static inline void neon_scale8(int16x8_t s, float32x4_t g, int32x4_t *lo, int32x4_t *hi)
+{
+    float32x4_t flo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+    float32x4_t fhi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+    *lo = vcvtaq_s32_f32(vmulq_f32(flo, g));
+    *hi = vcvtaq_s32_f32(vmulq_f32(fhi, g));
+}
+
+static inline int16x8_t neon_narrow_sat(int32x4_t lo, int32x4_t hi)
+{
+    return vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+}
+#endif
+
+void shadow_mix_add_gain_sat_i16(int16_t *dst, const int16_t *src, float gain, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t lo, hi;
+        neon_scale8(vld1q_s16(src + i), g, &lo, &hi);
+        int16x8_t d = vld1q_s16(dst + i);
+        lo = vaddw_s16(lo, vget_low_s16(d));
+        hi = vaddw_s16(hi, vget_high_s16(d));
+        vst1q_s16(dst + i, neon_narrow_sat(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = sat16((int32_t)dst[i] + (int32_t)lroundf((float)src[i] * gain));
+    }
+}
+
+void shadow_mix_scale_i16(int16_t *dst, const int16_t *src, float gain, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t lo, hi;
+        neon_scale8(vld1q_s16(src + i), g, &lo, &hi);
+        vst1q_s16(dst + i, neon_narrow_sat(lo, hi));
+    }
+#endif
+    for (; i < n; i++) dst[i] = sat16((int32_t)lroundf((float)src[i] * gain));
+}
+
+void shadow_mix_add_i32(int32_t *dst, const int32_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(dst + i, vaddq_s32(vld1q_s32(dst + i), vld1q_s32(src + i)));
+    }
+#endif
+    for (; i < n; i++) dst[i] += src[i];
+}
+
+void shadow_mix_add_i16_to_i32(int32_t *dst, const int16_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(src + i);
+        vst1q_s32(dst + i, vaddw_s16(vld1q_s32(dst + i), vget_low_s16(v)));
+        vst1q_s32(dst + i + 4, vaddw_s16(vld1q_s32(dst + i + 4), vget_high_s16(v)));
+    }
+#endif
+    for (; i < n; i++) dst[i] += src[i];
+}
+
+void shadow_mix_add_i32_sat_i16(int16_t *dst, const int32_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t d = vld1q_s16(dst + i);
+        int32x4_t lo = vqaddq_s32(vmovl_s16(vget_low_s16(d)), vld1q_s32(src + i));
+        int32x4_t hi = vqaddq_s32(vmovl_s16(vget_high_s16(d)), vld1q_s32(src + i + 4));
+        vst1q_s16(dst + i, neon_narrow_sat(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        int64_t v = (int64_t)dst[i] + (int64_t)src[i];
+        dst[i] = (v > 32767) ? 32767 : (v < -32768) ? -32768 : (int16_t)v;
+    }
+}
+
+void shadow_mix_clamp_i32_to_i16(int16_t *dst, const int32_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(dst + i, neon_narrow_sat(vld1q_s32(src + i), vld1q_s32(src + i + 4)));
+    }
+#endif
+    for (; i < n; i++) dst[i] = sat16(src[i]);
+}
+
+/* Fade gain after k frames (closed form of the per-frame step) */
+static inline float ramp_gain_at(float g0, float target, float step, int k)
+{
+    if (g0 < target) {
+        float g = g0 + step * (float)k;
+        return g > target ? target : g;
+    }
+    if (g0 > target) {
+        float g = g0 - step * (float)k;
+        return g < target ? target : g;
+    }
+    return g0;
+}
+
+void shadow_mix_ramp_scale_i32(int32_t *out, const int16_t *src, int frames,
+                               float vol, float *gain, float target, float step)
+{
+    float g0 = *gain;
+    int k = 0;
+
+    if (g0 == target) {
+        /* Steady state: plain scale, no envelope */
+        int i = 0;
+        int n = frames * 2;
+        float g = vol * g0;
+#if SHADOW_MIX_NEON
+        float32x4_t gv = vdupq_n_f32(g);
+        for (; i + 8 <= n; i += 8) {
+            int32x4_t lo, hi;
+            neon_scale8(vld1q_s16(src + i), gv, &lo, &hi);
+            vst1q_s32(out + i, lo);
+            vst1q_s32(out + i + 4, hi);
+        }
+#endif
+        for (; i < n; i++) out[i] = (int32_t)lroundf((float)src[i] * g);
+        return;
+    }
+
+#if SHADOW_MIX_NEON
+    /* Four frames (8 samples) per iteration; lanes carry g for L,R,L,R */
+    {
+        const float dir = (g0 < target) ? step : -step;
+        const float lane_k_lo[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        const float lane_k_hi[4] = { 2.0f, 2.0f, 3.0f, 3.0f };
+        float32x4_t klo = vld1q_f32(lane_k_lo);
+        float32x4_t khi = vld1q_f32(lane_k_hi);
+        float32x4_t tv = vdupq_n_f32(target);
+        float32x4_t vv = vdupq_n_f32(vol);
+        for (; k + 4 <= frames; k += 4) {
+            float32x4_t base = vdupq_n_f32((float)k);
+            float32x4_t glo = vaddq_f32(vdupq_n_f32(g0), vmulq_n_f32(vaddq_f32(base, klo), dir));
+            float32x4_t ghi = vaddq_f32(vdupq_n_f32(g0), vmulq_n_f32(vaddq_f32(base, khi), dir));
+            if (g0 < target) {
+                glo = vminq_f32(glo, tv);
+                ghi = vminq_f32(ghi, tv);
+            } else {
+                glo = vmaxq_f32(glo, tv);
+                ghi = vmaxq_f32(ghi, tv);
+            }
+            int16x8_t s = vld1q_s16(src + k * 2);
+            float32x4_t flo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+            float32x4_t fhi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+            vst1q_s32(out + k * 2, vcvtaq_s32_f32(vmulq_f32(flo, vmulq_f32(vv, glo))));
+            vst1q_s32(out + k * 2 + 4, vcvtaq_s32_f32(vmulq_f32(fhi, vmulq_f32(vv, ghi))));
+        }
+    }
+#endif
+    for (; k < frames; k++) {
+        float g = vol * ramp_gain_at(g0, target, step, k);
+        out[k * 2] = (int32_t)lroundf((float)src[k * 2] * g);
+        out[k * 2 + 1] = (int32_t)lroundf((float)src[k * 2 + 1] * g);
+    }
+
+    *gain = ramp_gain_at(g0, target, step, frames);
+}
+
+void shadow_mix_i16_to_f32(float *dst, const int16_t *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    float32x4_t s = vdupq_n_f32(1.0f / 32768.0f);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), s));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), s));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (float)src[i] * (1.0f / 32768.0f);
+}
+
+void shadow_mix_f32_to_i16(int16_t *dst, const float *src, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    float32x4_t s = vdupq_n_f32(32768.0f);
+    for (; i + 8 <= n; i += 8) {
+        /* vcvtq_s32_f32 truncates and saturates to int32, then narrow saturates */
+        int32x4_t lo = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i), s));
+        int32x4_t hi = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i + 4), s));
+        vst1q_s16(dst + i, neon_narrow_sat(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        float v = src[i] * 32768.0f;
+        if (v > 32767.0f) v = 32767.0f;
+        if (v < -32768.0f) v = -32768.0f;
+        dst[i] = (int16_t)v;
+    }
+}
+
+void shadow_mix_add_f32_gain_sat_i16(int16_t *dst, const float *src, float gain, int n)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t d = vld1q_s16(dst + i);
+        int32x4_t lo = vcvtaq_s32_f32(vmulq_f32(vld1q_f32(src + i), g));
+        int32x4_t hi = vcvtaq_s32_f32(vmulq_f32(vld1q_f32(src + i + 4), g));
+        lo = vqaddq_s32(lo, vmovl_s16(vget_low_s16(d)));
+        hi = vqaddq_s32(hi, vmovl_s16(vget_high_s16(d)));
+        vst1q_s16(dst + i, neon_narrow_sat(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        float v = src[i] * gain;
+        if (v > 65535.0f) v = 65535.0f;    /* keep lroundf in range */
+        if (v < -65536.0f) v = -65536.0f;
+        dst[i] = sat16((int32_t)dst[i] + (int32_t)lroundf(v));
+    }
+}
+
+int shadow_mix_peak_i16(const int16_t *src, int n)
+{
+    int i = 0;
+    int peak = 0;
+#if SHADOW_MIX_NEON
+    uint16x8_t m = vdupq_n_u16(0);
+    for (; i + 8 <= n; i += 8) {
+        /* vabsq_s16 wraps -32768; reinterpret as unsigned gives 32768 */
+        m = vmaxq_u16(m, vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(src + i))));
+    }
+    peak = vmaxvq_u16(m);
+#endif
+    for (; i < n; i++) {
+        int a = src[i] < 0 ? -(int)src[i] : src[i];
+        if (a > peak) peak = a;
+    }
+    return peak;
+}
+
+int shadow_mix_is_silent_i16(const int16_t *src, int n, int threshold)
+{
+    int i = 0;
+#if SHADOW_MIX_NEON
+    uint16x8_t t = vdupq_n_u16((uint16_t)threshold);
+    for (; i + 32 <= n; i += 32) {
+        uint16x8_t a0 = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(src + i)));
+        uint16x8_t a1 = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(src + i + 8)));
+        uint16x8_t a2 = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(src + i + 16)));
+        uint16x8_t a3 = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(src + i + 24)));
+        uint16x8_t m = vmaxq_u16(vmaxq_u16(a0, a1), vmaxq_u16(a2, a3));
+        if (vmaxvq_u16(vcgtq_u16(m, t))) return 0;
+    }
+#endif
+    for (; i < n; i++) {
+        if (src[i] > threshold || src[i] < -threshold) return 0;
+    }
+    return 1;
+}
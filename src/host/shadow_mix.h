@@ -0,0 +1,80 @@
+/* shadow_mix.h - Block mixing kernels for the shim audio path
+ *
+ * The SPI-path mix code (mix_from_buffer, render_to_buffer, the JACK
+ * bridge mix and preview playback) is a handful of primitive loops:
+ * saturating int16 adds, lroundf(x * gain) scaling, per-frame fade ramps,
+ * int16 <-> float conversion and silence detection. They live here once,
+ * as scalar loops the compiler can vectorise, plus NEON implementations
+ * for aarch64 that are off by default (see SHADOW_MIX_ENABLE_NEON).
+ *
+ * Conventions:
+ *   n       counts samples (interleaved stereo: 2 per frame)
+ *   frames  counts stereo frames
+ *   Scaling rounds half away from zero, matching lroundf().
+ *   Float samples use 1.0 == int16 full scale (sample / 32768).
+ *
+ * All kernels are allocation-free and safe to call from the SPI thread.
+ * Buffers need no particular alignment. */
+
+#ifndef SHADOW_MIX_H
+#define SHADOW_MIX_H
+
+#include <stdint.h>
+
+/* The NEON paths have not been run on a Move yet, so they are opt-in:
+ * build with -DSHADOW_MIX_ENABLE_NEON (and run test_mix_kernels.sh on the
+ * device) to use them. Scalar is the default everywhere. */
+#if defined(__aarch64__) && defined(__ARM_NEON) && defined(SHADOW_MIX_ENABLE_NEON)
+#define SHADOW_MIX_NEON 1
+#else
+#define SHADOW_MIX_NEON 0
+#endif
+
+/* Name of the compiled implementation ("neon" or "scalar"). */
+const char *shadow_mix_impl(void);
+
+/* dst[i] = sat16(dst[i] + src[i]) */
+void shadow_mix_add_sat_i16(int16_t *dst, const int16_t *src, int n);
+
+/* dst[i] = sat16(dst[i] + round(src[i] * gain)) */
+void shadow_mix_add_gain_sat_i16(int16_t *dst, const int16_t *src, float gain, int n);
+
+/* dst[i] = sat16(round(src[i] * gain)) — dst may alias src */
+void shadow_mix_scale_i16(int16_t *dst, const int16_t *src, float gain, int n);
+
+/* dst[i] += src[i] */
+void shadow_mix_add_i32(int32_t *dst, const int32_t *src, int n);
+
+/* dst[i] += src[i] (int16 into an int32 accumulator) */
+void shadow_mix_add_i16_to_i32(int32_t *dst, const int16_t *src, int n);
+
+/* dst[i] = sat16(dst[i] + src[i]) */
+void shadow_mix_add_i32_sat_i16(int16_t *dst, const int32_t *src, int n);
+
+/* dst[i] = sat16(src[i]) */
+void shadow_mix_clamp_i32_to_i16(int16_t *dst, const int32_t *src, int n);
+
+/* Fade-ramped scale of an interleaved stereo block:
+ *   out[2k+c] = round(src[2k+c] * vol * g_k)
+ * where g_k moves from *gain toward target by `step` per frame and stops
+ * at target (the shadow_fade_advance() envelope). *gain is updated to the
+ * value after the last frame. */
+void shadow_mix_ramp_scale_i32(int32_t *out, const int16_t *src, int frames,
+                               float vol, float *gain, float target, float step);
+
+/* dst[i] = src[i] / 32768 */
+void shadow_mix_i16_to_f32(float *dst, const int16_t *src, int n);
+
+/* dst[i] = sat16(src[i] * 32768) (truncating, as the float bus does) */
+void shadow_mix_f32_to_i16(int16_t *dst, const float *src, int n);
+
+/* dst[i] = sat16(dst[i] + round(src[i] * gain)) for float sources */
+void shadow_mix_add_f32_gain_sat_i16(int16_t *dst, const float *src, float gain, int n);
+
+/* Largest |src[i]| in the block (0..32768). */
+int shadow_mix_peak_i16(const int16_t *src, int n);
+
+/* 1 if every |src[i]| <= threshold. Exits at the first loud sample. */
+int shadow_mix_is_silent_i16(const int16_t *src, int n, int threshold);
+
+#endif /* SHADOW_MIX_H */
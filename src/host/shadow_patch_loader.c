@@ -0,0 +1,252 @@
+/* shadow_patch_loader.c - Background chain instance builder for patch loads
+ *
+ * Ownership protocol (per slot):
+ *   SPI thread   writes req_patch, then bumps req_seq (release) and kicks
+ *                the loader futex.
+ *   Loader       builds a result for the latest req_seq, re-checks req_seq
+ *                (a newer request discards the build) and publishes it by
+ *                atomic exchange into ready[slot]. Anything it displaces was
+ *                never seen by the SPI thread and is destroyed immediately.
+ *   SPI thread   takes ready[slot] by atomic exchange with NULL, swaps the
+ *                instance into the slot, then pushes the result (now holding
+ *                the old instance) onto the lock-free retire stack.
+ *   Loader       takes the whole stack at once and destroys retired
+ *                instances once the grace period elapsed. */
+
+#define _GNU_SOURCE
+#include <linux/futex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shadow_patch_loader.h"
+#include "shadow_bulk_thread.h"
+
+static patch_loader_host_t host;
+
+static pthread_t loader_thread;
+static volatile int loader_running = 0;
+
+/* Futex word: bumped by the SPI thread on every request/release. */
+static uint32_t loader_kick = 0;
+
+/* Per-slot request mailbox (written by SPI thread) */
+static uint32_t req_seq[SHADOW_CHAIN_INSTANCES];
+static int req_patch[SHADOW_CHAIN_INSTANCES];
+
+/* SPI-thread private: last request sequence taken or cancelled */
+static uint32_t taken_seq[SHADOW_CHAIN_INSTANCES];
+
+/* Loader-thread private: last request sequence built */
+static uint32_t built_seq[SHADOW_CHAIN_INSTANCES];
+
+/* Finished builds (atomic pointer swap) */
+static patch_loader_result_t *ready[SHADOW_CHAIN_INSTANCES];
+
+/* Retire stack: SPI thread pushes, loader takes all (intrusive, unbounded) */
+static patch_loader_result_t *retire_head = NULL;
+
+/* Loader-thread private: retirees waiting out the grace period */
+static patch_loader_result_t *retire_pending = NULL;
+
+static uint64_t loader_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static void loader_log(const char *msg)
+{
+    if (host.log) host.log(msg);
+}
+
+static void loader_kick_wake(void)
+{
+    __atomic_add_fetch(&loader_kick, 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &loader_kick, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static void loader_free_result(patch_loader_result_t *r)
+{
+    if (!r) return;
+    if (r->instance && host.destroy) host.destroy(r->instance);
+    free(r);
+}
+
+static void loader_build_slot(int slot, uint32_t seq)
+{
+    int patch_index = __atomic_load_n(&req_patch[slot], __ATOMIC_RELAXED);
+
+    if (patch_index < 0) {
+        /* Cancelled: drop any build that was waiting */
+        loader_free_result(__atomic_exchange_n(&ready[slot], NULL, __ATOMIC_ACQ_REL));
+        return;
+    }
+
+    patch_loader_result_t *r = calloc(1, sizeof(*r));
+    if (!r) return;
+    r->seq = seq;
+    r->slot = slot;
+    r->patch_index = patch_index;
+    r->receive_channel = -1;
+    r->forward_channel = PATCH_LOADER_CHANNEL_ABSENT;
+    r->default_forward_channel = PATCH_LOADER_CHANNEL_ABSENT;
+
+    uint64_t t0 = loader_now_ms();
+    r->ok = (host.build && host.build(slot, patch_index, r) == 0);
+    uint64_t took = loader_now_ms() - t0;
+
+    if (__atomic_load_n(&req_seq[slot], __ATOMIC_ACQUIRE) != seq) {
+        /* Superseded while building — the main loop rebuilds the latest. */
+        loader_free_result(r);
+        return;
+    }
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "Patch loader: slot %d patch %d %s in %llums (\"%s\")",
+             slot, patch_index, r->ok ? "built" : "FAILED",
+             (unsigned long long)took, r->patch_name);
+    loader_log(msg);
+
+    loader_free_result(__atomic_exchange_n(&ready[slot], r, __ATOMIC_ACQ_REL));
+}
+
+/* Destroy retired instances whose grace period has elapsed.
+ * Returns 1 if entries are still waiting. */
+static int loader_drain_retired(void)
+{
+    patch_loader_result_t *r = __atomic_exchange_n(&retire_head, NULL, __ATOMIC_ACQUIRE);
+    while (r) {
+        patch_loader_result_t *next = r->retire_next;
+        r->retire_next = retire_pending;
+        retire_pending = r;
+        r = next;
+    }
+
+    uint64_t now = loader_now_ms();
+    patch_loader_result_t **link = &retire_pending;
+    while (*link) {
+        r = *link;
+        if (now - r->retired_ms < PATCH_LOADER_RETIRE_GRACE_MS) {
+            link = &r->retire_next;
+            continue;
+        }
+        *link = r->retire_next;
+        loader_free_result(r);
+    }
+    return retire_pending != NULL;
+}
+
+static void *loader_thread_main(void *arg)
+{
+    (void)arg;
+    while (loader_running) {
+        uint32_t kick = __atomic_load_n(&loader_kick, __ATOMIC_ACQUIRE);
+
+        for (int slot = 0; slot < SHADOW_CHAIN_INSTANCES; slot++) {
+            uint32_t seq = __atomic_load_n(&req_seq[slot], __ATOMIC_ACQUIRE);
+            if (seq == built_seq[slot]) continue;
+            built_seq[slot] = seq;
+            loader_build_slot(slot, seq);
+        }
+
+        int retire_waiting = loader_drain_retired();
+
+        /* Sleep until kicked; poll briefly while retirees wait out the grace */
+        struct timespec timeout = {
+            .tv_sec = retire_waiting ? 0 : 1,
+            .tv_nsec = retire_waiting ? PATCH_LOADER_RETIRE_GRACE_MS * 1000000L : 0,
+        };
+        syscall(SYS_futex, &loader_kick, FUTEX_WAIT_PRIVATE, kick, &timeout, NULL, 0);
+    }
+    return NULL;
+}
+
+/* SPI thread: queue `r` (and whatever instance it holds) for destruction.
+ * Never fails and never frees, however far behind the loader is. */
+static void loader_retire_push(patch_loader_result_t *r)
+{
+    r->retired_ms = loader_now_ms();
+    patch_loader_result_t *head = __atomic_load_n(&retire_head, __ATOMIC_RELAXED);
+    do {
+        r->retire_next = head;
+    } while (!__atomic_compare_exchange_n(&retire_head, &head, r, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    loader_kick_wake();
+}
+
+void patch_loader_init(const patch_loader_host_t *h)
+{
+    host = *h;
+}
+
+int patch_loader_start(void)
+{
+    if (loader_running) return 0;
+
+    loader_running = 1;
+    int rc = shadow_bulk_thread_create(&loader_thread, loader_thread_main, NULL,
+                                       "schwung-loader");
+    if (rc != 0) {
+        loader_running = 0;
+        loader_log("Patch loader: thread creation failed, using synchronous loads");
+        return -1;
+    }
+    loader_log("Patch loader: started");
+    return 0;
+}
+
+int patch_loader_running(void)
+{
+    return loader_running;
+}
+
+void patch_loader_request(int slot, int patch_index)
+{
+    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return;
+    __atomic_store_n(&req_patch[slot], patch_index, __ATOMIC_RELAXED);
+    uint32_t seq = __atomic_add_fetch(&req_seq[slot], 1, __ATOMIC_RELEASE);
+    if (patch_index < 0) taken_seq[slot] = seq;
+    loader_kick_wake();
+}
+
+int patch_loader_pending(int slot)
+{
+    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return 0;
+    return __atomic_load_n(&req_seq[slot], __ATOMIC_RELAXED) != taken_seq[slot];
+}
+
+int patch_loader_ready(int slot)
+{
+    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return 0;
+    return __atomic_load_n(&ready[slot], __ATOMIC_ACQUIRE) != NULL;
+}
+
+patch_loader_result_t *patch_loader_take(int slot)
+{
+    if (slot < 0 || slot >= SHADOW_CHAIN_INSTANCES) return NULL;
+    patch_loader_result_t *r = __atomic_exchange_n(&ready[slot], NULL, __ATOMIC_ACQ_REL);
+    if (!r) return NULL;
+    if (r->seq != __atomic_load_n(&req_seq[slot], __ATOMIC_RELAXED)) {
+        /* Superseded between publish and take; a newer build is coming. */
+        loader_retire_push(r);
+        return NULL;
+    }
+    taken_seq[slot] = r->seq;
+    return r;
+}
+
+void patch_loader_release(patch_loader_result_t *result, void *retired_instance)
+{
+    if (!result) return;
+    /* The caller has moved the new instance into the slot; the result
+     * struct now carries the retired one to the loader. */
+    result->instance = retired_instance;
+    loader_retire_push(result);
+}
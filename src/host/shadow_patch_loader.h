@@ -0,0 +1,81 @@
+/* shadow_patch_loader.h - Background chain instance builder for patch loads
+ *
+ * Loading a patch into a live chain instance runs dlopen, module.json and
+ * patch JSON parsing and capture-rule file reads. Doing that from the SPI
+ * callback risks a multi-millisecond xrun on every patch change.
+ *
+ * The loader thread instead builds a brand new, fully initialised chain
+ * instance for the requested (slot, patch) off the audio thread and
+ * publishes it through a per-slot atomic pointer. The SPI thread picks it
+ * up once the slot has faded out, swaps it into shadow_chain_slots[] and
+ * hands the old instance back for deferred destruction on the loader
+ * thread. The audio path never blocks and never frees. */
+
+#ifndef SHADOW_PATCH_LOADER_H
+#define SHADOW_PATCH_LOADER_H
+
+#include <stdint.h>
+#include "shadow_constants.h"
+#include "shadow_chain_types.h"
+
+/* Retired instances are destroyed after this grace period, so no frame
+ * that could still hold the old pointer is in flight. */
+#define PATCH_LOADER_RETIRE_GRACE_MS 20
+
+/* A finished build, owned by the SPI thread between take and release. */
+typedef struct patch_loader_result_t {
+    uint32_t seq;               /* request sequence this build satisfies */
+    int slot;
+    int patch_index;
+    int ok;                     /* 0 = build failed, instance may be NULL */
+    void *instance;             /* new chain instance (or retired one after release) */
+    char patch_name[64];
+    int receive_channel;        /* patch:receive_channel (0 = All, 1-16), -1 if absent */
+    int forward_channel;        /* patch:forward_channel (-2..15), -3 if absent */
+    int default_forward_channel; /* synth:default_forward_channel (-2..15), -3 if absent */
+    shadow_capture_rules_t capture;
+    uint64_t retired_ms;        /* set on release, used for the grace period */
+    struct patch_loader_result_t *retire_next;  /* retire list link */
+} patch_loader_result_t;
+
+#define PATCH_LOADER_CHANNEL_ABSENT (-3)
+
+typedef struct {
+    void (*log)(const char *msg);
+    /* Build a ready-to-render instance for (slot, patch_index) into `out`.
+     * Called on the loader thread only. Returns 0 on success. */
+    int (*build)(int slot, int patch_index, patch_loader_result_t *out);
+    /* Destroy an instance created by build (or a retired slot instance). */
+    void (*destroy)(void *instance);
+} patch_loader_host_t;
+
+/* Initialize with host callbacks. */
+void patch_loader_init(const patch_loader_host_t *host);
+
+/* Start the loader thread. Returns 0 on success. */
+int patch_loader_start(void);
+
+/* 1 if the loader thread is running (async loads available). */
+int patch_loader_running(void);
+
+/* SPI thread: request an async build for (slot, patch_index). A newer
+ * request supersedes an older one still in flight. patch_index < 0
+ * cancels any outstanding request for the slot. */
+void patch_loader_request(int slot, int patch_index);
+
+/* SPI thread: 1 if a request for `slot` has not been taken yet. */
+int patch_loader_pending(int slot);
+
+/* SPI thread: 1 if a finished build for `slot` is waiting to be taken. */
+int patch_loader_ready(int slot);
+
+/* SPI thread: take ownership of the finished build for `slot` (NULL if
+ * none, or if it was superseded by a newer request). */
+patch_loader_result_t *patch_loader_take(int slot);
+
+/* SPI thread: return a taken result. `retired_instance` (the slot's old
+ * instance, may be NULL) is destroyed on the loader thread after the grace
+ * period, together with the result struct. */
+void patch_loader_release(patch_loader_result_t *result, void *retired_instance);
+
+#endif /* SHADOW_PATCH_LOADER_H */
@@ -0,0 +1,224 @@
+/* shadow_render_pool.c - Real-time worker pool for per-slot DSP rendering
+ *
+ * Batch protocol (single producer = SPI thread):
+ *   1. Producer writes fn/ctx, zeroes pool_done, then publishes the claim
+ *      word (generation | n_jobs | next=0) with release semantics.
+ *   2. Producer bumps pool_gen and FUTEX_WAKEs the workers.
+ *   3. Producer and workers claim jobs by CAS on the claim word. A claim
+ *      only succeeds if its generation matches, so a worker that wakes late
+ *      can never pick up a job from a different batch.
+ *   4. Each finished job increments pool_done; the producer spins until
+ *      pool_done == n_jobs. Batch fields stay stable until then because the
+ *      producer cannot return while any claimed job is outstanding. */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shadow_render_pool.h"
+
+static render_pool_host_t host;
+
+static pthread_t pool_threads[RENDER_POOL_MAX_WORKERS];
+static int pool_worker_count = 0;
+static volatile int pool_exit = 0;
+
+/* Futex word: bumped once per batch. */
+static uint32_t pool_gen = 0;
+
+/* Claim word: [63:32] generation, [31:16] n_jobs, [15:0] next job index. */
+static uint64_t pool_claim = 0;
+static uint32_t pool_done = 0;
+
+static render_pool_job_fn pool_fn = NULL;
+static void *pool_ctx = NULL;
+
+/* Telemetry (relaxed, informational) */
+static uint32_t stat_batches = 0;
+static uint32_t stat_jobs_worker = 0;
+static uint32_t stat_jobs_caller = 0;
+static uint64_t stat_join_wait_max_us = 0;
+
+static inline void pool_cpu_relax(void)
+{
+#if defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ volatile("pause" ::: "memory");
+#endif
+}
+
+static inline uint64_t pool_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void pool_log(const char *msg)
+{
+    if (host.log) host.log(msg);
+}
+
+/* Claim and run jobs of generation `gen` until none remain.
+ * Returns the number of jobs this thread executed. */
+static uint32_t pool_drain(uint32_t gen)
+{
+    uint32_t ran = 0;
+    uint64_t cur = __atomic_load_n(&pool_claim, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t cgen = (uint32_t)(cur >> 32);
+        uint32_t jobs = (uint32_t)(cur >> 16) & 0xFFFF;
+        uint32_t next = (uint32_t)cur & 0xFFFF;
+        if (cgen != gen || next >= jobs) break;
+        if (!__atomic_compare_exchange_n(&pool_claim, &cur, cur + 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;  /* cur reloaded by CAS */
+        }
+        /* Claimed: batch fields are stable until our completion is counted. */
+        pool_fn(pool_ctx, (int)next);
+        __atomic_add_fetch(&pool_done, 1, __ATOMIC_RELEASE);
+        ran++;
+        cur = __atomic_load_n(&pool_claim, __ATOMIC_ACQUIRE);
+    }
+    return ran;
+}
+
+static void *pool_worker_main(void *arg)
+{
+    (void)arg;
+    uint32_t seen = __atomic_load_n(&pool_gen, __ATOMIC_ACQUIRE);
+
+    while (!pool_exit) {
+        uint32_t gen = __atomic_load_n(&pool_gen, __ATOMIC_ACQUIRE);
+        if (gen == seen) {
+            syscall(SYS_futex, &pool_gen, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+            continue;
+        }
+        seen = gen;
+        uint32_t ran = pool_drain(gen);
+        if (ran) __atomic_add_fetch(&stat_jobs_worker, ran, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+void render_pool_init(const render_pool_host_t *h)
+{
+    host = *h;
+}
+
+int render_pool_start(int workers)
+{
+    if (pool_worker_count > 0) return pool_worker_count;
+    if (workers > RENDER_POOL_MAX_WORKERS) workers = RENDER_POOL_MAX_WORKERS;
+    if (workers <= 0) return 0;
+
+    pool_exit = 0;
+    int fifo_failed = 0;
+
+    for (int i = 0; i < workers; i++) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        struct sched_param sp = { .sched_priority = RENDER_POOL_FIFO_PRIORITY };
+        pthread_attr_setschedparam(&attr, &sp);
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int c = 0; c < 8; c++) {
+            if (RENDER_POOL_CPU_MASK & (1 << c)) CPU_SET(c, &cpus);
+        }
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+
+        int rc = pthread_create(&pool_threads[i], &attr, pool_worker_main, NULL);
+        if (rc == EPERM) {
+            /* No CAP_SYS_NICE (e.g. host-side testing): keep affinity,
+             * fall back to inherited scheduling. */
+            fifo_failed = 1;
+            pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+            rc = pthread_create(&pool_threads[i], &attr, pool_worker_main, NULL);
+        }
+        pthread_attr_destroy(&attr);
+        if (rc != 0) break;
+        pthread_setname_np(pool_threads[i], "schwung-render");
+        pool_worker_count++;
+    }
+
+    char msg[128];
+    snprintf(msg, sizeof(msg),
+             "Render pool: %d worker(s) started, sched=%s, cpus=0x%x",
+             pool_worker_count, fifo_failed ? "inherited" : "FIFO",
+             RENDER_POOL_CPU_MASK);
+    pool_log(msg);
+    return pool_worker_count;
+}
+
+void render_pool_stop(void)
+{
+    if (pool_worker_count == 0) return;
+    pool_exit = 1;
+    __atomic_add_fetch(&pool_gen, 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &pool_gen, FUTEX_WAKE_PRIVATE, RENDER_POOL_MAX_WORKERS, NULL, NULL, 0);
+    for (int i = 0; i < pool_worker_count; i++) {
+        pthread_join(pool_threads[i], NULL);
+    }
+    pool_worker_count = 0;
+}
+
+int render_pool_worker_count(void)
+{
+    return pool_worker_count;
+}
+
+void render_pool_run(render_pool_job_fn fn, void *ctx, int n_jobs)
+{
+    if (n_jobs <= 0) return;
+    if (pool_worker_count == 0 || n_jobs < 2) {
+        for (int i = 0; i < n_jobs; i++) fn(ctx, i);
+        return;
+    }
+    if (n_jobs > 0xFFFF) n_jobs = 0xFFFF;
+
+    uint32_t gen = pool_gen + 1;  /* single producer: plain read is fine */
+
+    pool_fn = fn;
+    pool_ctx = ctx;
+    __atomic_store_n(&pool_done, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&pool_claim,
+                     ((uint64_t)gen << 32) | ((uint64_t)n_jobs << 16),
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&pool_gen, gen, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &pool_gen, FUTEX_WAKE_PRIVATE, pool_worker_count, NULL, NULL, 0);
+
+    /* Participate, then wait only for jobs a worker already claimed. */
+    uint32_t ran = pool_drain(gen);
+
+    if (__atomic_load_n(&pool_done, __ATOMIC_ACQUIRE) < (uint32_t)n_jobs) {
+        uint64_t t0 = pool_now_us();
+        while (__atomic_load_n(&pool_done, __ATOMIC_ACQUIRE) < (uint32_t)n_jobs) {
+            pool_cpu_relax();
+        }
+        uint64_t waited = pool_now_us() - t0;
+        if (waited > stat_join_wait_max_us) stat_join_wait_max_us = waited;
+    }
+
+    __atomic_add_fetch(&stat_batches, 1, __ATOMIC_RELAXED);
+    if (ran) __atomic_add_fetch(&stat_jobs_caller, ran, __ATOMIC_RELAXED);
+}
+
+void render_pool_take_stats(render_pool_stats_t *out)
+{
+    if (!out) return;
+    out->batches = __atomic_exchange_n(&stat_batches, 0, __ATOMIC_RELAXED);
+    out->jobs_worker = __atomic_exchange_n(&stat_jobs_worker, 0, __ATOMIC_RELAXED);
+    out->jobs_caller = __atomic_exchange_n(&stat_jobs_caller, 0, __ATOMIC_RELAXED);
+    out->join_wait_max_us = __atomic_exchange_n(&stat_join_wait_max_us, 0, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,61 @@
+/* shadow_render_pool.h - Real-time worker pool for per-slot DSP rendering
+ *
+ * A small fork/join pool that lets the SPI callback fan out independent
+ * jobs (one per active chain slot) to SCHED_FIFO worker threads pinned to
+ * cores 0-2, keeping core 3 free for the SPI driver (see
+ * docs/REALTIME_SAFETY.md).
+ *
+ * The calling thread always participates: it claims jobs from the same
+ * lock-free counter as the workers, so if no worker wakes in time the
+ * frame degrades to the old serial cost instead of stalling. The join is
+ * a spin on an atomic completion counter — no mutexes, no allocation. */
+
+#ifndef SHADOW_RENDER_POOL_H
+#define SHADOW_RENDER_POOL_H
+
+#include <stdint.h>
+
+/* Maximum workers (cores 0-2; the caller is the fourth participant). */
+#define RENDER_POOL_MAX_WORKERS 3
+
+/* Worker scheduling: match MoveOriginal's audio threads so the workers
+ * are not preempted by the UI or JACK clients mid-frame. */
+#define RENDER_POOL_FIFO_PRIORITY 70
+#define RENDER_POOL_CPU_MASK      0x7   /* cores 0-2 */
+
+/* Job callback: run job index `job` (0..n_jobs-1) of the current batch. */
+typedef void (*render_pool_job_fn)(void *ctx, int job);
+
+typedef struct {
+    void (*log)(const char *msg);
+} render_pool_host_t;
+
+typedef struct {
+    uint32_t batches;         /* render_pool_run calls that used workers */
+    uint32_t jobs_worker;     /* jobs executed on worker threads */
+    uint32_t jobs_caller;     /* jobs executed on the calling (SPI) thread */
+    uint64_t join_wait_max_us;/* longest spin waiting for in-flight jobs */
+} render_pool_stats_t;
+
+/* Initialize with host callbacks. */
+void render_pool_init(const render_pool_host_t *host);
+
+/* Start up to `workers` threads. Returns the number actually started
+ * (0 if threads could not be created). Safe to call once. */
+int render_pool_start(int workers);
+
+/* Stop and join all worker threads. */
+void render_pool_stop(void);
+
+/* Number of running workers (0 when the pool is disabled). */
+int render_pool_worker_count(void);
+
+/* Run fn(ctx, 0..n_jobs-1) across the pool and the caller, returning when
+ * every job has completed. Falls back to a plain serial loop when the pool
+ * has no workers or n_jobs < 2. Must only be called from one thread. */
+void render_pool_run(render_pool_job_fn fn, void *ctx, int n_jobs);
+
+/* Read and reset the pool counters (telemetry thread). */
+void render_pool_take_stats(render_pool_stats_t *out);
+
+#endif /* SHADOW_RENDER_POOL_H */
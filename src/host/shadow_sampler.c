@@ -9,13 +9,18 @@
 
 #define _GNU_SOURCE
 #include "shadow_sampler.h"
+#include "shadow_skipback_codec.h"
+#include "shadow_bulk_thread.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <time.h>
+#include <sched.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 /* ============================================================================
  * Host callbacks (set during sampler_init)
@@ -108,14 +113,75 @@ static pthread_cond_t sampler_ring_cond = PTHREAD_COND_INITIALIZER;
 static volatile int sampler_writer_running = 0;
 static volatile int sampler_writer_should_exit = 0;
 
-/* Skipback state */
+/* Skipback state.
+ *
+ * Positions are absolute sample counts since skipback_init(); sample N lives
+ * at skipback_buffer[N % skipback_total_samples]. Only the audio thread
+ * advances skipback_written. The ring holds [valid_start, written), where
+ * valid_start = max(skipback_valid_from, written - total).
+ *
+ * A save doesn't stop capture. skipback_trigger_save() runs on the audio
+ * thread, so it can record a consistent snapshot (start/end, absolute, so
+ * the ring's lap is part of it) between two blocks. It then sets
+ * skipback_hold_pos to the oldest sample the writer hasn't copied out yet.
+ * Capture keeps writing ahead and only drops a block if that block would
+ * overwrite the held region. */
+#define SKIPBACK_NO_HOLD UINT64_MAX
+#define SKIPBACK_SAVE_CHUNK_SECONDS 2  /* writer staging: audio headroom per fwrite */
+#define SKIPBACK_SAVE_MARGIN_BLOCKS 32 /* ~93ms left free for the writer thread to start */
+#define SKIPBACK_BLOCK_SAMPLES (SAMPLER_FRAMES_PER_BLOCK * SAMPLER_NUM_CHANNELS)
+
 static int16_t *skipback_buffer = NULL;
-static volatile size_t skipback_write_pos = 0;
-static volatile int skipback_buffer_full = 0;
-static int skipback_saving = 0;
-static pthread_t skipback_writer_thread;
+static volatile uint64_t skipback_written = 0;
+static volatile uint64_t skipback_valid_from = 0;
+static volatile uint64_t skipback_hold_pos = SKIPBACK_NO_HOLD;
+static volatile uint32_t skipback_dropped_blocks = 0; /* blocks refused to protect a save */
+static int skipback_last_dropped = 0;                 /* audio thread only */
+static int skipback_saving = 0;    /* save or resize owns the ring (mutually exclusive) */
+static int skipback_resizing = 0;  /* resize is swapping buffers: capture must stay out */
+static int skipback_capture_busy = 0;
 volatile int skipback_overlay_timeout = 0;
 
+/* What the writer thread streams out; filled by skipback_trigger_save(). */
+typedef struct {
+    const int16_t *buf;
+    size_t total;
+    uint64_t start;
+    uint64_t end;
+    uint32_t dropped;   /* skipback_dropped_blocks at the snapshot */
+} skipback_snapshot_t;
+static skipback_snapshot_t skipback_snap;
+
+/* Compressed history (features.json "skipback_compressed").
+ *
+ * Instead of the PCM ring, the audio thread copies each block into a small
+ * staging ring and the schwung-skipbk thread encodes it losslessly
+ * (shadow_skipback_codec.c) into a byte ring of [u16 length][payload]
+ * records, evicting the oldest records as it goes. History is capped at the
+ * configured seconds, and the byte ring is SKIPBACK_STORE_PERCENT of the
+ * PCM ring for them: music encodes to 45-60%, so it saves the full setting
+ * in about two thirds of the RAM. Audio that barely compresses (dense noise)
+ * is evicted by size first, so its saves come out shorter.
+ * Record n is block n, i.e. samples [n, n + 1) * SKIPBACK_BLOCK_SAMPLES, so
+ * skipback_written and skipback_hold_pos keep their meaning. */
+#define SKIPBACK_STAGE_BLOCKS 512          /* ~1.5s of encoder slack */
+#define SKIPBACK_ENCODE_BATCH 8            /* wake the encoder every N blocks */
+#define SKIPBACK_STORE_PERCENT 65          /* byte ring size, % of the PCM ring */
+
+static int skipback_compressed = 0;
+static int16_t *skipback_stage = NULL;
+static volatile uint32_t skipback_stage_w = 0;   /* blocks staged (audio thread) */
+static volatile uint32_t skipback_stage_r = 0;   /* blocks encoded (encoder thread) */
+static uint8_t *skipback_store = NULL;
+static size_t skipback_store_size = 0;
+static uint64_t skipback_store_head = 0;         /* absolute byte positions */
+static uint64_t skipback_store_tail = 0;
+static uint64_t skipback_store_first = 0;        /* block number of the record at tail */
+static uint64_t skipback_store_end = 0;          /* block number of the next record */
+static uint64_t skipback_store_max_blocks = 0;
+static uint64_t skipback_read_cursor = 0;        /* writer: byte position of its next record */
+static pthread_mutex_t skipback_store_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /* Runtime size of the rolling buffer (in samples per channel × frames).
  * Established by skipback_init(); may be changed by skipback_resize(). */
 static volatile int skipback_seconds_actual = 0;
@@ -1071,14 +1137,26 @@ void sampler_on_clock(uint8_t status) {
  * Skipback
  * ============================================================================ */
 
+static int skipback_compressed_init(int sec, size_t samples);
+
+void skipback_set_compressed(int enabled) {
+    if (skipback_buffer || skipback_store) return;  /* fixed once allocated */
+    skipback_compressed = enabled ? 1 : 0;
+}
+
 void skipback_init(int seconds) {
-    if (skipback_buffer) return;
+    if (skipback_buffer || skipback_store) return;
     int sec = skipback_clamp_seconds(seconds);
     size_t samples = (size_t)SAMPLER_SAMPLE_RATE * (size_t)sec * (size_t)SAMPLER_NUM_CHANNELS;
+    if (skipback_compressed) {
+        if (skipback_compressed_init(sec, samples) == 0) return;
+        skipback_compressed = 0;
+        s_host.log("Skipback: compressed history unavailable, using PCM buffer");
+    }
     skipback_buffer = (int16_t *)calloc(samples, sizeof(int16_t));
     if (skipback_buffer) {
-        skipback_write_pos = 0;
-        skipback_buffer_full = 0;
+        skipback_written = 0;
+        skipback_valid_from = 0;
         skipback_seconds_actual = sec;
         skipback_total_samples = samples;
         char msg[96];
@@ -1094,32 +1172,249 @@ int skipback_get_seconds(void) {
     return skipback_seconds_actual;
 }
 
+/* Copy absolute samples [from, from + n) out of a ring into a linear buffer. */
+static void skipback_ring_read(const int16_t *ring, size_t total, uint64_t from,
+                               int16_t *dst, size_t n) {
+    size_t pos = (size_t)(from % total);
+    while (n > 0) {
+        size_t chunk = n;
+        if (pos + chunk > total) chunk = total - pos;
+        memcpy(dst, ring + pos, chunk * sizeof(int16_t));
+        dst += chunk;
+        n -= chunk;
+        pos = (pos + chunk) % total;
+    }
+}
+
+/* Copy absolute samples [from, to) between two rings of different sizes,
+ * keeping each sample at its absolute position modulo the ring size. */
+static void skipback_ring_copy(int16_t *dst, size_t dst_total,
+                               const int16_t *src, size_t src_total,
+                               uint64_t from, uint64_t to) {
+    while (from < to) {
+        size_t s = (size_t)(from % src_total);
+        size_t d = (size_t)(from % dst_total);
+        size_t chunk = (size_t)(to - from);
+        if (s + chunk > src_total) chunk = src_total - s;
+        if (d + chunk > dst_total) chunk = dst_total - d;
+        memcpy(dst + d, src + s, chunk * sizeof(int16_t));
+        from += chunk;
+    }
+}
+
+/* ---- Compressed history ---- */
+
+/* Copy bytes in/out of the compressed store at absolute position `pos`. */
+static void skipback_store_read(uint64_t pos, void *dst, size_t n) {
+    uint8_t *d = (uint8_t *)dst;
+    size_t at = (size_t)(pos % skipback_store_size);
+    size_t first = n;
+    if (at + first > skipback_store_size) first = skipback_store_size - at;
+    memcpy(d, skipback_store + at, first);
+    memcpy(d + first, skipback_store, n - first);
+}
+
+static void skipback_store_write(uint64_t pos, const void *src, size_t n) {
+    const uint8_t *s = (const uint8_t *)src;
+    size_t at = (size_t)(pos % skipback_store_size);
+    size_t first = n;
+    if (at + first > skipback_store_size) first = skipback_store_size - at;
+    memcpy(skipback_store + at, s, first);
+    memcpy(skipback_store, s + first, n - first);
+}
+
+/* Drop the oldest record. Caller holds skipback_store_mutex and has checked
+ * that no save still needs it. */
+static void skipback_store_evict(void) {
+    uint8_t len[2];
+    skipback_store_read(skipback_store_tail, len, 2);
+    skipback_store_tail += 2 + (size_t)(len[0] | (len[1] << 8));
+    skipback_store_first++;
+}
+
+/* Encoder thread: append one record, evicting what no save holds. Returns 0
+ * if a save is still reading the oldest audio and there is no room yet. */
+static int skipback_store_append(const uint8_t *rec, size_t len) {
+    pthread_mutex_lock(&skipback_store_mutex);
+    uint64_t hold = __atomic_load_n(&skipback_hold_pos, __ATOMIC_ACQUIRE);
+    while (skipback_store_head + len - skipback_store_tail > skipback_store_size ||
+           skipback_store_end - skipback_store_first >= skipback_store_max_blocks) {
+        if (hold != SKIPBACK_NO_HOLD &&
+            (skipback_store_first + 1) * SKIPBACK_BLOCK_SAMPLES > hold) {
+            pthread_mutex_unlock(&skipback_store_mutex);
+            return 0;
+        }
+        skipback_store_evict();
+    }
+    skipback_store_write(skipback_store_head, rec, len);
+    skipback_store_head += len;
+    skipback_store_end++;
+    pthread_mutex_unlock(&skipback_store_mutex);
+    return 1;
+}
+
+static void *skipback_encoder_main(void *arg) {
+    (void)arg;
+    uint8_t rec[2 + SKIPBACK_CODEC_MAX_BYTES];
+    for (;;) {
+        uint32_t r = skipback_stage_r;
+        uint32_t w = __atomic_load_n(&skipback_stage_w, __ATOMIC_ACQUIRE);
+        if (r == w) {
+            /* Woken every SKIPBACK_ENCODE_BATCH blocks; the timeout picks up
+             * a partial batch once capture stops. */
+            struct timespec timeout = { .tv_sec = 0, .tv_nsec = 50 * 1000000L };
+            syscall(SYS_futex, &skipback_stage_w, FUTEX_WAIT_PRIVATE, w, &timeout, NULL, 0);
+            continue;
+        }
+        const int16_t *pcm = skipback_stage +
+            (size_t)(r % SKIPBACK_STAGE_BLOCKS) * SKIPBACK_BLOCK_SAMPLES;
+        size_t len = skipback_codec_encode(pcm, rec + 2);
+        rec[0] = (uint8_t)(len & 0xff);
+        rec[1] = (uint8_t)(len >> 8);
+        /* Staged audio waits (and the staging ring fills) while a save still
+         * needs the oldest records. */
+        while (!skipback_store_append(rec, len + 2)) usleep(2000);
+        __atomic_store_n(&skipback_stage_r, r + 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+/* Byte ring size and block cap for `sec` seconds of compressed history */
+static size_t skipback_compressed_store_size(int sec) {
+    return (size_t)SAMPLER_SAMPLE_RATE * (size_t)sec * SAMPLER_NUM_CHANNELS *
+           sizeof(int16_t) / 100 * SKIPBACK_STORE_PERCENT;
+}
+
+static uint64_t skipback_compressed_max_blocks(int sec) {
+    return (uint64_t)sec * SAMPLER_SAMPLE_RATE / SAMPLER_FRAMES_PER_BLOCK;
+}
+
+static int skipback_compressed_init(int sec, size_t samples) {
+    size_t store_size = skipback_compressed_store_size(sec);
+    uint8_t *store = (uint8_t *)malloc(store_size);
+    int16_t *stage = (int16_t *)malloc((size_t)SKIPBACK_STAGE_BLOCKS * SKIPBACK_BLOCK_SAMPLES *
+                                       sizeof(int16_t));
+    if (!store || !stage) {
+        free(store);
+        free(stage);
+        return -1;
+    }
+    skipback_stage = stage;
+    skipback_store_size = store_size;
+    skipback_store_max_blocks = skipback_compressed_max_blocks(sec);
+
+    pthread_t t;
+    if (shadow_bulk_thread_create(&t, skipback_encoder_main, NULL, "schwung-skipbk") != 0) {
+        skipback_stage = NULL;
+        free(stage);
+        free(store);
+        return -1;
+    }
+    pthread_detach(t);
+
+    skipback_written = 0;
+    skipback_seconds_actual = sec;
+    skipback_total_samples = samples;
+    __atomic_store_n(&skipback_store, store, __ATOMIC_RELEASE);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Skipback: allocated %ds compressed history (%.1f MB, PCM would be %.1f MB)",
+             sec, (double)store_size / (1024.0 * 1024.0),
+             (double)(samples * sizeof(int16_t)) / (1024.0 * 1024.0));
+    s_host.log(msg);
+    return 0;
+}
+
+/* Audio thread: hand one block to the encoder. */
+static void skipback_stage_block(const int16_t *audio);
+
+/* Audio-thread entry for capture/amend. Returns 0 while skipback_resize() is
+ * swapping buffers; the Dekker-style pair of seq_cst flags lets the resizer
+ * wait for an in-flight block without either side taking a lock. */
+static int skipback_enter(void) {
+    __atomic_store_n(&skipback_capture_busy, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&skipback_resizing, __ATOMIC_SEQ_CST)) {
+        __atomic_store_n(&skipback_capture_busy, 0, __ATOMIC_RELEASE);
+        return 0;
+    }
+    return 1;
+}
+
+static void skipback_leave(void) {
+    __atomic_store_n(&skipback_capture_busy, 0, __ATOMIC_RELEASE);
+}
+
+static void skipback_drop_block(void) {
+    skipback_last_dropped = 1;
+    __atomic_fetch_add(&skipback_dropped_blocks, 1, __ATOMIC_RELAXED);
+}
+
+static void skipback_stage_block(const int16_t *audio) {
+    uint32_t w = skipback_stage_w;
+    if (w - __atomic_load_n(&skipback_stage_r, __ATOMIC_ACQUIRE) >= SKIPBACK_STAGE_BLOCKS) {
+        skipback_drop_block();
+        return;
+    }
+    memcpy(skipback_stage + (size_t)(w % SKIPBACK_STAGE_BLOCKS) * SKIPBACK_BLOCK_SAMPLES,
+           audio, SKIPBACK_BLOCK_SAMPLES * sizeof(int16_t));
+    __atomic_store_n(&skipback_stage_w, w + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&skipback_written, skipback_written + SKIPBACK_BLOCK_SAMPLES,
+                     __ATOMIC_RELEASE);
+    skipback_last_dropped = 0;
+    if (((w + 1) % SKIPBACK_ENCODE_BATCH) == 0)
+        syscall(SYS_futex, &skipback_stage_w, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
 void skipback_capture(int16_t *audio) {
-    if (!skipback_buffer || !audio || __atomic_load_n(&skipback_saving, __ATOMIC_ACQUIRE)) return;
+    if (!audio) return;
+    if (skipback_store) {
+        skipback_stage_block(audio);
+        return;
+    }
+    if (!skipback_buffer) return;
+    if (!skipback_enter()) {
+        skipback_drop_block();
+        return;
+    }
 
     size_t total_samples = skipback_total_samples;
-    if (total_samples == 0) return;
     size_t block_samples = SAMPLER_FRAMES_PER_BLOCK * SAMPLER_NUM_CHANNELS;
-    size_t wp = skipback_write_pos;
+    uint64_t w = skipback_written;
 
-    for (size_t i = 0; i < block_samples; i++) {
-        skipback_buffer[wp] = audio[i];
-        wp = (wp + 1) % total_samples;
+    /* Never overwrite audio a running save hasn't copied out yet. */
+    uint64_t hold = __atomic_load_n(&skipback_hold_pos, __ATOMIC_ACQUIRE);
+    if (hold != SKIPBACK_NO_HOLD && w + block_samples - hold > total_samples) {
+        skipback_leave();
+        skipback_drop_block();
+        return;
     }
 
-    if (!skipback_buffer_full && wp < skipback_write_pos)
-        skipback_buffer_full = 1;
-    skipback_write_pos = wp;
+    size_t pos = (size_t)(w % total_samples);
+    size_t first = block_samples;
+    if (pos + first > total_samples) first = total_samples - pos;
+    memcpy(skipback_buffer + pos, audio, first * sizeof(int16_t));
+    if (first < block_samples)
+        memcpy(skipback_buffer, audio + first, (block_samples - first) * sizeof(int16_t));
+
+    __atomic_store_n(&skipback_written, w + block_samples, __ATOMIC_RELEASE);
+    skipback_last_dropped = 0;
+    skipback_leave();
 }
 
 void skipback_amend(const int16_t *audio) {
-    if (!skipback_buffer || !audio || __atomic_load_n(&skipback_saving, __ATOMIC_ACQUIRE)) return;
+    /* PCM ring only: in compressed mode the block may already be encoded. */
+    if (!skipback_buffer || !audio || skipback_last_dropped) return;
+    if (!skipback_enter()) return;
 
     size_t total_samples = skipback_total_samples;
-    if (total_samples == 0) return;
     size_t block_samples = SAMPLER_FRAMES_PER_BLOCK * SAMPLER_NUM_CHANNELS;
+    uint64_t w = skipback_written;
+    if (w < block_samples) {
+        skipback_leave();
+        return;
+    }
     /* Mix into the block that was just written by skipback_capture */
-    size_t start = (skipback_write_pos + total_samples - block_samples) % total_samples;
+    size_t start = (size_t)((w - block_samples) % total_samples);
     for (size_t i = 0; i < block_samples; i++) {
         size_t pos = (start + i) % total_samples;
         int32_t sum = (int32_t)skipback_buffer[pos] + (int32_t)audio[i];
@@ -1127,6 +1422,47 @@ void skipback_amend(const int16_t *audio) {
         if (sum < -32768) sum = -32768;
         skipback_buffer[pos] = (int16_t)sum;
     }
+    skipback_leave();
+}
+
+/* Compressed mode: the audio thread never touches the store, so only the
+ * encoder is paused (via the store mutex) while the records are moved. */
+static void skipback_resize_compressed(int sec) {
+    size_t new_size = skipback_compressed_store_size(sec);
+    uint8_t *new_store = (uint8_t *)malloc(new_size);
+    if (!new_store) {
+        s_host.log("Skipback: resize allocation failed");
+        return;
+    }
+    uint64_t new_max = skipback_compressed_max_blocks(sec);
+
+    pthread_mutex_lock(&skipback_store_mutex);
+    while (skipback_store_head - skipback_store_tail > new_size ||
+           skipback_store_end - skipback_store_first > new_max)
+        skipback_store_evict();
+    /* Records keep their absolute byte positions */
+    for (uint64_t pos = skipback_store_tail; pos < skipback_store_head; ) {
+        size_t chunk = (size_t)(skipback_store_head - pos);
+        size_t at = (size_t)(pos % new_size);
+        if (at + chunk > new_size) chunk = new_size - at;
+        skipback_store_read(pos, new_store + at, chunk);
+        pos += chunk;
+    }
+    uint8_t *old_store = skipback_store;
+    skipback_store = new_store;
+    skipback_store_size = new_size;
+    skipback_store_max_blocks = new_max;
+    skipback_seconds_actual = sec;
+    skipback_total_samples = (size_t)SAMPLER_SAMPLE_RATE * (size_t)sec * SAMPLER_NUM_CHANNELS;
+    uint64_t kept = skipback_store_end - skipback_store_first;
+    pthread_mutex_unlock(&skipback_store_mutex);
+    free(old_store);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Skipback: resized compressed history to %ds (kept %.1fs, %.1f MB)",
+             sec, (double)(kept * SAMPLER_FRAMES_PER_BLOCK) / SAMPLER_SAMPLE_RATE,
+             (double)new_size / (1024.0 * 1024.0));
+    s_host.log(msg);
 }
 
 void skipback_resize(int new_seconds) {
@@ -1135,7 +1471,7 @@ void skipback_resize(int new_seconds) {
     /* Serialize concurrent resize requests. */
     pthread_mutex_lock(&skipback_resize_mutex);
 
-    if (!skipback_buffer || sec == skipback_seconds_actual) {
+    if ((!skipback_buffer && !skipback_store) || sec == skipback_seconds_actual) {
         pthread_mutex_unlock(&skipback_resize_mutex);
         return;
     }
@@ -1148,12 +1484,16 @@ void skipback_resize(int new_seconds) {
         s_host.log("Skipback: resize deferred (save in progress)");
         return;
     }
-    /* skipback_saving==1 now gates skipback_capture/amend on the audio thread. */
+
+    if (skipback_store) {
+        skipback_resize_compressed(sec);
+        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&skipback_resize_mutex);
+        return;
+    }
 
     size_t old_total = skipback_total_samples;
     int16_t *old_buf = skipback_buffer;
-    size_t old_wp = skipback_write_pos;
-    int old_full = skipback_buffer_full;
 
     size_t new_total = (size_t)SAMPLER_SAMPLE_RATE * (size_t)sec * (size_t)SAMPLER_NUM_CHANNELS;
     int16_t *new_buf = (int16_t *)calloc(new_total, sizeof(int16_t));
@@ -1164,46 +1504,33 @@ void skipback_resize(int new_seconds) {
         return;
     }
 
-    /* Determine how many samples of valid audio currently exist (linear). */
-    size_t valid;
-    size_t start_pos;
-    if (old_full) {
-        valid = old_total;
-        start_pos = old_wp;  /* oldest sample */
-    } else {
-        valid = old_wp;
-        start_pos = 0;
-    }
-
-    /* Decide what to keep when shrinking: the most recent N samples. */
-    size_t keep = (valid < new_total) ? valid : new_total;
-    if (keep < valid) {
-        size_t skip = valid - keep;
-        start_pos = (start_pos + skip) % old_total;
-    }
-
-    /* Copy keep samples from old ring (starting at start_pos, wrapping)
-     * into new buffer linearly starting at index 0. */
-    size_t remaining = keep;
-    size_t src = start_pos;
-    size_t dst = 0;
-    while (remaining > 0) {
-        size_t chunk = remaining;
-        if (src + chunk > old_total) chunk = old_total - src;
-        memcpy(new_buf + dst, old_buf + src, chunk * sizeof(int16_t));
-        dst += chunk;
-        src = (src + chunk) % old_total;
-        remaining -= chunk;
-    }
+    /* Bulk copy while the audio thread keeps capturing into the old ring.
+     * Keep the most recent audio that fits when shrinking. */
+    uint64_t w0 = __atomic_load_n(&skipback_written, __ATOMIC_ACQUIRE);
+    uint64_t lo = skipback_valid_from;
+    if (w0 > old_total && w0 - old_total > lo) lo = w0 - old_total;
+    if (w0 - lo > new_total) lo = w0 - new_total;
+    skipback_ring_copy(new_buf, new_total, old_buf, old_total, lo, w0);
+
+    /* Shut capture out only for the blocks written during the bulk copy —
+     * a few blocks at most, so the audio thread normally never sees it. */
+    __atomic_store_n(&skipback_resizing, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&skipback_capture_busy, __ATOMIC_SEQ_CST))
+        sched_yield();
+
+    uint64_t w1 = skipback_written;
+    uint64_t tail = w0;
+    if (w1 - tail > new_total) tail = w1 - new_total;
+    skipback_ring_copy(new_buf, new_total, old_buf, old_total, tail, w1);
+    /* Blocks captured during the bulk copy may have overwritten its oldest part */
+    if (w1 > old_total && w1 - old_total > lo) lo = w1 - old_total;
+    if (w1 - lo > new_total) lo = w1 - new_total;
 
-    /* Publish new buffer state. Pointer write is atomic on aligned aarch64,
-     * but the audio thread is gated by skipback_saving anyway. */
     skipback_buffer = new_buf;
     skipback_total_samples = new_total;
-    skipback_write_pos = (keep < new_total) ? keep : 0;
-    skipback_buffer_full = (keep == new_total);
+    skipback_valid_from = lo;
     skipback_seconds_actual = sec;
-    __sync_synchronize();
+    __atomic_store_n(&skipback_resizing, 0, __ATOMIC_RELEASE);
 
     free(old_buf);
 
@@ -1211,7 +1538,7 @@ void skipback_resize(int new_seconds) {
     snprintf(msg, sizeof(msg),
              "Skipback: resized to %ds (kept %.1fs, %.1f MB)",
              sec,
-             (double)keep / ((double)SAMPLER_NUM_CHANNELS * (double)SAMPLER_SAMPLE_RATE),
+             (double)(w1 - lo) / ((double)SAMPLER_NUM_CHANNELS * (double)SAMPLER_SAMPLE_RATE),
              (double)(new_total * sizeof(int16_t)) / (1024.0 * 1024.0));
     s_host.log(msg);
 
@@ -1219,9 +1546,103 @@ void skipback_resize(int new_seconds) {
     pthread_mutex_unlock(&skipback_resize_mutex);
 }
 
+/* Release the ring back to capture and allow the next save/resize. */
+static void skipback_save_done(void) {
+    __atomic_store_n(&skipback_hold_pos, SKIPBACK_NO_HOLD, __ATOMIC_RELEASE);
+    __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+}
+
+static uint32_t skipback_decode_errors = 0;  /* writer thread */
+
+/* Compressed mode: decode whole blocks at the writer's cursor, waiting for
+ * the encoder where it hasn't reached the snapshot end yet. */
+static size_t skipback_stage_chunk_compressed(uint64_t pos, int16_t *staging,
+                                              size_t chunk_samples) {
+    uint8_t rec[SKIPBACK_CODEC_MAX_BYTES];
+    size_t n = 0;
+    while (n + SKIPBACK_BLOCK_SAMPLES <= chunk_samples && pos + n < skipback_snap.end) {
+        uint64_t block = (pos + n) / SKIPBACK_BLOCK_SAMPLES;
+        pthread_mutex_lock(&skipback_store_mutex);
+        if (block >= skipback_store_end) {
+            pthread_mutex_unlock(&skipback_store_mutex);
+            usleep(2000);
+            continue;
+        }
+        uint8_t hdr[2];
+        skipback_store_read(skipback_read_cursor, hdr, 2);
+        size_t len = (size_t)(hdr[0] | (hdr[1] << 8));
+        size_t copy = len <= sizeof(rec) ? len : 0;
+        skipback_store_read(skipback_read_cursor + 2, rec, copy);
+        skipback_read_cursor += 2 + len;
+        pthread_mutex_unlock(&skipback_store_mutex);
+
+        if (skipback_codec_decode(rec, copy, staging + n) != 0) skipback_decode_errors++;
+        n += SKIPBACK_BLOCK_SAMPLES;
+        __atomic_store_n(&skipback_hold_pos, pos + n, __ATOMIC_RELEASE);
+    }
+    return n;
+}
+
+/* Copy the next chunk of the snapshot into staging and hand that part of the
+ * ring back to the audio thread. Returns the number of samples staged. */
+static size_t skipback_stage_chunk(uint64_t pos, int16_t *staging, size_t chunk_samples) {
+    if (skipback_store) return skipback_stage_chunk_compressed(pos, staging, chunk_samples);
+    size_t n = (size_t)(skipback_snap.end - pos);
+    if (n > chunk_samples) n = chunk_samples;
+    if (n == 0) return 0;
+    skipback_ring_read(skipback_snap.buf, skipback_snap.total, pos, staging, n);
+    __atomic_store_n(&skipback_hold_pos, pos + n, __ATOMIC_RELEASE);
+    return n;
+}
+
 static void *skipback_writer_func(void *arg) {
     (void)arg;
 
+    /* Whole blocks, so compressed records never straddle a chunk */
+    size_t chunk_samples = (size_t)SAMPLER_SAMPLE_RATE * SKIPBACK_SAVE_CHUNK_SECONDS *
+                           SAMPLER_NUM_CHANNELS / SKIPBACK_BLOCK_SAMPLES * SKIPBACK_BLOCK_SAMPLES;
+    int16_t *staging = (int16_t *)malloc(chunk_samples * sizeof(int16_t));
+    if (!staging) {
+        s_host.log("Skipback: failed to allocate staging buffer");
+        s_host.announce("Skipback failed");
+        skipback_save_done();
+        return NULL;
+    }
+
+    /* Compressed mode: the save starts at the oldest stored record within the
+     * configured length, skipping older records by their length headers.
+     * Holding it here stops the encoder from evicting anything we read. */
+    if (skipback_store) {
+        uint64_t end_block = skipback_snap.end / SKIPBACK_BLOCK_SAMPLES;
+        uint64_t keep_blocks = skipback_snap.total / SKIPBACK_BLOCK_SAMPLES;
+        pthread_mutex_lock(&skipback_store_mutex);
+        uint64_t block = skipback_store_first;
+        uint64_t cursor = skipback_store_tail;
+        while (block < skipback_store_end && block + keep_blocks < end_block) {
+            uint8_t hdr[2];
+            skipback_store_read(cursor, hdr, 2);
+            cursor += 2 + (size_t)(hdr[0] | (hdr[1] << 8));
+            block++;
+        }
+        skipback_snap.start = block * SKIPBACK_BLOCK_SAMPLES;
+        skipback_read_cursor = cursor;
+        __atomic_store_n(&skipback_hold_pos, skipback_snap.start, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&skipback_store_mutex);
+        skipback_decode_errors = 0;
+        if (skipback_snap.start >= skipback_snap.end) {
+            s_host.log("Skipback: no audio captured yet");
+            s_host.announce("No audio captured yet");
+            free(staging);
+            skipback_save_done();
+            return NULL;
+        }
+    }
+
+    /* Stage the oldest chunk before any filesystem work, so a full ring has
+     * headroom while mkdir/fopen run instead of dropping the incoming blocks. */
+    uint64_t pos = skipback_snap.start;
+    size_t staged = skipback_stage_chunk(pos, staging, chunk_samples);
+
     /* Build date-based save directory */
     time_t now = time(NULL);
     struct tm tm_buf;
@@ -1229,14 +1650,16 @@ static void *skipback_writer_func(void *arg) {
     if (!tm_info) {
         s_host.log("Skipback: failed to get local time");
         s_host.announce("Skipback failed");
-        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+        free(staging);
+        skipback_save_done();
         return NULL;
     }
     char date_subdir[32];
     if (strftime(date_subdir, sizeof(date_subdir), "%Y-%m-%d", tm_info) == 0) {
         s_host.log("Skipback: failed to format date subdirectory");
         s_host.announce("Skipback failed");
-        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+        free(staging);
+        skipback_save_done();
         return NULL;
     }
     char skipback_dir[256];
@@ -1263,33 +1686,13 @@ static void *skipback_writer_func(void *arg) {
     if (!f) {
         s_host.log("Skipback: failed to open WAV file");
         s_host.announce("Skipback failed");
-        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
-        return NULL;
-    }
-
-    /* Determine how much data to write */
-    size_t total_samples = skipback_total_samples;
-    size_t wp = skipback_write_pos;
-    size_t data_samples;
-    size_t start_pos;
-
-    if (skipback_buffer_full) {
-        data_samples = total_samples;
-        start_pos = wp;
-    } else {
-        data_samples = wp;
-        start_pos = 0;
-    }
-
-    if (data_samples == 0) {
-        s_host.log("Skipback: no audio captured yet");
-        s_host.announce("No audio captured yet");
-        fclose(f);
-        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+        free(staging);
+        skipback_save_done();
         return NULL;
     }
 
     /* Write WAV header */
+    size_t data_samples = (size_t)(skipback_snap.end - skipback_snap.start);
     uint32_t data_bytes = (uint32_t)(data_samples * sizeof(int16_t));
     sampler_wav_header_t hdr;
     memcpy(hdr.riff_id, "RIFF", 4);
@@ -1307,17 +1710,14 @@ static void *skipback_writer_func(void *arg) {
     hdr.data_size = data_bytes;
     fwrite(&hdr, sizeof(hdr), 1, f);
 
-    /* Write audio data from ring buffer */
-    size_t pos = start_pos;
-    size_t remaining = data_samples;
-    while (remaining > 0) {
-        size_t chunk = remaining;
-        if (pos + chunk > total_samples)
-            chunk = total_samples - pos;
-        fwrite(skipback_buffer + pos, sizeof(int16_t), chunk, f);
-        pos = (pos + chunk) % total_samples;
-        remaining -= chunk;
+    /* Stream the snapshot out of the ring one staged chunk at a time. Each
+     * chunk is released to capture before its (possibly slow) fwrite. */
+    while (staged > 0) {
+        fwrite(staging, sizeof(int16_t), staged, f);
+        pos += staged;
+        staged = skipback_stage_chunk(pos, staging, chunk_samples);
     }
+    free(staging);
 
     fclose(f);
     chown_to_ableton(path);
@@ -1328,37 +1728,91 @@ static void *skipback_writer_func(void *arg) {
              path, (float)frames / SAMPLER_SAMPLE_RATE);
     s_host.log(msg);
 
+    if (skipback_decode_errors > 0) {
+        snprintf(msg, sizeof(msg), "Skipback: %u compressed blocks failed to decode (written as silence)",
+                 skipback_decode_errors);
+        s_host.log(msg);
+    }
+
+    uint32_t dropped = __atomic_load_n(&skipback_dropped_blocks, __ATOMIC_RELAXED) - skipback_snap.dropped;
+    if (dropped > 0) {
+        snprintf(msg, sizeof(msg),
+                 "Skipback: %u blocks not captured while saving (writer fell a full buffer behind)",
+                 dropped);
+        s_host.log(msg);
+    }
+
+    /* Only now may the next save start: the file is closed (a save in the
+     * same second reuses its name) and the snapshot is no longer read */
+    skipback_save_done();
+
     skipback_overlay_timeout = SKIPBACK_OVERLAY_FRAMES;
     s_host.overlay_sync();
     s_host.announce("Skipback saved");
-    __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
     return NULL;
 }
 
+/* Called from the audio thread (MIDI input handling), between two
+ * skipback_capture() calls, so the snapshot is block-aligned without locks. */
 void skipback_trigger_save(void) {
-    if (__atomic_load_n(&skipback_saving, __ATOMIC_ACQUIRE)) {
+    if (!skipback_buffer && !skipback_store) {
+        s_host.announce("Skipback not available");
+        return;
+    }
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&skipback_saving, &expected, 1,
+                                     0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
         s_host.announce("Skipback already saving");
         return;
     }
-    if (!skipback_buffer) {
-        s_host.announce("Skipback not available");
+
+    /* A resize can't be mid-swap here: it holds skipback_saving throughout. */
+    uint64_t end = skipback_written;
+    size_t total = skipback_total_samples;
+    uint64_t start = skipback_valid_from;
+    if (skipback_store) {
+        /* Capture never touches the store; the writer picks the start and
+         * sets the hold itself, under the store mutex. */
+        start = 0;
+    } else {
+        /* With a full ring the very next block would hit the hold, so leave the
+         * oldest few blocks out of the save as room for the writer to start up. */
+        size_t margin = SKIPBACK_SAVE_MARGIN_BLOCKS * SKIPBACK_BLOCK_SAMPLES;
+        if (end > total - margin && end - (total - margin) > start) start = end - (total - margin);
+    }
+    if (end == start) {
+        s_host.log("Skipback: no audio captured yet");
+        s_host.announce("No audio captured yet");
+        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
         return;
     }
-    __atomic_store_n(&skipback_saving, 1, __ATOMIC_RELEASE);
-    __sync_synchronize();
+
+    skipback_snap.buf = skipback_buffer;
+    skipback_snap.total = total;
+    skipback_snap.start = start;
+    skipback_snap.end = end;
+    skipback_snap.dropped = skipback_dropped_blocks;
+    if (!skipback_store) __atomic_store_n(&skipback_hold_pos, start, __ATOMIC_RELEASE);
 
     s_host.announce("Saving skipback");
 
+    /* Called on the audio thread: the writer (which decodes the whole
+     * history in compressed mode) must not inherit its FIFO priority */
     pthread_t t;
-    if (pthread_create(&t, NULL, skipback_writer_func, NULL) != 0) {
+    if (shadow_bulk_thread_create(&t, skipback_writer_func, NULL, "schwung-skipsav") != 0) {
         s_host.log("Skipback: failed to create writer thread");
         s_host.announce("Skipback failed");
-        __atomic_store_n(&skipback_saving, 0, __ATOMIC_RELEASE);
+        skipback_save_done();
         return;
     }
     pthread_detach(t);
+    if (skipback_store) {
+        s_host.log("Skipback: saving compressed history...");
+        return;
+    }
     char msg[64];
-    snprintf(msg, sizeof(msg), "Skipback: saving last %d seconds...", skipback_seconds_actual);
+    snprintf(msg, sizeof(msg), "Skipback: saving last %.1f seconds...",
+             (double)(end - start) / ((double)SAMPLER_NUM_CHANNELS * (double)SAMPLER_SAMPLE_RATE));
     s_host.log(msg);
 }
 
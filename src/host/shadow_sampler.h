@@ -70,7 +70,9 @@ typedef struct {
 #define SAMPLER_DURATION_COUNT 6
 #define SAMPLER_CLOCK_STALE_THRESHOLD 200
 #define SAMPLER_SETTINGS_PATH "/data/UserData/schwung/settings.txt"
+#ifndef SAMPLER_SETS_DIR
 #define SAMPLER_SETS_DIR "/data/UserData/UserLibrary/Sets"
+#endif
 #define SAMPLER_OVERLAY_DONE_FRAMES 90
 #define SAMPLER_VU_HOLD_DURATION 8
 #define SAMPLER_VU_DECAY_RATE 1500
@@ -84,7 +86,9 @@ typedef struct {
 
 #define SKIPBACK_DEFAULT_SECONDS 30
 #define SKIPBACK_MAX_SECONDS 300
+#ifndef SKIPBACK_DIR
 #define SKIPBACK_DIR "/data/UserData/UserLibrary/Samples/Schwung/Skipback"
+#endif
 #define SKIPBACK_OVERLAY_FRAMES 171
 
 /* ============================================================================
@@ -191,16 +195,27 @@ void sampler_on_clock(uint8_t status);
 
 /* Skipback: allocate buffer, capture audio, trigger save.
  * Pass desired duration in seconds (clamped to [SKIPBACK_DEFAULT_SECONDS, SKIPBACK_MAX_SECONDS]).
- * Calling skipback_init() multiple times is safe; size is established on first call. */
+ * Calling skipback_init() multiple times is safe; size is established on first call.
+ * skipback_capture/amend/trigger_save run on the audio thread. A save
+ * snapshots the buffer and streams it out on a writer thread while capture
+ * keeps running, so back-to-back saves leave no gap. */
 void skipback_init(int seconds);
+
+/* Keep skipback history losslessly compressed (shadow_skipback_codec.c) on a
+ * background encoder thread instead of as PCM. Holds the configured seconds
+ * of music in about two thirds of the PCM buffer's RAM (audio that barely
+ * compresses saves shorter). Only takes effect
+ * if called before skipback_init(). skipback_amend() is a no-op in this mode. */
+void skipback_set_compressed(int enabled);
 void skipback_capture(int16_t *audio);
 void skipback_amend(const int16_t *audio);
 void skipback_trigger_save(void);
 
 /* Resize the rolling buffer in place, preserving as much existing audio as
  * fits in the new size (oldest samples truncated when shrinking). Safe to
- * call from any non-realtime thread; gates the audio thread via the saving
- * flag for the duration of the swap. No-op if a save is in progress. */
+ * call from any non-realtime thread. Capture continues during the copy; the
+ * audio thread is only kept out while the last few blocks are copied and the
+ * buffer pointer is swapped. No-op if a save is in progress. */
 void skipback_resize(int new_seconds);
 
 /* Returns the currently allocated skipback duration in seconds (0 if not yet init). */
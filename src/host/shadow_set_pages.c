@@ -7,9 +7,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include <sys/xattr.h>
 #include <dirent.h>
+#include <poll.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -53,8 +55,11 @@ static const char *set_page_xattr_names[] = {
 
 static set_pages_host_t host;
 
+static void set_page_recover(void);
+
 void set_pages_init(const set_pages_host_t *h) {
     host = *h;
+    set_page_recover();
 }
 
 /* ============================================================================
@@ -556,6 +561,10 @@ static void set_page_restore_xattrs(const char *sets_dir, const char *stash_dir)
             snprintf(uuid_path, sizeof(uuid_path), "%s/%s", sets_dir, uuid);
             struct stat st;
             if (stat(uuid_path, &st) == 0) {
+                /* A rename carries xattrs along; only write what differs */
+                char cur[256];
+                ssize_t clen = getxattr(uuid_path, attr, cur, sizeof(cur) - 1);
+                if (clen == (ssize_t)strlen(val) && memcmp(cur, val, clen) == 0) continue;
                 setxattr(uuid_path, attr, val, strlen(val), 0);
             }
         }
@@ -563,7 +572,6 @@ static void set_page_restore_xattrs(const char *sets_dir, const char *stash_dir)
     fclose(xf);
 }
 
-/* Move all UUID directories from src_dir to dst_dir */
 /* Count non-dot directory entries (UUID dirs) in a path */
 static int count_uuid_dirs(const char *path)
 {
@@ -584,9 +592,13 @@ static int count_uuid_dirs(const char *path)
     return count;
 }
 
-/* Write a recovery manifest listing UUID dirs in a page stash directory */
+/* Write a recovery manifest listing the UUID dirs stashed in
+ * stash_dir/Sets */
 static void write_manifest(const char *stash_dir, int page_num)
 {
+    char sets_dir[600];
+    snprintf(sets_dir, sizeof(sets_dir), "%s/Sets", stash_dir);
+
     char manifest_path[512];
     snprintf(manifest_path, sizeof(manifest_path), "%s/manifest.txt", stash_dir);
 
@@ -599,13 +611,13 @@ static void write_manifest(const char *stash_dir, int page_num)
     strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm);
     fprintf(f, "# Set page manifest - page %d - %s\n", page_num, timestamp);
 
-    DIR *d = opendir(stash_dir);
+    DIR *d = opendir(sets_dir);
     if (d) {
         struct dirent *entry;
         while ((entry = readdir(d)) != NULL) {
             if (entry->d_name[0] == '.') continue;
-            char full[512];
-            snprintf(full, sizeof(full), "%s/%s", stash_dir, entry->d_name);
+            char full[768];
+            snprintf(full, sizeof(full), "%s/%s", sets_dir, entry->d_name);
             struct stat st;
             if (stat(full, &st) == 0 && S_ISDIR(st.st_mode))
                 fprintf(f, "%s\n", entry->d_name);
@@ -616,6 +628,7 @@ static void write_manifest(const char *stash_dir, int page_num)
     chown_to_ableton(manifest_path);
 }
 
+/* Move all UUID directories from src_dir to dst_dir */
 static int set_page_move_dirs(const char *src_dir, const char *dst_dir, int *out_skipped)
 {
     DIR *d = opendir(src_dir);
@@ -625,6 +638,8 @@ static int set_page_move_dirs(const char *src_dir, const char *dst_dir, int *out
     struct dirent *entry;
     while ((entry = readdir(d)) != NULL) {
         if (entry->d_name[0] == '.') continue;
+        /* A page stash's own Sets/ is not a set */
+        if (strcmp(entry->d_name, "Sets") == 0) continue;
         /* Only move directories (UUID dirs) */
         char src_path[512], dst_path[512];
         snprintf(src_path, sizeof(src_path), "%s/%s", src_dir, entry->d_name);
@@ -659,16 +674,49 @@ static int set_page_move_dirs(const char *src_dir, const char *dst_dir, int *out
     return moved;
 }
 
+static int is_dir(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+/* fsync a directory so renames and creates inside it reach the card */
+static void fsync_dir(const char *path)
+{
+    int fd = open(path, O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+/* Replace a small file in SET_PAGES_DIR with `text` (tmp + fsync + rename):
+ * after a power cut it holds either the old or the new contents */
+static int set_pages_write_file(const char *path, const char *text)
+{
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+    size_t len = strlen(text);
+    int ok = write(fd, text, len) == (ssize_t)len && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    chown_to_ableton(path);
+    fsync_dir(SET_PAGES_DIR);
+    return 0;
+}
+
 /* Persist current page number to disk */
 static void set_page_persist(int page)
 {
+    char text[16];
     shadow_ensure_dir(SET_PAGES_DIR);
-    FILE *f = fopen(SET_PAGES_CURRENT_PATH, "w");
-    if (f) {
-        fprintf(f, "%d\n", page);
-        fclose(f);
-        chown_to_ableton(SET_PAGES_CURRENT_PATH);
-    }
+    snprintf(text, sizeof(text), "%d\n", page);
+    set_pages_write_file(SET_PAGES_CURRENT_PATH, text);
 }
 
 /* Read current page from disk (returns 0 if not found) */
@@ -683,6 +731,379 @@ int set_page_read_persisted(void)
     return page;
 }
 
+/* ============================================================================
+ * Page swap
+ *
+ * While a page is inactive its sets live in SET_PAGES_DIR/page_N/Sets. A
+ * switch moves the whole directory, not each set: Sets/ is renamed to
+ * page_<old>/Sets and page_<new>/Sets is renamed to Sets/. Both live on
+ * /data, so each step is one atomic rename no matter how many sets a page
+ * holds, and each UUID dir keeps its xattrs. SET_PAGES_JOURNAL_PATH
+ * ("<old> <new> <inode of page_<new>/Sets>") is written before the first
+ * rename and removed once the new page is persisted; set_page_recover()
+ * settles a switch that a crash left half done. The inode tells the
+ * installed page apart from an empty Sets/ that Move recreated after only
+ * the first rename landed.
+ * ============================================================================ */
+
+static void page_stash_dir(int page, char *out, size_t len)
+{
+    snprintf(out, len, SET_PAGES_DIR "/page_%d", page);
+}
+
+static void page_sets_dir(int page, char *out, size_t len)
+{
+    snprintf(out, len, SET_PAGES_DIR "/page_%d/Sets", page);
+}
+
+static void sets_parent_dir(char *out, size_t len)
+{
+    snprintf(out, len, "%s", SAMPLER_SETS_DIR);
+    char *slash = strrchr(out, '/');
+    if (slash && slash != out) *slash = '\0';
+}
+
+/* Stashes from before the whole-directory swap hold the UUID dirs directly
+ * in page_N/. Gather them into page_N/Sets the first time the page is
+ * visited. */
+static void set_page_migrate_stash(int page)
+{
+    char stash[512], sets[512];
+    page_stash_dir(page, stash, sizeof(stash));
+    page_sets_dir(page, sets, sizeof(sets));
+    if (is_dir(sets) || count_uuid_dirs(stash) == 0) return;
+
+    if (mkdir(sets, 0755) != 0) return;
+    chown_to_ableton(sets);
+    int skipped = 0;
+    int moved = set_page_move_dirs(stash, sets, &skipped);
+
+    char msg[256];
+    snprintf(msg, sizeof(msg), "SetPage: migrated %d sets of page %d into page_%d/Sets (skipped %d)",
+             moved, page + 1, page, skipped);
+    host.log(msg);
+}
+
+/* Put `new_sets` in place as Sets/, or an empty Sets/ for a page that
+ * has never been used */
+static int set_page_install_sets(const char *new_sets, mode_t mode)
+{
+    if (is_dir(new_sets)) return rename(new_sets, SAMPLER_SETS_DIR);
+    if (mkdir(SAMPLER_SETS_DIR, mode) != 0) return -1;
+    chmod(SAMPLER_SETS_DIR, mode);
+    chown_to_ableton(SAMPLER_SETS_DIR);
+    return 0;
+}
+
+int set_page_swap(int old_page, int new_page)
+{
+    char old_stash[512], old_sets[512], new_stash[512], new_sets[512];
+    char parent[512], msg[1200];
+
+    page_stash_dir(old_page, old_stash, sizeof(old_stash));
+    page_sets_dir(old_page, old_sets, sizeof(old_sets));
+    page_stash_dir(new_page, new_stash, sizeof(new_stash));
+    page_sets_dir(new_page, new_sets, sizeof(new_sets));
+    sets_parent_dir(parent, sizeof(parent));
+
+    shadow_ensure_dir(old_stash);
+    set_page_migrate_stash(new_page);
+
+    /* page_<old>/Sets is where Sets/ is about to go, so it must not exist.
+     * Anything there belongs to the page that is active now. */
+    if (is_dir(old_sets)) {
+        int skipped = 0;
+        set_page_move_dirs(old_sets, SAMPLER_SETS_DIR, &skipped);
+        if (rmdir(old_sets) != 0) {
+            snprintf(msg, sizeof(msg), "SetPage: cannot clear %s (%s), not switching",
+                     old_sets, strerror(errno));
+            host.log(msg);
+            return -1;
+        }
+    }
+
+    struct stat sets_st;
+    mode_t sets_mode = 0755;
+    if (stat(SAMPLER_SETS_DIR, &sets_st) == 0) {
+        sets_mode = sets_st.st_mode & 07777;
+    } else if (mkdir(SAMPLER_SETS_DIR, sets_mode) == 0) {
+        chown_to_ableton(SAMPLER_SETS_DIR);
+    }
+    int old_count = count_uuid_dirs(SAMPLER_SETS_DIR);
+
+    /* Backup of the Sets/ xattrs; the rename itself keeps them */
+    set_page_save_xattrs(SAMPLER_SETS_DIR, old_stash);
+
+    /* A never-used page gets its (empty) Sets now, so the journal can
+     * name the directory that is about to become Sets/ */
+    if (!is_dir(new_sets) && mkdir(new_sets, sets_mode) == 0) {
+        chmod(new_sets, sets_mode);
+        chown_to_ableton(new_sets);
+    }
+    struct stat new_st;
+    unsigned long long new_ino = 0;
+    if (stat(new_sets, &new_st) == 0) new_ino = (unsigned long long)new_st.st_ino;
+
+    char journal[64];
+    snprintf(journal, sizeof(journal), "%d %d %llu\n", old_page, new_page, new_ino);
+    if (set_pages_write_file(SET_PAGES_JOURNAL_PATH, journal) != 0) {
+        host.log("SetPage: cannot write switch journal, not switching");
+        return -1;
+    }
+
+    if (rename(SAMPLER_SETS_DIR, old_sets) != 0) {
+        snprintf(msg, sizeof(msg), "SetPage: rename %s -> %s failed: %s",
+                 SAMPLER_SETS_DIR, old_sets, strerror(errno));
+        host.log(msg);
+        unlink(SET_PAGES_JOURNAL_PATH);
+        return -1;
+    }
+    if (set_page_install_sets(new_sets, sets_mode) != 0) {
+        snprintf(msg, sizeof(msg), "SetPage: installing page %d failed: %s, restoring page %d",
+                 new_page + 1, strerror(errno), old_page + 1);
+        host.log(msg);
+        rename(old_sets, SAMPLER_SETS_DIR);
+        fsync_dir(parent);
+        unlink(SET_PAGES_JOURNAL_PATH);
+        return -1;
+    }
+    fsync_dir(parent);
+    fsync_dir(old_stash);
+    fsync_dir(new_stash);
+
+    write_manifest(old_stash, old_page);
+    set_page_restore_xattrs(SAMPLER_SETS_DIR, new_stash);
+    set_page_persist(new_page);
+    unlink(SET_PAGES_JOURNAL_PATH);
+    fsync_dir(SET_PAGES_DIR);
+
+    snprintf(msg, sizeof(msg), "SetPage: stashed %d sets of page %d, %d sets of page %d in Sets/",
+             old_count, old_page + 1, count_uuid_dirs(SAMPLER_SETS_DIR), new_page + 1);
+    host.log(msg);
+    return 0;
+}
+
+/* Sets/ is present and page_<old>/Sets too, but Sets/ is not the journaled
+ * page_<new>/Sets, which is still in the stash: only the first rename
+ * landed and Move has made a fresh Sets/ since. Fold whatever it wrote
+ * into the new page and install that. Returns 0 when the new page is in
+ * place; otherwise Sets/ is left as the current page, and the next switch
+ * merges page_<old>/Sets back into it. */
+static int set_page_replace_recreated(int new_page, const char *new_sets)
+{
+    char msg[1200];
+    int skipped = 0;
+    int moved = set_page_move_dirs(SAMPLER_SETS_DIR, new_sets, &skipped);
+    if (rmdir(SAMPLER_SETS_DIR) != 0) {
+        char aside[512];
+        snprintf(aside, sizeof(aside), SET_PAGES_DIR "/page_%d/Sets.recreated", new_page);
+        if (rename(SAMPLER_SETS_DIR, aside) != 0) {
+            snprintf(msg, sizeof(msg), "SetPage: cannot clear recreated %s (%s)",
+                     SAMPLER_SETS_DIR, strerror(errno));
+            host.log(msg);
+            return -1;
+        }
+    }
+    snprintf(msg, sizeof(msg), "SetPage: Sets/ was recreated mid-switch, moved %d sets into page %d (skipped %d)",
+             moved, new_page + 1, skipped);
+    host.log(msg);
+    return set_page_install_sets(new_sets, 0755);
+}
+
+/* Settle a switch left half done by a crash or power cut. Sets/ tells us
+ * how far it got: missing means only the first rename landed, so finish
+ * the switch; present with page_<old>/Sets means both landed, unless it is
+ * not the journaled directory (see set_page_replace_recreated); present
+ * without it means nothing moved. */
+static void set_page_recover(void)
+{
+    FILE *f = fopen(SET_PAGES_JOURNAL_PATH, "r");
+    if (!f) return;
+    int old_page = -1, new_page = -1;
+    unsigned long long new_ino = 0;
+    int n = fscanf(f, "%d %d %llu", &old_page, &new_page, &new_ino);
+    fclose(f);
+
+    char msg[256];
+    if (n < 2 || old_page < 0 || old_page >= SET_PAGES_TOTAL ||
+        new_page < 0 || new_page >= SET_PAGES_TOTAL) {
+        host.log("SetPage: ignoring unreadable switch journal");
+        unlink(SET_PAGES_JOURNAL_PATH);
+        return;
+    }
+
+    char old_sets[512], new_sets[512], parent[512];
+    page_sets_dir(old_page, old_sets, sizeof(old_sets));
+    page_sets_dir(new_page, new_sets, sizeof(new_sets));
+    sets_parent_dir(parent, sizeof(parent));
+
+    int page;
+    if (!is_dir(SAMPLER_SETS_DIR)) {
+        if (set_page_install_sets(new_sets, 0755) == 0) {
+            page = new_page;
+        } else {
+            rename(old_sets, SAMPLER_SETS_DIR);
+            page = old_page;
+        }
+        fsync_dir(parent);
+    } else if (is_dir(old_sets)) {
+        struct stat sets_st;
+        int recreated = new_ino != 0 && is_dir(new_sets) &&
+                        stat(SAMPLER_SETS_DIR, &sets_st) == 0 &&
+                        (unsigned long long)sets_st.st_ino != new_ino;
+        page = new_page;
+        if (recreated) {
+            if (set_page_replace_recreated(new_page, new_sets) != 0) page = old_page;
+            fsync_dir(parent);
+        }
+    } else {
+        page = old_page;
+    }
+
+    set_page_persist(page);
+    unlink(SET_PAGES_JOURNAL_PATH);
+    fsync_dir(SET_PAGES_DIR);
+
+    snprintf(msg, sizeof(msg), "SetPage: recovered interrupted switch %d -> %d, on page %d",
+             old_page + 1, new_page + 1, page + 1);
+    host.log(msg);
+}
+
+/* ============================================================================
+ * Save completion
+ *
+ * saveSongIfDirty may return before Move's last write lands. Instead of
+ * sync() and sleeping until the set count stops changing, watch Sets/ and
+ * the two levels below it (Sets/<uuid>/<name>/) with inotify and go ahead
+ * once nothing has been written for SET_PAGE_SAVE_QUIET_MS.
+ * ============================================================================ */
+
+#define SET_PAGE_SAVE_QUIET_MS 250
+#define SET_PAGE_SAVE_MAX_MS   3000
+#define SET_PAGE_MAX_WATCHES   512
+#define SET_PAGE_WATCH_MASK    (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | \
+                                IN_CREATE | IN_DELETE | IN_ONLYDIR)
+
+typedef struct {
+    int fd;
+    int count;
+    int wd[SET_PAGE_MAX_WATCHES];
+    int depth[SET_PAGE_MAX_WATCHES];
+    char *path[SET_PAGE_MAX_WATCHES];
+} save_watch_t;
+
+static save_watch_t save_watch = { .fd = -1 };
+
+static long long mono_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void save_watch_add(save_watch_t *w, const char *path, int depth)
+{
+    if (w->count >= SET_PAGE_MAX_WATCHES) return;
+    int wd = inotify_add_watch(w->fd, path, SET_PAGE_WATCH_MASK);
+    if (wd < 0) return;
+    char *copy = strdup(path);
+    if (!copy) return;
+    w->wd[w->count] = wd;
+    w->depth[w->count] = depth;
+    w->path[w->count] = copy;
+    w->count++;
+    if (depth >= 2) return;
+
+    DIR *d = opendir(path);
+    if (!d) return;
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        char sub[768];
+        snprintf(sub, sizeof(sub), "%s/%s", path, entry->d_name);
+        if (is_dir(sub)) save_watch_add(w, sub, depth + 1);
+    }
+    closedir(d);
+}
+
+/* Start watching before the save request so no write is missed */
+static void save_watch_open(save_watch_t *w)
+{
+    w->count = 0;
+    w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (w->fd >= 0) save_watch_add(w, SAMPLER_SETS_DIR, 0);
+}
+
+static void save_watch_close(save_watch_t *w)
+{
+    for (int i = 0; i < w->count; i++) free(w->path[i]);
+    w->count = 0;
+    if (w->fd >= 0) close(w->fd);
+    w->fd = -1;
+}
+
+/* Drain pending events, following new directories. Returns events read. */
+static int save_watch_drain(save_watch_t *w)
+{
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int events = 0;
+    for (;;) {
+        ssize_t n = read(w->fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (char *p = buf; p < buf + n; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            events++;
+            if ((ev->mask & IN_CREATE) && (ev->mask & IN_ISDIR) && ev->len > 0) {
+                for (int i = 0; i < w->count; i++) {
+                    if (w->wd[i] != ev->wd || w->depth[i] >= 2) continue;
+                    char sub[768];
+                    snprintf(sub, sizeof(sub), "%s/%s", w->path[i], ev->name);
+                    save_watch_add(w, sub, w->depth[i] + 1);
+                    break;
+                }
+            }
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return events;
+}
+
+static void save_watch_wait(save_watch_t *w)
+{
+    if (w->fd < 0) {
+        /* No inotify: give the save a fixed moment instead */
+        usleep(500000);
+        return;
+    }
+
+    long long start = mono_ms(), last = start;
+    int events = save_watch_drain(w);
+    if (events > 0) last = mono_ms();
+    for (;;) {
+        long long now = mono_ms();
+        long long wait = last + SET_PAGE_SAVE_QUIET_MS - now;
+        if (start + SET_PAGE_SAVE_MAX_MS - now < wait) wait = start + SET_PAGE_SAVE_MAX_MS - now;
+        if (wait <= 0) break;
+        struct pollfd pfd = { .fd = w->fd, .events = POLLIN };
+        if (poll(&pfd, 1, (int)wait) > 0) {
+            int n = save_watch_drain(w);
+            if (n > 0) {
+                events += n;
+                last = mono_ms();
+            }
+        }
+    }
+
+    char msg[128];
+    long long took = mono_ms() - start;
+    if (took >= SET_PAGE_SAVE_MAX_MS)
+        snprintf(msg, sizeof(msg), "SetPage: Sets/ still changing after %lld ms (%d events), going ahead",
+                 took, events);
+    else
+        snprintf(msg, sizeof(msg), "SetPage: save settled in %lld ms (%d events)", took, events);
+    host.log(msg);
+}
+
 /* Background thread args for set page change */
 typedef struct {
     int old_page;
@@ -747,7 +1168,7 @@ static void set_page_update_song_index(int index)
     free(buf);
 }
 
-/* Background thread: does the heavy I/O for page change, then restarts Move */
+/* Background thread: saves, swaps the page's sets in, then restarts Move */
 static void *set_page_change_thread(void *arg)
 {
     set_page_change_args_t *a = (set_page_change_args_t *)arg;
@@ -755,7 +1176,10 @@ static void *set_page_change_thread(void *arg)
     int new_page = a->new_page;
     free(a);
 
-    /* 1. Save song if dirty via dbus (blocking - we're on a background thread) */
+    /* 1. Save song if dirty via dbus (blocking - we're on a background
+     *    thread), then wait for its writes to settle */
+    set_page_loading = SET_PAGE_STAGE_SAVING;
+    save_watch_open(&save_watch);
     {
         const char *argv[] = {
             "dbus-send", "--system", "--print-reply",
@@ -767,92 +1191,34 @@ static void *set_page_change_thread(void *arg)
         };
         host.run_command(argv);
     }
+    save_watch_wait(&save_watch);
+    save_watch_close(&save_watch);
 
-    /* 1b. Sync + poll: wait for save to materialize on disk */
-    {
-        sync();
-        int prev_count = count_uuid_dirs(SAMPLER_SETS_DIR);
-        for (int attempt = 0; attempt < 6; attempt++) {
-            usleep(500000); /* 500ms */
-            sync();
-            int cur = count_uuid_dirs(SAMPLER_SETS_DIR);
-            if (cur == prev_count) break; /* stable */
-            prev_count = cur;
-        }
+    /* 2. Swap the target page's sets into Sets/ (persists new_page) */
+    set_page_loading = SET_PAGE_STAGE_LOADING;
+    if (set_page_swap(old_page, new_page) != 0) {
         char msg[128];
-        snprintf(msg, sizeof(msg), "SetPage: post-save sync: %d sets in Sets/", prev_count);
+        snprintf(msg, sizeof(msg), "SetPage: switch failed, staying on page %d", old_page + 1);
         host.log(msg);
+        set_page_current = old_page;
+        set_page_loading = SET_PAGE_STAGE_IDLE;
+        set_page_change_in_flight = 0;
+        return NULL;
     }
 
-    /* 2. Save xattrs for current sets */
-    char current_stash[512];
-    snprintf(current_stash, sizeof(current_stash), SET_PAGES_DIR "/page_%d", old_page);
-    shadow_ensure_dir(current_stash);
-    set_page_save_xattrs(SAMPLER_SETS_DIR, current_stash);
-
-    /* Pre-flight inventory */
-    int pre_count = count_uuid_dirs(SAMPLER_SETS_DIR);
-    {
-        char msg[128];
-        snprintf(msg, sizeof(msg), "SetPage: pre-flight: %d sets in Sets/", pre_count);
-        host.log(msg);
-    }
-
-    /* 3. Move current sets to stash */
-    int stash_skipped = 0;
-    int stashed = set_page_move_dirs(SAMPLER_SETS_DIR, current_stash, &stash_skipped);
-
-    /* Post-stash inventory */
-    {
-        int remaining = count_uuid_dirs(SAMPLER_SETS_DIR);
-        char msg[256];
-        snprintf(msg, sizeof(msg), "SetPage: stashed %d (skipped %d), %d remaining in Sets/",
-                 stashed, stash_skipped, remaining);
-        host.log(msg);
-        if (remaining > 0) {
-            host.log("SetPage: WARNING - sets still in Sets/ after stash!");
-        }
-    }
-
-    /* Write recovery manifest for the stash */
-    write_manifest(current_stash, old_page);
-
-    /* 4. Move target page sets from stash to Sets/ */
-    char target_stash[512];
-    snprintf(target_stash, sizeof(target_stash), SET_PAGES_DIR "/page_%d", new_page);
-    shadow_ensure_dir(target_stash);
-    int restore_skipped = 0;
-    int restored = set_page_move_dirs(target_stash, SAMPLER_SETS_DIR, &restore_skipped);
-
-    /* Post-restore inventory */
-    {
-        int now_in_sets = count_uuid_dirs(SAMPLER_SETS_DIR);
-        char msg[256];
-        snprintf(msg, sizeof(msg), "SetPage: restored %d from page_%d (skipped %d), %d now in Sets/",
-                 restored, new_page, restore_skipped, now_in_sets);
-        host.log(msg);
-    }
-
-    /* 5. Restore xattrs for target page */
-    set_page_restore_xattrs(SAMPLER_SETS_DIR, target_stash);
-
-    /* 6. Update currentSongIndex to 0 so Move loads the first set on new page */
+    /* 3. Update currentSongIndex to 0 so Move loads the first set on new page */
     set_page_update_song_index(0);
 
-    /* 7. Persist page number */
-    set_page_persist(new_page);
-
     {
         char msg[128];
-        snprintf(msg, sizeof(msg), "SetPage: now on page %d (%d sets restored), restarting Move",
-                 new_page + 1, restored);
+        snprintf(msg, sizeof(msg), "SetPage: now on page %d, restarting Move", new_page + 1);
         host.log(msg);
     }
 
-    /* 8. Save shadow state before restart */
+    /* 4. Save shadow state before restart */
     host.save_state();
 
-    /* 9. Trigger restart via the existing mechanism */
+    /* 5. Trigger restart via the existing mechanism */
     host.log("SetPage: triggering restart");
     system("/data/UserData/schwung/restart-move.sh");
 
@@ -877,7 +1243,7 @@ void shadow_change_set_page(int new_page)
 
     /* Update state and show "Loading..." toast immediately (before I/O) */
     set_page_current = new_page;
-    set_page_loading = 1;
+    set_page_loading = SET_PAGE_STAGE_SAVING;
     set_page_overlay_active = 1;
     set_page_overlay_timeout = SET_PAGE_OVERLAY_FRAMES;
     host.overlay_sync();
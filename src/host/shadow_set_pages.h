@@ -12,11 +12,20 @@
  * Constants
  * ============================================================================ */
 
+#ifndef SET_PAGES_DIR
 #define SET_PAGES_DIR "/data/UserData/schwung/set_pages"
+#endif
 #define SET_PAGES_CURRENT_PATH SET_PAGES_DIR "/current_page.txt"
+#define SET_PAGES_JOURNAL_PATH SET_PAGES_DIR "/switch.journal"
 #define SET_PAGES_TOTAL 8
 #define SET_PAGE_OVERLAY_FRAMES 120  /* ~2 seconds at 60fps */
 
+/* set_page_loading values: how far a page switch has got, shown in the
+ * set page toast. Non-zero means a switch is under way. */
+#define SET_PAGE_STAGE_IDLE    0
+#define SET_PAGE_STAGE_LOADING 1     /* swapping sets / restarting Move */
+#define SET_PAGE_STAGE_SAVING  2     /* waiting for Move to save the current set */
+
 /* Path constants used by set/config management */
 #define SHADOW_CHAIN_CONFIG_FILENAME "shadow_chain_config.json"
 #define SHADOW_CHAIN_CONFIG_PATH "/data/UserData/schwung/" SHADOW_CHAIN_CONFIG_FILENAME
@@ -68,7 +77,8 @@ extern uint32_t sampler_pending_set_seq;
  * ============================================================================ */
 
 /* Initialize set pages subsystem with callbacks to shim functions.
- * Must be called before any other set pages function. */
+ * Must be called before any other set pages function. Finishes or rolls
+ * back a page switch that was interrupted by a crash or power cut. */
 void set_pages_init(const set_pages_host_t *host);
 
 /* Utility: ensure a directory exists (mkdir -p) */
@@ -99,4 +109,10 @@ int set_page_read_persisted(void);
 /* Change to a new set page (non-blocking: spawns background thread) */
 void shadow_change_set_page(int new_page);
 
+/* Swap the sets in Sets/ for those stashed for new_page: Sets/ becomes
+ * set_pages/page_<old>/Sets and page_<new>/Sets becomes Sets/, two
+ * directory renames under a journal, then persists new_page. Returns 0 on
+ * success; on failure Sets/ is unchanged. Called by the switch thread. */
+int set_page_swap(int old_page, int new_page);
+
 #endif /* SHADOW_SET_PAGES_H */
@@ -0,0 +1,283 @@
+/* shadow_skipback_codec.c - Lossless block codec for compressed skipback history
+ *
+ * Bitstream, MSB first, one block:
+ *   1 bit   stereo mode: 0 = left/right, 1 = mid/side
+ *   per channel (L,R or M,S):
+ *     2 bits  predictor order 0-3
+ *     5 bits  Rice parameter k (0-24), 30 = constant, 31 = verbatim
+ *     data    constant: one 17-bit value; verbatim: 128 17-bit values;
+ *             Rice: `order` 17-bit warm-up samples, then 128-order
+ *             zigzagged residuals, unary quotient + k low bits
+ *   zero padding to the next byte
+ *
+ * The predictor only looks back within the block, so every block decodes on
+ * its own. Side is L-R and mid is R+(S>>1), both exact in 17 bits. */
+
+#include <string.h>
+
+#include "shadow_skipback_codec.h"
+
+#define N SKIPBACK_CODEC_BLOCK_FRAMES
+#define VALUE_BITS 17
+#define MAX_RICE_K 24
+#define PARAM_CONSTANT 30
+#define PARAM_VERBATIM 31
+#define MAX_UNARY (1u << 22)
+
+typedef struct {
+    int order;
+    int param;
+    uint32_t bits;
+} chan_plan_t;
+
+/* ---- bit I/O ---- */
+
+typedef struct {
+    uint8_t *p;
+    uint64_t acc;
+    int bits;
+} bit_writer_t;
+
+static inline uint32_t low_mask(int n)
+{
+    return n >= 32 ? 0xFFFFFFFFu : ((1u << n) - 1u);
+}
+
+static inline void put_bits(bit_writer_t *w, uint32_t v, int n)
+{
+    if (n == 0) return;
+    w->acc = (w->acc << n) | (v & low_mask(n));
+    w->bits += n;
+    while (w->bits >= 8) {
+        w->bits -= 8;
+        *w->p++ = (uint8_t)(w->acc >> w->bits);
+    }
+}
+
+static inline void put_unary(bit_writer_t *w, uint32_t q)
+{
+    while (q >= 31) {
+        put_bits(w, 0, 31);
+        q -= 31;
+    }
+    put_bits(w, 1, (int)q + 1);  /* q zeros then a one */
+}
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t acc;
+    int bits;
+    int err;
+} bit_reader_t;
+
+static inline uint32_t get_bits(bit_reader_t *r, int n)
+{
+    if (n == 0) return 0;
+    while (r->bits < n) {
+        if (r->p >= r->end) {
+            r->err = 1;
+            return 0;
+        }
+        r->acc = (r->acc << 8) | *r->p++;
+        r->bits += 8;
+    }
+    r->bits -= n;
+    return (uint32_t)(r->acc >> r->bits) & low_mask(n);
+}
+
+static inline uint32_t get_unary(bit_reader_t *r)
+{
+    uint32_t q = 0;
+    while (!r->err && get_bits(r, 1) == 0) {
+        if (++q > MAX_UNARY) r->err = 1;
+    }
+    return q;
+}
+
+/* ---- prediction ---- */
+
+/* Only valid for i >= order; the first `order` samples are sent verbatim */
+static inline int32_t predict(const int32_t *x, int i, int order)
+{
+    switch (order) {
+    case 1: return x[i - 1];
+    case 2: return 2 * x[i - 1] - x[i - 2];
+    case 3: return 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3];
+    default: return 0;
+    }
+}
+
+static inline uint32_t zigzag(int32_t r)
+{
+    return ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t u)
+{
+    return (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+}
+
+static inline int32_t sign_extend17(uint32_t v)
+{
+    return (int32_t)(v << (32 - VALUE_BITS)) >> (32 - VALUE_BITS);
+}
+
+static uint32_t rice_bits(const uint32_t *u, int n, int k)
+{
+    uint32_t bits = (uint32_t)n * (uint32_t)(k + 1);
+    for (int i = 0; i < n; i++) bits += u[i] >> k;
+    return bits;
+}
+
+static void plan_channel(const int32_t *x, chan_plan_t *pl)
+{
+    int constant = 1;
+    for (int i = 1; i < N && constant; i++) constant = (x[i] == x[0]);
+    if (constant) {
+        pl->order = 0;
+        pl->param = PARAM_CONSTANT;
+        pl->bits = 7 + VALUE_BITS;
+        return;
+    }
+
+    /* Pick the order with the smallest residual magnitude, compared over the
+     * samples every order predicts (FLAC's fixed-predictor heuristic) */
+    uint64_t best_sum = UINT64_MAX;
+    int order = 0;
+    for (int o = 0; o <= 3; o++) {
+        uint64_t sum = 0;
+        for (int i = 3; i < N; i++) sum += zigzag(x[i] - predict(x, i, o));
+        if (sum < best_sum) {
+            best_sum = sum;
+            order = o;
+        }
+    }
+
+    uint32_t u[N];
+    int n = N - order;
+    for (int i = 0; i < n; i++) u[i] = zigzag(x[order + i] - predict(x, order + i, order));
+
+    /* k ~ log2(mean residual); try its neighbours exactly */
+    uint64_t mean = best_sum / (N - 3);
+    int k0 = 0;
+    while (k0 < MAX_RICE_K && (mean >> (k0 + 1)) > 0) k0++;
+    uint32_t best_bits = UINT32_MAX;
+    int k = k0;
+    for (int c = k0 - 1; c <= k0 + 1; c++) {
+        if (c < 0 || c > MAX_RICE_K) continue;
+        uint32_t b = rice_bits(u, n, c);
+        if (b < best_bits) {
+            best_bits = b;
+            k = c;
+        }
+    }
+    best_bits += (uint32_t)order * VALUE_BITS;
+
+    pl->order = order;
+    if (best_bits >= (uint32_t)N * VALUE_BITS) {
+        pl->param = PARAM_VERBATIM;
+        pl->bits = 7 + (uint32_t)N * VALUE_BITS;
+    } else {
+        pl->param = k;
+        pl->bits = 7 + best_bits;
+    }
+}
+
+static void write_channel(bit_writer_t *w, const int32_t *x, const chan_plan_t *pl)
+{
+    put_bits(w, (uint32_t)pl->order, 2);
+    put_bits(w, (uint32_t)pl->param, 5);
+    if (pl->param == PARAM_CONSTANT) {
+        put_bits(w, (uint32_t)x[0], VALUE_BITS);
+    } else if (pl->param == PARAM_VERBATIM) {
+        for (int i = 0; i < N; i++) put_bits(w, (uint32_t)x[i], VALUE_BITS);
+    } else {
+        int k = pl->param;
+        for (int i = 0; i < pl->order; i++) put_bits(w, (uint32_t)x[i], VALUE_BITS);
+        for (int i = pl->order; i < N; i++) {
+            uint32_t u = zigzag(x[i] - predict(x, i, pl->order));
+            put_unary(w, u >> k);
+            put_bits(w, u, k);
+        }
+    }
+}
+
+static void read_channel(bit_reader_t *r, int32_t *x)
+{
+    int order = (int)get_bits(r, 2);
+    int param = (int)get_bits(r, 5);
+    if (param == PARAM_CONSTANT) {
+        int32_t v = sign_extend17(get_bits(r, VALUE_BITS));
+        for (int i = 0; i < N; i++) x[i] = v;
+    } else if (param == PARAM_VERBATIM) {
+        for (int i = 0; i < N; i++) x[i] = sign_extend17(get_bits(r, VALUE_BITS));
+    } else if (param <= MAX_RICE_K) {
+        for (int i = 0; i < order; i++) x[i] = sign_extend17(get_bits(r, VALUE_BITS));
+        for (int i = order; i < N && !r->err; i++) {
+            uint32_t q = get_unary(r);
+            if (q > (MAX_UNARY >> param)) r->err = 1;  /* residual beyond 17-bit range */
+            uint32_t u = (q << param) | get_bits(r, param);
+            x[i] = unzigzag(u) + predict(x, i, order);
+            if (x[i] < -65536 || x[i] > 65535) r->err = 1;  /* corrupt: stop before it overflows */
+        }
+    } else {
+        r->err = 1;
+    }
+}
+
+size_t skipback_codec_encode(const int16_t *pcm, uint8_t *out)
+{
+    /* 0 = L, 1 = R, 2 = M, 3 = S */
+    int32_t ch[4][N];
+    for (int i = 0; i < N; i++) {
+        int32_t l = pcm[2 * i], r = pcm[2 * i + 1];
+        int32_t s = l - r;
+        ch[0][i] = l;
+        ch[1][i] = r;
+        ch[2][i] = r + (s >> 1);
+        ch[3][i] = s;
+    }
+
+    chan_plan_t pl[4];
+    for (int c = 0; c < 4; c++) plan_channel(ch[c], &pl[c]);
+    int ms = pl[2].bits + pl[3].bits < pl[0].bits + pl[1].bits;
+
+    bit_writer_t w = { .p = out, .acc = 0, .bits = 0 };
+    put_bits(&w, (uint32_t)ms, 1);
+    write_channel(&w, ch[ms ? 2 : 0], &pl[ms ? 2 : 0]);
+    write_channel(&w, ch[ms ? 3 : 1], &pl[ms ? 3 : 1]);
+    if (w.bits > 0) put_bits(&w, 0, 8 - w.bits);
+    return (size_t)(w.p - out);
+}
+
+int skipback_codec_decode(const uint8_t *in, size_t len, int16_t *pcm)
+{
+    bit_reader_t r = { .p = in, .end = in + len, .acc = 0, .bits = 0, .err = 0 };
+    int32_t a[N], b[N];
+    int ms = (int)get_bits(&r, 1);
+    read_channel(&r, a);
+    if (!r.err) read_channel(&r, b);
+
+    for (int i = 0; i < N && !r.err; i++) {
+        int32_t l, rr;
+        if (ms) {
+            rr = a[i] - (b[i] >> 1);
+            l = rr + b[i];
+        } else {
+            l = a[i];
+            rr = b[i];
+        }
+        if (l < -32768 || l > 32767 || rr < -32768 || rr > 32767) {
+            r.err = 1;
+            break;
+        }
+        pcm[2 * i] = (int16_t)l;
+        pcm[2 * i + 1] = (int16_t)rr;
+    }
+    if (r.err) {
+        memset(pcm, 0, N * 2 * sizeof(int16_t));
+        return -1;
+    }
+    return 0;
+}
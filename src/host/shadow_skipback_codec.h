@@ -0,0 +1,29 @@
+/* shadow_skipback_codec.h - Lossless block codec for compressed skipback history
+ *
+ * Encodes one 128-frame interleaved stereo int16 block at a time, each block
+ * independently decodable so the rolling store can drop its oldest block
+ * without touching the rest. Per block: left/right or mid/side, then per
+ * channel a fixed polynomial predictor (order 0-3, FLAC-style) with Rice
+ * coded residuals, or a constant/verbatim escape. Music typically lands at
+ * 45-60% of PCM size, silence at a few bytes per block. */
+
+#ifndef SHADOW_SKIPBACK_CODEC_H
+#define SHADOW_SKIPBACK_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SKIPBACK_CODEC_BLOCK_FRAMES 128
+
+/* Worst case encoded size (both channels verbatim), rounded up */
+#define SKIPBACK_CODEC_MAX_BYTES 552
+
+/* Encode one block of SKIPBACK_CODEC_BLOCK_FRAMES interleaved stereo frames.
+ * `out` must hold SKIPBACK_CODEC_MAX_BYTES. Returns the encoded size. */
+size_t skipback_codec_encode(const int16_t *pcm, uint8_t *out);
+
+/* Decode one block written by skipback_codec_encode(). Returns 0 on success,
+ * -1 if the data is truncated or malformed (pcm is then zeroed). */
+int skipback_codec_decode(const uint8_t *in, size_t len, int16_t *pcm);
+
+#endif /* SHADOW_SKIPBACK_CODEC_H */
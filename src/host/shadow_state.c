@@ -1,12 +1,25 @@
 /* shadow_state.c - Shadow slot state persistence
  * Extracted from schwung_shim.c for maintainability. */
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <pwd.h>
+#include <pthread.h>
+#include <time.h>
 #include "shadow_state.h"
+#include "shadow_bulk_thread.h"
+
+#define STATE_SLOTS 4
+
+/* Debounce: write once the state has been quiet this long, but never hold a
+ * change back longer than the cap while it keeps changing. */
+#define STATE_SAVE_QUIET_MS 250
+#define STATE_SAVE_MAX_DELAY_MS 2000
 
 /* ============================================================================
  * Host callbacks (set by state_init)
@@ -16,24 +29,212 @@ static void (*host_log)(const char *msg);
 static shadow_chain_slot_t *host_chain_slots;
 static int *host_solo_count;
 
+/* ============================================================================
+ * In-memory model and writer thread
+ *
+ * shadow_save_state() only snapshots the slot fields into `state_pending`
+ * and wakes the writer; the file I/O happens on state_writer_main. A burst
+ * of saves (mute/solo drumming, a volume knob sweep) collapses into one
+ * write. state_write_lock serializes the writer with shadow_flush_state().
+ * ============================================================================ */
+
+typedef struct {
+    float volume[STATE_SLOTS];
+    int channel[STATE_SLOTS];
+    int forward_channel[STATE_SLOTS];
+    int transpose[STATE_SLOTS];
+    int muted[STATE_SLOTS];
+    int soloed[STATE_SLOTS];
+} state_model_t;
+
+static pthread_mutex_t state_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t state_cond;    /* CLOCK_MONOTONIC, set up in state_init */
+static pthread_mutex_t state_write_lock = PTHREAD_MUTEX_INITIALIZER;
+static state_model_t state_pending;
+static uint32_t state_pending_gen;   /* bumped by every save */
+static uint32_t state_written_gen;   /* last generation on disk */
+static int state_writer_running;
+
 /* Fix file ownership after writing as root */
 static void chown_to_ableton(const char *path) {
     struct passwd *pw = getpwnam("ableton");
     if (pw) chown(path, pw->pw_uid, pw->pw_gid);
 }
 
+static void state_write_file(const state_model_t *m);
+static void *state_writer_main(void *arg);
+
 void state_init(const state_host_t *host)
 {
     host_log = host->log;
     host_chain_slots = host->chain_slots;
     host_solo_count = host->solo_count;
+
+    if (!state_writer_running) {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&state_cond, &attr);
+        pthread_condattr_destroy(&attr);
+
+        /* state_init runs from the SPI callback: don't inherit its FIFO core */
+        pthread_t tid;
+        if (shadow_bulk_thread_create(&tid, state_writer_main, NULL, "schwung-state") == 0) {
+            pthread_detach(tid);
+            state_writer_running = 1;
+        } else if (host_log) {
+            host_log("shadow_state: writer thread failed, saving synchronously");
+        }
+    }
+}
+
+/* Caller holds state_lock */
+static void state_snapshot(void)
+{
+    state_model_t *m = &state_pending;
+    for (int i = 0; i < STATE_SLOTS; i++) {
+        m->volume[i] = host_chain_slots[i].volume;
+        m->channel[i] = host_chain_slots[i].channel;
+        m->forward_channel[i] = host_chain_slots[i].forward_channel;
+        m->transpose[i] = host_chain_slots[i].transpose;
+        m->muted[i] = host_chain_slots[i].muted;
+        m->soloed[i] = host_chain_slots[i].soloed;
+    }
+    state_pending_gen++;
+}
+
+static void deadline_after_ms(struct timespec *ts, const struct timespec *from, int ms)
+{
+    *ts = *from;
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static int ts_before(const struct timespec *a, const struct timespec *b)
+{
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/* Write the pending model if it is newer than the file. Called with
+ * state_write_lock held and state_lock not held. */
+static void state_write_pending(void)
+{
+    pthread_mutex_lock(&state_lock);
+    if (state_written_gen == state_pending_gen) {
+        pthread_mutex_unlock(&state_lock);
+        return;
+    }
+    state_model_t m = state_pending;
+    uint32_t gen = state_pending_gen;
+    pthread_mutex_unlock(&state_lock);
+
+    state_write_file(&m);
+
+    pthread_mutex_lock(&state_lock);
+    state_written_gen = gen;
+    pthread_mutex_unlock(&state_lock);
+}
+
+static void *state_writer_main(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&state_lock);
+    for (;;) {
+        while (state_pending_gen == state_written_gen)
+            pthread_cond_wait(&state_cond, &state_lock);
+
+        /* Coalesce: wait for a quiet period, capped from the first change */
+        struct timespec first, cap, quiet;
+        clock_gettime(CLOCK_MONOTONIC, &first);
+        deadline_after_ms(&cap, &first, STATE_SAVE_MAX_DELAY_MS);
+        for (;;) {
+            uint32_t gen = state_pending_gen;
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            deadline_after_ms(&quiet, &now, STATE_SAVE_QUIET_MS);
+            if (ts_before(&cap, &quiet)) quiet = cap;
+            while (state_pending_gen == gen &&
+                   pthread_cond_timedwait(&state_cond, &state_lock, &quiet) != ETIMEDOUT) {
+            }
+            if (state_pending_gen == gen) break;         /* quiet */
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (!ts_before(&now, &cap)) break;           /* held back long enough */
+        }
+        pthread_mutex_unlock(&state_lock);
+
+        pthread_mutex_lock(&state_write_lock);
+        state_write_pending();
+        pthread_mutex_unlock(&state_write_lock);
+
+        pthread_mutex_lock(&state_lock);
+    }
+    return NULL;
 }
 
 /* ============================================================================
- * shadow_save_state - Write slot state to shadow_chain_config.json
+ * shadow_save_state / shadow_flush_state - Record slot state for writing
  * ============================================================================ */
 
 void shadow_save_state(void)
+{
+    pthread_mutex_lock(&state_lock);
+    state_snapshot();
+    if (state_writer_running) pthread_cond_signal(&state_cond);
+    pthread_mutex_unlock(&state_lock);
+
+    if (!state_writer_running) shadow_flush_state();
+}
+
+void shadow_flush_state(void)
+{
+    pthread_mutex_lock(&state_lock);
+    state_snapshot();
+    pthread_mutex_unlock(&state_lock);
+
+    pthread_mutex_lock(&state_write_lock);
+    state_write_pending();
+    pthread_mutex_unlock(&state_write_lock);
+}
+
+/* ============================================================================
+ * state_write_file - Write slot state to shadow_chain_config.json
+ * ============================================================================ */
+
+/* Make the new config durable, then rename it over the old one so readers
+ * (shadow_ui.js, set page copies) never see a half-written file. */
+static int state_commit_file(FILE *f, const char *tmp_path)
+{
+    int ok = fflush(f) == 0 && fsync(fileno(f)) == 0;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        unlink(tmp_path);
+        return -1;
+    }
+    chown_to_ableton(tmp_path);
+    if (rename(tmp_path, SHADOW_CONFIG_PATH) != 0) {
+        unlink(tmp_path);
+        return -1;
+    }
+
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s", SHADOW_CONFIG_PATH);
+    char *slash = strrchr(dir, '/');
+    if (slash) {
+        *slash = '\0';
+        int dfd = open(dir[0] ? dir : "/", O_RDONLY | O_DIRECTORY);
+        if (dfd >= 0) {
+            fsync(dfd);
+            close(dfd);
+        }
+    }
+    return 0;
+}
+
+static void state_write_file(const state_model_t *m)
 {
     /* Read existing config to preserve fields written by shadow_ui.js */
     FILE *f = fopen(SHADOW_CONFIG_PATH, "r");
@@ -170,7 +371,8 @@ void shadow_save_state(void)
     }
 
     /* Write complete config file */
-    f = fopen(SHADOW_CONFIG_PATH, "w");
+    const char *tmp_path = SHADOW_CONFIG_PATH ".tmp";
+    f = fopen(tmp_path, "w");
     if (!f) {
         if (host_log) host_log("shadow_save_state: failed to open for writing");
         return;
@@ -198,51 +400,32 @@ void shadow_save_state(void)
     }
     /* Volume is always the real user-set level; mute/solo are separate flags */
     fprintf(f, "  \"slot_volumes\": [%.3f, %.3f, %.3f, %.3f],\n",
-            host_chain_slots[0].volume,
-            host_chain_slots[1].volume,
-            host_chain_slots[2].volume,
-            host_chain_slots[3].volume);
+            m->volume[0], m->volume[1], m->volume[2], m->volume[3]);
     fprintf(f, "  \"slot_channels\": [%d, %d, %d, %d],\n",
-            host_chain_slots[0].channel,
-            host_chain_slots[1].channel,
-            host_chain_slots[2].channel,
-            host_chain_slots[3].channel);
+            m->channel[0], m->channel[1], m->channel[2], m->channel[3]);
     fprintf(f, "  \"slot_forward_channels\": [%d, %d, %d, %d],\n",
-            host_chain_slots[0].forward_channel,
-            host_chain_slots[1].forward_channel,
-            host_chain_slots[2].forward_channel,
-            host_chain_slots[3].forward_channel);
+            m->forward_channel[0], m->forward_channel[1],
+            m->forward_channel[2], m->forward_channel[3]);
     fprintf(f, "  \"slot_transpose\": [%d, %d, %d, %d],\n",
-            host_chain_slots[0].transpose,
-            host_chain_slots[1].transpose,
-            host_chain_slots[2].transpose,
-            host_chain_slots[3].transpose);
+            m->transpose[0], m->transpose[1], m->transpose[2], m->transpose[3]);
     fprintf(f, "  \"slot_muted\": [%d, %d, %d, %d],\n",
-            host_chain_slots[0].muted,
-            host_chain_slots[1].muted,
-            host_chain_slots[2].muted,
-            host_chain_slots[3].muted);
+            m->muted[0], m->muted[1], m->muted[2], m->muted[3]);
     fprintf(f, "  \"slot_soloed\": [%d, %d, %d, %d]\n",
-            host_chain_slots[0].soloed,
-            host_chain_slots[1].soloed,
-            host_chain_slots[2].soloed,
-            host_chain_slots[3].soloed);
+            m->soloed[0], m->soloed[1], m->soloed[2], m->soloed[3]);
     fprintf(f, "}\n");
-    fclose(f);
-    chown_to_ableton(SHADOW_CONFIG_PATH);
+    if (state_commit_file(f, tmp_path) != 0) {
+        if (host_log) host_log("shadow_save_state: failed to write config");
+        return;
+    }
 
     char msg[320];
     snprintf(msg, sizeof(msg), "Saved slots: ch=[%d,%d,%d,%d] fwd=[%d,%d,%d,%d] vol=[%.2f,%.2f,%.2f,%.2f] muted=[%d,%d,%d,%d] soloed=[%d,%d,%d,%d]",
-             host_chain_slots[0].channel, host_chain_slots[1].channel,
-             host_chain_slots[2].channel, host_chain_slots[3].channel,
-             host_chain_slots[0].forward_channel, host_chain_slots[1].forward_channel,
-             host_chain_slots[2].forward_channel, host_chain_slots[3].forward_channel,
-             host_chain_slots[0].volume, host_chain_slots[1].volume,
-             host_chain_slots[2].volume, host_chain_slots[3].volume,
-             host_chain_slots[0].muted, host_chain_slots[1].muted,
-             host_chain_slots[2].muted, host_chain_slots[3].muted,
-             host_chain_slots[0].soloed, host_chain_slots[1].soloed,
-             host_chain_slots[2].soloed, host_chain_slots[3].soloed);
+             m->channel[0], m->channel[1], m->channel[2], m->channel[3],
+             m->forward_channel[0], m->forward_channel[1],
+             m->forward_channel[2], m->forward_channel[3],
+             m->volume[0], m->volume[1], m->volume[2], m->volume[3],
+             m->muted[0], m->muted[1], m->muted[2], m->muted[3],
+             m->soloed[0], m->soloed[1], m->soloed[2], m->soloed[3]);
     if (host_log) host_log(msg);
 }
 
@@ -284,10 +467,14 @@ void shadow_load_state(void)
         if (pos) {
             float v0, v1, v2, v3;
             if (sscanf(pos, "[%f, %f, %f, %f]", &v0, &v1, &v2, &v3) == 4) {
-                if (v0 < 0.0f) v0 = 0.0f; if (v0 > 4.0f) v0 = 4.0f;
-                if (v1 < 0.0f) v1 = 0.0f; if (v1 > 4.0f) v1 = 4.0f;
-                if (v2 < 0.0f) v2 = 0.0f; if (v2 > 4.0f) v2 = 4.0f;
-                if (v3 < 0.0f) v3 = 0.0f; if (v3 > 4.0f) v3 = 4.0f;
+                if (v0 < 0.0f) v0 = 0.0f;
+                if (v0 > 4.0f) v0 = 4.0f;
+                if (v1 < 0.0f) v1 = 0.0f;
+                if (v1 > 4.0f) v1 = 4.0f;
+                if (v2 < 0.0f) v2 = 0.0f;
+                if (v2 > 4.0f) v2 = 4.0f;
+                if (v3 < 0.0f) v3 = 0.0f;
+                if (v3 > 4.0f) v3 = 4.0f;
                 host_chain_slots[0].volume = v0;
                 host_chain_slots[1].volume = v1;
                 host_chain_slots[2].volume = v2;
@@ -10,7 +10,9 @@
  * Constants
  * ============================================================================ */
 
+#ifndef SHADOW_CONFIG_PATH
 #define SHADOW_CONFIG_PATH "/data/UserData/schwung/shadow_chain_config.json"
+#endif
 
 /* ============================================================================
  * Callback struct
@@ -30,9 +32,17 @@ typedef struct {
 void state_init(const state_host_t *host);
 
 /* Save slot volumes, forward channels, mute/solo to shadow_chain_config.json.
- * Preserves fields written by shadow_ui.js (patches, master_fx, etc.). */
+ * Preserves fields written by shadow_ui.js (patches, master_fx, etc.).
+ * Only records the current values: a background writer coalesces bursts and
+ * writes the file (tmp + fsync + rename) once the state has been quiet for
+ * 250 ms, at most 2 s after the first change. Safe on latency-sensitive
+ * paths. */
 void shadow_save_state(void);
 
+/* Record and write the state now, waiting for the file to be on disk. For
+ * paths that are about to restart or power off Move. */
+void shadow_flush_state(void);
+
 /* Load slot volumes, forward channels, mute/solo from shadow_chain_config.json. */
 void shadow_load_state(void);
 
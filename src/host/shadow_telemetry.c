@@ -0,0 +1,129 @@
+/* shadow_telemetry.c - Per-frame SPI timing telemetry in shared memory
+ *
+ * See shadow_telemetry.h for the reader protocol. The SPI thread is the
+ * only writer; recording a stage is a single store into the staging array
+ * and committing a frame is ~TELEM_STAGE_COUNT counter increments. */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "shadow_constants.h"
+#include "shadow_telemetry.h"
+
+static telemetry_host_t host;
+static telemetry_shm_t *shm = NULL;
+
+/* Current frame, written by the SPI thread and (per slot) render workers */
+static uint32_t staging[TELEM_STAGE_COUNT];
+static uint64_t staging_time_ns;
+
+static const char *stage_names[TELEM_STAGE_COUNT] = {
+    [TELEM_TOTAL] = "total",
+    [TELEM_PRE] = "pre",
+    [TELEM_IOCTL] = "ioctl",
+    [TELEM_POST] = "post",
+    [TELEM_SLOT0_SYNTH] = "s1_synth",
+    [TELEM_SLOT1_SYNTH] = "s2_synth",
+    [TELEM_SLOT2_SYNTH] = "s3_synth",
+    [TELEM_SLOT3_SYNTH] = "s4_synth",
+    [TELEM_SLOT0_FX] = "s1_fx",
+    [TELEM_SLOT1_FX] = "s2_fx",
+    [TELEM_SLOT2_FX] = "s3_fx",
+    [TELEM_SLOT3_FX] = "s4_fx",
+    [TELEM_MASTER_FX] = "master_fx",
+    [TELEM_LINK_READ] = "link_read",
+    [TELEM_MIX] = "mix",
+    [TELEM_RENDER] = "render",
+};
+
+int telemetry_init(const telemetry_host_t *h)
+{
+    if (h) host = *h;
+    if (shm) return 0;
+
+    int fd = shm_open(SHM_SHADOW_TELEMETRY, O_CREAT | O_RDWR, 0666);
+    if (fd < 0) {
+        if (host.log) host.log("Telemetry: shm_open failed, SPI telemetry disabled");
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(telemetry_shm_t)) != 0) {
+        close(fd);
+        if (host.log) host.log("Telemetry: ftruncate failed, SPI telemetry disabled");
+        return -1;
+    }
+    telemetry_shm_t *m = (telemetry_shm_t *)mmap(NULL, sizeof(telemetry_shm_t),
+                                                 PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        if (host.log) host.log("Telemetry: mmap failed, SPI telemetry disabled");
+        return -1;
+    }
+
+    /* Readers check magic last: publish the layout before it */
+    memset(m, 0, sizeof(*m));
+    m->version = TELEMETRY_VERSION;
+    m->stage_count = TELEM_STAGE_COUNT;
+    m->bucket_count = TELEMETRY_BUCKETS;
+    m->ring_size = TELEMETRY_OVERRUN_RING;
+    m->budget_us = TELEMETRY_BUDGET_US;
+    m->overrun_us = TELEMETRY_OVERRUN_US;
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+        strncpy(m->stage_names[i], stage_names[i], TELEMETRY_NAME_LEN - 1);
+    }
+    __atomic_store_n(&m->magic, TELEMETRY_MAGIC, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) staging[i] = TELEMETRY_NOT_RUN;
+    shm = m;
+    if (host.log) host.log("Telemetry: /schwung-telemetry ready");
+    return 0;
+}
+
+void telemetry_frame_begin(uint64_t now_ns)
+{
+    if (!shm) return;
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) staging[i] = TELEMETRY_NOT_RUN;
+    staging_time_ns = now_ns;
+}
+
+void telemetry_record(telemetry_stage_t stage, uint32_t us)
+{
+    if (!shm || (unsigned)stage >= TELEM_STAGE_COUNT) return;
+    uint32_t prev = staging[stage];
+    staging[stage] = (prev == TELEMETRY_NOT_RUN) ? us : prev + us;
+}
+
+void telemetry_frame_end(void)
+{
+    if (!shm) return;
+
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+        uint32_t us = staging[i];
+        if (us == TELEMETRY_NOT_RUN) continue;
+        telemetry_hist_t *h = &shm->hist[i];
+        h->buckets[telemetry_bucket(us)]++;
+        h->sum_us += us;
+        h->last_us = us;
+        if (us > h->max_us) h->max_us = us;
+        __atomic_store_n(&h->count, h->count + 1, __ATOMIC_RELEASE);
+    }
+
+    uint64_t frame = shm->frames + 1;
+    uint32_t total = staging[TELEM_TOTAL];
+    if (total != TELEMETRY_NOT_RUN && total > TELEMETRY_OVERRUN_US) {
+        uint32_t w = shm->ring_write;
+        telemetry_frame_t *e = &shm->ring[w & (TELEMETRY_OVERRUN_RING - 1)];
+        uint32_t seq = e->seq;
+        __atomic_store_n(&e->seq, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        e->frame = frame;
+        e->time_ns = staging_time_ns;
+        memcpy(e->stage_us, staging, sizeof(staging));
+        __atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+        __atomic_store_n(&shm->ring_write, w + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&shm->overruns, shm->overruns + 1, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&shm->frames, frame, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,133 @@
+/* shadow_telemetry.h - Per-frame SPI timing telemetry in shared memory
+ *
+ * The SPI callback records how long each stage of a frame took (pre/ioctl/
+ * post, each slot's synth and FX, master FX, Link Audio reads). At the end
+ * of the frame the SPI thread folds those numbers into per-stage
+ * log-bucketed histograms and, when the frame ran over the threshold,
+ * copies the full breakdown into a small ring of recent overruns.
+ *
+ * Everything lives in /schwung-telemetry so readers (schwung-telemetry CLI,
+ * schwung-manager) see the live distribution without the shim doing any
+ * I/O. There is exactly one writer — the SPI thread — so the shim side is
+ * plain stores:
+ *   - histogram counters only grow; readers diff two snapshots
+ *   - ring entries carry a seqlock (odd while being written); readers
+ *     retry or skip an entry whose seq changed during the copy
+ *
+ * Slot stages may be recorded from render pool workers. Each worker only
+ * touches its own slot's entries, and the frame is committed after the pool
+ * has joined. */
+
+#ifndef SHADOW_TELEMETRY_H
+#define SHADOW_TELEMETRY_H
+
+#include <stdint.h>
+
+#define TELEMETRY_MAGIC         0x4D4C4554u  /* "TELM" */
+#define TELEMETRY_VERSION       1
+#define TELEMETRY_BUCKETS       64           /* quarter-octave, see telemetry_bucket() */
+#define TELEMETRY_OVERRUN_RING  64           /* power of two */
+#define TELEMETRY_NAME_LEN      16
+#define TELEMETRY_BUDGET_US     2902         /* 128 frames @ 44.1kHz */
+#define TELEMETRY_OVERRUN_US    2000         /* matches the shim's overrun counter */
+#define TELEMETRY_NOT_RUN       0xFFFFFFFFu  /* stage did not run this frame */
+
+typedef enum {
+    TELEM_TOTAL = 0,
+    TELEM_PRE,
+    TELEM_IOCTL,
+    TELEM_POST,
+    TELEM_SLOT0_SYNTH,
+    TELEM_SLOT1_SYNTH,
+    TELEM_SLOT2_SYNTH,
+    TELEM_SLOT3_SYNTH,
+    TELEM_SLOT0_FX,
+    TELEM_SLOT1_FX,
+    TELEM_SLOT2_FX,
+    TELEM_SLOT3_FX,
+    TELEM_MASTER_FX,
+    TELEM_LINK_READ,
+    TELEM_MIX,
+    TELEM_RENDER,
+    TELEM_STAGE_COUNT
+} telemetry_stage_t;
+
+typedef struct telemetry_hist_t {
+    uint64_t sum_us;
+    uint32_t count;                 /* frames in which the stage ran */
+    uint32_t max_us;
+    uint32_t last_us;
+    uint32_t reserved;
+    uint32_t buckets[TELEMETRY_BUCKETS];
+} telemetry_hist_t;
+
+typedef struct telemetry_frame_t {
+    volatile uint32_t seq;          /* seqlock: odd while the writer is copying */
+    uint32_t reserved;
+    uint64_t frame;                 /* frame counter at the time of the overrun */
+    uint64_t time_ns;               /* CLOCK_MONOTONIC at frame start */
+    uint32_t stage_us[TELEM_STAGE_COUNT];
+} telemetry_frame_t;
+
+typedef struct telemetry_shm_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stage_count;
+    uint32_t bucket_count;
+    uint32_t ring_size;
+    uint32_t budget_us;
+    uint32_t overrun_us;
+    uint32_t reserved;
+    volatile uint64_t frames;       /* committed frames */
+    volatile uint64_t overruns;     /* frames with total > overrun_us */
+    volatile uint32_t ring_write;   /* free-running; newest entry is ring_write - 1 */
+    uint32_t reserved2;
+    char stage_names[TELEM_STAGE_COUNT][TELEMETRY_NAME_LEN];
+    telemetry_hist_t hist[TELEM_STAGE_COUNT];
+    telemetry_frame_t ring[TELEMETRY_OVERRUN_RING];
+} telemetry_shm_t;
+
+/* Layout is read byte-wise by schwung-manager (shmtelemetry.go) */
+typedef char telemetry_shm_size_check[(sizeof(telemetry_shm_t) == 10424) ? 1 : -1];
+
+/* Bucket for a duration: 0-7us map 1:1, then four buckets per octave
+ * (~19% wide), the last bucket catches everything above ~114ms. */
+static inline int telemetry_bucket(uint32_t us)
+{
+    if (us < 8) return (int)us;
+    int msb = 31 - __builtin_clz(us);
+    int b = 4 * (msb - 1) + (int)((us >> (msb - 2)) & 3);
+    return b < TELEMETRY_BUCKETS ? b : TELEMETRY_BUCKETS - 1;
+}
+
+/* Smallest duration that falls into bucket b. */
+static inline uint32_t telemetry_bucket_floor(int b)
+{
+    if (b < 8) return (uint32_t)b;
+    int msb = b / 4 + 1;
+    return (1u << msb) | ((uint32_t)(b & 3) << (msb - 2));
+}
+
+typedef struct {
+    void (*log)(const char *msg);
+} telemetry_host_t;
+
+/* Create /schwung-telemetry and reset the histograms. Not RT-safe; call
+ * once at shim init. Recording is a no-op if the segment is unavailable. */
+int telemetry_init(const telemetry_host_t *host);
+
+/* SPI thread: start a frame. Every stage reads as not-run until recorded. */
+void telemetry_frame_begin(uint64_t now_ns);
+
+/* Add `us` to a stage of the current frame. Stages recorded more than once
+ * per frame (e.g. Link Audio reads per channel) accumulate. */
+void telemetry_record(telemetry_stage_t stage, uint32_t us);
+
+/* SPI thread: fold the frame into the histograms and the overrun ring. */
+void telemetry_frame_end(void);
+
+/* Microseconds between two CLOCK_MONOTONIC timestamps, for call sites. */
+#define TELEMETRY_US(t0, t1) \
+    ((uint32_t)(((t1).tv_sec - (t0).tv_sec) * 1000000LL + ((t1).tv_nsec - (t0).tv_nsec) / 1000))
+
+#endif /* SHADOW_TELEMETRY_H */
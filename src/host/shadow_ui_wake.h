@@ -0,0 +1,56 @@
+/* shadow_ui_wake.h - Wake the shadow UI when the shim publishes work for it
+ *
+ * shadow_control->ui_wake_seq is a cross-process futex. The shim bumps it
+ * after publishing UI MIDI or param ring responses; the shadow UI blocks on
+ * it until its next tick is due instead of sleeping a fixed interval, so
+ * input is handled as soon as it arrives.
+ *
+ * ui_waiting keeps the shim off the syscall unless the UI is actually
+ * asleep: the UI raises it before re-checking the sequence, the shim bumps
+ * the sequence before taking the flag, so one of them always sees the
+ * other. At most one FUTEX_WAKE is issued per UI sleep. */
+
+#ifndef SHADOW_UI_WAKE_H
+#define SHADOW_UI_WAKE_H
+
+#include <linux/futex.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shadow_constants.h"
+
+/* Shim side: safe on the SPI thread. */
+static inline void shadow_ui_wake(shadow_control_t *ctl)
+{
+    if (!ctl) return;
+    __atomic_add_fetch(&ctl->ui_wake_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_exchange_n(&ctl->ui_waiting, 0, __ATOMIC_SEQ_CST))
+        syscall(SYS_futex, &ctl->ui_wake_seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/* UI side: block for up to timeout_us unless the sequence has moved past
+ * *seen. Returns 1 if woken by the shim (and updates *seen), 0 on timeout. */
+static inline int shadow_ui_wait(shadow_control_t *ctl, uint32_t *seen, long timeout_us)
+{
+    if (!ctl) {
+        if (timeout_us > 0) usleep((useconds_t)timeout_us);
+        return 0;
+    }
+    __atomic_store_n(&ctl->ui_waiting, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ctl->ui_wake_seq, __ATOMIC_SEQ_CST) == *seen && timeout_us > 0) {
+        struct timespec ts = {
+            .tv_sec = timeout_us / 1000000,
+            .tv_nsec = (timeout_us % 1000000) * 1000,
+        };
+        syscall(SYS_futex, &ctl->ui_wake_seq, FUTEX_WAIT, *seen, &ts, NULL, 0);
+    }
+    __atomic_store_n(&ctl->ui_waiting, 0, __ATOMIC_RELAXED);
+    uint32_t now = __atomic_load_n(&ctl->ui_wake_seq, __ATOMIC_ACQUIRE);
+    if (now == *seen) return 0;
+    *seen = now;
+    return 1;
+}
+
+#endif /* SHADOW_UI_WAKE_H */
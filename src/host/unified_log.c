@@ -1,4 +1,6 @@
+#define _GNU_SOURCE
 #include "unified_log.h"
+#include "shadow_bulk_thread.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,6 +9,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <stdint.h>
 
 static FILE *log_file = NULL;
 static int log_crash_fd = -1;  /* Async-signal-safe FD for crash logging */
@@ -15,6 +18,33 @@ static int log_enabled_cache = 0;
 static int check_counter = 0;
 #define CHECK_INTERVAL 100  /* Check flag file every N calls */
 
+/* Realtime records: bounded MPMC ring (Vyukov). A producer claims a slot by
+ * CAS on rt_head, fills it and publishes with seq = pos + 1; the single
+ * drain thread consumes in order and frees the slot with seq = pos + size. */
+#define RT_RING_SIZE 1024  /* power of two; ~96 KB */
+#define RT_DRAIN_INTERVAL_US 20000
+#define RT_FLAG_CHECK_LOOPS 50  /* re-check the flag file every ~1s */
+
+typedef struct {
+    uint32_t seq;
+    uint8_t level;
+    uint8_t nargs;
+    uint64_t ts_ns;  /* CLOCK_REALTIME */
+    const char *source;
+    const char *fmt;
+    unified_log_arg_t args[UNIFIED_LOG_RT_MAX_ARGS];
+} rt_record_t;
+
+static rt_record_t rt_ring[RT_RING_SIZE];
+static uint32_t rt_head = 0;
+static uint32_t rt_tail = 0;       /* drain thread only */
+static int rt_ready = 0;           /* ring initialised and drain running */
+static int rt_stop = 0;
+static unsigned int rt_dropped = 0;
+static pthread_t rt_thread;
+static void *rt_drain_main(void *arg);
+static void rt_drain_records(void);
+
 void unified_log_init(void) {
     pthread_mutex_lock(&log_mutex);
     if (!log_file) {
@@ -31,9 +61,24 @@ void unified_log_init(void) {
     /* Initial flag check */
     log_enabled_cache = (access(UNIFIED_LOG_FLAG, F_OK) == 0) ? 1 : 0;
     pthread_mutex_unlock(&log_mutex);
+
+    if (__atomic_load_n(&rt_ready, __ATOMIC_ACQUIRE)) return;
+    for (uint32_t i = 0; i < RT_RING_SIZE; i++) rt_ring[i].seq = i;
+    rt_head = rt_tail = 0;
+    __atomic_store_n(&rt_stop, 0, __ATOMIC_RELAXED);
+
+    if (shadow_bulk_thread_create(&rt_thread, rt_drain_main, NULL, "schwung-log") != 0)
+        return;  /* unified_log_rt() stays a no-op */
+    __atomic_store_n(&rt_ready, 1, __ATOMIC_RELEASE);
 }
 
 void unified_log_shutdown(void) {
+    if (__atomic_exchange_n(&rt_ready, 0, __ATOMIC_ACQ_REL)) {
+        __atomic_store_n(&rt_stop, 1, __ATOMIC_RELEASE);
+        pthread_join(rt_thread, NULL);
+        rt_drain_records();
+    }
+
     pthread_mutex_lock(&log_mutex);
     if (log_file) {
         time_t now = time(NULL);
@@ -115,6 +160,215 @@ void unified_log(const char *source, int level, const char *fmt, ...) {
     va_end(args);
 }
 
+/* ---- realtime records ---- */
+
+void unified_log_rt(const char *source, int level, const char *fmt,
+                    int nargs, const unified_log_arg_t *args) {
+    if (!__atomic_load_n(&rt_ready, __ATOMIC_ACQUIRE)) return;
+    if (!__atomic_load_n(&log_enabled_cache, __ATOMIC_RELAXED)) return;
+    if (nargs > UNIFIED_LOG_RT_MAX_ARGS) {
+        __atomic_fetch_add(&rt_dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    rt_record_t *rec;
+    uint32_t pos = __atomic_load_n(&rt_head, __ATOMIC_RELAXED);
+    for (;;) {
+        rec = &rt_ring[pos & (RT_RING_SIZE - 1)];
+        uint32_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        int32_t dif = (int32_t)(seq - pos);
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&rt_head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        } else if (dif < 0) {
+            __atomic_fetch_add(&rt_dropped, 1, __ATOMIC_RELAXED);  /* full */
+            return;
+        } else {
+            pos = __atomic_load_n(&rt_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);  /* vDSO, no syscall */
+    rec->ts_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    rec->level = (uint8_t)level;
+    rec->nargs = (uint8_t)nargs;
+    rec->source = source;
+    rec->fmt = fmt;
+    for (int i = 0; i < nargs; i++) rec->args[i] = args[i];
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+unsigned int unified_log_rt_dropped(void) {
+    return __atomic_load_n(&rt_dropped, __ATOMIC_RELAXED);
+}
+
+/* printf one conversion from a record. `spec` holds '%', flags, width and
+ * precision already resolved to digits; the length modifier is rebuilt here
+ * so every integer goes through long long with the original width's
+ * truncation and signedness. */
+static int rt_format_one(char *out, size_t cap, const char *spec, size_t spec_len,
+                         const char *len_mod, char conv, const unified_log_arg_t *a) {
+    char f[48];
+    if (spec_len > sizeof(f) - 4) return 0;
+    memcpy(f, spec, spec_len);
+    size_t n = spec_len;
+    long long v = a->i;
+    int is_h = !strcmp(len_mod, "h"), is_hh = !strcmp(len_mod, "hh");
+    int is_wide = len_mod[0] == 'l' || len_mod[0] == 'z' || len_mod[0] == 'j' || len_mod[0] == 't';
+
+    switch (conv) {
+    case 'd': case 'i':
+        if (is_hh) v = (signed char)v;
+        else if (is_h) v = (short)v;
+        else if (!is_wide) v = (int)v;
+        f[n++] = 'l'; f[n++] = 'l'; f[n++] = conv; f[n] = '\0';
+        return snprintf(out, cap, f, v);
+    case 'u': case 'x': case 'X': case 'o': {
+        unsigned long long u = (unsigned long long)v;
+        if (is_hh) u = (unsigned char)u;
+        else if (is_h) u = (unsigned short)u;
+        else if (!is_wide) u = (unsigned int)u;
+        f[n++] = 'l'; f[n++] = 'l'; f[n++] = conv; f[n] = '\0';
+        return snprintf(out, cap, f, u);
+    }
+    case 'c':
+        f[n++] = 'c'; f[n] = '\0';
+        return snprintf(out, cap, f, (int)v);
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+        f[n++] = conv; f[n] = '\0';
+        return snprintf(out, cap, f, a->d);
+    case 's':
+        f[n++] = 's'; f[n] = '\0';
+        return snprintf(out, cap, f, a->p ? (const char *)a->p : "(null)");
+    case 'p':
+        f[n++] = 'p'; f[n] = '\0';
+        return snprintf(out, cap, f, a->p);
+    default:
+        return snprintf(out, cap, "%%%c", conv);
+    }
+}
+
+static void rt_format(char *out, size_t cap, const rt_record_t *rec) {
+    const char *p = rec->fmt;
+    size_t o = 0;
+    int argi = 0;
+    while (*p && o + 1 < cap) {
+        if (*p != '%') {
+            out[o++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[o++] = '%';
+            p += 2;
+            continue;
+        }
+
+        /* %[flags][width][.precision][length]conv, '*' taken from the args */
+        char spec[40];
+        size_t sn = 0;
+        spec[sn++] = *p++;
+        while (*p && strchr("-+ #0'", *p) && sn < 8) spec[sn++] = *p++;
+        for (int part = 0; part < 2; part++) {
+            if (part == 1) {
+                if (*p != '.') break;
+                spec[sn++] = *p++;
+            }
+            if (*p == '*') {
+                p++;
+                int v = argi < rec->nargs ? (int)rec->args[argi++].i : 0;
+                sn += (size_t)snprintf(spec + sn, sizeof(spec) - sn, "%d", v);
+            } else {
+                while (*p >= '0' && *p <= '9' && sn < 24) spec[sn++] = *p++;
+            }
+        }
+        char len_mod[3] = "";
+        int ln = 0;
+        while (*p && strchr("hlzjtLq", *p) && ln < 2) len_mod[ln++] = *p++;
+        len_mod[ln] = '\0';
+        char conv = *p ? *p++ : '\0';
+        if (!conv) break;
+        if (conv == 'n') {
+            argi++;
+            continue;
+        }
+        if (argi >= rec->nargs) {
+            /* Fewer args than conversions: leave the spec visible */
+            int w = snprintf(out + o, cap - o, "%.*s%s%c", (int)sn, spec, len_mod, conv);
+            if (w > 0) o += (size_t)w;
+            if (o >= cap) o = cap - 1;
+            continue;
+        }
+        int w = rt_format_one(out + o, cap - o, spec, sn, len_mod, conv, &rec->args[argi++]);
+        if (w > 0) o += (size_t)w;
+        if (o >= cap) o = cap - 1;
+    }
+    out[o] = '\0';
+}
+
+/* Take every published record off the ring and write it. Drain thread (or
+ * shutdown after the drain thread has exited) only. */
+static void rt_drain_records(void) {
+    static unsigned int reported_dropped = 0;
+    int wrote = 0;
+
+    pthread_mutex_lock(&log_mutex);
+    for (;;) {
+        rt_record_t *slot = &rt_ring[rt_tail & (RT_RING_SIZE - 1)];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != rt_tail + 1) break;
+        rt_record_t rec = *slot;
+        __atomic_store_n(&slot->seq, rt_tail + RT_RING_SIZE, __ATOMIC_RELEASE);
+        rt_tail++;
+
+        if (!log_file) log_file = fopen(UNIFIED_LOG_PATH, "a");
+        if (!log_file) continue;
+        char msg[512];
+        rt_format(msg, sizeof(msg), &rec);
+        time_t sec = (time_t)(rec.ts_ns / 1000000000ull);
+        struct tm tm_buf;
+        struct tm *tm_info = localtime_r(&sec, &tm_buf);
+        fprintf(log_file, "%02d:%02d:%02d.%03d [%s] [%s] %s\n",
+                tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec,
+                (int)((rec.ts_ns / 1000000ull) % 1000),
+                level_str(rec.level),
+                rec.source ? rec.source : "???", msg);
+        wrote = 1;
+    }
+
+    unsigned int dropped = __atomic_load_n(&rt_dropped, __ATOMIC_RELAXED);
+    if (dropped != reported_dropped && log_file) {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        struct tm tm_buf;
+        struct tm *tm_info = localtime_r(&tv.tv_sec, &tm_buf);
+        fprintf(log_file, "%02d:%02d:%02d.%03d [%s] [log] %u realtime records dropped (ring full)\n",
+                tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec,
+                (int)(tv.tv_usec / 1000), level_str(LOG_LEVEL_WARN),
+                dropped - reported_dropped);
+        reported_dropped = dropped;
+        wrote = 1;
+    }
+    if (wrote) fflush(log_file);
+    pthread_mutex_unlock(&log_mutex);
+}
+
+static void *rt_drain_main(void *arg) {
+    (void)arg;
+    int loops = 0;
+    while (!__atomic_load_n(&rt_stop, __ATOMIC_ACQUIRE)) {
+        usleep(RT_DRAIN_INTERVAL_US);
+        /* The flag file check moves here so producers never call access() */
+        if (++loops >= RT_FLAG_CHECK_LOOPS) {
+            loops = 0;
+            int on = (access(UNIFIED_LOG_FLAG, F_OK) == 0) ? 1 : 0;
+            __atomic_store_n(&log_enabled_cache, on, __ATOMIC_RELAXED);
+        }
+        rt_drain_records();
+    }
+    return NULL;
+}
+
 /* Async-signal-safe integer-to-string helper */
 static int crash_itoa(int val, char *buf, int buflen) {
     if (buflen < 2) return 0;
@@ -13,9 +13,13 @@ extern "C" {
 #define LOG_LEVEL_INFO  2
 #define LOG_LEVEL_DEBUG 3
 
-/* Default log file location */
+/* Default log file location (overridable for host tests) */
+#ifndef UNIFIED_LOG_PATH
 #define UNIFIED_LOG_PATH "/data/UserData/schwung/debug.log"
+#endif
+#ifndef UNIFIED_LOG_FLAG
 #define UNIFIED_LOG_FLAG "/data/UserData/schwung/debug_log_on"
+#endif
 
 /* Initialize/shutdown logging system */
 void unified_log_init(void);
@@ -31,12 +35,85 @@ void unified_log_v(const char *source, int level, const char *fmt, va_list args)
 /* Async-signal-safe crash logger - uses write() only, no mutex, no malloc */
 void unified_log_crash(const char *msg);
 
+/* Realtime-safe logging.
+ *
+ * unified_log_rt() copies a fixed-size binary record (timestamp, source,
+ * level, format pointer, up to UNIFIED_LOG_RT_MAX_ARGS packed args) into a
+ * lock-free ring and returns; no syscalls, locks or allocation. The
+ * schwung-log thread started by unified_log_init() formats and writes the
+ * records. When the ring is full the record is dropped and counted.
+ *
+ * The source, format and any %s argument must outlive the call (string
+ * literals): they are read later, on the drain thread. Supported
+ * conversions are d i u x X o c e f g a s p with flags, width, precision
+ * and h/hh/l/ll/z lengths; '*' width/precision consume an int argument.
+ *
+ * Use the LOG_RT_* macros, which pack the arguments by type. */
+#define UNIFIED_LOG_RT_MAX_ARGS 8
+
+typedef union {
+    long long i;
+    double d;
+    const void *p;
+} unified_log_arg_t;
+
+void unified_log_rt(const char *source, int level, const char *fmt,
+                    int nargs, const unified_log_arg_t *args);
+
+/* Records dropped because the ring was full (or more args than fit) */
+unsigned int unified_log_rt_dropped(void);
+
 /* Convenience macros */
 #define LOG_ERROR(src, ...) unified_log(src, LOG_LEVEL_ERROR, __VA_ARGS__)
 #define LOG_WARN(src, ...)  unified_log(src, LOG_LEVEL_WARN, __VA_ARGS__)
 #define LOG_INFO(src, ...)  unified_log(src, LOG_LEVEL_INFO, __VA_ARGS__)
 #define LOG_DEBUG(src, ...) unified_log(src, LOG_LEVEL_DEBUG, __VA_ARGS__)
 
+#ifndef __cplusplus
+static inline unified_log_arg_t unified_log_arg_i(long long v) {
+    unified_log_arg_t a; a.i = v; return a;
+}
+static inline unified_log_arg_t unified_log_arg_d(double v) {
+    unified_log_arg_t a; a.d = v; return a;
+}
+static inline unified_log_arg_t unified_log_arg_p(const void *v) {
+    unified_log_arg_t a; a.p = v; return a;
+}
+
+#define UNIFIED_LOG_RT_ARG(x) _Generic((x), \
+    float: unified_log_arg_d, double: unified_log_arg_d, \
+    char *: unified_log_arg_p, const char *: unified_log_arg_p, \
+    void *: unified_log_arg_p, const void *: unified_log_arg_p, \
+    default: unified_log_arg_i)(x)
+
+#define UNIFIED_LOG_RT_N(...) UNIFIED_LOG_RT_N_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define UNIFIED_LOG_RT_N_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define UNIFIED_LOG_RT_CAT(a, b) UNIFIED_LOG_RT_CAT_(a, b)
+#define UNIFIED_LOG_RT_CAT_(a, b) a##b
+#define UNIFIED_LOG_RT_MAP_0() unified_log_arg_i(0)
+#define UNIFIED_LOG_RT_MAP_1(a) UNIFIED_LOG_RT_ARG(a)
+#define UNIFIED_LOG_RT_MAP_2(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_1(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_3(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_2(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_4(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_3(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_5(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_4(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_6(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_5(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_7(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_6(__VA_ARGS__)
+#define UNIFIED_LOG_RT_MAP_8(a, ...) UNIFIED_LOG_RT_ARG(a), UNIFIED_LOG_RT_MAP_7(__VA_ARGS__)
+
+/* LOG_RT(src, level, fmt, ...) - up to 8 integer, floating, string or
+ * pointer arguments; more is a compile error. */
+#define LOG_RT(src, level, fmt, ...) do { \
+    const unified_log_arg_t unified_log_rt_args_[] = { \
+        UNIFIED_LOG_RT_CAT(UNIFIED_LOG_RT_MAP_, UNIFIED_LOG_RT_N(__VA_ARGS__))(__VA_ARGS__) }; \
+    unified_log_rt((src), (level), (fmt), UNIFIED_LOG_RT_N(__VA_ARGS__), unified_log_rt_args_); \
+} while (0)
+
+#define LOG_RT_ERROR(src, ...) LOG_RT(src, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_RT_WARN(src, ...)  LOG_RT(src, LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_RT_INFO(src, ...)  LOG_RT(src, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_RT_DEBUG(src, ...) LOG_RT(src, LOG_LEVEL_DEBUG, __VA_ARGS__)
+#endif /* !__cplusplus */
+
 #ifdef __cplusplus
 }
 #endif
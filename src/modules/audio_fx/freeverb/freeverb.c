@@ -3,6 +3,17 @@
  *
  * Classic Schroeder-Moorer reverb algorithm.
  * Based on public domain Freeverb by Jezar at Dreampoint.
+ *
+ * The 8 combs x 2 channels all see the same mono input, so they run as one
+ * 16-lane bank: per sample, lanes 0-7 (left) and 8-15 (right) load their
+ * delayed output, update the damping lowpass and write back. Each lane
+ * keeps its own delay line, stored lane-major in one block so every lane
+ * streams through memory sequentially. Blocks are split where any lane
+ * wraps, so the inner loop has no index checks.
+ *
+ * The allpasses then run one at a time over the whole block. Delay lengths,
+ * the per-comb arithmetic and the order of the 8-comb sums are those of the
+ * per-sample version.
  */
 
 #include <stdio.h>
@@ -34,13 +45,18 @@ static const int allpass_tuning_r[NUM_ALLPASSES] = { 556 + 23, 441 + 23, 341 + 2
 /* Maximum delay length */
 #define MAX_DELAY 2048
 
-/* Comb filter state */
+/* Comb bank: lanes 0-7 are comb_tuning_l, 8-15 comb_tuning_r */
+#define COMB_LANES (NUM_COMBS * 2)
+
+/* Frames per internal pass (stack scratch size) */
+#define FV_BLOCK 128
+
 typedef struct {
-    float buffer[MAX_DELAY];
-    int bufsize;
-    int bufidx;
-    float filterstore;
-} comb_filter_t;
+    float buffer[COMB_LANES][MAX_DELAY];
+    int bufsize[COMB_LANES];
+    int bufidx[COMB_LANES];
+    float filterstore[COMB_LANES];
+} comb_bank_t;
 
 /* Allpass filter state */
 typedef struct {
@@ -69,8 +85,7 @@ typedef struct {
     float wet2;
 
     /* Filter instances */
-    comb_filter_t comb_l[NUM_COMBS];
-    comb_filter_t comb_r[NUM_COMBS];
+    comb_bank_t combs;
     allpass_filter_t allpass_l[NUM_ALLPASSES];
     allpass_filter_t allpass_r[NUM_ALLPASSES];
 } freeverb_instance_t;
@@ -84,21 +99,70 @@ static void v2_log(const char *msg) {
     }
 }
 
-/* Initialize a comb filter */
-static void comb_init(comb_filter_t *c, int size) {
-    memset(c->buffer, 0, sizeof(c->buffer));
-    c->bufsize = (size < MAX_DELAY) ? size : MAX_DELAY;
-    c->bufidx = 0;
-    c->filterstore = 0.0f;
+/* Initialize the comb bank */
+static void comb_bank_init(comb_bank_t *b) {
+    memset(b, 0, sizeof(*b));
+    for (int c = 0; c < NUM_COMBS; c++) {
+        b->bufsize[c] = (comb_tuning_l[c] < MAX_DELAY) ? comb_tuning_l[c] : MAX_DELAY;
+        b->bufsize[NUM_COMBS + c] = (comb_tuning_r[c] < MAX_DELAY) ? comb_tuning_r[c] : MAX_DELAY;
+    }
 }
 
-/* Process one sample through comb filter (instance-based) */
-static inline float comb_process(comb_filter_t *c, float input, float feedback, float damp1, float damp2) {
-    float output = c->buffer[c->bufidx];
-    c->filterstore = (output * damp2) + (c->filterstore * damp1);
-    c->buffer[c->bufidx] = input + (c->filterstore * feedback);
-    if (++c->bufidx >= c->bufsize) c->bufidx = 0;
-    return output;
+/* Run `len` samples through all 16 combs. p[k] points at lane k's current
+ * position, with at least `len` samples before its wrap. Per lane this is
+ * the classic comb:
+ *   output = buf; filterstore = output*damp2 + filterstore*damp1;
+ *   buf = input + filterstore*feedback
+ * sum_l / sum_r receive the sum of the 8 left / right outputs. */
+static void comb_bank_run(float *const p[COMB_LANES], float *filterstore,
+                          const float *input, float *sum_l, float *sum_r, int len,
+                          float feedback, float damp1, float damp2) {
+    float fs[COMB_LANES];
+    memcpy(fs, filterstore, sizeof(fs));
+
+    for (int i = 0; i < len; i++) {
+        float y[COMB_LANES];
+        for (int k = 0; k < COMB_LANES; k++) y[k] = p[k][i];
+        for (int k = 0; k < COMB_LANES; k++) {
+            fs[k] = (y[k] * damp2) + (fs[k] * damp1);
+            p[k][i] = input[i] + (fs[k] * feedback);
+        }
+        float l = 0.0f, r = 0.0f;
+        for (int k = 0; k < NUM_COMBS; k++) {
+            l += y[k];
+            r += y[NUM_COMBS + k];
+        }
+        sum_l[i] = l;
+        sum_r[i] = r;
+    }
+
+    memcpy(filterstore, fs, sizeof(fs));
+}
+
+/* Process `frames` (<= FV_BLOCK) mono input samples through the comb bank */
+static void comb_bank_process(comb_bank_t *b, const float *input,
+                              float *sum_l, float *sum_r, int frames,
+                              float feedback, float damp1, float damp2) {
+    int done = 0;
+    while (done < frames) {
+        /* Largest run in which no lane wraps */
+        int len = frames - done;
+        for (int k = 0; k < COMB_LANES; k++) {
+            int room = b->bufsize[k] - b->bufidx[k];
+            if (room < len) len = room;
+        }
+
+        float *p[COMB_LANES];
+        for (int k = 0; k < COMB_LANES; k++) p[k] = b->buffer[k] + b->bufidx[k];
+        comb_bank_run(p, b->filterstore, input + done, sum_l + done, sum_r + done,
+                      len, feedback, damp1, damp2);
+
+        for (int k = 0; k < COMB_LANES; k++) {
+            b->bufidx[k] += len;
+            if (b->bufidx[k] >= b->bufsize[k]) b->bufidx[k] = 0;
+        }
+        done += len;
+    }
 }
 
 /* Initialize an allpass filter */
@@ -108,13 +172,23 @@ static void allpass_init(allpass_filter_t *a, int size) {
     a->bufidx = 0;
 }
 
-/* Process one sample through allpass filter */
-static inline float allpass_process(allpass_filter_t *a, float input) {
-    float bufout = a->buffer[a->bufidx];
-    float output = -input + bufout;
-    a->buffer[a->bufidx] = input + (bufout * 0.5f);
-    if (++a->bufidx >= a->bufsize) a->bufidx = 0;
-    return output;
+/* Run a block of samples through an allpass filter, in place */
+static void allpass_process_block(allpass_filter_t *a, float *io, int frames) {
+    int done = 0;
+    while (done < frames) {
+        int len = a->bufsize - a->bufidx;
+        if (len > frames - done) len = frames - done;
+        float *buf = a->buffer + a->bufidx;
+        for (int i = 0; i < len; i++) {
+            float input = io[done + i];
+            float bufout = buf[i];
+            io[done + i] = -input + bufout;
+            buf[i] = input + (bufout * 0.5f);
+        }
+        a->bufidx += len;
+        if (a->bufidx >= a->bufsize) a->bufidx = 0;
+        done += len;
+    }
 }
 
 /* Update derived parameters (instance-based) */
@@ -148,10 +222,7 @@ static void* v2_create_instance(const char *module_dir, const char *config_json)
     inst->width = 1.0f;
 
     /* Initialize comb filters */
-    for (int i = 0; i < NUM_COMBS; i++) {
-        comb_init(&inst->comb_l[i], comb_tuning_l[i]);
-        comb_init(&inst->comb_r[i], comb_tuning_r[i]);
-    }
+    comb_bank_init(&inst->combs);
 
     /* Initialize allpass filters */
     for (int i = 0; i < NUM_ALLPASSES; i++) {
@@ -173,52 +244,86 @@ static void v2_destroy_instance(void *instance) {
     free(inst);
 }
 
-static void v2_process_block(void *instance, int16_t *audio_inout, int frames) {
-    freeverb_instance_t *inst = (freeverb_instance_t*)instance;
-    if (!inst) return;
+/* Process interleaved stereo (float, 1.0 = int16 full scale, unclamped).
+ * in and out may be the same buffer. */
+static void fv_process(freeverb_instance_t *inst, const float *in, float *out, int frames) {
+    float input[FV_BLOCK], out_l[FV_BLOCK], out_r[FV_BLOCK];
 
-    for (int i = 0; i < frames; i++) {
-        /* Convert to float (-1.0 to 1.0) */
-        float in_l = audio_inout[i * 2] / 32768.0f;
-        float in_r = audio_inout[i * 2 + 1] / 32768.0f;
+    while (frames > 0) {
+        int n = (frames < FV_BLOCK) ? frames : FV_BLOCK;
 
         /* Mix input to mono for reverb processing */
-        float input = (in_l + in_r) * 0.5f;
+        for (int i = 0; i < n; i++) {
+            input[i] = (in[i * 2] + in[i * 2 + 1]) * 0.5f;
+        }
 
         /* Accumulate comb filter outputs */
-        float out_l = 0.0f;
-        float out_r = 0.0f;
-
-        for (int c = 0; c < NUM_COMBS; c++) {
-            out_l += comb_process(&inst->comb_l[c], input, inst->feedback, inst->damp1, inst->damp2);
-            out_r += comb_process(&inst->comb_r[c], input, inst->feedback, inst->damp1, inst->damp2);
-        }
+        comb_bank_process(&inst->combs, input, out_l, out_r, n,
+                          inst->feedback, inst->damp1, inst->damp2);
 
         /* Scale down comb output (8 filters summed) */
-        out_l *= 0.125f;
-        out_r *= 0.125f;
+        for (int i = 0; i < n; i++) {
+            out_l[i] *= 0.125f;
+            out_r[i] *= 0.125f;
+        }
 
         /* Pass through allpass filters in series */
         for (int a = 0; a < NUM_ALLPASSES; a++) {
-            out_l = allpass_process(&inst->allpass_l[a], out_l);
-            out_r = allpass_process(&inst->allpass_r[a], out_r);
+            allpass_process_block(&inst->allpass_l[a], out_l, n);
+            allpass_process_block(&inst->allpass_r[a], out_r, n);
         }
 
         /* Mix wet and dry */
-        float mix_l = out_l * inst->wet1 + out_r * inst->wet2 + in_l * inst->dry;
-        float mix_r = out_r * inst->wet1 + out_l * inst->wet2 + in_r * inst->dry;
+        for (int i = 0; i < n; i++) {
+            float in_l = in[i * 2];
+            float in_r = in[i * 2 + 1];
+            out[i * 2] = out_l[i] * inst->wet1 + out_r[i] * inst->wet2 + in_l * inst->dry;
+            out[i * 2 + 1] = out_r[i] * inst->wet1 + out_l[i] * inst->wet2 + in_r * inst->dry;
+        }
+
+        in += n * 2;
+        out += n * 2;
+        frames -= n;
+    }
+}
+
+static void v2_process_block(void *instance, int16_t *audio_inout, int frames) {
+    freeverb_instance_t *inst = (freeverb_instance_t*)instance;
+    if (!inst) return;
+
+    float buf[FV_BLOCK * 2];
+    while (frames > 0) {
+        int n = (frames < FV_BLOCK) ? frames : FV_BLOCK;
+
+        /* Convert to float (-1.0 to 1.0) */
+        for (int i = 0; i < n * 2; i++) {
+            buf[i] = audio_inout[i] / 32768.0f;
+        }
+
+        fv_process(inst, buf, buf, n);
 
         /* Clamp and convert back to int16 */
-        if (mix_l > 1.0f) mix_l = 1.0f;
-        if (mix_l < -1.0f) mix_l = -1.0f;
-        if (mix_r > 1.0f) mix_r = 1.0f;
-        if (mix_r < -1.0f) mix_r = -1.0f;
+        for (int i = 0; i < n * 2; i++) {
+            float v = buf[i];
+            if (v > 1.0f) v = 1.0f;
+            if (v < -1.0f) v = -1.0f;
+            audio_inout[i] = (int16_t)(v * 32767.0f);
+        }
 
-        audio_inout[i * 2] = (int16_t)(mix_l * 32767.0f);
-        audio_inout[i * 2 + 1] = (int16_t)(mix_r * 32767.0f);
+        audio_inout += n * 2;
+        frames -= n;
     }
 }
 
+/* Float32 block entry point (optional, discovered by the host via dlsym).
+ * No conversion or clamping: the host saturates once at the end of the bus. */
+void move_audio_fx_process_block_f32(void *instance, float *audio_inout, int frames) {
+    freeverb_instance_t *inst = (freeverb_instance_t*)instance;
+    if (!inst) return;
+
+    fv_process(inst, audio_inout, audio_inout, frames);
+}
+
 /* Simple JSON number extraction */
 static int json_get_float(const char *json, const char *key, float *out) {
     char search[64];
@@ -315,6 +420,56 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
     return -1;
 }
 
+/* === Typed parameter handles (plugin_param_ext_v3) === */
+
+enum {
+    FV_PARAM_ROOM_SIZE,
+    FV_PARAM_DAMPING,
+    FV_PARAM_WET,
+    FV_PARAM_DRY,
+    FV_PARAM_WIDTH,
+    FV_PARAM_COUNT
+};
+
+static const char *const fv_param_keys[FV_PARAM_COUNT] = {
+    "room_size", "damping", "wet", "dry", "width"
+};
+
+static int v3_resolve_param(void *instance, const char *key) {
+    (void)instance;
+    for (int i = 0; i < FV_PARAM_COUNT; i++) {
+        if (strcmp(key, fv_param_keys[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static void v3_set_param_f(void *instance, int id, float v) {
+    freeverb_instance_t *inst = (freeverb_instance_t*)instance;
+    if (!inst) return;
+
+    v = (v < 0.0f) ? 0.0f : (v > 1.0f) ? 1.0f : v;
+    switch (id) {
+        case FV_PARAM_ROOM_SIZE: inst->room_size = v; break;
+        case FV_PARAM_DAMPING:   inst->damping = v; break;
+        case FV_PARAM_WET:       inst->wet = v; break;
+        case FV_PARAM_DRY:       inst->dry = v; break;
+        case FV_PARAM_WIDTH:     inst->width = v; break;
+        default: return;
+    }
+
+    v2_update_params(inst);
+}
+
+static const plugin_param_ext_v3_t g_param_ext_v3 = {
+    .api_version = MOVE_PLUGIN_API_VERSION_3,
+    .resolve_param = v3_resolve_param,
+    .set_param_f = v3_set_param_f,
+};
+
+const plugin_param_ext_v3_t* move_plugin_param_ext_v3(void) {
+    return &g_param_ext_v3;
+}
+
 /* === V2 Entry Point === */
 
 static audio_fx_api_v2_t g_fx_api_v2;
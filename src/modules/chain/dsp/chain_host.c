@@ -111,6 +111,18 @@ typedef enum {
 #define MOVE_STEP_NOTE_MAX 31
 #define MOVE_PAD_NOTE_MIN 68
 
+/* Timestamped MIDI (move_plugin_on_midi_timed), queued for synths that
+ * export their own timed entry point. Everything else keeps block-start
+ * timing, so render_block is always called with the full block. */
+#define CHAIN_TIMED_MIDI_MAX 32
+
+typedef struct {
+    uint8_t msg[3];
+    uint8_t len;
+    uint8_t source;
+    uint8_t offset;
+} chain_timed_midi_t;
+
 /* Knob mapping constants */
 #define MAX_KNOB_MAPPINGS 8
 #define KNOB_CC_START 71
@@ -159,6 +171,22 @@ typedef struct {
     int option_count;       /* Number of enum options */
 } chain_param_info_t;
 
+/* Parsed module.json metadata, shared by every instance that loads the
+ * module (see module_meta_acquire). Immutable once published. */
+typedef struct chain_module_meta {
+    struct chain_module_meta *next;
+    int refs;
+    char dir[MAX_PATH_LEN];
+    struct timespec mtime;
+    off_t size;
+    chain_param_info_t *params;     /* param_count entries, NULL if none */
+    int param_count;
+    char *ui_hierarchy;             /* Raw ui_hierarchy JSON, NULL if none */
+    int pre_capable;                /* capabilities.pre_capable */
+    int default_forward_channel;    /* capabilities.default_forward_channel, -1 if absent */
+    size_t bytes;                   /* Heap footprint, for mem_stats */
+} chain_module_meta_t;
+
 #define MAX_MOD_TARGETS 32
 #define MAX_MOD_SOURCES_PER_TARGET 8
 #define MOD_PARAM_CACHE_REFRESH_MS 250
@@ -186,6 +214,11 @@ typedef struct mod_target_state {
     float min_val;
     float max_val;
     knob_type_t type;
+    /* Typed handle cache (plugin_param_ext_v3), valid while param_gen
+     * matches inst->param_ext_gen. param_fx: -1 = synth, 0.. = fx slot. */
+    int param_id;
+    int param_fx;
+    uint32_t param_gen;
 } mod_target_state_t;
 
 #define MOVE_PAD_NOTE_MAX 99
@@ -296,6 +329,9 @@ typedef struct {
     lfo_state_t lfos[LFO_COUNT];  /* LFO configuration */
 } patch_info_t;
 
+/* Parsed patches directory shared by every instance (see patch_index_acquire) */
+typedef struct chain_patch_index chain_patch_index_t;
+
 /* ============================================================================
  * Parameter Smoothing (to avoid zipper noise on knob changes)
  * ============================================================================ */
@@ -308,6 +344,8 @@ typedef struct {
     float target;
     float current;
     int active;
+    int param_id;         /* plugin_param_ext_v3 id, -1 = use set_param */
+    uint32_t param_gen;   /* inst->param_ext_gen the id was resolved for */
 } smooth_param_t;
 
 typedef struct {
@@ -331,6 +369,8 @@ static smooth_param_t* smoother_get_param(param_smoother_t *smoother, const char
         p->target = 0.0f;
         p->current = 0.0f;
         p->active = 0;
+        p->param_id = -1;
+        p->param_gen = 0;
         return p;
     }
     return NULL;
@@ -376,6 +416,24 @@ static void smoother_reset(param_smoother_t *smoother) {
     memset(smoother->params, 0, sizeof(smoother->params));
 }
 
+/* Look up the optional typed-param extension exported by a sub-plugin */
+static const plugin_param_ext_v3_t *param_ext_lookup(void *handle) {
+    if (!handle) return NULL;
+    move_plugin_param_ext_v3_fn fn =
+        (move_plugin_param_ext_v3_fn)dlsym(handle, MOVE_PLUGIN_PARAM_EXT_V3_SYMBOL);
+    if (!fn) return NULL;
+    const plugin_param_ext_v3_t *ext = fn();
+    if (!ext || ext->api_version != MOVE_PLUGIN_API_VERSION_3 ||
+        !ext->resolve_param || !ext->set_param_f) return NULL;
+    return ext;
+}
+
+/* Resolve `key` to a typed id, or -1 when the plugin has no fast path */
+static int param_ext_resolve(const plugin_param_ext_v3_t *ext, void *instance, const char *key) {
+    if (!ext || !instance || !key || !key[0]) return -1;
+    return ext->resolve_param(instance, key);
+}
+
 /* Check if a string looks like a float value (for smoothing eligibility) */
 static int is_smoothable_float(const char *val, float *out_value) {
     if (!val || !val[0]) return 0;
@@ -412,112 +470,54 @@ static int is_smoothable_float(const char *val, float *out_value) {
 
 /* Chain instance state - contains all per-instance data for v2 API */
 typedef struct chain_instance {
-    /* Module directory */
-    char module_dir[MAX_PATH_LEN];
+    /* Render path. Everything render_block and on_midi touch per block is
+     * kept together here, pointers and flags first, so a slot's working set
+     * is a few contiguous cache lines; the control-path state below it is
+     * only read by loads, set_param and get_param. Module metadata and the
+     * patch list live outside the instance (see chain_module_meta_t and
+     * chain_patch_index_t). */
 
     /* Sub-plugin state - Synth */
-    void *synth_handle;
     plugin_api_v1_t *synth_plugin;
     plugin_api_v2_t *synth_plugin_v2;
     void *synth_instance;
-    char current_synth_module[MAX_NAME_LEN];
-    int synth_default_forward_channel;  /* -1 = no default, 0-15 = channel */
 
-    /* Sub-plugin state - MIDI Source */
-    void *source_handle;
-    plugin_api_v1_t *source_plugin;
-    char current_source_module[MAX_NAME_LEN];
+    /* Optional float32 block entry points (discovered via dlsym). When any
+     * stage has one, the slot bus stays in float from synth to the last FX. */
+    move_plugin_render_block_f32_fn synth_render_f32;
+    audio_fx_process_block_f32_fn fx_process_f32[MAX_AUDIO_FX];
+
+    /* Optional timed MIDI entry point of the synth (discovered via dlsym),
+     * and the offset to pass it while a queued event is being dispatched */
+    move_plugin_on_midi_timed_fn synth_on_midi_timed;
+    int synth_midi_offset;
 
     /* Audio FX state */
-    void *fx_handles[MAX_AUDIO_FX];
     audio_fx_api_v1_t *fx_plugins[MAX_AUDIO_FX];
     audio_fx_api_v2_t *fx_plugins_v2[MAX_AUDIO_FX];
     void *fx_instances[MAX_AUDIO_FX];
     int fx_is_v2[MAX_AUDIO_FX];
     int fx_count;
-    char current_fx_modules[MAX_AUDIO_FX][MAX_NAME_LEN];  /* Track loaded FX names */
 
     /* Optional MIDI handler for audio FX (discovered via dlsym) */
     void (*fx_on_midi[MAX_AUDIO_FX])(void *instance, const uint8_t *msg, int len, int source);
 
-    /* Module parameter info */
-    chain_param_info_t synth_params[MAX_CHAIN_PARAMS];
-    int synth_param_count;
-    chain_param_info_t fx_params[MAX_AUDIO_FX][MAX_CHAIN_PARAMS];
-    int fx_param_counts[MAX_AUDIO_FX];
-    char fx_ui_hierarchy[MAX_AUDIO_FX][65536];  /* Cached ui_hierarchy JSON */
-
-    /* Patch state */
-    patch_info_t patches[MAX_PATCHES];
-    int patch_count;
-    int current_patch;
+    /* Optional typed param handles (plugin_param_ext_v3, discovered via dlsym).
+     * param_ext_gen bumps on every synth/FX load or unload so cached ids in
+     * smoothers and mod targets re-resolve against the new module. */
+    const plugin_param_ext_v3_t *synth_param_ext;
+    const plugin_param_ext_v3_t *fx_param_ext[MAX_AUDIO_FX];
+    uint32_t param_ext_gen;
 
     /* MIDI FX module state */
-    void *midi_fx_handles[MAX_MIDI_FX];
     midi_fx_api_v1_t *midi_fx_plugins[MAX_MIDI_FX];
     void *midi_fx_instances[MAX_MIDI_FX];
     int midi_fx_count;
-    char current_midi_fx_modules[MAX_MIDI_FX][MAX_NAME_LEN];
-    chain_param_info_t midi_fx_params[MAX_MIDI_FX][MAX_CHAIN_PARAMS];
-    int midi_fx_param_counts[MAX_MIDI_FX];
-    char midi_fx_ui_hierarchy[MAX_MIDI_FX][65536];  /* Cached ui_hierarchy JSON */
-
-    /* Knob mapping state */
-    knob_mapping_t knob_mappings[MAX_KNOB_MAPPINGS];
-    int knob_mapping_count;
-    uint64_t knob_last_time_ms[MAX_KNOB_MAPPINGS];  /* For acceleration */
-
-    /* Runtime modulation bus state */
-    mod_target_state_t mod_targets[MAX_MOD_TARGETS];
-    int mod_target_count;
-    uint64_t mod_param_refresh_ms_synth;
-    uint64_t mod_param_refresh_ms_fx[MAX_AUDIO_FX];
-    uint64_t mod_param_refresh_ms_midi_fx[MAX_MIDI_FX];
-
-    /* Per-slot LFO state */
-    lfo_state_t lfos[LFO_COUNT];
-    float lfo_base_values[LFO_COUNT];  /* Base value snapshot for LFO-to-LFO modulation */
-    int lfo_base_valid[LFO_COUNT];     /* Whether base has been snapshotted */
-
-    /* Recording state */
-    int recording;
-    FILE *wav_file;
-    uint32_t samples_written;
-    char current_recording[MAX_PATH_LEN];
-    int16_t *ring_buffer;
-    volatile size_t ring_write_pos;
-    volatile size_t ring_read_pos;
-    pthread_t writer_thread;
-    pthread_mutex_t ring_mutex;
-    pthread_cond_t ring_cond;
-    volatile int writer_running;
-    volatile int writer_should_exit;
-
-    /* MIDI input filter */
-    midi_input_t midi_input;
-
-    /* Raw MIDI bypass */
-    int raw_midi;
-
-    /* Source UI state */
-    int source_ui_active;
-
-    /* Component UI mode */
-    int component_ui_mode;
-
-    /* Host APIs for sub-plugins */
-    host_api_v1_t subplugin_host_api;
-    host_api_v1_t source_host_api;
-
-    /* Reference to host API (shared) */
-    const host_api_v1_t *host;
-
-    /* Parameter smoothing for synth and FX */
-    param_smoother_t synth_smoother;
-    param_smoother_t fx_smoothers[MAX_AUDIO_FX];
 
-    /* Dirty flag: 1 = modified since last load/save */
-    int dirty;
+    /* Per-component bypass flags. 1 = bypassed (skip processing), 0 = active. */
+    int synth_bypassed;
+    int midi_fx_bypassed[MAX_MIDI_FX];
+    int fx_bypassed[MAX_AUDIO_FX];
 
     /* External audio injection (e.g. Move track audio from Link Audio).
      * Set by host before render_block; mixed after synth, before FX. */
@@ -527,11 +527,10 @@ typedef struct chain_instance {
     /* When set, render_block outputs raw synth only (no inject mix, no FX).
      * The shim calls chain_process_fx() separately for same-frame FX. */
     int external_fx_mode;
-
-    /* Channel settings from last load_file (autosave restore).
-     * Used as fallback when current_patch == -1 (file-based load, not library). */
-    int loaded_receive_channel;   /* PATCH_CHANNEL_UNSET=absent, 0=All, 1-16=specific */
-    int loaded_forward_channel;   /* PATCH_CHANNEL_UNSET=absent, -2=passthrough, -1=auto, 0-15=channel */
+    /* Float bus: the unclamped synth from the last external_fx_mode render,
+     * picked up by chain_process_fx() so the synth → FX edge never clips */
+    float ext_fx_bus[FRAMES_PER_BLOCK * 2];
+    int ext_fx_bus_valid;
 
     /* MIDI FX placement: 0 = Post (default, output goes to slot synth only),
      * 1 = Pre (output also injected into Move's MIDI_IN cable 0 so Move's
@@ -539,10 +538,11 @@ typedef struct chain_instance {
      * Only meaningful when a MIDI FX is loaded. */
     int midi_fx_pre_mode;
 
-    /* Cached "pre_capable" hint from the loaded MIDI FX module.json.
-     * Informs the Shadow UI default on first placement; does not gate the
-     * per-slot toggle (legacy FX can still be switched to Pre manually). */
-    int midi_fx_pre_capable[MAX_MIDI_FX];
+    /* MIDI input filter */
+    midi_input_t midi_input;
+
+    /* Raw MIDI bypass */
+    int raw_midi;
 
     /* Pre-mode echo refcount: per-note counter tracking notes we injected
      * into Move's MIDI_IN cable 2. Move plays the injection and echoes it
@@ -563,10 +563,107 @@ typedef struct chain_instance {
      * events — not our own injection echoes — affect it. */
     uint8_t pre_pad_held[128];
 
-    /* Per-component bypass flags. 1 = bypassed (skip processing), 0 = active. */
-    int synth_bypassed;
-    int midi_fx_bypassed[MAX_MIDI_FX];
-    int fx_bypassed[MAX_AUDIO_FX];
+    /* Reference to host API (shared) */
+    const host_api_v1_t *host;
+
+    /* Parameter smoothing for synth and FX */
+    param_smoother_t synth_smoother;
+    param_smoother_t fx_smoothers[MAX_AUDIO_FX];
+
+    /* Per-slot LFO state */
+    lfo_state_t lfos[LFO_COUNT];
+    float lfo_base_values[LFO_COUNT];  /* Base value snapshot for LFO-to-LFO modulation */
+    int lfo_base_valid[LFO_COUNT];     /* Whether base has been snapshotted */
+
+    /* Runtime modulation bus state */
+    mod_target_state_t mod_targets[MAX_MOD_TARGETS];
+    int mod_target_count;
+    uint64_t mod_param_refresh_ms_synth;
+    uint64_t mod_param_refresh_ms_fx[MAX_AUDIO_FX];
+    uint64_t mod_param_refresh_ms_midi_fx[MAX_MIDI_FX];
+
+    /* Timestamped MIDI waiting for its offset in the next render_block,
+     * sorted by offset */
+    chain_timed_midi_t timed_midi[CHAIN_TIMED_MIDI_MAX];
+    int timed_midi_count;
+
+    /* Control path */
+
+    /* Module directory */
+    char module_dir[MAX_PATH_LEN];
+
+    /* Loaded modules: dlopen handles and names */
+    void *synth_handle;
+    char current_synth_module[MAX_NAME_LEN];
+    int synth_default_forward_channel;  /* -1 = no default, 0-15 = channel */
+    void *fx_handles[MAX_AUDIO_FX];
+    char current_fx_modules[MAX_AUDIO_FX][MAX_NAME_LEN];  /* Track loaded FX names */
+    void *midi_fx_handles[MAX_MIDI_FX];
+    char current_midi_fx_modules[MAX_MIDI_FX][MAX_NAME_LEN];
+
+    /* Sub-plugin state - MIDI Source */
+    void *source_handle;
+    plugin_api_v1_t *source_plugin;
+    char current_source_module[MAX_NAME_LEN];
+
+    /* Module parameter info. The param tables point into the shared
+     * module.json metadata until the plugin reports runtime chain_params,
+     * which are copied into the instance-owned *_runtime table instead.
+     * That table (*_runtime_cap entries) is sized on the control path, at
+     * load and after state/plugin_id changes, so the audio-thread refresh
+     * from modulation only copies; if the plugin outgrows it, that refresh
+     * sets the component's bit in params_runtime_regrow for the next
+     * control-path call to resize it. */
+    chain_module_meta_t *synth_meta;
+    chain_param_info_t *synth_params;
+    int synth_param_count;
+    chain_param_info_t *synth_params_runtime;
+    int synth_params_runtime_cap;
+    chain_module_meta_t *fx_meta[MAX_AUDIO_FX];
+    chain_param_info_t *fx_params[MAX_AUDIO_FX];
+    int fx_param_counts[MAX_AUDIO_FX];
+    chain_param_info_t *fx_params_runtime[MAX_AUDIO_FX];
+    int fx_params_runtime_cap[MAX_AUDIO_FX];
+    chain_module_meta_t *midi_fx_meta[MAX_MIDI_FX];
+    chain_param_info_t *midi_fx_params[MAX_MIDI_FX];
+    int midi_fx_param_counts[MAX_MIDI_FX];
+    chain_param_info_t *midi_fx_params_runtime[MAX_MIDI_FX];
+    int midi_fx_params_runtime_cap[MAX_MIDI_FX];
+    uint32_t params_runtime_regrow;  /* bit per component, see chain_params_runtime_lookup */
+
+    /* Patch state (shared, read-only snapshot of the patches directory) */
+    chain_patch_index_t *patch_index;
+    const patch_info_t *patches;
+    int patch_count;
+    int current_patch;
+
+    /* Knob mapping state */
+    knob_mapping_t knob_mappings[MAX_KNOB_MAPPINGS];
+    int knob_mapping_count;
+    uint64_t knob_last_time_ms[MAX_KNOB_MAPPINGS];  /* For acceleration */
+
+    /* Source UI state */
+    int source_ui_active;
+
+    /* Component UI mode */
+    int component_ui_mode;
+
+    /* Host APIs for sub-plugins */
+    host_api_v1_t subplugin_host_api;
+    host_api_v1_t source_host_api;
+
+    /* Dirty flag: 1 = modified since last load/save */
+    int dirty;
+
+    /* Channel settings from last load_file (autosave restore).
+     * Used as fallback when current_patch == -1 (file-based load, not library). */
+    int loaded_receive_channel;   /* PATCH_CHANNEL_UNSET=absent, 0=All, 1-16=specific */
+    int loaded_forward_channel;   /* PATCH_CHANNEL_UNSET=absent, -2=passthrough, -1=auto, 0-15=channel */
+
+    /* Cached "pre_capable" hint from the loaded MIDI FX module.json.
+     * Informs the Shadow UI default on first placement; does not gate the
+     * per-slot toggle (legacy FX can still be switched to Pre manually). */
+    int midi_fx_pre_capable[MAX_MIDI_FX];
 } chain_instance_t;
 
 /* ============================================================================
@@ -716,11 +813,17 @@ static int chain_get_clock_status(void);
 static int scan_patches(const char *module_dir);
 static void unload_patch(void);
 static int parse_chain_params(const char *module_path, chain_param_info_t *params, int *count);
-static int parse_ui_hierarchy_cache(const char *module_path, char *out, int out_len);
+static int parse_chain_params_json(const char *json, chain_param_info_t *params, int *count);
+static chain_module_meta_t *module_meta_acquire(const char *module_path);
+static void chain_params_clear(chain_module_meta_t **meta, chain_param_info_t **params,
+                               int *count, chain_param_info_t **runtime, int *runtime_cap);
 static int parse_chain_params_array_json(const char *json_array, chain_param_info_t *params, int max_params);
 static chain_param_info_t *find_param_info(chain_param_info_t *params, int count, const char *key);
 static chain_param_info_t *find_param_by_key(chain_instance_t *inst, const char *target, const char *key);
 static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const char *target);
+static void chain_params_reserve_runtime(chain_instance_t *inst, const char *target);
+static void chain_params_after_set_param(chain_instance_t *inst, const char *target,
+                                         const char *subkey);
 static float dsp_value_to_float(const char *val_str, chain_param_info_t *pinfo, float fallback);
 static void v2_chain_log(chain_instance_t *inst, const char *msg);  /* Forward declaration */
 static void parse_debug_log(const char *msg);  /* Forward declaration */
@@ -1592,8 +1695,9 @@ static int v2_load_midi_fx(chain_instance_t *inst, const char *fx_name) {
     strncpy(inst->current_midi_fx_modules[slot], fx_name, MAX_NAME_LEN - 1);
     inst->current_midi_fx_modules[slot][MAX_NAME_LEN - 1] = '\0';
 
-    /* Parse chain_params from module.json for type info */
-    if (parse_chain_params(fx_dir, inst->midi_fx_params[slot], &inst->midi_fx_param_counts[slot]) < 0) {
+    /* Param types, ui_hierarchy and capabilities from module.json */
+    chain_module_meta_t *meta = module_meta_acquire(fx_dir);
+    if (!meta) {
         v2_chain_log(inst, "ERROR: Failed to parse MIDI FX parameters");
         api->destroy_instance(instance);
         dlclose(handle);
@@ -1603,37 +1707,21 @@ static int v2_load_midi_fx(chain_instance_t *inst, const char *fx_name) {
         inst->current_midi_fx_modules[slot][0] = '\0';
         return -1;
     }
+    inst->midi_fx_meta[slot] = meta;
+    inst->midi_fx_params[slot] = meta->params;
+    inst->midi_fx_param_counts[slot] = meta->param_count;
 
-    parse_ui_hierarchy_cache(fx_dir, inst->midi_fx_ui_hierarchy[slot], sizeof(inst->midi_fx_ui_hierarchy[slot]));
-
-    /* Read optional "pre_capable" hint from module.json capabilities.
-     * This informs the Shadow UI default on first placement; does not gate
-     * the per-slot Pre/Post toggle (the user can still flip it manually). */
-    inst->midi_fx_pre_capable[slot] = 0;
-    char mj_path[MAX_PATH_LEN];
-    snprintf(mj_path, sizeof(mj_path), "%s/module.json", fx_dir);
-    FILE *mj = fopen(mj_path, "r");
-    if (mj) {
-        fseek(mj, 0, SEEK_END);
-        long mj_size = ftell(mj);
-        fseek(mj, 0, SEEK_SET);
-        if (mj_size > 0 && mj_size < 65536) {
-            char *mj_buf = malloc(mj_size + 1);
-            if (mj_buf) {
-                size_t nr = fread(mj_buf, 1, mj_size, mj);
-                mj_buf[nr] = '\0';
-                int cap = 0;
-                if (json_get_int_in_section(mj_buf, "capabilities", "pre_capable", &cap) == 0
-                    && cap) {
-                    inst->midi_fx_pre_capable[slot] = 1;
-                }
-                free(mj_buf);
-            }
-        }
-        fclose(mj);
-    }
+    /* The optional "pre_capable" hint informs the Shadow UI default on
+     * first placement; it does not gate the per-slot Pre/Post toggle (the
+     * user can still flip it manually). */
+    inst->midi_fx_pre_capable[slot] = meta->pre_capable;
 
     inst->midi_fx_count++;
+    {
+        char target[24];
+        snprintf(target, sizeof(target), "midi_fx%d", slot + 1);
+        chain_params_reserve_runtime(inst, target);
+    }
 
     snprintf(msg, sizeof(msg), "MIDI FX loaded: %s (slot %d)", fx_name, slot);
     v2_chain_log(inst, msg);
@@ -1660,9 +1748,10 @@ static void v2_unload_all_midi_fx(chain_instance_t *inst) {
         inst->midi_fx_plugins[i] = NULL;
         inst->midi_fx_instances[i] = NULL;
         inst->current_midi_fx_modules[i][0] = '\0';
-        inst->midi_fx_param_counts[i] = 0;
+        chain_params_clear(&inst->midi_fx_meta[i], &inst->midi_fx_params[i],
+                           &inst->midi_fx_param_counts[i], &inst->midi_fx_params_runtime[i],
+                           &inst->midi_fx_params_runtime_cap[i]);
         inst->mod_param_refresh_ms_midi_fx[i] = 0;
-        inst->midi_fx_ui_hierarchy[i][0] = '\0';
         inst->midi_fx_pre_capable[i] = 0;
         inst->midi_fx_bypassed[i] = 0;
     }
@@ -2410,6 +2499,13 @@ static int parse_chain_params(const char *module_path, chain_param_info_t *param
     { size_t nr = fread(json, 1, size, f); json[nr] = '\0'; }
     fclose(f);
 
+    int rc = parse_chain_params_json(json, params, count);
+    free(json);
+    return rc;
+}
+
+/* Parse parameter definitions from module.json text already in memory. */
+static int parse_chain_params_json(const char *json, chain_param_info_t *params, int *count) {
     /* Try ui_hierarchy first */
     const char *hierarchy = strstr(json, "\"ui_hierarchy\"");
     if (hierarchy) {
@@ -2423,7 +2519,6 @@ static int parse_chain_params(const char *module_path, chain_param_info_t *param
             chain_log(log_msg);
         }
         if (*count > 0) {
-            free(json);
             return 0;
         }
         /* count == 0: hierarchy had no inline params (string refs only).
@@ -2437,13 +2532,11 @@ static int parse_chain_params(const char *module_path, chain_param_info_t *param
     /* Find chain_params array */
     const char *chain_params_str = strstr(json, "\"chain_params\"");
     if (!chain_params_str) {
-        free(json);
         return 0;  /* No params is OK */
     }
 
     const char *arr_start = strchr(chain_params_str, '[');
     if (!arr_start) {
-        free(json);
         return 0;
     }
 
@@ -2591,61 +2684,203 @@ static int parse_chain_params(const char *module_path, chain_param_info_t *param
         pos = obj_end + 1;
     }
 
-    free(json);
     return 0;
 }
 
-/* Parse ui_hierarchy object from module.json and cache it as raw JSON. */
-static int parse_ui_hierarchy_cache(const char *module_path, char *out, int out_len) {
-    char json_path[MAX_PATH_LEN];
-    if (!module_path || !out || out_len < 2) return -1;
+/* Locate the ui_hierarchy object in module.json text.
+ * Returns its length and sets *start, or -1 if there is none. */
+static int find_ui_hierarchy(const char *json, const char **start) {
+    const char *hier_start = strstr(json, "\"ui_hierarchy\"");
+    if (!hier_start) return -1;
+    const char *obj_start = strchr(hier_start, '{');
+    if (!obj_start) return -1;
 
-    out[0] = '\0';
-    snprintf(json_path, sizeof(json_path), "%s/module.json", module_path);
+    int depth = 1;
+    const char *obj_end = obj_start + 1;
+    while (*obj_end && depth > 0) {
+        if (*obj_end == '{') depth++;
+        else if (*obj_end == '}') depth--;
+        obj_end++;
+    }
+    if (depth != 0) return -1;
+    *start = obj_start;
+    return (int)(obj_end - obj_start);
+}
 
-    FILE *f = fopen(json_path, "r");
-    if (!f) return -1;
+/* ============================================================================
+ * Shared module metadata
+ *
+ * All chain instances live in one process (the shim hosts every slot plus
+ * master FX), and each synth/FX load used to re-read and re-parse the
+ * module's module.json into per-instance tables: 256 chain_param_info_t
+ * per component and a 64 KB ui_hierarchy buffer per FX. Metadata is now
+ * parsed once per module.json into an exactly-sized, immutable entry that
+ * every slot loading the module points at.
+ *
+ * Entries are keyed by module directory and validated against module.json's
+ * mtime and size on each acquire, so a reinstalled module is picked up on
+ * its next load. The list holds one reference to the current entry for each
+ * directory; a superseded entry lives until its last instance releases it.
+ * The lock only guards the list and refcounts: module.json is parsed and
+ * entries are freed outside it, since the SPI thread takes it on unload.
+ * ============================================================================ */
 
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    if (size <= 0 || size >= 65536) {
-        fclose(f);
-        return -1;
+static pthread_mutex_t g_module_meta_lock = PTHREAD_MUTEX_INITIALIZER;
+static chain_module_meta_t *g_module_meta;
+
+static void module_meta_free(chain_module_meta_t *m) {
+    free(m->params);
+    free(m->ui_hierarchy);
+    free(m);
+}
+
+/* Drop a reference; returns 1 if it was the last, for the caller to free
+ * once the lock is released */
+static int module_meta_unref_locked(chain_module_meta_t *m) {
+    return --m->refs == 0;
+}
+
+/* Link to the list entry for module_path, or NULL. Caller holds the lock. */
+static chain_module_meta_t **module_meta_find_locked(const char *module_path) {
+    for (chain_module_meta_t **link = &g_module_meta; *link; link = &(*link)->next) {
+        if (strcmp((*link)->dir, module_path) == 0) return link;
     }
+    return NULL;
+}
 
-    char *json = malloc(size + 1);
+static int module_meta_matches(const chain_module_meta_t *m, const struct stat *st) {
+    return m->size == st->st_size &&
+           m->mtime.tv_sec == st->st_mtim.tv_sec &&
+           m->mtime.tv_nsec == st->st_mtim.tv_nsec;
+}
+
+static chain_module_meta_t *module_meta_build(const char *module_path, const struct stat *st) {
+    char json_path[MAX_PATH_LEN];
+    snprintf(json_path, sizeof(json_path), "%s/module.json", module_path);
+
+    if (st->st_size <= 0 || st->st_size > 65536) return NULL;
+    FILE *f = fopen(json_path, "r");
+    if (!f) return NULL;
+    char *json = malloc((size_t)st->st_size + 1);
     if (!json) {
         fclose(f);
-        return -1;
+        return NULL;
     }
-
-    { size_t nr = fread(json, 1, size, f); json[nr] = '\0'; }
+    { size_t nr = fread(json, 1, (size_t)st->st_size, f); json[nr] = '\0'; }
     fclose(f);
 
-    int rc = -1;
-    const char *hier_start = strstr(json, "\"ui_hierarchy\"");
-    if (hier_start) {
-        const char *obj_start = strchr(hier_start, '{');
-        if (obj_start) {
-            int depth = 1;
-            const char *obj_end = obj_start + 1;
-            while (*obj_end && depth > 0) {
-                if (*obj_end == '{') depth++;
-                else if (*obj_end == '}') depth--;
-                obj_end++;
-            }
-            int len = (int)(obj_end - obj_start);
-            if (depth == 0 && len > 0 && len < out_len) {
-                memcpy(out, obj_start, (size_t)len);
-                out[len] = '\0';
-                rc = len;
-            }
+    chain_module_meta_t *m = calloc(1, sizeof(*m));
+    chain_param_info_t *parsed = malloc(sizeof(chain_param_info_t) * MAX_CHAIN_PARAMS);
+    if (!m || !parsed || parse_chain_params_json(json, parsed, &m->param_count) < 0) {
+        free(parsed);
+        free(m);
+        free(json);
+        return NULL;
+    }
+
+    if (m->param_count > 0) {
+        m->params = malloc(sizeof(chain_param_info_t) * (size_t)m->param_count);
+        if (m->params) {
+            memcpy(m->params, parsed, sizeof(chain_param_info_t) * (size_t)m->param_count);
+        } else {
+            m->param_count = 0;
         }
     }
+    free(parsed);
 
+    const char *hier = NULL;
+    int hier_len = find_ui_hierarchy(json, &hier);
+    if (hier_len > 0) {
+        m->ui_hierarchy = malloc((size_t)hier_len + 1);
+        if (m->ui_hierarchy) {
+            memcpy(m->ui_hierarchy, hier, (size_t)hier_len);
+            m->ui_hierarchy[hier_len] = '\0';
+        }
+    }
+
+    int cap = 0;
+    if (json_get_int_in_section(json, "capabilities", "pre_capable", &cap) == 0 && cap) {
+        m->pre_capable = 1;
+    }
+    int fwd_ch = -1;
+    if (json_get_int_in_section(json, "capabilities", "default_forward_channel", &fwd_ch) != 0) {
+        fwd_ch = -1;
+    }
+    m->default_forward_channel = fwd_ch;
     free(json);
-    return rc;
+
+    strncpy(m->dir, module_path, MAX_PATH_LEN - 1);
+    m->mtime = st->st_mtim;
+    m->size = st->st_size;
+    m->bytes = sizeof(*m) + sizeof(chain_param_info_t) * (size_t)m->param_count +
+               (m->ui_hierarchy ? strlen(m->ui_hierarchy) + 1 : 0);
+    return m;
+}
+
+/* Get the metadata for a module directory, parsing module.json only if it
+ * is new or has changed. Returns a reference the caller must release with
+ * module_meta_release(), or NULL if module.json is missing or unreadable. */
+static chain_module_meta_t *module_meta_acquire(const char *module_path) {
+    char json_path[MAX_PATH_LEN];
+    struct stat st;
+    snprintf(json_path, sizeof(json_path), "%s/module.json", module_path);
+    if (stat(json_path, &st) != 0) return NULL;
+
+    pthread_mutex_lock(&g_module_meta_lock);
+    chain_module_meta_t **link = module_meta_find_locked(module_path);
+    chain_module_meta_t *m = link ? *link : NULL;
+    if (m && module_meta_matches(m, &st)) {
+        m->refs++;
+        pthread_mutex_unlock(&g_module_meta_lock);
+        return m;
+    }
+    pthread_mutex_unlock(&g_module_meta_lock);
+
+    chain_module_meta_t *built = module_meta_build(module_path, &st);
+    if (!built) return NULL;
+
+    /* Publish, unless another load got there first while we parsed */
+    chain_module_meta_t *dropped = NULL;
+    pthread_mutex_lock(&g_module_meta_lock);
+    link = module_meta_find_locked(module_path);
+    m = link ? *link : NULL;
+    if (m && module_meta_matches(m, &st)) {
+        m->refs++;
+        dropped = built;
+    } else {
+        if (m) {
+            /* module.json changed: drop the list's reference */
+            *link = m->next;
+            if (module_meta_unref_locked(m)) dropped = m;
+        }
+        built->refs = 2;    /* list + caller */
+        built->next = g_module_meta;
+        g_module_meta = built;
+        m = built;
+    }
+    pthread_mutex_unlock(&g_module_meta_lock);
+    if (dropped) module_meta_free(dropped);
+    return m;
+}
+
+static void module_meta_release(chain_module_meta_t *m) {
+    if (!m) return;
+    pthread_mutex_lock(&g_module_meta_lock);
+    int last = module_meta_unref_locked(m);
+    pthread_mutex_unlock(&g_module_meta_lock);
+    if (last) module_meta_free(m);
+}
+
+/* Drop a component's metadata reference and runtime param table */
+static void chain_params_clear(chain_module_meta_t **meta, chain_param_info_t **params,
+                               int *count, chain_param_info_t **runtime, int *runtime_cap) {
+    module_meta_release(*meta);
+    *meta = NULL;
+    free(*runtime);
+    *runtime = NULL;
+    *runtime_cap = 0;
+    *params = NULL;
+    *count = 0;
 }
 
 /*
@@ -4613,6 +4848,30 @@ static void chain_mod_update_base_from_set_param(chain_instance_t *inst,
     entry->base_value = chain_mod_clampf(base, entry->min_val, entry->max_val);
 }
 
+/* Resolve (once per module load) a typed handle for a mod target.
+ * Returns 1 if entry->param_id/param_fx can be written via set_param_f. */
+static int chain_mod_resolve_handle(chain_instance_t *inst, mod_target_state_t *entry) {
+    if (entry->param_gen != inst->param_ext_gen) {
+        entry->param_gen = inst->param_ext_gen;
+        entry->param_id = -1;
+        entry->param_fx = -1;
+        if (strcmp(entry->target, "synth") == 0) {
+            if (inst->synth_plugin_v2) {
+                entry->param_id = param_ext_resolve(inst->synth_param_ext, inst->synth_instance, entry->param);
+            }
+        } else if (strncmp(entry->target, "fx", 2) == 0) {
+            int fx_slot = atoi(entry->target + 2) - 1;
+            if (fx_slot >= 0 && fx_slot < MAX_AUDIO_FX && fx_slot < inst->fx_count &&
+                inst->fx_is_v2[fx_slot]) {
+                entry->param_fx = fx_slot;
+                entry->param_id = param_ext_resolve(inst->fx_param_ext[fx_slot],
+                                                    inst->fx_instances[fx_slot], entry->param);
+            }
+        }
+    }
+    return entry->param_id >= 0;
+}
+
 static void chain_mod_apply_effective_value(chain_instance_t *inst, mod_target_state_t *entry, int force_write) {
     if (!inst || !entry || !entry->active) return;
 
@@ -4643,14 +4902,26 @@ static void chain_mod_apply_effective_value(chain_instance_t *inst, mod_target_s
         }
     }
 
-    char val_str[32];
-    if (entry->type == KNOB_TYPE_INT || entry->type == KNOB_TYPE_ENUM) {
-        snprintf(val_str, sizeof(val_str), "%d", (int)entry->effective_value);
+    int rc;
+    if (chain_mod_resolve_handle(inst, entry)) {
+        float v = entry->effective_value;
+        if (entry->type == KNOB_TYPE_INT || entry->type == KNOB_TYPE_ENUM) v = (float)(int)v;
+        if (entry->param_fx < 0) {
+            inst->synth_param_ext->set_param_f(inst->synth_instance, entry->param_id, v);
+        } else {
+            inst->fx_param_ext[entry->param_fx]->set_param_f(inst->fx_instances[entry->param_fx],
+                                                            entry->param_id, v);
+        }
+        rc = 0;
     } else {
-        snprintf(val_str, sizeof(val_str), "%.6f", entry->effective_value);
+        char val_str[32];
+        if (entry->type == KNOB_TYPE_INT || entry->type == KNOB_TYPE_ENUM) {
+            snprintf(val_str, sizeof(val_str), "%d", (int)entry->effective_value);
+        } else {
+            snprintf(val_str, sizeof(val_str), "%.6f", entry->effective_value);
+        }
+        rc = chain_mod_set_param_string(inst, entry->target, entry->param, val_str);
     }
-
-    int rc = chain_mod_set_param_string(inst, entry->target, entry->param, val_str);
     if (rc == 0) {
         entry->last_applied_value = entry->effective_value;
         if (now_ms == 0) now_ms = get_time_ms();
@@ -4850,8 +5121,9 @@ static void v2_unload_midi_source(chain_instance_t *inst);
 static int v2_load_synth(chain_instance_t *inst, const char *module_name);
 static int v2_load_audio_fx(chain_instance_t *inst, const char *fx_name);
 static int v2_parse_patch_file(chain_instance_t *inst, const char *path, patch_info_t *patch);
-static int v2_load_from_patch_info(chain_instance_t *inst, patch_info_t *patch);
+static int v2_load_from_patch_info(chain_instance_t *inst, const patch_info_t *patch);
 static int v2_scan_patches(chain_instance_t *inst);
+static void patch_index_release(chain_patch_index_t *idx);
 static int v2_load_patch(chain_instance_t *inst, int patch_idx);
 
 /* Create a new chain instance */
@@ -4868,9 +5140,8 @@ static void* v2_create_instance(const char *module_dir, const char *config_json)
     inst->loaded_receive_channel = PATCH_CHANNEL_UNSET;
     inst->loaded_forward_channel = PATCH_CHANNEL_UNSET;
 
-    /* Initialize mutex and condition for recording thread */
-    pthread_mutex_init(&inst->ring_mutex, NULL);
-    pthread_cond_init(&inst->ring_cond, NULL);
+    /* Cached param handles start out stale (their param_gen is 0) */
+    inst->param_ext_gen = 1;
 
     /* Set up host API for sub-plugins */
     if (g_host) {
@@ -4905,35 +5176,20 @@ static void v2_destroy_instance(void *instance) {
 
     v2_chain_log(inst, "Destroying instance");
 
-    /* Stop recording if active */
-    if (inst->writer_running) {
-        pthread_mutex_lock(&inst->ring_mutex);
-        inst->writer_should_exit = 1;
-        pthread_cond_signal(&inst->ring_cond);
-        pthread_mutex_unlock(&inst->ring_mutex);
-        pthread_join(inst->writer_thread, NULL);
-        inst->writer_running = 0;
-    }
-
-    if (inst->wav_file) {
-        fclose(inst->wav_file);
-        inst->wav_file = NULL;
-    }
-
-    if (inst->ring_buffer) {
-        free(inst->ring_buffer);
-        inst->ring_buffer = NULL;
-    }
-
     /* Unload all plugins */
     v2_synth_panic(inst);
     v2_unload_all_audio_fx(inst);
     v2_unload_synth(inst);
     v2_unload_midi_source(inst);
 
-    /* Cleanup mutex/cond */
-    pthread_mutex_destroy(&inst->ring_mutex);
-    pthread_cond_destroy(&inst->ring_cond);
+    /* Drop the remaining shared metadata references */
+    for (int i = 0; i < MAX_MIDI_FX; i++) {
+        chain_params_clear(&inst->midi_fx_meta[i], &inst->midi_fx_params[i],
+                           &inst->midi_fx_param_counts[i], &inst->midi_fx_params_runtime[i],
+                           &inst->midi_fx_params_runtime_cap[i]);
+    }
+    patch_index_release(inst->patch_index);
+    inst->patch_index = NULL;
 
     free(inst);
 }
@@ -4986,8 +5242,14 @@ static void v2_unload_synth(chain_instance_t *inst) {
     inst->synth_plugin = NULL;
     inst->synth_plugin_v2 = NULL;
     inst->synth_instance = NULL;
+    inst->synth_param_ext = NULL;
+    inst->synth_render_f32 = NULL;
+    inst->synth_on_midi_timed = NULL;
+    inst->param_ext_gen++;
     inst->current_synth_module[0] = '\0';
-    inst->synth_param_count = 0;
+    chain_params_clear(&inst->synth_meta, &inst->synth_params,
+                       &inst->synth_param_count, &inst->synth_params_runtime,
+                       &inst->synth_params_runtime_cap);
     inst->mod_param_refresh_ms_synth = 0;
     inst->synth_default_forward_channel = -1;
     inst->synth_bypassed = 0;
@@ -5022,13 +5284,17 @@ static void v2_unload_all_audio_fx(chain_instance_t *inst) {
         inst->fx_instances[i] = NULL;
         inst->fx_is_v2[i] = 0;
         inst->fx_on_midi[i] = NULL;
-        inst->fx_param_counts[i] = 0;
+        inst->fx_param_ext[i] = NULL;
+        inst->fx_process_f32[i] = NULL;
+        chain_params_clear(&inst->fx_meta[i], &inst->fx_params[i],
+                           &inst->fx_param_counts[i], &inst->fx_params_runtime[i],
+                           &inst->fx_params_runtime_cap[i]);
         inst->mod_param_refresh_ms_fx[i] = 0;
         inst->current_fx_modules[i][0] = '\0';
-        inst->fx_ui_hierarchy[i][0] = '\0';
         inst->fx_bypassed[i] = 0;
     }
     inst->fx_count = 0;
+    inst->param_ext_gen++;
 }
 
 /* V2 unload a single audio FX slot */
@@ -5058,10 +5324,14 @@ static void v2_unload_audio_fx_slot(chain_instance_t *inst, int slot) {
     inst->fx_instances[slot] = NULL;
     inst->fx_is_v2[slot] = 0;
     inst->fx_on_midi[slot] = NULL;
-    inst->fx_param_counts[slot] = 0;
+    inst->fx_param_ext[slot] = NULL;
+    inst->fx_process_f32[slot] = NULL;
+    inst->param_ext_gen++;
+    chain_params_clear(&inst->fx_meta[slot], &inst->fx_params[slot],
+                       &inst->fx_param_counts[slot], &inst->fx_params_runtime[slot],
+                       &inst->fx_params_runtime_cap[slot]);
     inst->mod_param_refresh_ms_fx[slot] = 0;
     inst->current_fx_modules[slot][0] = '\0';
-    inst->fx_ui_hierarchy[slot][0] = '\0';
     inst->fx_bypassed[slot] = 0;
 }
 
@@ -5139,13 +5409,18 @@ static int v2_load_audio_fx_slot(chain_instance_t *inst, int slot, const char *f
         typedef void (*fx_on_midi_fn)(void *, const uint8_t *, int, int);
         inst->fx_on_midi[slot] = (fx_on_midi_fn)dlsym(handle, "move_audio_fx_on_midi");
     }
+    inst->fx_param_ext[slot] = param_ext_lookup(handle);
+    inst->fx_process_f32[slot] =
+        (audio_fx_process_block_f32_fn)dlsym(handle, AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL);
+    inst->param_ext_gen++;
 
     /* Track the loaded module name */
     strncpy(inst->current_fx_modules[slot], fx_name, MAX_NAME_LEN - 1);
     inst->current_fx_modules[slot][MAX_NAME_LEN - 1] = '\0';
 
-    /* Parse chain_params from module.json for type info */
-    if (parse_chain_params(fx_dir, inst->fx_params[slot], &inst->fx_param_counts[slot]) < 0) {
+    /* Param types and ui_hierarchy from module.json */
+    chain_module_meta_t *meta = module_meta_acquire(fx_dir);
+    if (!meta) {
         v2_chain_log(inst, "ERROR: Failed to parse audio FX parameters");
         api->destroy_instance(fx_inst);
         dlclose(handle);
@@ -5154,17 +5429,25 @@ static int v2_load_audio_fx_slot(chain_instance_t *inst, int slot, const char *f
         inst->fx_instances[slot] = NULL;
         inst->fx_is_v2[slot] = 0;
         inst->fx_on_midi[slot] = NULL;
+        inst->fx_param_ext[slot] = NULL;
+        inst->fx_process_f32[slot] = NULL;
         inst->current_fx_modules[slot][0] = '\0';
-        inst->fx_ui_hierarchy[slot][0] = '\0';
         return -1;
     }
-    parse_ui_hierarchy_cache(fx_dir, inst->fx_ui_hierarchy[slot], sizeof(inst->fx_ui_hierarchy[slot]));
+    inst->fx_meta[slot] = meta;
+    inst->fx_params[slot] = meta->params;
+    inst->fx_param_counts[slot] = meta->param_count;
     inst->mod_param_refresh_ms_fx[slot] = 0;
 
     /* Update fx_count to include this slot */
     if (slot >= inst->fx_count) {
         inst->fx_count = slot + 1;
     }
+    {
+        char target[16];
+        snprintf(target, sizeof(target), "fx%d", slot + 1);
+        chain_params_reserve_runtime(inst, target);
+    }
 
     snprintf(msg, sizeof(msg), "Audio FX v2 loaded: %s (slot %d, %d params)", fx_name, slot, inst->fx_param_counts[slot]);
     v2_chain_log(inst, msg);
@@ -5294,51 +5577,44 @@ static int v2_load_synth(chain_instance_t *inst, const char *module_name) {
     inst->synth_plugin = NULL;
     inst->synth_plugin_v2 = api;
     inst->synth_instance = synth_inst;
+    inst->synth_param_ext = param_ext_lookup(handle);
+    inst->synth_render_f32 =
+        (move_plugin_render_block_f32_fn)dlsym(handle, MOVE_PLUGIN_RENDER_BLOCK_F32_SYMBOL);
+    inst->synth_on_midi_timed =
+        (move_plugin_on_midi_timed_fn)dlsym(handle, MOVE_PLUGIN_ON_MIDI_TIMED_SYMBOL);
+    inst->param_ext_gen++;
     strncpy(inst->current_synth_module, module_name, MAX_NAME_LEN - 1);
 
-    /* Parse chain_params from module.json for type info */
-    if (parse_chain_params(synth_path, inst->synth_params, &inst->synth_param_count) < 0) {
+    /* Param types and capabilities from module.json */
+    chain_module_meta_t *meta = module_meta_acquire(synth_path);
+    if (!meta) {
         v2_chain_log(inst, "ERROR: Failed to parse synth parameters");
         api->destroy_instance(synth_inst);
         dlclose(handle);
         inst->synth_handle = NULL;
         inst->synth_plugin_v2 = NULL;
         inst->synth_instance = NULL;
+        inst->synth_param_ext = NULL;
+        inst->synth_render_f32 = NULL;
+        inst->synth_on_midi_timed = NULL;
         inst->current_synth_module[0] = '\0';
         return -1;
     }
+    inst->synth_meta = meta;
+    inst->synth_params = meta->params;
+    inst->synth_param_count = meta->param_count;
     inst->mod_param_refresh_ms_synth = 0;
+    chain_params_reserve_runtime(inst, "synth");
 
-    /* Parse default_forward_channel from capabilities in module.json */
+    /* default_forward_channel from capabilities */
     inst->synth_default_forward_channel = -1;  /* Default: no forwarding preference */
-    {
-        char json_path[MAX_PATH_LEN];
-        snprintf(json_path, sizeof(json_path), "%s/module.json", synth_path);
-        FILE *f = fopen(json_path, "r");
-        if (f) {
-            fseek(f, 0, SEEK_END);
-            long size = ftell(f);
-            fseek(f, 0, SEEK_SET);
-            if (size > 0 && size < 65536) {
-                char *json = malloc(size + 1);
-                if (json) {
-                    { size_t nr = fread(json, 1, size, f); json[nr] = '\0'; }
-                    int fwd_ch = -1;
-                    if (json_get_int_in_section(json, "capabilities", "default_forward_channel", &fwd_ch) == 0) {
-                        if (fwd_ch == -2) {
-                            inst->synth_default_forward_channel = -2;  /* Passthrough (for MPE) */
-                            v2_chain_log(inst, "Synth default_forward_channel: passthrough");
-                        } else if (fwd_ch >= 1 && fwd_ch <= 16) {
-                            inst->synth_default_forward_channel = fwd_ch - 1;  /* Store as 0-15 */
-                            snprintf(msg, sizeof(msg), "Synth default_forward_channel: %d", fwd_ch);
-                            v2_chain_log(inst, msg);
-                        }
-                    }
-                    free(json);
-                }
-            }
-            fclose(f);
-        }
+    if (meta->default_forward_channel == -2) {
+        inst->synth_default_forward_channel = -2;  /* Passthrough (for MPE) */
+        v2_chain_log(inst, "Synth default_forward_channel: passthrough");
+    } else if (meta->default_forward_channel >= 1 && meta->default_forward_channel <= 16) {
+        inst->synth_default_forward_channel = meta->default_forward_channel - 1;  /* Store as 0-15 */
+        snprintf(msg, sizeof(msg), "Synth default_forward_channel: %d", meta->default_forward_channel);
+        v2_chain_log(inst, msg);
     }
 
     snprintf(msg, sizeof(msg), "Synth v2 loaded: %s (%d params)", module_name, inst->synth_param_count);
@@ -5404,13 +5680,18 @@ static int v2_load_audio_fx(chain_instance_t *inst, const char *fx_name) {
         typedef void (*fx_on_midi_fn)(void *, const uint8_t *, int, int);
         inst->fx_on_midi[slot] = (fx_on_midi_fn)dlsym(handle, "move_audio_fx_on_midi");
     }
+    inst->fx_param_ext[slot] = param_ext_lookup(handle);
+    inst->fx_process_f32[slot] =
+        (audio_fx_process_block_f32_fn)dlsym(handle, AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL);
+    inst->param_ext_gen++;
 
     /* Track the loaded module name */
     strncpy(inst->current_fx_modules[slot], fx_name, MAX_NAME_LEN - 1);
     inst->current_fx_modules[slot][MAX_NAME_LEN - 1] = '\0';
 
-    /* Parse chain_params from module.json for type info */
-    if (parse_chain_params(fx_dir, inst->fx_params[slot], &inst->fx_param_counts[slot]) < 0) {
+    /* Param types and ui_hierarchy from module.json */
+    chain_module_meta_t *meta = module_meta_acquire(fx_dir);
+    if (!meta) {
         v2_chain_log(inst, "ERROR: Failed to parse audio FX parameters");
         api->destroy_instance(fx_inst);
         dlclose(handle);
@@ -5419,61 +5700,240 @@ static int v2_load_audio_fx(chain_instance_t *inst, const char *fx_name) {
         inst->fx_instances[slot] = NULL;
         inst->fx_is_v2[slot] = 0;
         inst->fx_on_midi[slot] = NULL;
+        inst->fx_param_ext[slot] = NULL;
+        inst->fx_process_f32[slot] = NULL;
         inst->current_fx_modules[slot][0] = '\0';
-        inst->fx_ui_hierarchy[slot][0] = '\0';
         return -1;
     }
-    parse_ui_hierarchy_cache(fx_dir, inst->fx_ui_hierarchy[slot], sizeof(inst->fx_ui_hierarchy[slot]));
+    inst->fx_meta[slot] = meta;
+    inst->fx_params[slot] = meta->params;
+    inst->fx_param_counts[slot] = meta->param_count;
     inst->mod_param_refresh_ms_fx[slot] = 0;
 
     inst->fx_count++;
+    {
+        char target[16];
+        snprintf(target, sizeof(target), "fx%d", slot + 1);
+        chain_params_reserve_runtime(inst, target);
+    }
 
     snprintf(msg, sizeof(msg), "Audio FX v2 loaded: %s (slot %d, %d params)", fx_name, slot, inst->fx_param_counts[slot]);
     v2_chain_log(inst, msg);
     return 0;
 }
 
-/* V2 scan patches - simple version */
-static int v2_scan_patches(chain_instance_t *inst) {
-    char patches_dir[MAX_PATH_LEN];
-    char msg[256];
+/* ============================================================================
+ * Shared patch index
+ *
+ * Every instance lists the same patches directory, and used to re-read and
+ * parse every patch file into its own 32-entry table on create and after
+ * each save/delete/update. Instances now share a refcounted snapshot of the
+ * parsed, sorted list. A rescan stats the directory's .json files and only
+ * parses those whose mtime or size changed; if none did, the current
+ * snapshot is handed out as is. Parsing happens outside g_patch_index_lock,
+ * which only guards the current pointer and refcounts.
+ * ============================================================================ */
 
-    if (!inst) return -1;
+typedef struct {
+    char path[MAX_PATH_LEN];
+    struct timespec mtime;
+    off_t size;
+} chain_patch_file_t;
+
+struct chain_patch_index {
+    int refs;
+    char dir[MAX_PATH_LEN];
+    chain_patch_file_t *files;      /* Every .json file seen, parsed or not */
+    int file_count;
+    patch_info_t *patches;          /* Parsed patches, sorted by name */
+    int count;
+    size_t bytes;                   /* Heap footprint, for mem_stats */
+};
 
-    snprintf(patches_dir, sizeof(patches_dir), "%s/../../patches", inst->module_dir);
-    inst->patch_count = 0;
-    /* Clear old data to prevent stale/garbage entries */
-    memset(inst->patches, 0, sizeof(inst->patches));
+static pthread_mutex_t g_patch_index_lock = PTHREAD_MUTEX_INITIALIZER;
+static chain_patch_index_t *g_patch_index;  /* Current snapshot */
 
-    DIR *dir = opendir(patches_dir);
-    if (!dir) {
-        snprintf(msg, sizeof(msg), "Cannot open patches dir: %s", patches_dir);
-        v2_chain_log(inst, msg);
-        return -1;
+static void patch_index_free(chain_patch_index_t *idx) {
+    free(idx->files);
+    free(idx->patches);
+    free(idx);
+}
+
+/* Drop a reference; returns 1 if it was the last, for the caller to free
+ * once the lock is released */
+static int patch_index_unref_locked(chain_patch_index_t *idx) {
+    return --idx->refs == 0;
+}
+
+static const chain_patch_file_t *patch_index_find_file(const chain_patch_index_t *idx,
+                                                       const chain_patch_file_t *file) {
+    for (int i = 0; i < idx->file_count; i++) {
+        const chain_patch_file_t *f = &idx->files[i];
+        if (strcmp(f->path, file->path) == 0 && f->size == file->size &&
+            f->mtime.tv_sec == file->mtime.tv_sec && f->mtime.tv_nsec == file->mtime.tv_nsec) {
+            return f;
+        }
+    }
+    return NULL;
+}
+
+static const patch_info_t *patch_index_find_patch(const chain_patch_index_t *idx, const char *path) {
+    for (int i = 0; i < idx->count; i++) {
+        if (strcmp(idx->patches[i].path, path) == 0) return &idx->patches[i];
+    }
+    return NULL;
+}
+
+/* Build a snapshot from the listed files, copying unchanged patches from
+ * the previous snapshot of the same directory */
+static chain_patch_index_t *patch_index_build(chain_instance_t *inst, const char *patches_dir,
+                                              chain_patch_file_t *files, int file_count,
+                                              const chain_patch_index_t *prev) {
+    chain_patch_index_t *idx = calloc(1, sizeof(*idx));
+    if (!idx) return NULL;
+    idx->patches = calloc(MAX_PATCHES, sizeof(patch_info_t));
+    if (!idx->patches) {
+        free(idx);
+        return NULL;
     }
 
+    int reused = 0;
+    for (int i = 0; i < file_count && idx->count < MAX_PATCHES; i++) {
+        patch_info_t *patch = &idx->patches[idx->count];
+        if (prev && patch_index_find_file(prev, &files[i])) {
+            /* Unchanged file: it either parsed last time or fails again */
+            const patch_info_t *old = patch_index_find_patch(prev, files[i].path);
+            if (old) {
+                memcpy(patch, old, sizeof(*patch));
+                idx->count++;
+                reused++;
+            }
+            continue;
+        }
+        memset(patch, 0, sizeof(*patch));
+        if (v2_parse_patch_file(inst, files[i].path, patch) == 0) {
+            strncpy(patch->path, files[i].path, MAX_PATH_LEN - 1);
+            idx->count++;
+        } else {
+            memset(patch, 0, sizeof(*patch));
+        }
+    }
+
+    /* Sort patches alphabetically by name */
+    if (idx->count > 1) {
+        qsort(idx->patches, idx->count, sizeof(patch_info_t), compare_patches);
+    }
+    if (idx->count < MAX_PATCHES) {
+        patch_info_t *shrunk = realloc(idx->patches, sizeof(patch_info_t) * (size_t)(idx->count ? idx->count : 1));
+        if (shrunk) idx->patches = shrunk;
+    }
+
+    strncpy(idx->dir, patches_dir, MAX_PATH_LEN - 1);
+    idx->files = files;
+    idx->file_count = file_count;
+    idx->bytes = sizeof(*idx) + sizeof(patch_info_t) * (size_t)(idx->count ? idx->count : 1) +
+                 sizeof(chain_patch_file_t) * (size_t)file_count;
+
+    char msg[256];
+    snprintf(msg, sizeof(msg), "Patch index: %d patches (%d parsed, %d reused)",
+             idx->count, idx->count - reused, reused);
+    v2_chain_log(inst, msg);
+    return idx;
+}
+
+/* Get a snapshot of the parsed patches in patches_dir. Returns a reference
+ * the caller must release with patch_index_release(), or NULL if the
+ * directory cannot be read. */
+static chain_patch_index_t *patch_index_acquire(chain_instance_t *inst, const char *patches_dir) {
+    DIR *dir = opendir(patches_dir);
+    if (!dir) return NULL;
+
+    chain_patch_file_t *files = NULL;
+    int file_count = 0, file_cap = 0;
     struct dirent *entry;
-    while ((entry = readdir(dir)) != NULL && inst->patch_count < MAX_PATCHES) {
+    while ((entry = readdir(dir)) != NULL) {
         if (entry->d_name[0] == '.') continue;
 
         size_t len = strlen(entry->d_name);
         if (len < 5 || strcmp(entry->d_name + len - 5, ".json") != 0) continue;
 
-        char path[MAX_PATH_LEN];
-        snprintf(path, sizeof(path), "%s/%s", patches_dir, entry->d_name);
-
-        patch_info_t *patch = &inst->patches[inst->patch_count];
-        if (v2_parse_patch_file(inst, path, patch) == 0) {
-            strncpy(patch->path, path, MAX_PATH_LEN - 1);
-            inst->patch_count++;
+        if (file_count == file_cap) {
+            int cap = file_cap ? file_cap * 2 : MAX_PATCHES;
+            chain_patch_file_t *grown = realloc(files, sizeof(*files) * (size_t)cap);
+            if (!grown) break;
+            files = grown;
+            file_cap = cap;
         }
+        chain_patch_file_t *f = &files[file_count];
+        struct stat st;
+        snprintf(f->path, sizeof(f->path), "%s/%s", patches_dir, entry->d_name);
+        if (stat(f->path, &st) != 0) continue;
+        f->mtime = st.st_mtim;
+        f->size = st.st_size;
+        file_count++;
     }
-
     closedir(dir);
 
-    /* Sort patches alphabetically by name */
-    if (inst->patch_count > 1) {
-        qsort(inst->patches, inst->patch_count, sizeof(patch_info_t), compare_patches);
+    pthread_mutex_lock(&g_patch_index_lock);
+    chain_patch_index_t *cur = g_patch_index;
+    if (cur && strcmp(cur->dir, patches_dir) != 0) cur = NULL;
+
+    int unchanged = cur && cur->file_count == file_count;
+    for (int i = 0; unchanged && i < file_count; i++) {
+        unchanged = patch_index_find_file(cur, &files[i]) != NULL;
+    }
+    /* Hold the previous snapshot while building from it */
+    if (cur) cur->refs++;
+    pthread_mutex_unlock(&g_patch_index_lock);
+    if (unchanged) {
+        free(files);
+        return cur;
+    }
+
+    chain_patch_index_t *idx = patch_index_build(inst, patches_dir, files, file_count, cur);
+    if (!idx) free(files);
+
+    chain_patch_index_t *dropped[2] = { NULL, NULL };
+    pthread_mutex_lock(&g_patch_index_lock);
+    if (cur && patch_index_unref_locked(cur)) dropped[0] = cur;
+    if (idx) {
+        idx->refs = 2;    /* g_patch_index + caller */
+        if (g_patch_index && patch_index_unref_locked(g_patch_index)) dropped[1] = g_patch_index;
+        g_patch_index = idx;
+    }
+    pthread_mutex_unlock(&g_patch_index_lock);
+    for (int i = 0; i < 2; i++) {
+        if (dropped[i]) patch_index_free(dropped[i]);
+    }
+    return idx;
+}
+
+static void patch_index_release(chain_patch_index_t *idx) {
+    if (!idx) return;
+    pthread_mutex_lock(&g_patch_index_lock);
+    int last = patch_index_unref_locked(idx);
+    pthread_mutex_unlock(&g_patch_index_lock);
+    if (last) patch_index_free(idx);
+}
+
+/* V2 scan patches - swap in the current shared patch index */
+static int v2_scan_patches(chain_instance_t *inst) {
+    char patches_dir[MAX_PATH_LEN];
+    char msg[256];
+
+    if (!inst) return -1;
+
+    snprintf(patches_dir, sizeof(patches_dir), "%s/../../patches", inst->module_dir);
+    chain_patch_index_t *idx = patch_index_acquire(inst, patches_dir);
+    patch_index_release(inst->patch_index);
+    inst->patch_index = idx;
+    inst->patches = idx ? idx->patches : NULL;
+    inst->patch_count = idx ? idx->count : 0;
+
+    if (!idx) {
+        snprintf(msg, sizeof(msg), "Cannot open patches dir: %s", patches_dir);
+        v2_chain_log(inst, msg);
+        return -1;
     }
 
     return inst->patch_count;
@@ -6660,7 +7120,7 @@ static int v2_parse_patch_file(chain_instance_t *inst, const char *path, patch_i
 }
 
 /* V2 load patch */
-static int v2_load_from_patch_info(chain_instance_t *inst, patch_info_t *patch) {
+static int v2_load_from_patch_info(chain_instance_t *inst, const patch_info_t *patch) {
     char msg[256];
 
     if (!inst || !patch) {
@@ -6715,12 +7175,13 @@ static int v2_load_from_patch_info(chain_instance_t *inst, patch_info_t *patch)
             snprintf(msg, sizeof(msg), "Applying synth state: %.50s...", patch->synth_state);
             v2_chain_log(inst, msg);
             inst->synth_plugin_v2->set_param(inst->synth_instance, "state", patch->synth_state);
+            chain_params_reserve_runtime(inst, "synth");
         }
     }
 
     /* Load audio FX */
     for (int i = 0; i < patch->audio_fx_count; i++) {
-        audio_fx_config_t *cfg = &patch->audio_fx[i];
+        const audio_fx_config_t *cfg = &patch->audio_fx[i];
         {
             char dbg[256];
             snprintf(dbg, sizeof(dbg), "[load] Loading audio_fx[%d]: module='%s' param_count=%d",
@@ -6777,12 +7238,15 @@ static int v2_load_from_patch_info(chain_instance_t *inst, patch_info_t *patch)
             } else if (inst->fx_plugins[fx_idx] && inst->fx_plugins[fx_idx]->set_param) {
                 inst->fx_plugins[fx_idx]->set_param("state", cfg->state);
             }
+            char target[16];
+            snprintf(target, sizeof(target), "fx%d", fx_idx + 1);
+            chain_params_reserve_runtime(inst, target);
         }
     }
 
     /* Load MIDI FX */
     for (int i = 0; i < patch->midi_fx_count; i++) {
-        midi_fx_config_t *cfg = &patch->midi_fx[i];
+        const midi_fx_config_t *cfg = &patch->midi_fx[i];
         if (v2_load_midi_fx(inst, cfg->module) != 0) {
             snprintf(msg, sizeof(msg), "Failed to load MIDI FX: %s", cfg->module);
             v2_chain_log(inst, msg);
@@ -6807,6 +7271,9 @@ static int v2_load_from_patch_info(chain_instance_t *inst, patch_info_t *patch)
                     snprintf(msg, sizeof(msg), "Applying MIDI FX state: %.50s...", cfg->state);
                     v2_chain_log(inst, msg);
                     api->set_param(instance, "state", cfg->state);
+                    char target[24];
+                    snprintf(target, sizeof(target), "midi_fx%d", fx_idx + 1);
+                    chain_params_reserve_runtime(inst, target);
                 }
             }
         }
@@ -6936,6 +7403,21 @@ static inline void pre_mode_track_inject(chain_instance_t *inst,
     }
 }
 
+/* Send MIDI from the event path to the synth. While a queued timed event
+ * is being dispatched, synths with their own timed entry point get the
+ * offset; anything else (e.g. a synth swapped in since) gets it now. */
+static void inst_synth_on_midi(chain_instance_t *inst, const uint8_t *msg, int len, int source) {
+    if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->on_midi) {
+        if (inst->synth_midi_offset > 0 && inst->synth_on_midi_timed) {
+            inst->synth_on_midi_timed(inst->synth_instance, msg, len, source, inst->synth_midi_offset);
+        } else {
+            inst->synth_plugin_v2->on_midi(inst->synth_instance, msg, len, source);
+        }
+    } else if (inst->synth_plugin && inst->synth_plugin->on_midi) {
+        inst->synth_plugin->on_midi(msg, len, source);
+    }
+}
+
 /* Send a note to synth with optional transposition (for chords) */
 static void inst_send_note_to_synth(chain_instance_t *inst, const uint8_t *msg, int len, int source, int interval) {
     if (!inst || len < 3) return;
@@ -6948,11 +7430,7 @@ static void inst_send_note_to_synth(chain_instance_t *inst, const uint8_t *msg,
         out_msg[1] = (uint8_t)transposed;
     }
 
-    if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->on_midi) {
-        inst->synth_plugin_v2->on_midi(inst->synth_instance, out_msg, len, source);
-    } else if (inst->synth_plugin && inst->synth_plugin->on_midi) {
-        inst->synth_plugin->on_midi(out_msg, len, source);
-    }
+    inst_synth_on_midi(inst, out_msg, len, source);
 }
 
 /* V2 on_midi handler */
@@ -7127,11 +7605,7 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
 
     /* Send processed messages to synth */
     for (int i = 0; i < out_count; i++) {
-        if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->on_midi) {
-            inst->synth_plugin_v2->on_midi(inst->synth_instance, out_msgs[i], out_lens[i], source);
-        } else if (inst->synth_plugin && inst->synth_plugin->on_midi) {
-            inst->synth_plugin->on_midi(out_msgs[i], out_lens[i], source);
-        }
+        inst_synth_on_midi(inst, out_msgs[i], out_lens[i], source);
     }
 
     /* Pre mode: also inject into Move's MIDI_IN (cable 2) so Move's native
@@ -7372,6 +7846,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
             } else if (inst->synth_plugin && inst->synth_plugin->set_param) {
                 inst->synth_plugin->set_param(subkey, val);
             }
+            chain_params_after_set_param(inst, "synth", subkey);
             inst->dirty = 1;
         }
     }
@@ -7409,6 +7884,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
                 inst->fx_param_counts[0] = 0;
                 inst->mod_param_refresh_ms_fx[0] = 0;
             }
+            chain_params_after_set_param(inst, "fx1", subkey);
             inst->dirty = 1;
         }
     }
@@ -7446,6 +7922,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
                 inst->fx_param_counts[1] = 0;
                 inst->mod_param_refresh_ms_fx[1] = 0;
             }
+            chain_params_after_set_param(inst, "fx2", subkey);
             inst->dirty = 1;
         }
     }
@@ -7472,6 +7949,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
                 }
             }
             inst->midi_fx_plugins[0]->set_param(inst->midi_fx_instances[0], subkey, val);
+            chain_params_after_set_param(inst, "midi_fx1", subkey);
             inst->dirty = 1;
         }
     }
@@ -7495,6 +7973,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
                 }
             }
             inst->midi_fx_plugins[1]->set_param(inst->midi_fx_instances[1], subkey, val);
+            chain_params_after_set_param(inst, "midi_fx2", subkey);
             inst->dirty = 1;
         }
     }
@@ -7787,18 +8266,56 @@ static float dsp_value_to_float(const char *val_str, chain_param_info_t *pinfo,
     return fallback;
 }
 
+#define CHAIN_PARAMS_RUNTIME_HEADROOM 16  /* spare runtime entries for plugins that grow */
+
 /*
- * Refresh target parameter metadata from runtime plugin chain_params.
- * This allows modulation to resolve dynamic params that are not declared in
- * static module.json metadata.
+ * The param table fields of a component ("synth", "fxN", "midi_fx[N]").
+ * Returns its bit in params_runtime_regrow, or -1 if no such component is
+ * loaded.
  */
-static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const char *target) {
-    if (!inst || !target) return -1;
+static int chain_params_runtime_lookup(chain_instance_t *inst, const char *target,
+                                       chain_param_info_t ***params, int **count,
+                                       chain_param_info_t ***runtime, int **cap) {
+    if (strcmp(target, "synth") == 0) {
+        *params = &inst->synth_params;
+        *count = &inst->synth_param_count;
+        *runtime = &inst->synth_params_runtime;
+        *cap = &inst->synth_params_runtime_cap;
+        return 0;
+    }
+    if (strncmp(target, "fx", 2) == 0) {
+        int fx_slot = atoi(target + 2) - 1;
+        if (fx_slot < 0 || fx_slot >= MAX_AUDIO_FX || fx_slot >= inst->fx_count) return -1;
+        *params = &inst->fx_params[fx_slot];
+        *count = &inst->fx_param_counts[fx_slot];
+        *runtime = &inst->fx_params_runtime[fx_slot];
+        *cap = &inst->fx_params_runtime_cap[fx_slot];
+        return 1 + fx_slot;
+    }
+    if (strncmp(target, "midi_fx", 7) == 0) {
+        int midi_fx_slot = 0;
+        if (target[7] != '\0') {
+            midi_fx_slot = atoi(target + 7) - 1;
+        }
+        if (midi_fx_slot < 0 || midi_fx_slot >= MAX_MIDI_FX || midi_fx_slot >= inst->midi_fx_count) return -1;
+        *params = &inst->midi_fx_params[midi_fx_slot];
+        *count = &inst->midi_fx_param_counts[midi_fx_slot];
+        *runtime = &inst->midi_fx_params_runtime[midi_fx_slot];
+        *cap = &inst->midi_fx_params_runtime_cap[midi_fx_slot];
+        return 1 + MAX_AUDIO_FX + midi_fx_slot;
+    }
+    return -1;
+}
 
+/*
+ * Ask a component's plugin for its runtime chain_params and parse them into
+ * `parsed` (MAX_CHAIN_PARAMS entries). Returns the count, or -1 if the
+ * plugin reports none.
+ */
+static int chain_params_fetch_runtime(chain_instance_t *inst, const char *target,
+                                      chain_param_info_t *parsed) {
     char buf[32768];
     int result = -1;
-    chain_param_info_t parsed[MAX_CHAIN_PARAMS];
-    int parsed_count = -1;
 
     if (strcmp(target, "synth") == 0) {
         if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->get_param) {
@@ -7806,15 +8323,7 @@ static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const ch
         } else if (inst->synth_plugin && inst->synth_plugin->get_param) {
             result = inst->synth_plugin->get_param("chain_params", buf, sizeof(buf));
         }
-        if (result <= 0) return -1;
-        parsed_count = parse_chain_params_array_json(buf, parsed, MAX_CHAIN_PARAMS);
-        if (parsed_count < 0) return -1;
-        memcpy(inst->synth_params, parsed, sizeof(chain_param_info_t) * (size_t)parsed_count);
-        inst->synth_param_count = parsed_count;
-        return parsed_count;
-    }
-
-    if (strncmp(target, "fx", 2) == 0) {
+    } else if (strncmp(target, "fx", 2) == 0) {
         int fx_slot = atoi(target + 2) - 1;
         if (fx_slot < 0 || fx_slot >= MAX_AUDIO_FX || fx_slot >= inst->fx_count) return -1;
 
@@ -7824,15 +8333,7 @@ static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const ch
         } else if (inst->fx_plugins[fx_slot] && inst->fx_plugins[fx_slot]->get_param) {
             result = inst->fx_plugins[fx_slot]->get_param("chain_params", buf, sizeof(buf));
         }
-        if (result <= 0) return -1;
-        parsed_count = parse_chain_params_array_json(buf, parsed, MAX_CHAIN_PARAMS);
-        if (parsed_count < 0) return -1;
-        memcpy(inst->fx_params[fx_slot], parsed, sizeof(chain_param_info_t) * (size_t)parsed_count);
-        inst->fx_param_counts[fx_slot] = parsed_count;
-        return parsed_count;
-    }
-
-    if (strncmp(target, "midi_fx", 7) == 0) {
+    } else if (strncmp(target, "midi_fx", 7) == 0) {
         int midi_fx_slot = 0;
         if (target[7] != '\0') {
             midi_fx_slot = atoi(target + 7) - 1;
@@ -7844,15 +8345,99 @@ static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const ch
                                                                 "chain_params",
                                                                 buf,
                                                                 sizeof(buf));
-        if (result <= 0) return -1;
-        parsed_count = parse_chain_params_array_json(buf, parsed, MAX_CHAIN_PARAMS);
-        if (parsed_count < 0) return -1;
-        memcpy(inst->midi_fx_params[midi_fx_slot], parsed, sizeof(chain_param_info_t) * (size_t)parsed_count);
-        inst->midi_fx_param_counts[midi_fx_slot] = parsed_count;
-        return parsed_count;
     }
+    if (result <= 0) return -1;
+    return parse_chain_params_array_json(buf, parsed, MAX_CHAIN_PARAMS);
+}
 
-    return -1;
+/*
+ * Control path (load, state restore, plugin_id change, or after the audio
+ * thread found the table too small): size the component's instance-owned
+ * runtime table for the chain_params its plugin reports now, plus headroom,
+ * and fill it. Plugins that report none keep the shared module.json params.
+ */
+static void chain_params_reserve_runtime(chain_instance_t *inst, const char *target) {
+    chain_param_info_t **params, **runtime;
+    int *count, *cap;
+    int bit = chain_params_runtime_lookup(inst, target, &params, &count, &runtime, &cap);
+    if (bit < 0) return;
+    __atomic_fetch_and(&inst->params_runtime_regrow, ~(1u << bit), __ATOMIC_RELAXED);
+
+    chain_param_info_t *parsed = malloc(sizeof(chain_param_info_t) * MAX_CHAIN_PARAMS);
+    int n = parsed ? chain_params_fetch_runtime(inst, target, parsed) : -1;
+    if (n < 0) {
+        free(parsed);
+        return;
+    }
+
+    if (n > *cap) {
+        int want = n + CHAIN_PARAMS_RUNTIME_HEADROOM;
+        if (want > MAX_CHAIN_PARAMS) want = MAX_CHAIN_PARAMS;
+        chain_param_info_t *table = malloc(sizeof(chain_param_info_t) * (size_t)want);
+        if (!table) {
+            free(parsed);
+            return;
+        }
+        chain_param_info_t *old = *runtime;
+        memcpy(table, parsed, sizeof(chain_param_info_t) * (size_t)n);
+        *runtime = table;
+        *cap = want;
+        *params = table;
+        *count = n;
+        free(old);
+    } else {
+        memcpy(*runtime, parsed, sizeof(chain_param_info_t) * (size_t)n);
+        *params = *runtime;
+        *count = n;
+    }
+    free(parsed);
+}
+
+/*
+ * Refresh target parameter metadata from runtime plugin chain_params.
+ * This allows modulation to resolve dynamic params that are not declared in
+ * static module.json metadata. Runs on the audio thread via modulation, so
+ * it only copies into the table chain_params_reserve_runtime() sized; what
+ * doesn't fit is left for the control path to make room for.
+ */
+static int chain_mod_refresh_target_param_cache(chain_instance_t *inst, const char *target) {
+    if (!inst || !target) return -1;
+
+    chain_param_info_t **params, **runtime;
+    int *count, *cap;
+    int bit = chain_params_runtime_lookup(inst, target, &params, &count, &runtime, &cap);
+    if (bit < 0) return -1;
+
+    chain_param_info_t parsed[MAX_CHAIN_PARAMS];
+    int parsed_count = chain_params_fetch_runtime(inst, target, parsed);
+    if (parsed_count < 0) return -1;
+    if (parsed_count > *cap) {
+        __atomic_fetch_or(&inst->params_runtime_regrow, 1u << bit, __ATOMIC_RELAXED);
+        if (!*runtime) return -1;
+        parsed_count = *cap;
+    }
+
+    memcpy(*runtime, parsed, sizeof(chain_param_info_t) * (size_t)parsed_count);
+    *params = *runtime;
+    *count = parsed_count;
+    return parsed_count;
+}
+
+/*
+ * Control path: after a set_param that may change a component's runtime
+ * chain_params (state restore, plugin_id), or once modulation found its
+ * table too small, re-size the table.
+ */
+static void chain_params_after_set_param(chain_instance_t *inst, const char *target,
+                                         const char *subkey) {
+    chain_param_info_t **params, **runtime;
+    int *count, *cap;
+    int bit = chain_params_runtime_lookup(inst, target, &params, &count, &runtime, &cap);
+    if (bit < 0) return;
+    if (strcmp(subkey, "state") == 0 || strcmp(subkey, "plugin_id") == 0 ||
+        (__atomic_load_n(&inst->params_runtime_regrow, __ATOMIC_RELAXED) & (1u << bit))) {
+        chain_params_reserve_runtime(inst, target);
+    }
 }
 
 /*
@@ -7989,6 +8574,48 @@ static chain_param_info_t* find_param_by_key(chain_instance_t *inst, const char
     return NULL;
 }
 
+/*
+ * Memory footprint of one slot, as JSON. instance and owned are this slot's
+ * own allocations (the struct and any runtime chain_params tables); shared
+ * is the module metadata and patch index it references, which every slot
+ * loading the same modules points at. module_cache covers the whole
+ * process, including entries only other slots use.
+ */
+static int v2_mem_stats(chain_instance_t *inst, char *buf, int buf_len) {
+    size_t owned = 0, shared = 0;
+
+    owned += sizeof(chain_param_info_t) * (size_t)inst->synth_params_runtime_cap;
+    for (int i = 0; i < MAX_AUDIO_FX; i++) {
+        owned += sizeof(chain_param_info_t) * (size_t)inst->fx_params_runtime_cap[i];
+    }
+    for (int i = 0; i < MAX_MIDI_FX; i++) {
+        owned += sizeof(chain_param_info_t) * (size_t)inst->midi_fx_params_runtime_cap[i];
+    }
+
+    int cache_entries = 0;
+    size_t cache_bytes = 0;
+    pthread_mutex_lock(&g_module_meta_lock);
+    if (inst->synth_meta) shared += inst->synth_meta->bytes;
+    for (int i = 0; i < MAX_AUDIO_FX; i++) {
+        if (inst->fx_meta[i]) shared += inst->fx_meta[i]->bytes;
+    }
+    for (int i = 0; i < MAX_MIDI_FX; i++) {
+        if (inst->midi_fx_meta[i]) shared += inst->midi_fx_meta[i]->bytes;
+    }
+    for (chain_module_meta_t *m = g_module_meta; m; m = m->next) {
+        cache_entries++;
+        cache_bytes += m->bytes;
+    }
+    pthread_mutex_unlock(&g_module_meta_lock);
+
+    if (inst->patch_index) shared += inst->patch_index->bytes;
+
+    return snprintf(buf, buf_len,
+                    "{\"instance\":%zu,\"owned\":%zu,\"shared\":%zu,"
+                    "\"module_cache_entries\":%d,\"module_cache_bytes\":%zu,\"patches\":%d}",
+                    sizeof(*inst), owned, shared, cache_entries, cache_bytes, inst->patch_count);
+}
+
 /* V2 get_param handler */
 static int v2_get_param(void *instance, const char *key, char *buf, int buf_len) {
     chain_instance_t *inst = (chain_instance_t *)instance;
@@ -8018,6 +8645,9 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
     if (strcmp(key, "dirty") == 0) {
         return snprintf(buf, buf_len, "%d", inst->dirty);
     }
+    if (strcmp(key, "mem_stats") == 0) {
+        return v2_mem_stats(inst, buf, buf_len);
+    }
     if (strcmp(key, "patch_count") == 0) {
         return snprintf(buf, buf_len, "%d", inst->patch_count);
     }
@@ -8373,10 +9003,11 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
 
         /* For ui_hierarchy: return cached JSON from module.json, fall through to plugin if empty */
         if (strcmp(subkey, "ui_hierarchy") == 0 && inst->fx_count > 0) {
-            if (inst->fx_ui_hierarchy[0][0]) {
-                int len = strlen(inst->fx_ui_hierarchy[0]);
+            const char *hier = inst->fx_meta[0] ? inst->fx_meta[0]->ui_hierarchy : NULL;
+            if (hier) {
+                int len = strlen(hier);
                 if (len < buf_len) {
-                    strcpy(buf, inst->fx_ui_hierarchy[0]);
+                    strcpy(buf, hier);
                     return len;
                 }
             }
@@ -8451,10 +9082,11 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
 
         /* For ui_hierarchy: return cached JSON from module.json, fall through to plugin if empty */
         if (strcmp(subkey, "ui_hierarchy") == 0 && inst->fx_count > 1) {
-            if (inst->fx_ui_hierarchy[1][0]) {
-                int len = strlen(inst->fx_ui_hierarchy[1]);
+            const char *hier = inst->fx_meta[1] ? inst->fx_meta[1]->ui_hierarchy : NULL;
+            if (hier) {
+                int len = strlen(hier);
                 if (len < buf_len) {
-                    strcpy(buf, inst->fx_ui_hierarchy[1]);
+                    strcpy(buf, hier);
                     return len;
                 }
             }
@@ -8528,10 +9160,11 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         if (mod_result >= 0) return mod_result;
         /* For ui_hierarchy: return cached JSON from module.json, fall through to plugin if empty */
         if (strcmp(subkey, "ui_hierarchy") == 0 && inst->midi_fx_count > 0) {
-            if (inst->midi_fx_ui_hierarchy[0][0]) {
-                int len = strlen(inst->midi_fx_ui_hierarchy[0]);
+            const char *hier = inst->midi_fx_meta[0] ? inst->midi_fx_meta[0]->ui_hierarchy : NULL;
+            if (hier) {
+                int len = strlen(hier);
                 if (len < buf_len) {
-                    strcpy(buf, inst->midi_fx_ui_hierarchy[0]);
+                    strcpy(buf, hier);
                     return len;
                 }
             }
@@ -8596,10 +9229,11 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         if (mod_result >= 0) return mod_result;
         /* For ui_hierarchy: return cached JSON from module.json, fall through to plugin if empty */
         if (strcmp(subkey, "ui_hierarchy") == 0 && inst->midi_fx_count > 1) {
-            if (inst->midi_fx_ui_hierarchy[1][0]) {
-                int len = strlen(inst->midi_fx_ui_hierarchy[1]);
+            const char *hier = inst->midi_fx_meta[1] ? inst->midi_fx_meta[1]->ui_hierarchy : NULL;
+            if (hier) {
+                int len = strlen(hier);
                 if (len < buf_len) {
-                    strcpy(buf, inst->midi_fx_ui_hierarchy[1]);
+                    strcpy(buf, hier);
                     return len;
                 }
             }
@@ -8763,6 +9397,158 @@ static void lfo_tick(chain_instance_t *inst, int frames) {
     }
 }
 
+/* ---- Slot audio bus ----
+ * The int16 bus is the historical path: every stage converts and clamps.
+ * When the synth or any FX exports a float32 entry point the whole slot bus
+ * runs in float instead (1.0 == int16 full scale) and is saturated once, on
+ * the final write to the caller's int16 buffer. int16-only stages in a float
+ * chain are bridged with a saturating conversion around their process_block. */
+
+static inline void chain_i16_to_f32(float *dst, const int16_t *src, int samples) {
+    for (int i = 0; i < samples; i++) dst[i] = (float)src[i] * (1.0f / 32768.0f);
+}
+
+static inline void chain_f32_to_i16(int16_t *dst, const float *src, int samples) {
+    for (int i = 0; i < samples; i++) {
+        float v = src[i] * 32768.0f;
+        if (v > 32767.0f) v = 32767.0f;
+        if (v < -32768.0f) v = -32768.0f;
+        dst[i] = (int16_t)v;
+    }
+}
+
+static int chain_float_bus_wanted(const chain_instance_t *inst) {
+    if (inst->synth_render_f32 && inst->synth_plugin_v2 && inst->synth_instance) return 1;
+    for (int i = 0; i < inst->fx_count && i < MAX_AUDIO_FX; i++) {
+        if (inst->fx_is_v2[i] && inst->fx_process_f32[i] && inst->fx_instances[i]) return 1;
+    }
+    return 0;
+}
+
+/* Run the audio FX chain on an int16 bus.
+ * Always process so FX state advances (delay buffers, reverb tails).
+ * If bypassed, save the dry input and restore it after process_block,
+ * so audio passes through unchanged but FX internals stay live. */
+static void chain_run_fx_i16(chain_instance_t *inst, int16_t *buf, int frames) {
+    for (int i = 0; i < inst->fx_count; i++) {
+        int bypassed = (i < MAX_AUDIO_FX && inst->fx_bypassed[i]);
+        int16_t fx_dry[FRAMES_PER_BLOCK * 2];
+        if (bypassed) {
+            memcpy(fx_dry, buf, frames * 2 * sizeof(int16_t));
+        }
+        if (inst->fx_is_v2[i]) {
+            if (inst->fx_plugins_v2[i] && inst->fx_instances[i] && inst->fx_plugins_v2[i]->process_block) {
+                inst->fx_plugins_v2[i]->process_block(inst->fx_instances[i], buf, frames);
+            }
+        } else {
+            if (inst->fx_plugins[i] && inst->fx_plugins[i]->process_block) {
+                inst->fx_plugins[i]->process_block(buf, frames);
+            }
+        }
+        if (bypassed) {
+            memcpy(buf, fx_dry, frames * 2 * sizeof(int16_t));
+        }
+    }
+}
+
+/* Run the audio FX chain on a float bus (same bypass semantics). */
+static void chain_run_fx_f32(chain_instance_t *inst, float *bus, int frames) {
+    int samples = frames * 2;
+    for (int i = 0; i < inst->fx_count && i < MAX_AUDIO_FX; i++) {
+        int bypassed = inst->fx_bypassed[i];
+        float fx_dry[FRAMES_PER_BLOCK * 2];
+        if (bypassed) {
+            memcpy(fx_dry, bus, samples * sizeof(float));
+        }
+        if (inst->fx_is_v2[i] && inst->fx_process_f32[i] && inst->fx_instances[i]) {
+            inst->fx_process_f32[i](inst->fx_instances[i], bus, frames);
+        } else {
+            /* int16-only stage: bridge with a saturating conversion */
+            int16_t tmp[FRAMES_PER_BLOCK * 2];
+            int ran = 0;
+            chain_f32_to_i16(tmp, bus, samples);
+            if (inst->fx_is_v2[i]) {
+                if (inst->fx_plugins_v2[i] && inst->fx_instances[i] && inst->fx_plugins_v2[i]->process_block) {
+                    inst->fx_plugins_v2[i]->process_block(inst->fx_instances[i], tmp, frames);
+                    ran = 1;
+                }
+            } else if (inst->fx_plugins[i] && inst->fx_plugins[i]->process_block) {
+                inst->fx_plugins[i]->process_block(tmp, frames);
+                ran = 1;
+            }
+            if (ran && !bypassed) chain_i16_to_f32(bus, tmp, samples);
+        }
+        if (bypassed) {
+            memcpy(bus, fx_dry, samples * sizeof(float));
+        }
+    }
+}
+
+/* Hand every queued timed event to v2_on_midi, in offset order */
+static void chain_dispatch_timed_midi(chain_instance_t *inst) {
+    for (int i = 0; i < inst->timed_midi_count; i++) {
+        chain_timed_midi_t *e = &inst->timed_midi[i];
+        inst->synth_midi_offset = e->offset;
+        v2_on_midi(inst, e->msg, e->len, e->source);
+    }
+    inst->synth_midi_offset = 0;
+    inst->timed_midi_count = 0;
+}
+
+/* Render the synth (or silence) into either bus, queued timed MIDI first.
+ * out_f32 is NULL on the int16 path; on the float path out_i16 is scratch
+ * for synths without a float entry point. */
+static void chain_render_synth(chain_instance_t *inst, int16_t *out_i16, float *out_f32, int frames) {
+    if (inst->timed_midi_count > 0) chain_dispatch_timed_midi(inst);
+    if (out_f32 && inst->synth_render_f32 && inst->synth_plugin_v2 && inst->synth_instance) {
+        inst->synth_render_f32(inst->synth_instance, out_f32, frames);
+        return;
+    }
+    if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->render_block) {
+        inst->synth_plugin_v2->render_block(inst->synth_instance, out_i16, frames);
+    } else if (inst->synth_plugin && inst->synth_plugin->render_block) {
+        inst->synth_plugin->render_block(out_i16, frames);
+    } else {
+        memset(out_i16, 0, frames * 2 * sizeof(int16_t));
+    }
+    if (out_f32) chain_i16_to_f32(out_f32, out_i16, frames * 2);
+}
+
+/* Float-bus variant of the synth → inject → FX path in v2_render_block. */
+static void v2_render_block_f32_bus(chain_instance_t *inst, int16_t *out_interleaved_lr, int frames) {
+    float bus[FRAMES_PER_BLOCK * 2];
+    int samples = frames * 2;
+
+    /* Always render so synth state advances; zero afterwards if bypassed */
+    chain_render_synth(inst, out_interleaved_lr, bus, frames);
+    if (inst->synth_bypassed) {
+        memset(bus, 0, samples * sizeof(float));
+    }
+
+    /* external_fx_mode: raw synth only, FX run later via chain_process_fx.
+     * The int16 copy is for the caller's mix and silence checks; the float
+     * bus is kept for chain_process_fx so FX still see the unclamped synth. */
+    if (inst->external_fx_mode) {
+        chain_f32_to_i16(out_interleaved_lr, bus, samples);
+        memcpy(inst->ext_fx_bus, bus, samples * sizeof(float));
+        inst->ext_fx_bus_valid = frames;
+        return;
+    }
+
+    /* Mix in external audio before FX without clipping the sum */
+    if (inst->inject_audio && inst->inject_audio_frames > 0) {
+        int n = (inst->inject_audio_frames < frames ? inst->inject_audio_frames : frames) * 2;
+        for (int i = 0; i < n; i++) {
+            bus[i] += (float)inst->inject_audio[i] * (1.0f / 32768.0f);
+        }
+        inst->inject_audio = NULL;
+        inst->inject_audio_frames = 0;
+    }
+
+    chain_run_fx_f32(inst, bus, frames);
+    chain_f32_to_i16(out_interleaved_lr, bus, samples);
+}
+
 /* V2 render_block handler */
 static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int frames) {
     chain_instance_t *inst = (chain_instance_t *)instance;
@@ -8778,6 +9564,14 @@ static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int fra
             for (int i = 0; i < inst->synth_smoother.count; i++) {
                 smooth_param_t *p = &inst->synth_smoother.params[i];
                 if (p->active) {
+                    if (p->param_gen != inst->param_ext_gen) {
+                        p->param_id = param_ext_resolve(inst->synth_param_ext, inst->synth_instance, p->key);
+                        p->param_gen = inst->param_ext_gen;
+                    }
+                    if (p->param_id >= 0) {
+                        inst->synth_param_ext->set_param_f(inst->synth_instance, p->param_id, p->current);
+                        continue;
+                    }
                     char val_str[32];
                     snprintf(val_str, sizeof(val_str), "%.6f", p->current);
                     if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->set_param) {
@@ -8795,6 +9589,14 @@ static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int fra
                 for (int i = 0; i < inst->fx_smoothers[fx].count; i++) {
                     smooth_param_t *p = &inst->fx_smoothers[fx].params[i];
                     if (p->active) {
+                        if (p->param_gen != inst->param_ext_gen) {
+                            p->param_id = param_ext_resolve(inst->fx_param_ext[fx], inst->fx_instances[fx], p->key);
+                            p->param_gen = inst->param_ext_gen;
+                        }
+                        if (p->param_id >= 0) {
+                            inst->fx_param_ext[fx]->set_param_f(inst->fx_instances[fx], p->param_id, p->current);
+                            continue;
+                        }
                         char val_str[32];
                         snprintf(val_str, sizeof(val_str), "%.6f", p->current);
                         if (inst->fx_is_v2[fx] && inst->fx_plugins_v2[fx] && inst->fx_instances[fx]) {
@@ -8814,17 +9616,17 @@ static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int fra
     /* Process MIDI FX tick (for arpeggiator timing) */
     v2_tick_midi_fx(inst, frames);
 
+    inst->ext_fx_bus_valid = 0;
+    if (chain_float_bus_wanted(inst)) {
+        v2_render_block_f32_bus(inst, out_interleaved_lr, frames);
+        return;
+    }
+
     /* Always render so synth state advances (envelopes, LFOs, phases).
      * If bypassed, zero the buffer afterward — downstream FX still see
      * silence as input but the synth's internal time doesn't freeze, so
      * unbypass resumes cleanly without a burst. */
-    if (inst->synth_plugin_v2 && inst->synth_instance && inst->synth_plugin_v2->render_block) {
-        inst->synth_plugin_v2->render_block(inst->synth_instance, out_interleaved_lr, frames);
-    } else if (inst->synth_plugin && inst->synth_plugin->render_block) {
-        inst->synth_plugin->render_block(out_interleaved_lr, frames);
-    } else {
-        memset(out_interleaved_lr, 0, frames * 2 * sizeof(int16_t));
-    }
+    chain_render_synth(inst, out_interleaved_lr, NULL, frames);
     if (inst->synth_bypassed) {
         memset(out_interleaved_lr, 0, frames * 2 * sizeof(int16_t));
     }
@@ -8848,29 +9650,7 @@ static void v2_render_block(void *instance, int16_t *out_interleaved_lr, int fra
         inst->inject_audio_frames = 0;
     }
 
-    /* Process through audio FX chain.
-     * Always process so FX state advances (delay buffers, reverb tails).
-     * If bypassed, save the dry input and restore it after process_block,
-     * so audio passes through unchanged but FX internals stay live. */
-    for (int i = 0; i < inst->fx_count; i++) {
-        int bypassed = (i < MAX_AUDIO_FX && inst->fx_bypassed[i]);
-        int16_t fx_dry[FRAMES_PER_BLOCK * 2];
-        if (bypassed) {
-            memcpy(fx_dry, out_interleaved_lr, frames * 2 * sizeof(int16_t));
-        }
-        if (inst->fx_is_v2[i]) {
-            if (inst->fx_plugins_v2[i] && inst->fx_instances[i] && inst->fx_plugins_v2[i]->process_block) {
-                inst->fx_plugins_v2[i]->process_block(inst->fx_instances[i], out_interleaved_lr, frames);
-            }
-        } else {
-            if (inst->fx_plugins[i] && inst->fx_plugins[i]->process_block) {
-                inst->fx_plugins[i]->process_block(out_interleaved_lr, frames);
-            }
-        }
-        if (bypassed) {
-            memcpy(out_interleaved_lr, fx_dry, frames * 2 * sizeof(int16_t));
-        }
-    }
+    chain_run_fx_i16(inst, out_interleaved_lr, frames);
 }
 
 /* V2 Plugin API structure */
@@ -8911,6 +9691,41 @@ void chain_set_inject_audio(void *instance, int16_t *buf, int frames) {
     inst->inject_audio_frames = frames;
 }
 
+/* Exported: timestamped MIDI (MOVE_PLUGIN_ON_MIDI_TIMED_SYMBOL).
+ * Called by the shim for external MIDI whose XMOS timestamp places it
+ * `offset` frames into the next block. The event is queued and goes
+ * through v2_on_midi (MIDI FX, knobs, synth) at its offset during the next
+ * render_block. Only synths that export the timed entry point can use the
+ * offset; for the rest, and for FX broadcasts (audio FX have no timed entry
+ * point), the event is handled now. */
+void move_plugin_on_midi_timed(void *instance, const uint8_t *msg, int len, int source, int offset) {
+    chain_instance_t *inst = (chain_instance_t *)instance;
+    if (!inst) return;
+    if (offset <= 0 || offset >= FRAMES_PER_BLOCK || len < 1 || len > 3 ||
+        !inst->synth_on_midi_timed || source == MOVE_MIDI_SOURCE_FX_BROADCAST) {
+        v2_on_midi(instance, msg, len, source);
+        return;
+    }
+    if (inst->timed_midi_count >= CHAIN_TIMED_MIDI_MAX) {
+        /* Queue full: hand over what is queued, in order, before this one */
+        chain_dispatch_timed_midi(inst);
+        v2_on_midi(instance, msg, len, source);
+        return;
+    }
+    /* Insert after any event with the same offset to keep arrival order */
+    int i = inst->timed_midi_count;
+    while (i > 0 && inst->timed_midi[i - 1].offset > offset) {
+        inst->timed_midi[i] = inst->timed_midi[i - 1];
+        i--;
+    }
+    chain_timed_midi_t *e = &inst->timed_midi[i];
+    memcpy(e->msg, msg, len);
+    e->len = (uint8_t)len;
+    e->source = (uint8_t)source;
+    e->offset = (uint8_t)offset;
+    inst->timed_midi_count++;
+}
+
 /* Exported: enable/disable external FX mode.
  * When enabled, render_block outputs raw synth only (no inject, no FX).
  * The caller is responsible for running chain_process_fx() separately. */
@@ -8921,27 +9736,30 @@ void chain_set_external_fx_mode(void *instance, int mode) {
 }
 
 /* Exported: run only the audio FX chain on the provided buffer.
- * Used by the shim for same-frame FX processing when external_fx_mode is set. */
+ * Used by the shim for same-frame FX processing when external_fx_mode is set.
+ * `buf` is the int16 synth from render_block plus whatever the shim mixed in
+ * (Link Audio). On the float bus that difference is added to the unclamped
+ * synth kept by render_block, so only the final write saturates. */
 void chain_process_fx(void *instance, int16_t *buf, int frames) {
     chain_instance_t *inst = (chain_instance_t *)instance;
     if (!inst) return;
-    for (int i = 0; i < inst->fx_count; i++) {
-        int bypassed = (i < MAX_AUDIO_FX && inst->fx_bypassed[i]);
-        int16_t fx_dry[FRAMES_PER_BLOCK * 2];
-        if (bypassed) {
-            memcpy(fx_dry, buf, frames * 2 * sizeof(int16_t));
-        }
-        if (inst->fx_is_v2[i]) {
-            if (inst->fx_plugins_v2[i] && inst->fx_instances[i] && inst->fx_plugins_v2[i]->process_block) {
-                inst->fx_plugins_v2[i]->process_block(inst->fx_instances[i], buf, frames);
+    if (chain_float_bus_wanted(inst)) {
+        float bus[FRAMES_PER_BLOCK * 2];
+        int samples = frames * 2;
+        if (inst->ext_fx_bus_valid == frames) {
+            int16_t synth_i16[FRAMES_PER_BLOCK * 2];
+            chain_f32_to_i16(synth_i16, inst->ext_fx_bus, samples);
+            for (int i = 0; i < samples; i++) {
+                bus[i] = inst->ext_fx_bus[i] +
+                         (float)(buf[i] - synth_i16[i]) * (1.0f / 32768.0f);
             }
         } else {
-            if (inst->fx_plugins[i] && inst->fx_plugins[i]->process_block) {
-                inst->fx_plugins[i]->process_block(buf, frames);
-            }
-        }
-        if (bypassed) {
-            memcpy(buf, fx_dry, frames * 2 * sizeof(int16_t));
+            chain_i16_to_f32(bus, buf, samples);
         }
+        inst->ext_fx_bus_valid = 0;
+        chain_run_fx_f32(inst, bus, frames);
+        chain_f32_to_i16(buf, bus, frames * 2);
+        return;
     }
+    chain_run_fx_i16(inst, buf, frames);
 }
@@ -38,6 +38,7 @@
 #include "host/plugin_api_v1.h"
 #include "host/audio_fx_api_v2.h"
 #include "host/shadow_constants.h"
+#include "host/shadow_ui_wake.h"
 #include "host/shadow_chain_types.h"
 #include "host/unified_log.h"
 #include "host/tts_engine.h"
@@ -55,6 +56,9 @@
 #include "host/shadow_fd_trace.h"
 #include "host/shadow_state.h"
 #include "host/shadow_midi.h"
+#include "host/shadow_render_pool.h"
+#include "host/shadow_mix.h"
+#include "host/shadow_telemetry.h"
 
 /* Debug flags - set to 1 to enable various debug logging */
 #define SHADOW_TIMING_LOG 0      /* ioctl/DSP timing logs to /tmp */
@@ -131,6 +135,7 @@ static shadow_ui_state_t *shadow_ui_state = NULL;
 static shadow_param_t *shadow_param = NULL;
 static web_param_set_ring_t *web_param_set_shm = NULL;       /* Web UI → shim param set ring */
 static web_param_notify_ring_t *web_param_notify_shm = NULL;  /* Shim → web UI param change ring */
+static shadow_param_ring_t *shadow_param_ring = NULL;          /* Batched param request/response rings */
 static shadow_screenreader_t *shadow_screenreader_shm = NULL;  /* Forward declaration for D-Bus handler */
 static shadow_overlay_state_t *shadow_overlay_shm = NULL;     /* Overlay state for JS rendering */
 
@@ -155,7 +160,11 @@ static bool set_pages_enabled = true;      /* Set pages enabled by default */
 static bool ext_midi_remap_feature_enabled = true; /* Cable-2 channel remap on by default */
 static bool skipback_require_volume = false; /* false=Shift+Capture, true=Shift+Vol+Capture */
 static bool midi_indicator_enabled_setting = false; /* Off by default; persisted in features.json */
+static bool parallel_render_enabled = false; /* Render slots on the worker pool (opt-in) */
+static bool async_patch_load_enabled = true; /* Build patch loads off the SPI thread */
 static int skipback_seconds_setting = SKIPBACK_DEFAULT_SECONDS; /* Skipback rolling buffer length */
+static bool skipback_compressed_enabled = false; /* Keep skipback history losslessly compressed */
+static bool sample_accurate_midi_enabled = false; /* Place external MIDI by XMOS timestamp */
 /* Shadow UI trigger mode: 0=long-press only, 1=Shift+Vol only, 2=both. Default=both. */
 static uint8_t shadow_ui_trigger_setting = 2;
 
@@ -556,10 +565,14 @@ static void preview_render(int16_t *buf, int frames) {
     const int is_float = (preview_format == PREVIEW_WAV_FORMAT_FLOAT);
     const int is_24bit = (preview_format == PREVIEW_WAV_FORMAT_PCM && preview_bits == 24);
 
+    /* Decode to float stereo, then mix the block in one kernel call */
+    float decoded[FRAMES_PER_BLOCK * 2];
+    if (frames > FRAMES_PER_BLOCK) frames = FRAMES_PER_BLOCK;
+    int n = 0;
     for (int i = 0; i < frames; i++) {
         if (preview_pos >= preview_total_frames) {
             preview_playing = 0;
-            return;
+            break;
         }
         float fL, fR;
         if (is_float) {
@@ -578,17 +591,11 @@ static void preview_render(int16_t *buf, int frames) {
             if (nch == 1) { fL = fR = sd[preview_pos] / 32768.0f; }
             else { fL = sd[preview_pos * 2] / 32768.0f; fR = sd[preview_pos * 2 + 1] / 32768.0f; }
         }
-        int32_t sL = (int32_t)(fL * gain * 32767.0f);
-        int32_t sR = (int32_t)(fR * gain * 32767.0f);
-        /* Mix into existing buffer */
-        int32_t mL = buf[i * 2]     + sL;
-        int32_t mR = buf[i * 2 + 1] + sR;
-        if (mL > 32767) mL = 32767; if (mL < -32768) mL = -32768;
-        if (mR > 32767) mR = 32767; if (mR < -32768) mR = -32768;
-        buf[i * 2]     = (int16_t)mL;
-        buf[i * 2 + 1] = (int16_t)mR;
+        decoded[n++] = fL;
+        decoded[n++] = fR;
         preview_pos++;
     }
+    shadow_mix_add_f32_gain_sat_i16(buf, decoded, gain * 32767.0f, n);
 }
 
 /* Per-slot idle detection: skip render_block when output has been silent.
@@ -871,7 +878,7 @@ static void load_feature_config(void)
     }
 
     /* Read file */
-    char config_buf[512];
+    char config_buf[1024];
     size_t len = fread(config_buf, 1, sizeof(config_buf) - 1, f);
     fclose(f);
     config_buf[len] = '\0';
@@ -971,6 +978,35 @@ static void load_feature_config(void)
         }
     }
 
+    /* Parse parallel_render_enabled (defaults to false).
+     * Opt-in because v1 sub-plugins shared by two slots keep global state
+     * and are not safe to render concurrently. */
+    const char *parallel_render_key = strstr(config_buf, "\"parallel_render_enabled\"");
+    if (parallel_render_key) {
+        const char *colon = strchr(parallel_render_key, ':');
+        if (colon) {
+            colon++;
+            while (*colon == ' ' || *colon == '\t') colon++;
+            if (strncmp(colon, "true", 4) == 0) {
+                parallel_render_enabled = true;
+            }
+        }
+    }
+
+    /* Parse async_patch_load_enabled (defaults to true).
+     * false restores the legacy synchronous load_patch on the SPI thread. */
+    const char *async_load_key = strstr(config_buf, "\"async_patch_load_enabled\"");
+    if (async_load_key) {
+        const char *colon = strchr(async_load_key, ':');
+        if (colon) {
+            colon++;
+            while (*colon == ' ' || *colon == '\t') colon++;
+            if (strncmp(colon, "false", 5) == 0) {
+                async_patch_load_enabled = false;
+            }
+        }
+    }
+
     /* Parse shadow_ui_trigger ("long_press" | "shift_vol" | "both"; default "both").
      * Legacy: if the string key is missing, fall back to bool "long_press_shadow"
      * (true → both, false → shift_vol). */
@@ -1015,18 +1051,51 @@ static void load_feature_config(void)
         }
     }
 
+    /* Parse skipback_compressed (defaults to false). Read before the first
+     * capture allocates the buffer; changing it needs a restart. */
+    const char *skipback_comp_key = strstr(config_buf, "\"skipback_compressed\"");
+    if (skipback_comp_key) {
+        const char *colon = strchr(skipback_comp_key, ':');
+        if (colon) {
+            colon++;
+            while (*colon == ' ' || *colon == '\t') colon++;
+            if (strncmp(colon, "true", 4) == 0) {
+                skipback_compressed_enabled = true;
+            }
+        }
+    }
+    skipback_set_compressed(skipback_compressed_enabled);
+
+    /* Parse sample_accurate_midi (defaults to false). Read before MIDI
+     * routing is initialized; changing it needs a restart. */
+    const char *sample_midi_key = strstr(config_buf, "\"sample_accurate_midi\"");
+    if (sample_midi_key) {
+        const char *colon = strchr(sample_midi_key, ':');
+        if (colon) {
+            colon++;
+            while (*colon == ' ' || *colon == '\t') colon++;
+            if (strncmp(colon, "true", 4) == 0) {
+                sample_accurate_midi_enabled = true;
+            }
+        }
+    }
+
     static const char *trigger_names[] = {"long_press", "shift_vol", "both"};
     const char *trigger_name = trigger_names[shadow_ui_trigger_setting < 3 ? shadow_ui_trigger_setting : 2];
-    char log_msg[256];
+    char log_msg[320];
     snprintf(log_msg, sizeof(log_msg),
-             "Features: shadow_ui=%s, link_audio=%s, display_mirror=%s, set_pages=%s, skipback=%s, skipback_buf=%ds, ui_trigger=%s",
+             "Features: shadow_ui=%s, link_audio=%s, display_mirror=%s, set_pages=%s, skipback=%s, skipback_buf=%ds%s, ui_trigger=%s, parallel_render=%s, async_patch_load=%s, sample_accurate_midi=%s",
              shadow_ui_enabled ? "enabled" : "disabled",
              link_audio.enabled ? "enabled" : "disabled",
              display_mirror_enabled ? "enabled" : "disabled",
              set_pages_enabled ? "enabled" : "disabled",
              skipback_require_volume ? "Shift+Vol+Capture" : "Shift+Capture",
              skipback_seconds_setting,
-             trigger_name);
+             skipback_compressed_enabled ? " compressed" : "",
+             trigger_name,
+             parallel_render_enabled ? "enabled" : "disabled",
+             async_patch_load_enabled ? "enabled" : "disabled",
+             sample_accurate_midi_enabled ? "enabled" : "disabled");
     shadow_log(log_msg);
 }
 
@@ -1528,6 +1597,184 @@ static uint64_t spi_slot_synth_max[SHADOW_CHAIN_INSTANCES];  /* render_block onl
 static uint64_t spi_slot_fx_max[SHADOW_CHAIN_INSTANCES];     /* chain_process_fx only */
 static uint32_t spi_slot_probe_burst_max;
 
+/* Per-frame inputs shared by every slot render job. */
+typedef struct {
+    int same_frame_fx;      /* synth-only render; FX run separately below */
+    int skip_deferred_fx;   /* main-mix rebuild from Link Audio owns slot FX */
+} shadow_slot_render_ctx_t;
+
+typedef struct {
+    shadow_slot_render_ctx_t rc;
+    int slots[SHADOW_CHAIN_INSTANCES];
+    int count;
+} shadow_slot_render_batch_t;
+
+/* Slots whose idle probe fired this frame. Atomic because slot jobs may run
+ * on render pool workers. */
+static uint32_t shadow_slot_probe_burst;
+
+/* Scale one slot's block by its effective volume and fade envelope,
+ * advancing the fade by one block (shadow_fade_advance per frame). */
+static void shadow_slot_mix_contrib(int s, const int16_t *src, int32_t *contrib)
+{
+    slot_fade_t *f = &shadow_chain_slots[s].fade;
+    shadow_mix_ramp_scale_i32(contrib, src, FRAMES_PER_BLOCK, shadow_effective_volume(s),
+                              &f->gain, f->target, f->step);
+}
+
+/* Render one chain slot (synth + deferred FX) for the next frame.
+ * Only touches slot `s`'s buffers and counters when rc->same_frame_fx is
+ * set, which is what makes it safe to run on a render pool worker. */
+static void shadow_inprocess_render_slot(int s, const shadow_slot_render_ctx_t *rc)
+{
+    /* Per-slot timing for the render+fx work below */
+    struct timespec slot_t0, slot_t1;
+    clock_gettime(CLOCK_MONOTONIC, &slot_t0);
+
+    /* Wake slot from idle if fade is ramping (otherwise gain stays at 0) */
+    if (shadow_chain_slots[s].fade.gain != shadow_chain_slots[s].fade.target) {
+        shadow_slot_idle[s] = 0;
+        shadow_slot_silence_frames[s] = 0;
+    }
+
+    /* Idle gate: skip render_block if synth output has been silent.
+     * Buffer is already zeroed; FX still runs for tail decay.
+     * Probe every ~0.5s to detect self-generating audio (LFOs, arps).
+     *
+     * Stagger: slots that go idle on the same frame (common at boot)
+     * have aligned silence_frames counters and would all probe the
+     * same frame, stacking render+FX cost into one ~1ms spike. The
+     * per-slot offset (s * 43) spreads probes evenly across the
+     * 172-frame window so at most one slot probes per frame. */
+    if (shadow_slot_idle[s]) {
+        shadow_slot_silence_frames[s]++;
+        if ((shadow_slot_silence_frames[s] + s * 43) % 172 != 0) {
+            /* Not a probe frame — skip synth render.
+             * Buffer is zeros; FX below still runs for tail decay. */
+            shadow_slot_deferred_valid[s] = 1;
+            goto slot_run_deferred_fx;
+        }
+        /* Probe frame: fall through to render and check output */
+        __atomic_add_fetch(&shadow_slot_probe_burst, 1, __ATOMIC_RELAXED);
+    }
+
+    if (rc->same_frame_fx) {
+        /* Synth only → per-slot buffer. FX deferred below. */
+        shadow_chain_set_external_fx_mode(shadow_chain_slots[s].instance, 1);
+        struct timespec synth_t0, synth_t1;
+        clock_gettime(CLOCK_MONOTONIC, &synth_t0);
+        shadow_plugin_v2->render_block(shadow_chain_slots[s].instance,
+                                       shadow_slot_deferred[s],
+                                       MOVE_FRAMES_PER_BLOCK);
+        clock_gettime(CLOCK_MONOTONIC, &synth_t1);
+        uint64_t synth_us = (synth_t1.tv_sec - synth_t0.tv_sec) * 1000000ULL +
+                            (synth_t1.tv_nsec - synth_t0.tv_nsec) / 1000;
+        if (synth_us > spi_slot_synth_max[s]) spi_slot_synth_max[s] = synth_us;
+        telemetry_record(TELEM_SLOT0_SYNTH + s, (uint32_t)synth_us);
+        shadow_slot_deferred_valid[s] = 1;
+    } else {
+        /* Fallback: full render (synth + FX) → accumulated buffer.
+         * No Link Audio inject (one-frame delay would cause issues). */
+        int16_t render_buffer[FRAMES_PER_BLOCK * 2];
+        memset(render_buffer, 0, sizeof(render_buffer));
+        shadow_plugin_v2->render_block(shadow_chain_slots[s].instance,
+                                       render_buffer, MOVE_FRAMES_PER_BLOCK);
+        if (link_audio.enabled && s < LINK_AUDIO_SHADOW_CHANNELS) {
+            float cap_vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
+            shadow_mix_scale_i16(shadow_slot_capture[s], render_buffer, cap_vol,
+                                 FRAMES_PER_BLOCK * 2);
+            /* Write to publisher shared memory for link_subscriber */
+            if (shadow_pub_audio_shm) {
+                link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
+                uint32_t wp = ps->write_pos;
+                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
+                    ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] = shadow_slot_capture[s][i];
+                    wp++;
+                }
+                __sync_synchronize();
+                ps->write_pos = wp;
+                ps->active = 1;
+            }
+        }
+        int32_t contrib[FRAMES_PER_BLOCK * 2];
+        shadow_slot_mix_contrib(s, render_buffer, contrib);
+        shadow_mix_add_i32_sat_i16(shadow_deferred_dsp_buffer, contrib, FRAMES_PER_BLOCK * 2);
+    }
+
+    /* Check if synth render output is silent */
+    {
+    int16_t *slot_out = rc->same_frame_fx ? shadow_slot_deferred[s] : shadow_deferred_dsp_buffer;
+    int is_silent = shadow_mix_is_silent_i16(slot_out, FRAMES_PER_BLOCK * 2, DSP_SILENCE_LEVEL);
+
+    if (is_silent) {
+        shadow_slot_silence_frames[s]++;
+        if (shadow_slot_silence_frames[s] >= DSP_IDLE_THRESHOLD) {
+            shadow_slot_idle[s] = 1;
+        }
+    } else {
+        shadow_slot_silence_frames[s] = 0;
+        shadow_slot_idle[s] = 0;
+    }
+    }
+
+    /* Run per-slot FX in post-ioctl (deferred) when same_frame_fx is active.
+     * Moves ~435µs avg / 3ms max out of the pre-ioctl budget.
+     * When synth is idle, FX still runs on zeros for tail decay.
+     * When both synth AND FX are idle, skip entirely. */
+slot_run_deferred_fx:
+    if (rc->skip_deferred_fx) {
+        /* Mark valid with zeros so downstream non-rebuild path, if
+         * it ran, would get silence — but in practice main path
+         * replaces mailbox entirely so this is just for safety. */
+        memset(shadow_slot_fx_deferred[s], 0,
+               sizeof(shadow_slot_fx_deferred[s]));
+        shadow_slot_fx_deferred_valid[s] = 1;
+    } else if (rc->same_frame_fx && shadow_chain_process_fx) {
+        if (shadow_slot_fx_idle[s] && shadow_slot_idle[s]) {
+            /* Both idle — FX output is silence */
+            shadow_slot_fx_deferred_valid[s] = 1;
+        } else {
+            int16_t fx_buf[FRAMES_PER_BLOCK * 2];
+            memcpy(fx_buf, shadow_slot_deferred[s], sizeof(fx_buf));
+            struct timespec fx_t0, fx_t1;
+            clock_gettime(CLOCK_MONOTONIC, &fx_t0);
+            shadow_chain_process_fx(shadow_chain_slots[s].instance,
+                                    fx_buf, MOVE_FRAMES_PER_BLOCK);
+            clock_gettime(CLOCK_MONOTONIC, &fx_t1);
+            uint64_t fx_us = (fx_t1.tv_sec - fx_t0.tv_sec) * 1000000ULL +
+                             (fx_t1.tv_nsec - fx_t0.tv_nsec) / 1000;
+            if (fx_us > spi_slot_fx_max[s]) spi_slot_fx_max[s] = fx_us;
+            telemetry_record(TELEM_SLOT0_FX + s, (uint32_t)fx_us);
+            memcpy(shadow_slot_fx_deferred[s], fx_buf, sizeof(fx_buf));
+            shadow_slot_fx_deferred_valid[s] = 1;
+
+            /* Track FX output silence for phase 2 idle */
+            int fx_silent = shadow_mix_is_silent_i16(fx_buf, FRAMES_PER_BLOCK * 2,
+                                                     DSP_SILENCE_LEVEL);
+            if (fx_silent) {
+                shadow_slot_fx_silence_frames[s]++;
+                if (shadow_slot_fx_silence_frames[s] >= DSP_IDLE_THRESHOLD)
+                    shadow_slot_fx_idle[s] = 1;
+            } else {
+                shadow_slot_fx_silence_frames[s] = 0;
+                shadow_slot_fx_idle[s] = 0;
+            }
+        }
+    }
+
+    /* End per-slot timing (added 2026-05-15 for render spike hunt) */
+    clock_gettime(CLOCK_MONOTONIC, &slot_t1);
+    uint64_t slot_us = (slot_t1.tv_sec - slot_t0.tv_sec) * 1000000ULL +
+                       (slot_t1.tv_nsec - slot_t0.tv_nsec) / 1000;
+    if (slot_us > spi_slot_render_max[s]) spi_slot_render_max[s] = slot_us;
+}
+
+static void shadow_render_slot_job(void *ctx, int job)
+{
+    shadow_slot_render_batch_t *batch = (shadow_slot_render_batch_t *)ctx;
+    shadow_inprocess_render_slot(batch->slots[job], &batch->rc);
+}
+
 /* === DEFERRED DSP RENDERING ===
  * Render DSP into buffer (slow, ~300µs) - called POST-ioctl
  * This renders audio for the NEXT frame, adding one frame of latency (~3ms)
@@ -1550,190 +1797,53 @@ static void shadow_inprocess_render_to_buffer(void) {
     /* Same-frame FX: render synth only into per-slot buffers.
      * FX + Link Audio inject are processed in mix_from_buffer (same frame as mailbox)
      * so the inject/subtract cancellation is sample-accurate. */
-    int same_frame_fx = (shadow_chain_set_external_fx_mode != NULL &&
-                         shadow_chain_process_fx != NULL);
+    shadow_slot_render_batch_t batch;
+    batch.rc.same_frame_fx = (shadow_chain_set_external_fx_mode != NULL &&
+                              shadow_chain_process_fx != NULL);
+
+    /* Skip the deferred FX call ONLY when the main-mix rebuild path
+     * will actually run this frame — otherwise the slot has no FX
+     * output at all (both the deferred and the rebuild paths get
+     * skipped). Mirrors the conditions of `rebuild_from_la` computed
+     * later in shadow_inprocess_mix_from_buffer(). */
+    int la_any_active = 0;
+    if (shadow_in_audio_shm) {
+        for (int i = 0; i < LINK_AUDIO_IN_SLOT_COUNT; i++) {
+            if (shadow_in_audio_shm->slots[i].active) {
+                la_any_active = 1; break;
+            }
+        }
+    }
+    batch.rc.skip_deferred_fx = (link_audio.enabled &&
+                                 link_audio_routing_enabled &&
+                                 la_any_active);
 
     /* Probe-burst diagnostic: count slots whose idle probe fires this frame.
      * If 2-3 slots' silence counters align on the same probe-frame the
      * render cost stacks into a single ~1ms spike. */
-    uint32_t probe_burst_this_frame = 0;
+    __atomic_store_n(&shadow_slot_probe_burst, 0, __ATOMIC_RELAXED);
     if (shadow_plugin_v2 && shadow_plugin_v2->render_block) {
+        batch.count = 0;
         for (int s = 0; s < SHADOW_CHAIN_INSTANCES; s++) {
             if (!shadow_chain_slots[s].active || !shadow_chain_slots[s].instance) continue;
+            batch.slots[batch.count++] = s;
+        }
 
-            /* Per-slot timing for the render+fx work below */
-            struct timespec slot_t0, slot_t1;
-            clock_gettime(CLOCK_MONOTONIC, &slot_t0);
-
-            /* Wake slot from idle if fade is ramping (otherwise gain stays at 0) */
-            if (shadow_chain_slots[s].fade.gain != shadow_chain_slots[s].fade.target) {
-                shadow_slot_idle[s] = 0;
-                shadow_slot_silence_frames[s] = 0;
-            }
-
-            /* Idle gate: skip render_block if synth output has been silent.
-             * Buffer is already zeroed; FX still runs for tail decay.
-             * Probe every ~0.5s to detect self-generating audio (LFOs, arps).
-             *
-             * Stagger: slots that go idle on the same frame (common at boot)
-             * have aligned silence_frames counters and would all probe the
-             * same frame, stacking render+FX cost into one ~1ms spike. The
-             * per-slot offset (s * 43) spreads probes evenly across the
-             * 172-frame window so at most one slot probes per frame. */
-            if (shadow_slot_idle[s]) {
-                shadow_slot_silence_frames[s]++;
-                if ((shadow_slot_silence_frames[s] + s * 43) % 172 != 0) {
-                    /* Not a probe frame — skip synth render.
-                     * Buffer is zeros; FX below still runs for tail decay. */
-                    shadow_slot_deferred_valid[s] = 1;
-                    goto slot_run_deferred_fx;
-                }
-                /* Probe frame: fall through to render and check output */
-                probe_burst_this_frame++;
-            }
-
-            if (same_frame_fx) {
-                /* Synth only → per-slot buffer. FX deferred below. */
-                shadow_chain_set_external_fx_mode(shadow_chain_slots[s].instance, 1);
-                struct timespec synth_t0, synth_t1;
-                clock_gettime(CLOCK_MONOTONIC, &synth_t0);
-                shadow_plugin_v2->render_block(shadow_chain_slots[s].instance,
-                                               shadow_slot_deferred[s],
-                                               MOVE_FRAMES_PER_BLOCK);
-                clock_gettime(CLOCK_MONOTONIC, &synth_t1);
-                uint64_t synth_us = (synth_t1.tv_sec - synth_t0.tv_sec) * 1000000ULL +
-                                    (synth_t1.tv_nsec - synth_t0.tv_nsec) / 1000;
-                if (synth_us > spi_slot_synth_max[s]) spi_slot_synth_max[s] = synth_us;
-                shadow_slot_deferred_valid[s] = 1;
-            } else {
-                /* Fallback: full render (synth + FX) → accumulated buffer.
-                 * No Link Audio inject (one-frame delay would cause issues). */
-                int16_t render_buffer[FRAMES_PER_BLOCK * 2];
-                memset(render_buffer, 0, sizeof(render_buffer));
-                shadow_plugin_v2->render_block(shadow_chain_slots[s].instance,
-                                               render_buffer, MOVE_FRAMES_PER_BLOCK);
-                if (link_audio.enabled && s < LINK_AUDIO_SHADOW_CHANNELS) {
-                    float cap_vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++)
-                        shadow_slot_capture[s][i] = (int16_t)lroundf((float)render_buffer[i] * cap_vol);
-                    /* Write to publisher shared memory for link_subscriber */
-                    if (shadow_pub_audio_shm) {
-                        link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
-                        uint32_t wp = ps->write_pos;
-                        for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                            ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] = shadow_slot_capture[s][i];
-                            wp++;
-                        }
-                        __sync_synchronize();
-                        ps->write_pos = wp;
-                        ps->active = 1;
-                    }
-                }
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    float vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    int32_t mixed = shadow_deferred_dsp_buffer[i] + (int32_t)(render_buffer[i] * vol);
-                    if (mixed > 32767) mixed = 32767;
-                    if (mixed < -32768) mixed = -32768;
-                    shadow_deferred_dsp_buffer[i] = (int16_t)mixed;
-                    if (i & 1) shadow_fade_advance(s);
-                }
-            }
-
-            /* Check if synth render output is silent */
-            {
-            int16_t *slot_out = same_frame_fx ? shadow_slot_deferred[s] : shadow_deferred_dsp_buffer;
-            int is_silent = 1;
-            for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                if (slot_out[i] > DSP_SILENCE_LEVEL || slot_out[i] < -DSP_SILENCE_LEVEL) {
-                    is_silent = 0;
-                    break;
-                }
-            }
-
-            if (is_silent) {
-                shadow_slot_silence_frames[s]++;
-                if (shadow_slot_silence_frames[s] >= DSP_IDLE_THRESHOLD) {
-                    shadow_slot_idle[s] = 1;
-                }
-            } else {
-                shadow_slot_silence_frames[s] = 0;
-                shadow_slot_idle[s] = 0;
-            }
-            }
-
-            /* Run per-slot FX in post-ioctl (deferred) when same_frame_fx is active.
-             * Moves ~435µs avg / 3ms max out of the pre-ioctl budget.
-             * When synth is idle, FX still runs on zeros for tail decay.
-             * When both synth AND FX are idle, skip entirely. */
-        slot_run_deferred_fx:
-            /* Skip the deferred FX call ONLY when the main-mix rebuild path
-             * will actually run this frame — otherwise the slot has no FX
-             * output at all (both the deferred and the rebuild paths get
-             * skipped). Mirrors the conditions of `rebuild_from_la` computed
-             * later in shadow_inprocess_mix_from_buffer(). */
-            int la_any_active = 0;
-            if (shadow_in_audio_shm) {
-                for (int i = 0; i < LINK_AUDIO_IN_SLOT_COUNT; i++) {
-                    if (shadow_in_audio_shm->slots[i].active) {
-                        la_any_active = 1; break;
-                    }
-                }
-            }
-            int skip_deferred_fx = (link_audio.enabled &&
-                                    link_audio_routing_enabled &&
-                                    la_any_active);
-
-            if (skip_deferred_fx) {
-                /* Mark valid with zeros so downstream non-rebuild path, if
-                 * it ran, would get silence — but in practice main path
-                 * replaces mailbox entirely so this is just for safety. */
-                memset(shadow_slot_fx_deferred[s], 0,
-                       sizeof(shadow_slot_fx_deferred[s]));
-                shadow_slot_fx_deferred_valid[s] = 1;
-            } else if (same_frame_fx && shadow_chain_process_fx) {
-                if (shadow_slot_fx_idle[s] && shadow_slot_idle[s]) {
-                    /* Both idle — FX output is silence */
-                    shadow_slot_fx_deferred_valid[s] = 1;
-                } else {
-                    int16_t fx_buf[FRAMES_PER_BLOCK * 2];
-                    memcpy(fx_buf, shadow_slot_deferred[s], sizeof(fx_buf));
-                    struct timespec fx_t0, fx_t1;
-                    clock_gettime(CLOCK_MONOTONIC, &fx_t0);
-                    shadow_chain_process_fx(shadow_chain_slots[s].instance,
-                                            fx_buf, MOVE_FRAMES_PER_BLOCK);
-                    clock_gettime(CLOCK_MONOTONIC, &fx_t1);
-                    uint64_t fx_us = (fx_t1.tv_sec - fx_t0.tv_sec) * 1000000ULL +
-                                     (fx_t1.tv_nsec - fx_t0.tv_nsec) / 1000;
-                    if (fx_us > spi_slot_fx_max[s]) spi_slot_fx_max[s] = fx_us;
-                    memcpy(shadow_slot_fx_deferred[s], fx_buf, sizeof(fx_buf));
-                    shadow_slot_fx_deferred_valid[s] = 1;
-
-                    /* Track FX output silence for phase 2 idle */
-                    int fx_silent = 1;
-                    for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                        if (fx_buf[i] > DSP_SILENCE_LEVEL || fx_buf[i] < -DSP_SILENCE_LEVEL) {
-                            fx_silent = 0;
-                            break;
-                        }
-                    }
-                    if (fx_silent) {
-                        shadow_slot_fx_silence_frames[s]++;
-                        if (shadow_slot_fx_silence_frames[s] >= DSP_IDLE_THRESHOLD)
-                            shadow_slot_fx_idle[s] = 1;
-                    } else {
-                        shadow_slot_fx_silence_frames[s] = 0;
-                        shadow_slot_fx_idle[s] = 0;
-                    }
-                }
-            }
-
-            /* End per-slot timing (added 2026-05-15 for render spike hunt) */
-            clock_gettime(CLOCK_MONOTONIC, &slot_t1);
-            uint64_t slot_us = (slot_t1.tv_sec - slot_t0.tv_sec) * 1000000ULL +
-                               (slot_t1.tv_nsec - slot_t0.tv_nsec) / 1000;
-            if (slot_us > spi_slot_render_max[s]) spi_slot_render_max[s] = slot_us;
+        /* Slots only touch their own buffers in same-frame FX mode, so they
+         * can render concurrently. The fallback path accumulates into the
+         * shared deferred buffer and must stay serial. */
+        if (batch.rc.same_frame_fx && render_pool_worker_count() > 0) {
+            render_pool_run(shadow_render_slot_job, &batch, batch.count);
+        } else {
+            for (int i = 0; i < batch.count; i++)
+                shadow_inprocess_render_slot(batch.slots[i], &batch.rc);
         }
     }
+    /* The serial fallback path publishes slot audio from here rather than
+     * from mix_from_buffer(); don't leave it waiting a block for the kick */
+    if (link_audio.enabled && !batch.rc.same_frame_fx)
+        link_audio_pub_kick(shadow_pub_audio_shm);
+    uint32_t probe_burst_this_frame = __atomic_load_n(&shadow_slot_probe_burst, __ATOMIC_RELAXED);
     if (probe_burst_this_frame > spi_slot_probe_burst_max)
         spi_slot_probe_burst_max = probe_burst_this_frame;
 
@@ -1835,6 +1945,53 @@ static void shadow_latency_delay_apply(int slot, const int16_t *in,
     shadow_latency_delay_wp[slot] = wp + FRAMES_PER_BLOCK * 2;
 }
 
+/* Master FX chain on a float bus (1.0 == int16 full scale), used when at
+ * least one MFX slot exports move_audio_fx_process_block_f32. `me_sum` is
+ * the unclipped ME bus; the result is saturated once into `out`. int16-only
+ * stages (overtake FX, non-float MFX) are bridged with a saturating
+ * conversion around their process_block. */
+static void shadow_master_fx_run_f32(const int32_t *me_sum, int16_t *out)
+{
+    const int n = FRAMES_PER_BLOCK * 2;
+    float bus[FRAMES_PER_BLOCK * 2];
+    for (int i = 0; i < n; i++) bus[i] = (float)me_sum[i] * (1.0f / 32768.0f);  /* int32: no kernel */
+
+    for (int stage = -1; stage < MASTER_FX_SLOTS; stage++) {
+        audio_fx_process_block_f32_fn f32 = NULL;
+        void (*i16)(void *, int16_t *, int) = NULL;
+        void *instance;
+        int bypassed = 0;
+        if (stage < 0) {
+            /* Overtake DSP FX runs first, as on the int16 path */
+            if (!(overtake_dsp_fx && overtake_dsp_fx_inst)) continue;
+            instance = overtake_dsp_fx_inst;
+            i16 = overtake_dsp_fx->process_block;
+        } else {
+            master_fx_slot_t *s = &shadow_master_fx_slots[stage];
+            if (!(s->instance && s->api && s->api->process_block)) continue;
+            instance = s->instance;
+            f32 = s->process_f32;
+            i16 = s->api->process_block;
+            bypassed = s->bypassed;
+        }
+        if (!f32 && !i16) continue;
+
+        float dry[FRAMES_PER_BLOCK * 2];
+        if (bypassed) memcpy(dry, bus, sizeof(dry));
+        if (f32) {
+            f32(instance, bus, FRAMES_PER_BLOCK);
+        } else {
+            int16_t tmp[FRAMES_PER_BLOCK * 2];
+            shadow_mix_f32_to_i16(tmp, bus, n);
+            i16(instance, tmp, FRAMES_PER_BLOCK);
+            shadow_mix_i16_to_f32(bus, tmp, n);
+        }
+        if (bypassed) memcpy(bus, dry, sizeof(dry));
+    }
+
+    shadow_mix_f32_to_i16(out, bus, n);
+}
+
 static void shadow_inprocess_mix_from_buffer(void) {
     if (!shadow_inprocess_ready || !global_mmap_addr) return;
     if (!shadow_deferred_dsp_valid) return;  /* No buffer to mix yet */
@@ -1947,7 +2104,7 @@ static void shadow_inprocess_mix_from_buffer(void) {
          * Schwung-side delay ring so the first frame starts clean. */
         if (entering_rebuild && latency_comp_active != latency_comp_user_enabled) {
             latency_comp_active = latency_comp_user_enabled;
-            link_audio_reset_nudge_state();
+            link_audio_reset_drift_state();
             extern void shadow_latency_delay_reset(void);
             shadow_latency_delay_reset();
             {
@@ -1974,13 +2131,7 @@ static void shadow_inprocess_mix_from_buffer(void) {
     {
         const int16_t *jack_audio = schwung_jack_bridge_read_audio(g_jack_shm);
         if (jack_audio) {
-            for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                int32_t scaled_jack = (int32_t)lroundf((float)jack_audio[i] * mv);
-                int32_t mixed = (int32_t)mailbox_audio[i] + scaled_jack;
-                if (mixed > 32767) mixed = 32767;
-                if (mixed < -32768) mixed = -32768;
-                mailbox_audio[i] = (int16_t)mixed;
-            }
+            shadow_mix_add_gain_sat_i16(mailbox_audio, jack_audio, mv, FRAMES_PER_BLOCK * 2);
         }
     }
 
@@ -1998,10 +2149,14 @@ static void shadow_inprocess_mix_from_buffer(void) {
          * the mailbox from Move's own write) survives. */
         int la_channel_count = shim_move_channel_count();
         int any_la_valid = 0;
+        struct timespec la_t0, la_t1;
+        clock_gettime(CLOCK_MONOTONIC, &la_t0);
         for (int s = 0; s < SHADOW_CHAIN_INSTANCES && s < la_channel_count; s++) {
             la_cache_valid[s] = shim_read_move_channel(s, la_cache[s], FRAMES_PER_BLOCK);
             if (la_cache_valid[s]) any_la_valid = 1;
         }
+        clock_gettime(CLOCK_MONOTONIC, &la_t1);
+        telemetry_record(TELEM_LINK_READ, TELEMETRY_US(la_t0, la_t1));
         if (!any_la_valid) {
             /* SHM is empty across all slots — sidecar isn't producing fast
              * enough this frame. Skip the rebuild; treat this frame like
@@ -2030,7 +2185,7 @@ static void shadow_inprocess_mix_from_buffer(void) {
                 if (shadow_slot_fx_idle[s] && shadow_slot_idle[s] && !have_move_track) continue;
 
                 /* Latency comp: delay the local synth output to match the
-                 * Link Audio path before combining. The nudge in
+                 * Link Audio path before combining. The drift resampler in
                  * link_audio_read_channel_shm keeps the Move side stable
                  * at LATENCY_COMP_TARGET_SAMPLES; delaying the synth by
                  * the same amount aligns both into the FX chain. */
@@ -2046,7 +2201,7 @@ static void shadow_inprocess_mix_from_buffer(void) {
                 /* Latency alignment dump (slot 0 only). Touch
                  * /data/UserData/schwung/align_dump_trigger to arm;
                  * captures 300 blocks (~870 ms) of:
-                 *   slot0_move_track.pcm  — Move Link Audio (post-nudge)
+                 *   slot0_move_track.pcm  — Move Link Audio (post-resample)
                  *   slot0_synth_src.pcm   — Schwung synth (post-delay if
                  *                            comp active)
                  * Both s16le stereo @44.1k. Cross-correlate them to
@@ -2085,14 +2240,9 @@ static void shadow_inprocess_mix_from_buffer(void) {
 
                 /* Active slot: combine synth + Link Audio, run through FX */
                 int16_t fx_buf[FRAMES_PER_BLOCK * 2];
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    int32_t combined = (int32_t)synth_src[i];
-                    if (have_move_track)
-                        combined += (int32_t)move_track[i];
-                    if (combined > 32767) combined = 32767;
-                    if (combined < -32768) combined = -32768;
-                    fx_buf[i] = (int16_t)combined;
-                }
+                memcpy(fx_buf, synth_src, sizeof(fx_buf));
+                if (have_move_track)
+                    shadow_mix_add_sat_i16(fx_buf, move_track, FRAMES_PER_BLOCK * 2);
 
                 /* Main-mix dump (rebuild_from_la path). Gated on
                  * /data/UserData/schwung/main_fx_dump_trigger — touch to arm.
@@ -2128,8 +2278,12 @@ static void shadow_inprocess_mix_from_buffer(void) {
                     }
 
                     /* Run FX chain */
+                    struct timespec fx_t0, fx_t1;
+                    clock_gettime(CLOCK_MONOTONIC, &fx_t0);
                     shadow_chain_process_fx(shadow_chain_slots[s].instance,
                                             fx_buf, MOVE_FRAMES_PER_BLOCK);
+                    clock_gettime(CLOCK_MONOTONIC, &fx_t1);
+                    telemetry_record(TELEM_SLOT0_FX + s, TELEMETRY_US(fx_t0, fx_t1));
 
                     if (main_dump_frames > 0) {
                         if (mpost_f[s])
@@ -2149,13 +2303,8 @@ static void shadow_inprocess_mix_from_buffer(void) {
                 }
 
                 /* Track FX output silence for phase 2 idle */
-                int fx_silent = 1;
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    if (fx_buf[i] > DSP_SILENCE_LEVEL || fx_buf[i] < -DSP_SILENCE_LEVEL) {
-                        fx_silent = 0;
-                        break;
-                    }
-                }
+                int fx_silent = shadow_mix_is_silent_i16(fx_buf, FRAMES_PER_BLOCK * 2,
+                                                         DSP_SILENCE_LEVEL);
                 if (fx_silent) {
                     shadow_slot_fx_silence_frames[s]++;
                     if (shadow_slot_fx_silence_frames[s] >= DSP_IDLE_THRESHOLD) {
@@ -2169,8 +2318,8 @@ static void shadow_inprocess_mix_from_buffer(void) {
                 /* Capture for Link Audio publisher */
                 if (s < LINK_AUDIO_SHADOW_CHANNELS) {
                     float cap_vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++)
-                        shadow_slot_capture[s][i] = (int16_t)lroundf((float)fx_buf[i] * cap_vol);
+                    shadow_mix_scale_i16(shadow_slot_capture[s], fx_buf, cap_vol,
+                                         FRAMES_PER_BLOCK * 2);
                     /* Write to publisher shared memory for link_subscriber */
                     if (shadow_pub_audio_shm) {
                         link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
@@ -2185,26 +2334,15 @@ static void shadow_inprocess_mix_from_buffer(void) {
                 }
 
                 /* Add FX output to mailbox */
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    float vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    float gain = vol;
-                    int32_t mixed = (int32_t)mailbox_audio[i] + (int32_t)lroundf((float)fx_buf[i] * gain);
-                    if (mixed > 32767) mixed = 32767;
-                    if (mixed < -32768) mixed = -32768;
-                    mailbox_audio[i] = (int16_t)mixed;
-                    me_full[i] += (int32_t)lroundf((float)fx_buf[i] * vol);
-                    me_unity[i] += (int32_t)lroundf((float)fx_buf[i] * vol);
-                    if (i & 1) shadow_fade_advance(s);
-                }
+                int32_t contrib[FRAMES_PER_BLOCK * 2];
+                shadow_slot_mix_contrib(s, fx_buf, contrib);
+                shadow_mix_add_i32_sat_i16(mailbox_audio, contrib, FRAMES_PER_BLOCK * 2);
+                shadow_mix_add_i32(me_full, contrib, FRAMES_PER_BLOCK * 2);
+                shadow_mix_add_i32(me_unity, contrib, FRAMES_PER_BLOCK * 2);
             } else if (have_move_track) {
                 /* Inactive slot: pass Link Audio through at unity level.
                  * Master volume is applied after capture at the end. */
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    int32_t mixed = (int32_t)mailbox_audio[i] + (int32_t)move_track[i];
-                    if (mixed > 32767) mixed = 32767;
-                    if (mixed < -32768) mixed = -32768;
-                    mailbox_audio[i] = (int16_t)mixed;
-                }
+                shadow_mix_add_sat_i16(mailbox_audio, move_track, FRAMES_PER_BLOCK * 2);
                 /* Publish Move track audio to ME channel even without a synth loaded */
                 if (s < LINK_AUDIO_SHADOW_CHANNELS && shadow_pub_audio_shm) {
                     link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
@@ -2237,22 +2375,20 @@ skip_la_rebuild:
                     float cap_vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
                     link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
                     uint32_t wp = ps->write_pos;
+                    int16_t cap[FRAMES_PER_BLOCK * 2];
+                    shadow_mix_scale_i16(cap, fx_buf, cap_vol, FRAMES_PER_BLOCK * 2);
                     for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                        ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] =
-                            (int16_t)lroundf((float)fx_buf[i] * cap_vol);
+                        ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] = cap[i];
                         wp++;
                     }
                     __sync_synchronize();
                     ps->write_pos = wp;
                 }
 
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    float vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    int32_t contrib = (int32_t)lroundf((float)fx_buf[i] * vol);
-                    me_full[i] += contrib;
-                    me_unity[i] += contrib;
-                    if (i & 1) shadow_fade_advance(s);
-                }
+                int32_t contrib[FRAMES_PER_BLOCK * 2];
+                shadow_slot_mix_contrib(s, fx_buf, contrib);
+                shadow_mix_add_i32(me_full, contrib, FRAMES_PER_BLOCK * 2);
+                shadow_mix_add_i32(me_unity, contrib, FRAMES_PER_BLOCK * 2);
             } else if (shadow_slot_deferred_valid[s]) {
                 /* Fallback: FX not deferred — run inline (legacy path) */
                 if (shadow_slot_fx_idle[s] && shadow_slot_idle[s]) continue;
@@ -2266,22 +2402,18 @@ skip_la_rebuild:
                     float cap_vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
                     link_audio_pub_slot_t *ps = &shadow_pub_audio_shm->slots[s];
                     uint32_t wp = ps->write_pos;
+                    int16_t cap[FRAMES_PER_BLOCK * 2];
+                    shadow_mix_scale_i16(cap, fx_buf, cap_vol, FRAMES_PER_BLOCK * 2);
                     for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                        ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] =
-                            (int16_t)lroundf((float)fx_buf[i] * cap_vol);
+                        ps->ring[wp & LINK_AUDIO_PUB_SHM_RING_MASK] = cap[i];
                         wp++;
                     }
                     __sync_synchronize();
                     ps->write_pos = wp;
                 }
 
-                int fx_silent = 1;
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    if (fx_buf[i] > DSP_SILENCE_LEVEL || fx_buf[i] < -DSP_SILENCE_LEVEL) {
-                        fx_silent = 0;
-                        break;
-                    }
-                }
+                int fx_silent = shadow_mix_is_silent_i16(fx_buf, FRAMES_PER_BLOCK * 2,
+                                                         DSP_SILENCE_LEVEL);
                 if (fx_silent) {
                     shadow_slot_fx_silence_frames[s]++;
                     if (shadow_slot_fx_silence_frames[s] >= DSP_IDLE_THRESHOLD)
@@ -2291,13 +2423,10 @@ skip_la_rebuild:
                     shadow_slot_fx_idle[s] = 0;
                 }
 
-                for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-                    float vol = shadow_effective_volume(s) * shadow_chain_slots[s].fade.gain;
-                    int32_t contrib = (int32_t)lroundf((float)fx_buf[i] * vol);
-                    me_full[i] += contrib;
-                    me_unity[i] += contrib;
-                    if (i & 1) shadow_fade_advance(s);
-                }
+                int32_t contrib[FRAMES_PER_BLOCK * 2];
+                shadow_slot_mix_contrib(s, fx_buf, contrib);
+                shadow_mix_add_i32(me_full, contrib, FRAMES_PER_BLOCK * 2);
+                shadow_mix_add_i32(me_unity, contrib, FRAMES_PER_BLOCK * 2);
             }
         }
     }
@@ -2305,25 +2434,14 @@ skip_la_rebuild:
     /* Mix overtake DSP buffer into ME bus unconditionally. Under rebuild_from_la,
      * the mailbox is already the ME reconstruction and also needs overtake DSP;
      * under non-rebuild, the mailbox is Move-only and overtake DSP stays in ME. */
-    for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-        me_full[i] += (int32_t)shadow_deferred_dsp_buffer[i];
-        me_unity[i] += (int32_t)shadow_deferred_dsp_buffer[i];
-    }
+    shadow_mix_add_i16_to_i32(me_full, shadow_deferred_dsp_buffer, FRAMES_PER_BLOCK * 2);
+    shadow_mix_add_i16_to_i32(me_unity, shadow_deferred_dsp_buffer, FRAMES_PER_BLOCK * 2);
     if (rebuild_from_la) {
-        for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-            int32_t mixed = (int32_t)mailbox_audio[i] + (int32_t)shadow_deferred_dsp_buffer[i];
-            if (mixed > 32767) mixed = 32767;
-            if (mixed < -32768) mixed = -32768;
-            mailbox_audio[i] = (int16_t)mixed;
-        }
+        shadow_mix_add_sat_i16(mailbox_audio, shadow_deferred_dsp_buffer, FRAMES_PER_BLOCK * 2);
     }
 
     /* Save ME full-gain component for bridge split */
-    for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-        if (me_full[i] > 32767) me_full[i] = 32767;
-        if (me_full[i] < -32768) me_full[i] = -32768;
-        native_bridge_me_component[i] = (int16_t)me_full[i];
-    }
+    shadow_mix_clamp_i32_to_i16(native_bridge_me_component, me_full, FRAMES_PER_BLOCK * 2);
     native_bridge_capture_mv = mv;
     native_bridge_split_valid = 1;
 
@@ -2337,43 +2455,63 @@ skip_la_rebuild:
         }
         __sync_synchronize();
         ps->write_pos = wp;
+        /* Last publisher write of the block: hand it to link-subscriber now */
+        link_audio_pub_kick(shadow_pub_audio_shm);
     }
 
     /* Build int16 view of me_unity for FX plugins (MFX, overtake DSP FX).
      * Under rebuild_from_la, mailbox is already the ME reconstruction and FX
      * run on mailbox directly (preserving existing behavior — Task 8 revisits). */
     int16_t me_unity_i16[FRAMES_PER_BLOCK * 2];
+    int16_t *fx_target = rebuild_from_la ? mailbox_audio : me_unity_i16;
+
+    /* Float master FX bus: if any MFX slot exports a float32 entry point,
+     * run the chain on the unclipped ME sum and saturate once at the end
+     * instead of clamping me_unity before the first effect. */
+    struct timespec mfx_t0, mfx_t1;
+    clock_gettime(CLOCK_MONOTONIC, &mfx_t0);
+    int mfx_float = 0;
     if (!rebuild_from_la) {
-        for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-            int32_t v = me_unity[i];
-            if (v > 32767) v = 32767;
-            if (v < -32768) v = -32768;
-            me_unity_i16[i] = (int16_t)v;
+        for (int fx = 0; fx < MASTER_FX_SLOTS; fx++) {
+            if (shadow_master_fx_slots[fx].instance && shadow_master_fx_slots[fx].process_f32) {
+                mfx_float = 1;
+                break;
+            }
         }
     }
-    int16_t *fx_target = rebuild_from_la ? mailbox_audio : me_unity_i16;
 
-    /* Overtake DSP FX: process ME bus (non-rebuild) or reconstructed mailbox (rebuild_from_la) */
-    if (overtake_dsp_fx && overtake_dsp_fx_inst && overtake_dsp_fx->process_block) {
-        overtake_dsp_fx->process_block(overtake_dsp_fx_inst, fx_target, FRAMES_PER_BLOCK);
-    }
+    if (mfx_float) {
+        shadow_master_fx_run_f32(me_unity, me_unity_i16);
+    } else {
+        if (!rebuild_from_la) {
+            shadow_mix_clamp_i32_to_i16(me_unity_i16, me_unity, FRAMES_PER_BLOCK * 2);
+        }
 
-    /* Apply master FX chain. Under non-rebuild, MFX processes ME only; under
-     * rebuild_from_la, mailbox contains reconstructed ME tracks and MFX
-     * processes mailbox (Task 8 revisits). */
-    for (int fx = 0; fx < MASTER_FX_SLOTS; fx++) {
-        master_fx_slot_t *s = &shadow_master_fx_slots[fx];
-        if (!(s->instance && s->api && s->api->process_block)) continue;
-        int16_t mfx_dry[FRAMES_PER_BLOCK * 2];
-        if (s->bypassed) {
-            memcpy(mfx_dry, fx_target, FRAMES_PER_BLOCK * 2 * sizeof(int16_t));
+        /* Overtake DSP FX: process ME bus (non-rebuild) or reconstructed mailbox (rebuild_from_la) */
+        if (overtake_dsp_fx && overtake_dsp_fx_inst && overtake_dsp_fx->process_block) {
+            overtake_dsp_fx->process_block(overtake_dsp_fx_inst, fx_target, FRAMES_PER_BLOCK);
         }
-        s->api->process_block(s->instance, fx_target, FRAMES_PER_BLOCK);
-        if (s->bypassed) {
-            memcpy(fx_target, mfx_dry, FRAMES_PER_BLOCK * 2 * sizeof(int16_t));
+
+        /* Apply master FX chain. Under non-rebuild, MFX processes ME only; under
+         * rebuild_from_la, mailbox contains reconstructed ME tracks and MFX
+         * processes mailbox (Task 8 revisits). */
+        for (int fx = 0; fx < MASTER_FX_SLOTS; fx++) {
+            master_fx_slot_t *s = &shadow_master_fx_slots[fx];
+            if (!(s->instance && s->api && s->api->process_block)) continue;
+            int16_t mfx_dry[FRAMES_PER_BLOCK * 2];
+            if (s->bypassed) {
+                memcpy(mfx_dry, fx_target, FRAMES_PER_BLOCK * 2 * sizeof(int16_t));
+            }
+            s->api->process_block(s->instance, fx_target, FRAMES_PER_BLOCK);
+            if (s->bypassed) {
+                memcpy(fx_target, mfx_dry, FRAMES_PER_BLOCK * 2 * sizeof(int16_t));
+            }
         }
     }
 
+    clock_gettime(CLOCK_MONOTONIC, &mfx_t1);
+    telemetry_record(TELEM_MASTER_FX, TELEMETRY_US(mfx_t0, mfx_t1));
+
     /* Tick Master FX LFOs after processing so updated params apply next block.
      * This mirrors the legacy in-process mix path behavior. */
     shadow_master_fx_lfo_tick(FRAMES_PER_BLOCK);
@@ -2382,13 +2520,7 @@ skip_la_rebuild:
      * Move's audio in mailbox is already at mv; ME needs mv applied here.
      * Skipped under rebuild_from_la — that path has already composited into mailbox. */
     if (!rebuild_from_la) {
-        for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-            int32_t scaled_me = (int32_t)lroundf((float)me_unity_i16[i] * mv);
-            int32_t summed = (int32_t)mailbox_audio[i] + scaled_me;
-            if (summed > 32767) summed = 32767;
-            if (summed < -32768) summed = -32768;
-            mailbox_audio[i] = (int16_t)summed;
-        }
+        shadow_mix_add_gain_sat_i16(mailbox_audio, me_unity_i16, mv, FRAMES_PER_BLOCK * 2);
     }
 
     /* Build unity_view for capture consumers (skipback, native bridge, sampler).
@@ -2427,12 +2559,7 @@ skip_la_rebuild:
      * no master vol). Apply master volume now so DAC output respects the knob.
      * Non-rebuild path already applied mv in the final ME-sum above. */
     if (rebuild_from_la && mv < 0.9999f) {
-        for (int i = 0; i < FRAMES_PER_BLOCK * 2; i++) {
-            float scaled = (float)mailbox_audio[i] * mv;
-            if (scaled > 32767.0f) scaled = 32767.0f;
-            if (scaled < -32768.0f) scaled = -32768.0f;
-            mailbox_audio[i] = (int16_t)lroundf(scaled);
-        }
+        shadow_mix_scale_i16(mailbox_audio, mailbox_audio, mv, FRAMES_PER_BLOCK * 2);
     }
 
     /* Speaker-EQ compensation: on rebuild_from_la the DAC mailbox bypasses
@@ -2495,9 +2622,9 @@ skip_la_rebuild:
 
         /* Skipback buffer resize: settings UI writes new desired length to
          * shadow_control->skipback_seconds. We compare against the actually
-         * allocated size and dispatch a worker thread to resize. The worker
-         * holds skipback_saving briefly, so audio capture pauses for the
-         * ~tens-of-ms it takes to malloc + memcpy the new buffer. */
+         * allocated size and dispatch a worker thread to resize. Capture
+         * keeps running while the worker allocates and copies; it is only
+         * shut out for the final pointer swap. */
         {
             int desired = (int)shadow_control->skipback_seconds;
             if (desired > 0 && desired != skipback_get_seconds()
@@ -2623,6 +2750,7 @@ static inline void shadow_ui_midi_publish(uint8_t head, uint8_t status,
             shadow_ui_midi_shm[slot + 3] = d2;
             __atomic_store_n(&shadow_ui_midi_shm[slot], head, __ATOMIC_RELEASE);
             shadow_control->midi_ready++;
+            shadow_ui_wake(shadow_control);
             return;
         }
     }
@@ -2895,15 +3023,15 @@ static void init_shadow_shm(void)
     /* Create/open display shared memory */
     shm_display_fd = shm_open(SHM_SHADOW_DISPLAY, O_CREAT | O_RDWR, 0666);
     if (shm_display_fd >= 0) {
-        ftruncate(shm_display_fd, DISPLAY_BUFFER_SIZE);
-        shadow_display_shm = (uint8_t *)mmap(NULL, DISPLAY_BUFFER_SIZE,
+        ftruncate(shm_display_fd, SHADOW_DISPLAY_SHM_SIZE);
+        shadow_display_shm = (uint8_t *)mmap(NULL, SHADOW_DISPLAY_SHM_SIZE,
                                               PROT_READ | PROT_WRITE,
                                               MAP_SHARED, shm_display_fd, 0);
         if (shadow_display_shm == MAP_FAILED) {
             shadow_display_shm = NULL;
             printf("Shadow: Failed to mmap display shm\n");
         } else {
-            memset(shadow_display_shm, 0, DISPLAY_BUFFER_SIZE);
+            memset(shadow_display_shm, 0, SHADOW_DISPLAY_SHM_SIZE);
         }
     } else {
         printf("Shadow: Failed to create display shm\n");
@@ -3043,6 +3171,24 @@ static void init_shadow_shm(void)
         }
     }
 
+    /* Create/open batched param rings (shadow UI ↔ shim, many requests in flight) */
+    {
+        int fd = shm_open(SHM_SHADOW_PARAM_RING, O_CREAT | O_RDWR, 0666);
+        if (fd >= 0) {
+            ftruncate(fd, sizeof(shadow_param_ring_t));
+            shadow_param_ring = (shadow_param_ring_t *)mmap(NULL, sizeof(shadow_param_ring_t),
+                                                            PROT_READ | PROT_WRITE,
+                                                            MAP_SHARED, fd, 0);
+            if (shadow_param_ring == MAP_FAILED) {
+                shadow_param_ring = NULL;
+                printf("Shadow: Failed to mmap param ring\n");
+            } else {
+                memset(shadow_param_ring, 0, sizeof(shadow_param_ring_t));
+            }
+            close(fd);
+        }
+    }
+
     /* Create/open MIDI out shared memory (for shadow UI to send MIDI) */
     shm_midi_out_fd = shm_open(SHM_SHADOW_MIDI_OUT, O_CREAT | O_RDWR, 0666);
     if (shm_midi_out_fd >= 0) {
@@ -3401,6 +3547,23 @@ static void shadow_check_screenreader_announcements(void) {
 
 
 
+/* Shadow UI frame as last copied out of /schwung-display. The UI only
+ * rewrites the slices it drew into and flags them after the frame, so
+ * unchanged slices are never re-read here. */
+static uint8_t shadow_display_frame[DISPLAY_BUFFER_SIZE];
+
+static void shadow_display_pull(void)
+{
+    uint32_t *dirty_word = (uint32_t *)(shadow_display_shm + SHADOW_DISPLAY_DIRTY_OFFSET);
+    uint32_t dirty = __atomic_exchange_n(dirty_word, 0, __ATOMIC_ACQUIRE);
+    for (int s = 0; dirty && s < DISPLAY_SLICE_COUNT; s++) {
+        if (!(dirty & (1u << s))) continue;
+        int offset = s * DISPLAY_SLICE_BYTES;
+        int bytes = (s == DISPLAY_SLICE_COUNT - 1) ? DISPLAY_BUFFER_SIZE - offset : DISPLAY_SLICE_BYTES;
+        memcpy(shadow_display_frame + offset, shadow_display_shm + offset, bytes);
+    }
+}
+
 /* Swap display buffer if in shadow mode */
 static void shadow_swap_display(void)
 {
@@ -3452,7 +3615,8 @@ static void shadow_swap_display(void)
 
     /* Composite overlays onto shadow display if active */
     static uint8_t shadow_composited[DISPLAY_BUFFER_SIZE];
-    const uint8_t *display_src = shadow_display_shm;
+    shadow_display_pull();
+    const uint8_t *display_src = shadow_display_frame;
 
     if (skipback_overlay_timeout > 0) {
         skipback_overlay_timeout--;
@@ -3468,7 +3632,7 @@ static void shadow_swap_display(void)
     int draw_midi_ind = shadow_control && shadow_control->midi_indicator_enabled
                         && midi_indicator_active_notes > 0;
     if (draw_rec_dot || draw_midi_ind) {
-        memcpy(shadow_composited, shadow_display_shm, DISPLAY_BUFFER_SIZE);
+        memcpy(shadow_composited, shadow_display_frame, DISPLAY_BUFFER_SIZE);
         if (draw_rec_dot) {
             overlay_fill_rect(shadow_composited, 123, 1, 4, 4, 1);
         }
@@ -3557,51 +3721,51 @@ void web_param_notify_push(uint8_t slot, const char *key, const char *value) {
 }
 
 /* Callback for chain_mgmt: handle shim-specific param prefixes.
- * Reads/writes shadow_param->key/value/error/result_len directly.
+ * Reads/writes param->key/value/error/result_len directly.
  * Returns 1 if handled, 0 if not. */
-static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
+static int shim_handle_param_special(shadow_param_t *param, uint8_t req_type, uint32_t req_id) {
     (void)req_id;
-    const char *key = shadow_param->key;
+    const char *key = param->key;
 
     /* overtake_dsp:<sub_key> */
     if (strncmp(key, "overtake_dsp:", 13) == 0) {
         const char *param_key = key + 13;
         if (req_type == 1) {  /* SET */
             if (strcmp(param_key, "load") == 0) {
-                shadow_overtake_dsp_load(shadow_param->value);
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                shadow_overtake_dsp_load(param->value);
+                param->error = 0;
+                param->result_len = 0;
             } else if (strcmp(param_key, "unload") == 0) {
                 shadow_overtake_dsp_unload();
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                param->error = 0;
+                param->result_len = 0;
             } else if (overtake_dsp_gen && overtake_dsp_gen_inst && overtake_dsp_gen->set_param) {
-                overtake_dsp_gen->set_param(overtake_dsp_gen_inst, param_key, shadow_param->value);
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                overtake_dsp_gen->set_param(overtake_dsp_gen_inst, param_key, param->value);
+                param->error = 0;
+                param->result_len = 0;
             } else if (overtake_dsp_fx && overtake_dsp_fx_inst && overtake_dsp_fx->set_param) {
-                overtake_dsp_fx->set_param(overtake_dsp_fx_inst, param_key, shadow_param->value);
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                overtake_dsp_fx->set_param(overtake_dsp_fx_inst, param_key, param->value);
+                param->error = 0;
+                param->result_len = 0;
             } else {
-                shadow_param->error = 13;
-                shadow_param->result_len = -1;
+                param->error = 13;
+                param->result_len = -1;
             }
         } else if (req_type == 2) {  /* GET */
             int len = -1;
             if (overtake_dsp_gen && overtake_dsp_gen_inst && overtake_dsp_gen->get_param) {
                 len = overtake_dsp_gen->get_param(overtake_dsp_gen_inst, param_key,
-                                                   shadow_param->value, SHADOW_PARAM_VALUE_LEN);
+                                                   param->value, SHADOW_PARAM_VALUE_LEN);
             } else if (overtake_dsp_fx && overtake_dsp_fx_inst && overtake_dsp_fx->get_param) {
                 len = overtake_dsp_fx->get_param(overtake_dsp_fx_inst, param_key,
-                                                  shadow_param->value, SHADOW_PARAM_VALUE_LEN);
+                                                  param->value, SHADOW_PARAM_VALUE_LEN);
             }
             if (len >= 0) {
-                shadow_param->error = 0;
-                shadow_param->result_len = len;
+                param->error = 0;
+                param->result_len = len;
             } else {
-                shadow_param->error = 14;
-                shadow_param->result_len = -1;
+                param->error = 14;
+                param->result_len = -1;
             }
         }
         return 1;
@@ -3610,14 +3774,14 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
     /* jack:display — enable/disable JACK display override */
     if (strcmp(key, "jack:display") == 0) {
         if (req_type == 1 && g_jack_shm) {  /* SET */
-            g_jack_shm->display_active = (shadow_param->value[0] == '1') ? 1 : 0;
-            shadow_param->error = 0;
-            shadow_param->result_len = 0;
+            g_jack_shm->display_active = (param->value[0] == '1') ? 1 : 0;
+            param->error = 0;
+            param->result_len = 0;
         } else if (req_type == 2 && g_jack_shm) {  /* GET */
-            shadow_param->value[0] = g_jack_shm->display_active ? '1' : '0';
-            shadow_param->value[1] = '\0';
-            shadow_param->error = 0;
-            shadow_param->result_len = 1;
+            param->value[0] = g_jack_shm->display_active ? '1' : '0';
+            param->value[1] = '\0';
+            param->error = 0;
+            param->result_len = 1;
         }
         return 1;
     }
@@ -3631,7 +3795,7 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
     if (strcmp(key, "passthrough") == 0) {
         if (req_type == 1) {
             memset(overtake_passthrough_ccs, 0, sizeof(overtake_passthrough_ccs));
-            const char *p = shadow_param->value;
+            const char *p = param->value;
             while (p && *p) {
                 while (*p == ' ' || *p == ',') p++;
                 if (!*p) break;
@@ -3642,7 +3806,7 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
             /* Log so we can verify registration in the debug log. */
             char dbg[128];
             int off = snprintf(dbg, sizeof(dbg), "passthrough set: value=\"%s\" ccs=[",
-                               shadow_param->value ? shadow_param->value : "");
+                               param->value ? param->value : "");
             for (int i = 0; i < 128 && off < (int)sizeof(dbg) - 4; i++) {
                 if (overtake_passthrough_ccs[i]) {
                     off += snprintf(dbg + off, sizeof(dbg) - off, "%d,", i);
@@ -3650,22 +3814,22 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
             }
             snprintf(dbg + off, sizeof(dbg) - off, "]");
             shadow_log(dbg);
-            shadow_param->error = 0;
-            shadow_param->result_len = 0;
+            param->error = 0;
+            param->result_len = 0;
         }
-        shadow_param->response_ready = 1;
-        shadow_param->response_id = shadow_param->request_id;
+        param->response_ready = 1;
+        param->response_id = param->request_id;
         return 1;
     }
 
     if (strcmp(key, "suspend_overtake") == 0) {
         if (req_type == 1 && shadow_control) {  /* SET */
-            shadow_control->suspend_overtake = (shadow_param->value[0] == '1') ? 1 : 0;
-            shadow_param->error = 0;
-            shadow_param->result_len = 0;
+            shadow_control->suspend_overtake = (param->value[0] == '1') ? 1 : 0;
+            param->error = 0;
+            param->result_len = 0;
         }
-        shadow_param->response_ready = 1;
-        shadow_param->response_id = shadow_param->request_id;
+        param->response_ready = 1;
+        param->response_id = param->request_id;
         return 1;
     }
 
@@ -3682,11 +3846,11 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
             }
             led_queue_restore_jack_leds();
             led_queue_restore_jack_sysex_leds();
-            shadow_param->error = 0;
-            shadow_param->result_len = 0;
+            param->error = 0;
+            param->result_len = 0;
         }
-        shadow_param->response_ready = 1;
-        shadow_param->response_id = shadow_param->request_id;
+        param->response_ready = 1;
+        param->response_id = param->request_id;
         return 1;
     }
 
@@ -3696,7 +3860,7 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
         if (strcmp(fx_key, "resample_bridge") == 0) {
             if (req_type == 1) {
                 native_resample_bridge_mode_t new_mode =
-                    native_resample_bridge_mode_from_text(shadow_param->value);
+                    native_resample_bridge_mode_from_text(param->value);
                 if (new_mode != native_resample_bridge_mode) {
                     char msg[128];
                     snprintf(msg, sizeof(msg), "Native resample bridge mode: %s",
@@ -3704,21 +3868,21 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
                     shadow_log(msg);
                 }
                 native_resample_bridge_mode = new_mode;
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                param->error = 0;
+                param->result_len = 0;
             } else if (req_type == 2) {
                 int mode = (int)native_resample_bridge_mode;
                 if (mode < 0 || mode > 2) mode = 0;
-                shadow_param->result_len = snprintf(shadow_param->value,
+                param->result_len = snprintf(param->value,
                     SHADOW_PARAM_VALUE_LEN, "%d", mode);
-                shadow_param->error = 0;
+                param->error = 0;
             }
             return 1;
         }
         /* master_fx:link_audio_routing */
         if (strcmp(fx_key, "link_audio_routing") == 0) {
             if (req_type == 1) {
-                int val = atoi(shadow_param->value);
+                int val = atoi(param->value);
                 int prev = link_audio_routing_enabled;
                 link_audio_routing_enabled = val ? 1 : 0;
                 /* On 0→1, re-attempt /schwung-link-in attach. The init-time
@@ -3742,19 +3906,19 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
                              link_audio_routing_enabled ? "ON" : "OFF");
                     shadow_log(msg);
                 }
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                param->error = 0;
+                param->result_len = 0;
             } else if (req_type == 2) {
-                shadow_param->result_len = snprintf(shadow_param->value,
+                param->result_len = snprintf(param->value,
                     SHADOW_PARAM_VALUE_LEN, "%d", link_audio_routing_enabled);
-                shadow_param->error = 0;
+                param->error = 0;
             }
             return 1;
         }
         /* master_fx:link_audio_publish */
         if (strcmp(fx_key, "link_audio_publish") == 0) {
             if (req_type == 1) {
-                int val = atoi(shadow_param->value);
+                int val = atoi(param->value);
                 link_audio_publish_enabled = val ? 1 : 0;
                 {
                     char msg[64];
@@ -3762,12 +3926,12 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
                              link_audio_publish_enabled ? "ON" : "OFF");
                     shadow_log(msg);
                 }
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                param->error = 0;
+                param->result_len = 0;
             } else if (req_type == 2) {
-                shadow_param->result_len = snprintf(shadow_param->value,
+                param->result_len = snprintf(param->value,
                     SHADOW_PARAM_VALUE_LEN, "%d", link_audio_publish_enabled);
-                shadow_param->error = 0;
+                param->error = 0;
             }
             return 1;
         }
@@ -3777,23 +3941,23 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
          * flipping a delay buffer mid-playback. */
         if (strcmp(fx_key, "latency_comp_enabled") == 0) {
             if (req_type == 1) {
-                int val = atoi(shadow_param->value) ? 1 : 0;
+                int val = atoi(param->value) ? 1 : 0;
                 latency_comp_user_enabled = val;
                 if (val != latency_comp_active) {
                     latency_comp_active = val;
-                    link_audio_reset_nudge_state();
+                    link_audio_reset_drift_state();
                     shadow_latency_delay_reset();
                     char msg[64];
                     snprintf(msg, sizeof(msg), "Latency Comp: %s",
                              latency_comp_active ? "ACTIVE" : "BYPASSED");
                     shadow_log(msg);
                 }
-                shadow_param->error = 0;
-                shadow_param->result_len = 0;
+                param->error = 0;
+                param->result_len = 0;
             } else if (req_type == 2) {
-                shadow_param->result_len = snprintf(shadow_param->value,
+                param->result_len = snprintf(param->value,
                     SHADOW_PARAM_VALUE_LEN, "%d", latency_comp_user_enabled);
-                shadow_param->error = 0;
+                param->error = 0;
             }
             return 1;
         }
@@ -3817,12 +3981,12 @@ static int shim_handle_param_special(uint8_t req_type, uint32_t req_id) {
                         }
                     }
                 }
-                shadow_param->result_len = snprintf(shadow_param->value,
+                param->result_len = snprintf(param->value,
                     SHADOW_PARAM_VALUE_LEN, "%d", enabled);
-                shadow_param->error = 0;
+                param->error = 0;
             } else {
-                shadow_param->error = 1; /* read-only */
-                shadow_param->result_len = 0;
+                param->error = 1; /* read-only */
+                param->result_len = 0;
             }
             return 1;
         }
@@ -3880,12 +4044,14 @@ static void shim_init_subsystems(void)
         chain_mgmt_host_t cm_host = {
             .shadow_control_ptr = &shadow_control,
             .shadow_param_ptr = &shadow_param,
+            .shadow_param_ring_ptr = &shadow_param_ring,
             .shadow_ui_state_ptr = &shadow_ui_state,
             .global_mmap_addr_ptr = &global_mmap_addr,
             .overlay_sync = shadow_overlay_sync,
             .run_command = shim_run_command,
             .launch_shadow_ui = launch_shadow_ui,
             .shadow_ui_enabled = &shadow_ui_enabled,
+            .async_patch_load_enabled = &async_patch_load_enabled,
             .startup_modwheel_countdown = &shadow_startup_modwheel_countdown,
             .startup_modwheel_reset_frames = STARTUP_MODWHEEL_RESET_FRAMES,
             .handle_param_special = shim_handle_param_special,
@@ -3918,7 +4084,7 @@ static void shim_init_subsystems(void)
             .announce = send_screenreader_announcement,
             .overlay_sync = shadow_overlay_sync,
             .run_command = shim_run_command,
-            .save_state = shadow_save_state,
+            .save_state = shadow_flush_state,   /* runs right before a Move restart */
             .read_set_mute_states = shadow_read_set_mute_states,
             .read_set_tempo = sampler_read_set_tempo,
             .ui_state_update_slot = shadow_ui_state_update_slot,
@@ -4015,6 +4181,7 @@ static void shim_init_subsystems(void)
             .master_fx_forward_midi = shadow_master_fx_forward_midi,
             .queue_led = shadow_queue_led,
             .init_led_queue = shadow_init_led_queue,
+            .chain_on_midi_timed = sample_accurate_midi_enabled ? &shadow_chain_on_midi_timed : NULL,
             .chain_slots = shadow_chain_slots,
             .plugin_v2 = &shadow_plugin_v2,
             .shadow_control = &shadow_control,
@@ -4035,6 +4202,17 @@ static void shim_init_subsystems(void)
         };
         midi_routing_init(&midi_host);
     }
+    /* Start the slot render pool (cores 0-2, FIFO). One worker per
+     * remaining slot: the SPI thread renders a slot itself. */
+    {
+        render_pool_host_t rp_host = {
+            .log = shadow_log,
+        };
+        render_pool_init(&rp_host);
+        if (parallel_render_enabled) {
+            render_pool_start(SHADOW_CHAIN_INSTANCES - 1);
+        }
+    }
     /* Start Link Audio monitor — it will launch the subscriber
      * once link_audio_routing_enabled is set from config */
     if (link_audio.enabled) {
@@ -4052,6 +4230,7 @@ static void shim_init_subsystems(void)
         dbus_host_t dbus_host = {
             .log = shadow_log,
             .save_state = shadow_save_state,
+            .flush_state = shadow_flush_state,
             .apply_mute = shadow_apply_mute,
             .ui_state_update_slot = shadow_ui_state_update_slot,
             .native_sampler_update = native_sampler_update_from_dbus_text,
@@ -4696,6 +4875,8 @@ static void shim_pre_transfer(void *ctx, uint8_t *shadow, int size)
     }
 
     clock_gettime(CLOCK_MONOTONIC, &spi_ioctl_start);
+    telemetry_frame_begin((uint64_t)spi_ioctl_start.tv_sec * 1000000000ULL +
+                          (uint64_t)spi_ioctl_start.tv_nsec);
 
     /* === IOCTL GAP DETECTION (always-on, no flag needed) === */
     {
@@ -4732,17 +4913,11 @@ static void shim_pre_transfer(void *ctx, uint8_t *shadow, int size)
         spi_consecutive_overruns++;
         if (spi_consecutive_overruns >= SKIP_DSP_THRESHOLD) {
             spi_skip_dsp_this_frame = 1;
-#if SHADOW_TIMING_LOG
             static int skip_log_count = 0;
             if (skip_log_count++ < 10 || skip_log_count % 100 == 0) {
-                FILE *f = fopen("/tmp/ioctl_timing.log", "a");
-                if (f) {
-                    fprintf(f, "SKIP_DSP: spi_consecutive_overruns=%d, last_frame=%llu us\n",
+                LOG_RT_WARN("spi_timing", "SKIP_DSP: consecutive_overruns=%d last_frame=%lluus",
                             spi_consecutive_overruns, (unsigned long long)spi_last_frame_total_us);
-                    fclose(f);
-                }
             }
-#endif
         }
     } else {
         spi_consecutive_overruns = 0;
@@ -4791,6 +4966,7 @@ static void shim_pre_transfer(void *ctx, uint8_t *shadow, int size)
 
     TIME_SECTION_START();
     shadow_inprocess_handle_param_request();
+    shadow_inprocess_drain_param_ring();  /* Batched JS param requests (bounded) */
     shadow_drain_web_param_set();  /* Web UI fire-and-forget param sets */
     TIME_SECTION_END(spi_param_req_sum, spi_param_req_max);
 
@@ -4873,6 +5049,7 @@ static void shim_pre_transfer(void *ctx, uint8_t *shadow, int size)
         /* Track in granular timing */
         spi_inproc_mix_sum += mix_us;
         if (mix_us > spi_inproc_mix_max) spi_inproc_mix_max = mix_us;
+        telemetry_record(TELEM_MIX, (uint32_t)mix_us);
     }
 
     /* Update publisher shm slot active flags (subscriber reads these).
@@ -5178,7 +5355,15 @@ static void shim_pre_transfer(void *ctx, uint8_t *shadow, int size)
                         shadow_overlay_sync();
                 }
                 if (set_page_overlay_on) {
-                    set_page_overlay_timeout--;
+                    /* The switch thread advances set_page_loading: publish
+                     * each stage, and keep the toast up until it is done */
+                    static int synced_page_stage = -1;
+                    if (set_page_loading != synced_page_stage) {
+                        synced_page_stage = set_page_loading;
+                        shadow_overlay_sync();
+                    }
+                    if (!set_page_change_in_flight)
+                        set_page_overlay_timeout--;
                     if (set_page_overlay_timeout <= 0) {
                         set_page_overlay_active = 0;
                         shadow_overlay_sync();
@@ -7143,6 +7328,7 @@ static void shim_post_transfer(void *ctx, uint8_t *shadow, const uint8_t *hw, in
         }
     }
     TIME_SECTION_END(spi_post_render_sum, spi_post_render_max);
+    telemetry_record(TELEM_RENDER, TELEMETRY_US(spi_section_start, spi_section_end));
 #endif
 
     /* === POST-IOCTL: CHECK FOR RESTART REQUEST === */
@@ -7181,7 +7367,15 @@ post_timing:
     if (ioctl_us > spi_ioctl_max) spi_ioctl_max = ioctl_us;
     if (post_us > spi_post_max) spi_post_max = post_us;
 
-    /* Track overruns (no I/O — just update snapshot) */
+    /* Per-stage histograms + overrun ring in /schwung-telemetry — no I/O */
+    telemetry_record(TELEM_TOTAL, (uint32_t)total_us);
+    telemetry_record(TELEM_PRE, (uint32_t)pre_us);
+    telemetry_record(TELEM_IOCTL, (uint32_t)ioctl_us);
+    telemetry_record(TELEM_POST, (uint32_t)post_us);
+    telemetry_frame_end();
+
+    /* Track overruns (no I/O — just update snapshot, and queue an RT log
+     * record so every spike is in debug.log, not only the last one) */
     if (total_us > 2000) {
         static uint32_t hook_overrun_count = 0;
         hook_overrun_count++;
@@ -7190,6 +7384,10 @@ post_timing:
         spi_snap.last_overrun_pre = pre_us;
         spi_snap.last_overrun_ioctl = ioctl_us;
         spi_snap.last_overrun_post = post_us;
+        LOG_RT_DEBUG("spi_timing", "Overrun #%u: total=%lluus pre=%llu ioctl=%llu post=%llu",
+                     hook_overrun_count, (unsigned long long)total_us,
+                     (unsigned long long)pre_us, (unsigned long long)ioctl_us,
+                     (unsigned long long)post_us);
     }
 
     /* Snapshot frame-level timing every 1000 blocks (~3s) — no I/O */
@@ -7421,6 +7619,15 @@ static void *spi_timing_logger_thread(void *arg)
                 (unsigned long long)spi_snap.slot_fx_max[1],
                 (unsigned long long)spi_snap.slot_fx_max[2],
                 (unsigned long long)spi_snap.slot_fx_max[3]);
+            if (render_pool_worker_count() > 0) {
+                render_pool_stats_t rp;
+                render_pool_take_stats(&rp);
+                unified_log("spi_timing", LOG_LEVEL_DEBUG,
+                    "Render pool: workers=%d batches=%u jobs worker=%u caller=%u join_wait_max=%lluus",
+                    render_pool_worker_count(), rp.batches,
+                    rp.jobs_worker, rp.jobs_caller,
+                    (unsigned long long)rp.join_wait_max_us);
+            }
             if (spi_snap.jack_audio_hits > 0 || spi_snap.jack_audio_misses > 0) {
                 unified_log("spi_timing", LOG_LEVEL_DEBUG,
                     "JACK audio: hits=%u misses=%u (%.3f%% miss)",
@@ -7512,15 +7719,18 @@ static void *spi_timing_logger_thread(void *arg)
                                              &a_sum, &a_ct);
                 if (a_ct == 0) continue;
                 double mean = (double)a_sum / (double)a_ct;
+                float drift_ppm = 0.0f, drift_err = 0.0f;
+                link_audio_get_drift_stats(s, &drift_ppm, &drift_err);
                 /* avail is stereo samples → /2 frames → /44.1 ms */
                 unified_log("link_audio", LOG_LEVEL_INFO,
                     "avail slot=%d name=%s n=%u "
                     "min=%u (%.2f ms) mean=%.1f (%.2f ms) "
-                    "max=%u (%.2f ms)",
+                    "max=%u (%.2f ms) drift=%+.1fppm fill_err=%+.1f frames",
                     s, shadow_in_audio_shm->slots[s].name, a_ct,
                     a_min, (double)a_min / 2.0 / 44.1,
                     mean,  mean         / 2.0 / 44.1,
-                    a_max, (double)a_max / 2.0 / 44.1);
+                    a_max, (double)a_max / 2.0 / 44.1,
+                    drift_ppm, drift_err);
             }
         }
     }
@@ -7549,6 +7759,12 @@ static void shim_spi_init(void)
     /* Create JACK shadow driver shared memory (optional — zero overhead if JACK never connects) */
     g_jack_shm = schwung_jack_bridge_create();
 
+    /* Per-stage SPI histograms for schwung-telemetry / schwung-manager */
+    {
+        telemetry_host_t telem_host = { .log = shadow_log };
+        telemetry_init(&telem_host);
+    }
+
     /* Start background timing logger thread */
     {
         pthread_t tid;
@@ -26,23 +26,31 @@
 #include "quickjs-libc.h"
 
 #include "host/js_display.h"
+#include "host/js_bytecode_cache.h"
 #include "host/shadow_constants.h"
+#include "host/shadow_ui_wake.h"
+#include "host/link_audio.h"
 #include "../host/unified_log.h"
 #include "../host/analytics.h"
 
 #define SAMPLER_CMD_PATH "/data/UserData/schwung/sampler_cmd_path.txt"
 
+/* Overtake modules keep the fast tick this long after their last activity */
+#define OVERTAKE_FAST_HOLD_US 500000
+
 static uint8_t *shadow_ui_midi_shm = NULL;
 static uint8_t *shadow_display_shm = NULL;
 static shadow_control_t *shadow_control = NULL;
 static shadow_ui_state_t *shadow_ui_state = NULL;
 static shadow_param_t *shadow_param = NULL;
+static shadow_param_ring_t *shadow_param_ring = NULL;
 static shadow_midi_out_t *shadow_midi_out = NULL;
 static shadow_midi_dsp_t *shadow_midi_dsp = NULL;
 static shadow_midi_inject_t *shadow_midi_inject = NULL;
 static schwung_ext_midi_remap_t *ext_midi_remap = NULL;
 static shadow_screenreader_t *shadow_screenreader = NULL;
 static shadow_overlay_state_t *shadow_overlay = NULL;
+static link_audio_pub_shm_t *link_audio_pub_shm = NULL;
 
 static int global_exit_flag = 0;
 static uint8_t last_midi_ready = 0;
@@ -57,13 +65,26 @@ static uint32_t shadow_ui_checksum(const unsigned char *buf, size_t len) {
     return sum;
 }
 
-/* Display state - use shared buffer for packing */
-static unsigned char packed_buffer[DISPLAY_BUFFER_SIZE];
+/* Copy the slices drawn into since the last push to the shim and flag them
+ * for it. full: resend every slice, resyncing a shim that restarted.
+ * Returns 1 if the pushed frame differs from what the shim had. */
+static int shadow_display_push(int full) {
+    if (!shadow_display_shm) return 0;
+    int changed = js_display_dirty_slices &&
+                  memcmp(shadow_display_shm, js_display_screen_buffer, DISPLAY_BUFFER_SIZE) != 0;
+    if (full) js_display_dirty_slices = DISPLAY_ALL_SLICES;
+    uint32_t dirty = js_display_flush_slices(shadow_display_shm);
+    if (dirty) {
+        __atomic_fetch_or((uint32_t *)(shadow_display_shm + SHADOW_DISPLAY_DIRTY_OFFSET),
+                          dirty, __ATOMIC_RELEASE);
+    }
+    return changed;
+}
 
 static int open_shadow_shm(void) {
     int fd = shm_open(SHM_SHADOW_DISPLAY, O_RDWR, 0666);
     if (fd < 0) return -1;
-    shadow_display_shm = (uint8_t *)mmap(NULL, DISPLAY_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    shadow_display_shm = (uint8_t *)mmap(NULL, SHADOW_DISPLAY_SHM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     close(fd);
     if (shadow_display_shm == MAP_FAILED) { shadow_display_shm = NULL; return -1; }
 
@@ -93,6 +114,13 @@ static int open_shadow_shm(void) {
         if (shadow_param == MAP_FAILED) shadow_param = NULL;
     }
 
+    fd = shm_open(SHM_SHADOW_PARAM_RING, O_RDWR, 0666);
+    if (fd >= 0) {
+        shadow_param_ring = (shadow_param_ring_t *)mmap(NULL, sizeof(shadow_param_ring_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (shadow_param_ring == MAP_FAILED) shadow_param_ring = NULL;
+    }
+
     fd = shm_open(SHM_SHADOW_MIDI_OUT, O_RDWR, 0666);
     if (fd >= 0) {
         shadow_midi_out = (shadow_midi_out_t *)mmap(NULL, sizeof(shadow_midi_out_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
@@ -143,6 +171,19 @@ static int open_shadow_shm(void) {
         }
     }
 
+    fd = shm_open(SHM_LINK_AUDIO_PUB, O_RDWR, 0666);
+    if (fd >= 0) {
+        link_audio_pub_shm = (link_audio_pub_shm_t *)mmap(NULL, sizeof(link_audio_pub_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (link_audio_pub_shm == MAP_FAILED ||
+            link_audio_pub_shm->magic != LINK_AUDIO_PUB_SHM_MAGIC ||
+            link_audio_pub_shm->version != LINK_AUDIO_PUB_SHM_VERSION) {
+            if (link_audio_pub_shm != MAP_FAILED)
+                munmap(link_audio_pub_shm, sizeof(link_audio_pub_shm_t));
+            link_audio_pub_shm = NULL;
+        }
+    }
+
     return 0;
 }
 
@@ -173,19 +214,17 @@ static JSContext *JS_NewCustomContext(JSRuntime *rt) {
     return ctx;
 }
 
-static int eval_buf(JSContext *ctx, const void *buf, int buf_len,
-                    const char *filename, int eval_flags) {
-    JSValue val;
+/* Run a compiled script or module from js_bc_compile_file() */
+static int eval_compiled(JSContext *ctx, JSValue val, int eval_flags) {
     int ret;
     if ((eval_flags & JS_EVAL_TYPE_MASK) == JS_EVAL_TYPE_MODULE) {
-        val = JS_Eval(ctx, buf, buf_len, filename, eval_flags | JS_EVAL_FLAG_COMPILE_ONLY);
         if (!JS_IsException(val)) {
             js_module_set_import_meta(ctx, val, 1, 1);
             val = JS_EvalFunction(ctx, val);
         }
         val = js_std_await(ctx, val);
-    } else {
-        val = JS_Eval(ctx, buf, buf_len, filename, eval_flags);
+    } else if (!JS_IsException(val)) {
+        val = JS_EvalFunction(ctx, val);
     }
     if (JS_IsException(val)) {
         js_std_dump_error(ctx);
@@ -198,20 +237,10 @@ static int eval_buf(JSContext *ctx, const void *buf, int buf_len,
 }
 
 static int eval_file(JSContext *ctx, const char *filename, int module) {
-    uint8_t *buf;
-    int ret, eval_flags = JS_EVAL_FLAG_STRICT;
-    size_t buf_len;
-
-    buf = js_load_file(ctx, &buf_len, filename);
-    if (!buf) {
-        perror(filename);
-        return -1;
-    }
-
+    int eval_flags = JS_EVAL_FLAG_STRICT;
     if (module) eval_flags |= JS_EVAL_TYPE_MODULE;
-    ret = eval_buf(ctx, buf, buf_len, filename, eval_flags);
-    js_free(ctx, buf);
-    return ret;
+    return eval_compiled(ctx, js_bc_compile_file(ctx, filename, NULL, eval_flags),
+                         eval_flags);
 }
 
 static int getGlobalFunction(JSContext *ctx, const char *func_name, JSValue *retFunc) {
@@ -523,13 +552,13 @@ static JSValue js_shadow_control_restart(JSContext *ctx, JSValueConst this_val,
  * The loaded module can set globalThis.chain_ui to provide init/tick/onMidi functions.
  * Returns true on success, false on error.
  *
- * Uses a unique module name (path#N) for each load to bypass QuickJS's module
- * cache. This ensures overtake modules get fresh code on every launch and
- * picks up on-disk changes without restarting shadow_ui.
- * Relative imports still resolve correctly since QuickJS uses the dirname.
+ * Every call compiles (or reads from the bytecode cache) and evaluates a new
+ * module record, so overtake modules get fresh code on every launch and
+ * on-disk changes are picked up without restarting shadow_ui. The record is
+ * named after the file path rather than a per-load name so its cached
+ * bytecode stays valid across loads; relative imports resolve from its
+ * dirname as before.
  */
-static int shadow_ui_module_load_counter = 0;
-
 static JSValue js_shadow_load_ui_module(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
     (void)this_val;
     if (argc < 1) return JS_FALSE;
@@ -540,23 +569,10 @@ static JSValue js_shadow_load_ui_module(JSContext *ctx, JSValueConst this_val, i
     shadow_ui_log_line("Loading UI module:");
     shadow_ui_log_line(path);
 
-    /* Read the file from disk */
-    size_t buf_len;
-    uint8_t *buf = js_load_file(ctx, &buf_len, path);
-    if (!buf) {
-        perror(path);
-        JS_FreeCString(ctx, path);
-        return JS_FALSE;
-    }
-
-    /* Create a unique module name to bypass QuickJS module cache */
-    char module_name[512];
-    snprintf(module_name, sizeof(module_name), "%s#%d", path, ++shadow_ui_module_load_counter);
-    JS_FreeCString(ctx, path);
-
     int eval_flags = JS_EVAL_FLAG_STRICT | JS_EVAL_TYPE_MODULE;
-    int ret = eval_buf(ctx, buf, buf_len, module_name, eval_flags);
-    js_free(ctx, buf);
+    JSValue val = js_bc_compile_file(ctx, path, NULL, eval_flags);
+    JS_FreeCString(ctx, path);
+    int ret = eval_compiled(ctx, val, eval_flags);
 
     return ret == 0 ? JS_TRUE : JS_FALSE;
 }
@@ -582,8 +598,175 @@ static uint32_t shadow_param_next_request_id(void) {
     return shadow_param_request_seq;
 }
 
+/* === Batched param requests (/schwung-param-ring) ===
+ *
+ * shadow_set_params_batch / shadow_get_params_batch queue every entry on
+ * the request ring at once and return a Promise. shadow_param_batch_pump()
+ * (main loop and mailbox waits) tops up the ring, collects responses by
+ * request_id and settles a batch once every entry was answered or its
+ * deadline passed. */
+
+#define SHADOW_PARAM_BATCH_MAX_PENDING 8
+#define SHADOW_PARAM_BATCH_MAX_ENTRIES 256
+#define SHADOW_PARAM_BATCH_DEFAULT_TIMEOUT_MS 500
+#define SHADOW_PARAM_RING_ID_LIMIT 0xFFF00000u  /* Stay clear of web-originated IDs */
+
+typedef struct {
+    int used;
+    int is_get;
+    uint8_t slot;
+    uint32_t base_id;
+    int count;
+    int sent;
+    int answered;
+    int ok;
+    char (*keys)[SHADOW_PARAM_KEY_LEN];
+    char (*values)[SHADOW_PARAM_RING_VALUE_LEN];  /* set batches only */
+    uint8_t *done;
+    JSValue result;                               /* get batches: {key: value|null} */
+    JSValue resolve;
+    JSValue reject;
+    uint64_t deadline_ms;
+    uint64_t order;                               /* enqueue order, for send ordering */
+} shadow_param_batch_t;
+
+static shadow_param_batch_t shadow_param_batches[SHADOW_PARAM_BATCH_MAX_PENDING];
+static uint32_t shadow_param_ring_seq = 0;
+static uint64_t shadow_param_batch_order = 0;
+static JSContext *shadow_param_batch_ctx = NULL;
+
+static uint64_t shadow_param_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static uint32_t shadow_param_ring_reserve_ids(int count) {
+    if (shadow_param_ring_seq == 0 ||
+        shadow_param_ring_seq + (uint32_t)count >= SHADOW_PARAM_RING_ID_LIMIT) {
+        shadow_param_ring_seq = 1;
+    }
+    uint32_t base = shadow_param_ring_seq;
+    shadow_param_ring_seq += (uint32_t)count;
+    return base;
+}
+
+static void shadow_param_batch_free(JSContext *ctx, shadow_param_batch_t *b) {
+    free(b->keys);
+    free(b->values);
+    free(b->done);
+    JS_FreeValue(ctx, b->result);
+    JS_FreeValue(ctx, b->resolve);
+    JS_FreeValue(ctx, b->reject);
+    memset(b, 0, sizeof(*b));
+}
+
+static void shadow_param_batch_settle(JSContext *ctx, shadow_param_batch_t *b) {
+    JSValue val;
+    if (b->is_get) {
+        /* Entries that never got an answer read as null */
+        for (int i = 0; i < b->count; i++) {
+            if (!b->done[i]) JS_SetPropertyStr(ctx, b->result, b->keys[i], JS_NULL);
+        }
+        val = JS_DupValue(ctx, b->result);
+    } else {
+        val = JS_NewInt32(ctx, b->ok);
+    }
+    JSValue ret = JS_Call(ctx, b->resolve, JS_UNDEFINED, 1, &val);
+    JS_FreeValue(ctx, ret);
+    JS_FreeValue(ctx, val);
+    shadow_param_batch_free(ctx, b);
+}
+
+static void shadow_param_batch_pump(JSContext *ctx) {
+    shadow_param_ring_t *ring = shadow_param_ring;
+    if (!ring || !ctx) return;
+
+    /* Collect responses */
+    uint32_t tail = ring->resp_tail;
+    uint32_t head = __atomic_load_n(&ring->resp_head, __ATOMIC_ACQUIRE);
+    while (tail != head) {
+        const shadow_param_ring_entry_t *resp = &ring->responses[tail & (SHADOW_PARAM_RING_ENTRIES - 1)];
+        uint32_t id = resp->request_id;
+        for (int b = 0; b < SHADOW_PARAM_BATCH_MAX_PENDING; b++) {
+            shadow_param_batch_t *batch = &shadow_param_batches[b];
+            if (!batch->used || id < batch->base_id || id >= batch->base_id + (uint32_t)batch->count) continue;
+            int i = (int)(id - batch->base_id);
+            if (batch->done[i]) break;
+            batch->done[i] = 1;
+            batch->answered++;
+            if (resp->error == 0) {
+                batch->ok++;
+                if (batch->is_get) {
+                    JS_SetPropertyStr(ctx, batch->result, batch->keys[i], JS_NewString(ctx, resp->value));
+                }
+            } else if (batch->is_get) {
+                JS_SetPropertyStr(ctx, batch->result, batch->keys[i], JS_NULL);
+            }
+            break;
+        }
+        tail++;
+        __atomic_store_n(&ring->resp_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    /* Send queued entries in batch order so requests apply in program order */
+    for (;;) {
+        shadow_param_batch_t *next = NULL;
+        for (int b = 0; b < SHADOW_PARAM_BATCH_MAX_PENDING; b++) {
+            shadow_param_batch_t *batch = &shadow_param_batches[b];
+            if (batch->used && batch->sent < batch->count &&
+                (!next || batch->order < next->order)) next = batch;
+        }
+        if (!next) break;
+
+        uint32_t req_head = ring->req_head;
+        if (req_head - __atomic_load_n(&ring->req_tail, __ATOMIC_ACQUIRE) >= SHADOW_PARAM_RING_ENTRIES) break;
+
+        int i = next->sent++;
+        shadow_param_ring_entry_t *req = &ring->requests[req_head & (SHADOW_PARAM_RING_ENTRIES - 1)];
+        req->request_id = next->base_id + (uint32_t)i;
+        req->request_type = next->is_get ? 2 : 1;
+        req->slot = next->slot;
+        memcpy(req->key, next->keys[i], SHADOW_PARAM_KEY_LEN);
+        if (next->is_get) {
+            req->value[0] = '\0';
+        } else {
+            memcpy(req->value, next->values[i], SHADOW_PARAM_RING_VALUE_LEN);
+        }
+        __atomic_store_n(&ring->req_head, req_head + 1, __ATOMIC_RELEASE);
+    }
+
+    /* Settle finished or expired batches */
+    uint64_t now = shadow_param_now_ms();
+    for (int b = 0; b < SHADOW_PARAM_BATCH_MAX_PENDING; b++) {
+        shadow_param_batch_t *batch = &shadow_param_batches[b];
+        if (!batch->used) continue;
+        if (batch->answered >= batch->count || now >= batch->deadline_ms) {
+            shadow_param_batch_settle(ctx, batch);
+        }
+    }
+}
+
+/* Wait until every queued batch entry has been consumed by the shim, so a
+ * following mailbox request cannot overtake earlier batched sets. */
+static void shadow_param_ring_flush(int polls) {
+    shadow_param_ring_t *ring = shadow_param_ring;
+    if (!ring) return;
+    while (polls-- > 0) {
+        shadow_param_batch_pump(shadow_param_batch_ctx);
+        int unsent = 0;
+        for (int b = 0; b < SHADOW_PARAM_BATCH_MAX_PENDING; b++) {
+            if (shadow_param_batches[b].used &&
+                shadow_param_batches[b].sent < shadow_param_batches[b].count) unsent = 1;
+        }
+        if (!unsent && ring->req_tail == __atomic_load_n(&ring->req_head, __ATOMIC_ACQUIRE)) return;
+        usleep(SHADOW_PARAM_POLL_US);
+    }
+}
+
 static int shadow_param_wait_idle(int timeout_ms) {
     int timeout = shadow_param_timeout_to_polls(timeout_ms);
+    shadow_param_ring_flush(timeout);
     while (shadow_param->request_type != 0 && timeout > 0) {
         usleep(SHADOW_PARAM_POLL_US);
         timeout--;
@@ -742,8 +925,184 @@ static JSValue js_shadow_get_param(JSContext *ctx, JSValueConst this_val, int ar
     return JS_NewString(ctx, shadow_param->value);
 }
 
+static void shadow_param_free_props(JSContext *ctx, JSPropertyEnum *props, uint32_t n) {
+    if (!props) return;
+    for (uint32_t i = 0; i < n; i++) JS_FreeAtom(ctx, props[i].atom);
+    js_free(ctx, props);
+}
+
+/* Common setup for shadow_set_params_batch / shadow_get_params_batch.
+ * Returns a Promise, or JS_EXCEPTION with a pending exception. */
+static JSValue shadow_param_batch_start(JSContext *ctx, int is_get, int argc, JSValueConst *argv) {
+    int slot = 0;
+    if (argc < 2 || JS_ToInt32(ctx, &slot, argv[0])) {
+        return JS_ThrowTypeError(ctx, "expected (slot, params[, timeout_ms])");
+    }
+    if (slot < 0 || slot >= SHADOW_UI_SLOTS) return JS_ThrowRangeError(ctx, "slot out of range");
+
+    int32_t timeout_ms = SHADOW_PARAM_BATCH_DEFAULT_TIMEOUT_MS;
+    if (argc > 2 && !JS_IsUndefined(argv[2])) {
+        if (JS_ToInt32(ctx, &timeout_ms, argv[2])) return JS_EXCEPTION;
+        if (timeout_ms <= 0) timeout_ms = SHADOW_PARAM_BATCH_DEFAULT_TIMEOUT_MS;
+    }
+
+    /* set: {key: value} or [[key, value], ...]; get: [key, ...] */
+    JSValueConst src = argv[1];
+    JSPropertyEnum *props = NULL;
+    uint32_t nprops = 0;
+    int is_array = JS_IsArray(ctx, src);
+    int32_t count = 0;
+    if (is_array) {
+        JSValue len_val = JS_GetPropertyStr(ctx, src, "length");
+        int rc = JS_ToInt32(ctx, &count, len_val);
+        JS_FreeValue(ctx, len_val);
+        if (rc) return JS_EXCEPTION;
+    } else if (!is_get && JS_IsObject(src)) {
+        if (JS_GetOwnPropertyNames(ctx, &props, &nprops, src,
+                                   JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY)) return JS_EXCEPTION;
+        count = (int32_t)nprops;
+    } else {
+        return JS_ThrowTypeError(ctx, is_get ? "keys must be an array" : "params must be an object or array");
+    }
+    if (count > SHADOW_PARAM_BATCH_MAX_ENTRIES) {
+        shadow_param_free_props(ctx, props, nprops);
+        return JS_ThrowRangeError(ctx, "too many params in one batch");
+    }
+
+    shadow_param_batch_t *b = NULL;
+    for (int i = 0; i < SHADOW_PARAM_BATCH_MAX_PENDING; i++) {
+        if (!shadow_param_batches[i].used) { b = &shadow_param_batches[i]; break; }
+    }
+    if (!b) {
+        /* Too many batches in flight: let earlier ones settle first */
+        shadow_param_ring_flush(shadow_param_timeout_to_polls(timeout_ms));
+        for (int i = 0; i < SHADOW_PARAM_BATCH_MAX_PENDING; i++) {
+            if (!shadow_param_batches[i].used) { b = &shadow_param_batches[i]; break; }
+        }
+    }
+    if (!b) {
+        shadow_param_free_props(ctx, props, nprops);
+        return JS_ThrowInternalError(ctx, "param batch queue full");
+    }
+
+    int n = count;
+    b->keys = calloc(n > 0 ? n : 1, sizeof(*b->keys));
+    b->values = is_get ? NULL : calloc(n > 0 ? n : 1, sizeof(*b->values));
+    b->done = calloc(n > 0 ? n : 1, 1);
+    b->result = is_get ? JS_NewObject(ctx) : JS_UNDEFINED;
+    b->resolve = JS_UNDEFINED;
+    b->reject = JS_UNDEFINED;
+    if (!b->keys || !b->done || (!is_get && !b->values)) {
+        shadow_param_batch_free(ctx, b);
+        shadow_param_free_props(ctx, props, nprops);
+        return JS_ThrowOutOfMemory(ctx);
+    }
+
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        JSValue k = JS_UNDEFINED, v = JS_UNDEFINED;
+        if (props) {
+            k = JS_AtomToString(ctx, props[i].atom);
+            v = JS_GetProperty(ctx, src, props[i].atom);
+        } else if (is_get) {
+            k = JS_GetPropertyUint32(ctx, src, (uint32_t)i);
+        } else {
+            JSValue pair = JS_GetPropertyUint32(ctx, src, (uint32_t)i);
+            k = JS_GetPropertyUint32(ctx, pair, 0);
+            v = JS_GetPropertyUint32(ctx, pair, 1);
+            JS_FreeValue(ctx, pair);
+        }
+        const char *ks = JS_ToCString(ctx, k);
+        const char *vs = is_get ? NULL : JS_ToCString(ctx, v);
+        JS_FreeValue(ctx, k);
+        JS_FreeValue(ctx, v);
+
+        /* Skip keys/values that do not fit a ring entry (use shadow_set_param) */
+        if (ks && strlen(ks) < SHADOW_PARAM_KEY_LEN &&
+            (is_get || (vs && strlen(vs) < SHADOW_PARAM_RING_VALUE_LEN))) {
+            strcpy(b->keys[kept], ks);
+            if (!is_get) strcpy(b->values[kept], vs);
+            kept++;
+        } else if (ks) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "param batch: skipping oversized entry %.64s", ks);
+            shadow_ui_log_line(msg);
+            if (is_get && strlen(ks) < SHADOW_PARAM_KEY_LEN) {
+                JS_SetPropertyStr(ctx, b->result, ks, JS_NULL);
+            }
+        }
+        if (ks) JS_FreeCString(ctx, ks);
+        if (vs) JS_FreeCString(ctx, vs);
+    }
+    shadow_param_free_props(ctx, props, nprops);
+
+    JSValue funcs[2];
+    JSValue promise = JS_NewPromiseCapability(ctx, funcs);
+    if (JS_IsException(promise)) {
+        shadow_param_batch_free(ctx, b);
+        return promise;
+    }
+    b->resolve = funcs[0];
+    b->reject = funcs[1];
+    b->used = 1;
+    b->is_get = is_get;
+    b->slot = (uint8_t)slot;
+    b->count = kept;
+    b->base_id = shadow_param_ring_reserve_ids(kept > 0 ? kept : 1);
+    b->deadline_ms = shadow_param_now_ms() + (uint64_t)timeout_ms;
+    b->order = ++shadow_param_batch_order;
+
+    if (!shadow_param_ring) {
+        /* Older shim without the ring: apply one by one over the mailbox */
+        for (int i = 0; i < kept; i++) {
+            if (is_get) {
+                JSValue key = JS_NewString(ctx, b->keys[i]);
+                JSValue args[2] = { JS_NewInt32(ctx, slot), key };
+                JSValue v = js_shadow_get_param(ctx, JS_UNDEFINED, 2, args);
+                JS_FreeValue(ctx, key);
+                if (!JS_IsNull(v)) b->ok++;
+                JS_SetPropertyStr(ctx, b->result, b->keys[i], v);
+            } else if (shadow_param &&
+                       shadow_set_param_common(slot, b->keys[i], b->values[i], timeout_ms, 1)) {
+                b->ok++;
+            }
+            b->done[i] = 1;
+        }
+        b->sent = b->answered = kept;
+        shadow_param_batch_settle(ctx, b);
+        return promise;
+    }
+
+    shadow_param_batch_pump(ctx);
+    return promise;
+}
+
+/* shadow_set_params_batch(slot, params[, timeout_ms]) -> Promise<number>
+ * Sets many params in one go via the param ring. params is {key: value}
+ * or [[key, value], ...], applied in order. Resolves with the number of
+ * params the shim accepted (missing answers after timeout count as failed).
+ * Values must be shorter than SHADOW_PARAM_RING_VALUE_LEN; use
+ * shadow_set_param for state blobs.
+ */
+static JSValue js_shadow_set_params_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+    (void)this_val;
+    return shadow_param_batch_start(ctx, 0, argc, argv);
+}
+
+/* shadow_get_params_batch(slot, [key, ...][, timeout_ms]) -> Promise<object>
+ * Resolves with {key: value} (null for errors, timeouts and values too large
+ * for the ring — fetch those with shadow_get_param).
+ */
+static JSValue js_shadow_get_params_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+    (void)this_val;
+    return shadow_param_batch_start(ctx, 1, argc, argv);
+}
+
 /* === MIDI output functions for overtake modules === */
 
+/* MIDI sends so far (LEDs included): tick activity for the overtake pace */
+static uint32_t shadow_ui_midi_sends = 0;
+
 /* Common implementation for sending MIDI via shared memory */
 static JSValue js_shadow_midi_send(int cable, JSContext *ctx, JSValueConst this_val,
                                    int argc, JSValueConst *argv) {
@@ -784,6 +1143,7 @@ static JSValue js_shadow_midi_send(int cable, JSContext *ctx, JSValueConst this_
 
     /* Signal shim that data is ready */
     shadow_midi_out->ready++;
+    shadow_ui_midi_sends++;
 
     return JS_TRUE;
 }
@@ -2105,17 +2465,14 @@ static JSValue js_host_rescan_modules(JSContext *ctx, JSValueConst this_val,
 }
 
 /* host_flush_display() -> void
- * Immediately pack and copy display to shared memory.
+ * Immediately copy changed display slices to shared memory.
  * This is critical for showing progress during blocking operations
  * (e.g. catalog fetch) where the main loop can't run.
  */
 static JSValue js_host_flush_display(JSContext *ctx, JSValueConst this_val,
                                      int argc, JSValueConst *argv) {
     (void)ctx; (void)this_val; (void)argc; (void)argv;
-    if (shadow_display_shm) {
-        js_display_pack(packed_buffer);
-        memcpy(shadow_display_shm, packed_buffer, DISPLAY_BUFFER_SIZE);
-    }
+    shadow_display_push(0);
     js_display_screen_dirty = 0;
     return JS_UNDEFINED;
 }
@@ -2605,6 +2962,26 @@ static JSValue js_skipback_seconds_get(JSContext *ctx, JSValueConst this_val,
 }
 
 
+/* host_request_link_tempo(bpm) -> bool
+ * Ask link-subscriber to propose bpm to the Link session. It applies the
+ * request only while Move is the sole peer, so collaboration isn't
+ * clobbered. */
+static JSValue js_host_request_link_tempo(JSContext *ctx, JSValueConst this_val,
+                                          int argc, JSValueConst *argv) {
+    (void)this_val;
+    if (argc < 1 || !link_audio_pub_shm) return JS_FALSE;
+
+    double bpm = 0;
+    if (JS_ToFloat64(ctx, &bpm, argv[0]) || !(bpm >= 20.0 && bpm <= 999.0))
+        return JS_FALSE;
+
+    __atomic_store_n(&link_audio_pub_shm->tempo_request_bpm,
+                     (uint32_t)(bpm * 10000.0 + 0.5), __ATOMIC_RELAXED);
+    __atomic_add_fetch(&link_audio_pub_shm->tempo_request_seq, 1, __ATOMIC_RELEASE);
+    link_audio_pub_kick(link_audio_pub_shm);
+    return JS_TRUE;
+}
+
 /* tts_set_speed(speed) - Write to shared memory */
 static JSValue js_tts_set_speed(JSContext *ctx, JSValueConst this_val,
                                   int argc, JSValueConst *argv) {
@@ -3164,7 +3541,7 @@ static void init_javascript(JSRuntime **prt, JSContext **pctx) {
     js_std_add_helpers(ctx, -1, 0);
 
     /* Enable ES module imports (e.g., import { ... } from '../shared/constants.mjs') */
-    JS_SetModuleLoaderFunc(rt, NULL, js_module_loader, NULL);
+    JS_SetModuleLoaderFunc(rt, NULL, js_bc_module_loader, NULL);
 
     JSValue global_obj = JS_GetGlobalObject(ctx);
 
@@ -3199,6 +3576,8 @@ static void init_javascript(JSRuntime **prt, JSContext **pctx) {
     JS_SetPropertyStr(ctx, global_obj, "shadow_set_param", JS_NewCFunction(ctx, js_shadow_set_param, "shadow_set_param", 3));
     JS_SetPropertyStr(ctx, global_obj, "shadow_set_param_timeout", JS_NewCFunction(ctx, js_shadow_set_param_timeout, "shadow_set_param_timeout", 4));
     JS_SetPropertyStr(ctx, global_obj, "shadow_get_param", JS_NewCFunction(ctx, js_shadow_get_param, "shadow_get_param", 2));
+    JS_SetPropertyStr(ctx, global_obj, "shadow_set_params_batch", JS_NewCFunction(ctx, js_shadow_set_params_batch, "shadow_set_params_batch", 3));
+    JS_SetPropertyStr(ctx, global_obj, "shadow_get_params_batch", JS_NewCFunction(ctx, js_shadow_get_params_batch, "shadow_get_params_batch", 3));
 
     /* Register MIDI output functions for overtake modules */
     JS_SetPropertyStr(ctx, global_obj, "move_midi_external_send", JS_NewCFunction(ctx, js_move_midi_external_send, "move_midi_external_send", 1));
@@ -3234,6 +3613,7 @@ static void init_javascript(JSRuntime **prt, JSContext **pctx) {
     JS_SetPropertyStr(ctx, global_obj, "host_set_analytics_enabled", JS_NewCFunction(ctx, js_host_set_analytics_enabled, "host_set_analytics_enabled", 1));
     JS_SetPropertyStr(ctx, global_obj, "host_flush_display", JS_NewCFunction(ctx, js_host_flush_display, "host_flush_display", 0));
     JS_SetPropertyStr(ctx, global_obj, "host_send_screenreader", JS_NewCFunction(ctx, js_host_send_screenreader, "host_send_screenreader", 1));
+    JS_SetPropertyStr(ctx, global_obj, "host_request_link_tempo", JS_NewCFunction(ctx, js_host_request_link_tempo, "host_request_link_tempo", 1));
 
     /* Register TTS control functions */
     JS_SetPropertyStr(ctx, global_obj, "tts_set_enabled", JS_NewCFunction(ctx, js_tts_set_enabled, "tts_set_enabled", 1));
@@ -3316,6 +3696,12 @@ static void init_javascript(JSRuntime **prt, JSContext **pctx) {
     *pctx = ctx;
 }
 
+static int64_t shadow_ui_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 static int process_shadow_midi(JSContext *ctx, JSValue *onInternal, JSValue *onExternal) {
     if (!shadow_ui_midi_shm) return 0;
     int handled = 0;
@@ -3348,8 +3734,29 @@ static int process_shadow_midi(JSContext *ctx, JSValue *onInternal, JSValue *onE
     return handled;
 }
 
+/* shadow_ui --precompile <file.js>...
+ * Fill the bytecode cache without running anything (host update, module
+ * install). A module's imports are cached along with it. */
+static int precompile_main(int argc, char *argv[]) {
+    JSRuntime *rt = NULL;
+    JSContext *ctx = NULL;
+    init_javascript(&rt, &ctx);
+
+    int failed = 0;
+    for (int i = 0; i < argc; i++) {
+        if (js_bc_precompile(ctx, argv[i], JS_EVAL_FLAG_STRICT | JS_EVAL_TYPE_MODULE) != 0) {
+            fprintf(stderr, "shadow_ui: failed to precompile %s\n", argv[i]);
+            failed = 1;
+        }
+    }
+    return failed;
+}
+
 int main(int argc, char *argv[]) {
     const char *script = "/data/UserData/schwung/shadow/shadow_ui.js";
+    if (argc > 1 && strcmp(argv[1], "--precompile") == 0) {
+        return precompile_main(argc - 2, argv + 2);
+    }
     if (argc > 1) {
         script = argv[1];
     }
@@ -3416,10 +3823,16 @@ int main(int argc, char *argv[]) {
         shadow_ui_log_line("shadow_ui: shadow_save_state_now missing");
     }
 
+    shadow_param_batch_ctx = ctx;
+
     if (jsInitIsDefined) callGlobalFunction(ctx, &JSinit, 0);
     shadow_ui_log_line("shadow_ui: init called");
 
     int refresh_counter = 0;
+    uint32_t wake_seen = shadow_control ? __atomic_load_n(&shadow_control->ui_wake_seq, __ATOMIC_ACQUIRE) : 0;
+    int64_t tick_slot = shadow_ui_now_us();   /* When the last tick was due */
+    int64_t next_tick = tick_slot;            /* When the next one is due */
+    int64_t overtake_fast_until = 0;          /* Fast overtake ticks until then */
     while (!global_exit_flag) {
         if (shadow_control && shadow_control->should_exit) {
             if (jsSaveStateIsDefined) {
@@ -3431,6 +3844,7 @@ int main(int argc, char *argv[]) {
         /* Process incoming MIDI BEFORE tick() so that the current frame's
          * drawUI() reflects the latest input (knob CCs, button presses).
          * This eliminates one full loop iteration of display latency. */
+        int input = 0;
         if (shadow_control && shadow_control->midi_ready != last_midi_ready) {
             last_midi_ready = shadow_control->midi_ready;
             /* process_shadow_midi releases each slot byte-0 individually after
@@ -3438,27 +3852,52 @@ int main(int argc, char *argv[]) {
              * after dispatch races with the shim writer and silently drops
              * events written between the shim's slot-empty check and our
              * clear (manifested as dropped pad note-offs under burst). */
-            process_shadow_midi(ctx, &JSonMidiMessageInternal, &JSonMidiMessageExternal);
+            input = process_shadow_midi(ctx, &JSonMidiMessageInternal, &JSonMidiMessageExternal);
         }
 
-        if (jsTickIsDefined) {
-            callGlobalFunction(ctx, &JSTick, 0);
+        /* Settle batched param requests, then run their promise reactions */
+        shadow_param_batch_pump(ctx);
+        {
+            JSContext *job_ctx;
+            int job_ret;
+            while ((job_ret = JS_ExecutePendingJob(rt, &job_ctx)) > 0) {}
+            if (job_ret < 0) js_std_dump_error(job_ctx);
         }
 
-        refresh_counter++;
-        if ((js_display_screen_dirty || (refresh_counter % 30 == 0)) && shadow_display_shm) {
-            js_display_pack(packed_buffer);
-            memcpy(shadow_display_shm, packed_buffer, DISPLAY_BUFFER_SIZE);
-            js_display_screen_dirty = 0;
-        }
+        /* Tick when due, or early when input arrives once the tick's slot
+         * has opened: the screen follows a knob straight away, while ticks
+         * per second (which JS animations and timeouts count) stay put. */
+        int64_t now = shadow_ui_now_us();
+        if (now >= next_tick || (input && now >= tick_slot)) {
+            int64_t due = next_tick;
+            uint32_t sends = shadow_ui_midi_sends;
+            if (jsTickIsDefined) {
+                callGlobalFunction(ctx, &JSTick, 0);
+            }
 
-        /* Overtake modules need a faster tick rate for responsive display/LED
-         * updates.  Normal shadow UI (slot management) is fine at ~60 Hz. */
-        if (shadow_control && shadow_control->overtake_mode >= 2) {
-            usleep(2000);   /* ~500 Hz effective (minus tick work) */
-        } else {
-            usleep(16000);  /* ~60 Hz for normal shadow UI */
+            refresh_counter++;
+            int drawn = shadow_display_push(refresh_counter % 30 == 0);
+            int64_t end = shadow_ui_now_us();
+
+            /* Overtake modules tick faster for responsive display/LED updates
+             * while they are doing something: input, a changed frame or MIDI
+             * (LED) output keeps ~500 Hz for OVERTAKE_FAST_HOLD_US. Idle, they
+             * drop to the ~60 Hz of the normal shadow UI (the documented tick
+             * rate); input still wakes the loop and ticks at once. */
+            int64_t period = 16000;
+            if (shadow_control && shadow_control->overtake_mode >= 2) {
+                if (input || drawn || shadow_ui_midi_sends != sends)
+                    overtake_fast_until = end + OVERTAKE_FAST_HOLD_US;
+                if (end < overtake_fast_until) period = 2000;
+            }
+            tick_slot = due;
+            next_tick = (now >= due ? end : due + (end - now)) + period;
         }
+
+        /* Sleep until the next tick unless the shim publishes MIDI or
+         * param responses first */
+        int64_t wait_us = next_tick - shadow_ui_now_us();
+        if (wait_us > 0) shadow_ui_wait(shadow_control, &wake_seen, (long)wait_us);
     }
 
     js_std_free_handlers(rt);
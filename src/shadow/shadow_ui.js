@@ -4655,12 +4655,19 @@ function loadMasterPreset(index, presetName) {
                         if (fxConfig.params.plugin_id) {
                             shadow_set_param(0, `master_fx:${key}:plugin_id`, fxConfig.params.plugin_id);
                         }
-                        /* Restore remaining params */
+                        /* Restore remaining params in one batch when the
+                         * param ring is available (one frame, not one per param) */
+                        const restore = [];
                         for (const [pkey, pval] of Object.entries(fxConfig.params)) {
                             if (pkey !== "plugin_id") {
-                                shadow_set_param(0, `master_fx:${key}:${pkey}`, String(pval));
+                                restore.push([`master_fx:${key}:${pkey}`, String(pval)]);
                             }
                         }
+                        if (typeof shadow_set_params_batch === "function") {
+                            shadow_set_params_batch(0, restore);
+                        } else {
+                            for (const [pk, pv] of restore) shadow_set_param(0, pk, pv);
+                        }
                     }
                 } else {
                     /* Module not found - clear slot */
@@ -15147,8 +15154,9 @@ globalThis.tick = function() {
             loadRnboGraphFromDir(activeSlotStateDir);
 
             /* 10b. Request Link tempo override to match the new set's tempo.
-             * link-subscriber picks this up and only applies when numPeers==1
-             * (Move alone), so we don't clobber collaboration with Live. */
+             * link-subscriber picks this up over the publisher shm and only
+             * applies it when numPeers==1 (Move alone), so we don't clobber
+             * collaboration with Live. */
             if (uuid && setName) {
                 try {
                     const songPath = "/data/UserData/UserLibrary/Sets/" + uuid + "/" + setName + "/Song.abl";
@@ -15157,14 +15165,15 @@ globalThis.tick = function() {
                         const m = songJson.match(/"tempo"\s*:\s*([0-9.]+)/);
                         if (m && m[1]) {
                             const bpm = parseFloat(m[1]);
-                            if (bpm >= 20 && bpm <= 999) {
-                                host_write_file("/data/UserData/schwung/desired-tempo", bpm.toFixed(4) + "\n");
+                            if (bpm >= 20 && bpm <= 999 &&
+                                typeof host_request_link_tempo === "function" &&
+                                host_request_link_tempo(bpm)) {
                                 debugLog("SET_CHANGED: requested Link tempo override " + bpm.toFixed(2) + " BPM");
                             }
                         }
                     }
                 } catch (e) {
-                    debugLog("SET_CHANGED: tempo-override write failed: " + e);
+                    debugLog("SET_CHANGED: tempo-override request failed: " + e);
                 }
             }
 
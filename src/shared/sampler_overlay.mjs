@@ -255,6 +255,11 @@ export function drawShiftKnobOverlay(state) {
     print(tx, by + 25, state.shiftKnobValue || "", 1);
 }
 
+/* setPageLoading while Move saves the current set before a page switch
+ * (SET_PAGE_STAGE_SAVING in shadow_set_pages.h); other non-zero values
+ * mean the new page is loading */
+export const SET_PAGE_STAGE_SAVING = 2;
+
 /**
  * Set page toast overlay box dimensions (exported for rect blit coordinates).
  */
@@ -279,9 +284,14 @@ export function drawSetPageToast(state) {
 
     const page = (state.setPageCurrent || 0) + 1;
     const total = state.setPageTotal || 8;
-    const msg = state.setPageLoading
-        ? "Loading Page " + page + "/" + total + "..."
-        : "Page " + page + "/" + total;
+    let msg;
+    if (state.setPageLoading === SET_PAGE_STAGE_SAVING) {
+        msg = "Saving set...";
+    } else if (state.setPageLoading) {
+        msg = "Loading Page " + page + "/" + total + "...";
+    } else {
+        msg = "Page " + page + "/" + total;
+    }
     const msgX = Math.floor((SCREEN_WIDTH - msg.length * 6) / 2);
     print(msgX, boxY + 7, msg, 1);
 }
@@ -0,0 +1,541 @@
+/* render_harness — offline render of a chain instance without hardware.
+ *
+ * dlopens chain's dsp.so from a module tree laid out like
+ * /data/UserData/schwung/modules (chain/, sound_generators/, audio_fx/),
+ * configures one or more instances through set_param exactly as the shim
+ * does, then renders 128-frame blocks as fast as possible:
+ *
+ *   midi   scripted events dispatched before their block, through
+ *          move_plugin_on_midi_timed at their frame offset when chain
+ *          exports it, else through on_midi
+ *   synth  render_block with external_fx_mode (raw synth, like render_slot)
+ *   fx     chain_process_fx on synth (+ optional injected input)
+ *   mix    the shim's slot mix: fade-ramped sum into the ME bus, clamp and
+ *          add into the mailbox output via the shadow_mix kernels
+ *
+ * Input audio is written into a fake mailbox at MOVE_AUDIO_IN_OFFSET every
+ * block, so linein and anything else reading host->mapped_memory sees it.
+ * The mixed mailbox output is written to a 16-bit stereo WAV and per-block
+ * timings are reported as percentiles against the 2.9 ms SPI frame budget.
+ *
+ * Built natively (x86_64 or aarch64) by scripts/build-render-harness.sh;
+ * see docs/REALTIME_SAFETY.md for usage. */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host/plugin_api_v1.h"
+#include "host/shadow_mix.h"
+
+#define FRAMES      MOVE_FRAMES_PER_BLOCK
+#define SAMPLES     (FRAMES * 2)
+#define MAILBOX_SIZE 4096
+#define MAX_SLOTS   4
+#define MAX_PARAMS  64
+#define BUDGET_US   ((double)FRAMES * 1e6 / MOVE_SAMPLE_RATE)
+
+enum { T_MIDI, T_SYNTH, T_FX, T_MIX, T_TOTAL, T_COUNT };
+static const char *t_names[T_COUNT] = { "midi", "synth", "fx", "mix", "total" };
+
+typedef struct {
+    uint64_t frame;
+    int order;          /* file order, keeps equal-time events stable */
+    int len;
+    uint8_t msg[3];
+} midi_event_t;
+
+typedef void (*chain_set_external_fx_mode_fn)(void *instance, int mode);
+typedef void (*chain_process_fx_fn)(void *instance, int16_t *buf, int frames);
+typedef void (*chain_set_inject_audio_fn)(void *instance, int16_t *buf, int frames);
+
+static int verbose = 0;
+static float bpm = 120.0f;
+static uint8_t mailbox[MAILBOX_SIZE];
+static unsigned long midi_out_count = 0;
+
+/* ---- Host API ---- */
+
+static void h_log(const char *msg) {
+    if (verbose) fprintf(stderr, "[chain] %s\n", msg);
+}
+
+static int h_midi_send(const uint8_t *msg, int len) {
+    (void)msg;
+    midi_out_count++;
+    return len;
+}
+
+static int h_clock_status(void) { return MOVE_CLOCK_STATUS_STOPPED; }
+static float h_get_bpm(void) { return bpm; }
+static int h_slot_recv_channel(void *instance) { (void)instance; return -1; }
+
+/* ---- WAV I/O ---- */
+
+static uint32_t rd_u32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t rd_u16(const uint8_t *p) { return (uint16_t)(p[0] | p[1] << 8); }
+
+/* Load a PCM16/PCM24/float32 mono or stereo WAV as interleaved stereo int16. */
+static int16_t *wav_read(const char *path, uint64_t *frames_out) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return NULL; }
+
+    uint8_t hdr[12];
+    if (fread(hdr, 1, 12, f) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4)) {
+        fprintf(stderr, "%s: not a RIFF/WAVE file\n", path);
+        fclose(f);
+        return NULL;
+    }
+
+    int fmt = 0, channels = 0, bits = 0;
+    uint32_t rate = 0;
+    uint8_t *data = NULL;
+    uint32_t data_len = 0;
+    uint8_t ck[8];
+    while (fread(ck, 1, 8, f) == 8) {
+        uint32_t len = rd_u32(ck + 4);
+        if (!memcmp(ck, "fmt ", 4) && len >= 16) {
+            uint8_t fb[40] = {0};
+            if (fread(fb, 1, len < sizeof(fb) ? len : sizeof(fb), f) < 16) break;
+            if (len > sizeof(fb)) fseek(f, len - sizeof(fb), SEEK_CUR);
+            fmt = rd_u16(fb);
+            channels = rd_u16(fb + 2);
+            rate = rd_u32(fb + 4);
+            bits = rd_u16(fb + 14);
+            if (fmt == 0xFFFE && len >= 26) fmt = rd_u16(fb + 24);  /* WAVE_FORMAT_EXTENSIBLE */
+        } else if (!memcmp(ck, "data", 4)) {
+            data = malloc(len ? len : 1);
+            if (!data) break;
+            data_len = (uint32_t)fread(data, 1, len, f);
+            break;
+        } else {
+            fseek(f, len + (len & 1), SEEK_CUR);
+        }
+    }
+    fclose(f);
+
+    int ok_fmt = (fmt == 1 && (bits == 16 || bits == 24)) || (fmt == 3 && bits == 32);
+    if (!data || !ok_fmt || channels < 1 || channels > 2) {
+        fprintf(stderr, "%s: unsupported WAV (format %d, %d-bit, %d ch)\n", path, fmt, bits, channels);
+        free(data);
+        return NULL;
+    }
+    if (rate != MOVE_SAMPLE_RATE) {
+        fprintf(stderr, "%s: warning: %u Hz input rendered as %d Hz (no resampling)\n",
+                path, rate, MOVE_SAMPLE_RATE);
+    }
+
+    int bps = bits / 8;
+    uint64_t frames = data_len / (uint32_t)(bps * channels);
+    int16_t *out = malloc((frames ? frames : 1) * 2 * sizeof(int16_t));
+    if (!out) { free(data); return NULL; }
+
+    for (uint64_t i = 0; i < frames; i++) {
+        for (int c = 0; c < 2; c++) {
+            const uint8_t *p = data + (i * channels + (c < channels ? c : 0)) * bps;
+            int16_t s;
+            if (fmt == 3) {
+                union { uint32_t u; float f; } v = { .u = rd_u32(p) };
+                float x = v.f * 32768.0f;
+                s = x > 32767.0f ? 32767 : x < -32768.0f ? -32768 : (int16_t)lrintf(x);
+            } else if (bits == 24) {
+                s = (int16_t)(p[1] | p[2] << 8);
+            } else {
+                s = (int16_t)rd_u16(p);
+            }
+            out[i * 2 + c] = s;
+        }
+    }
+    free(data);
+    *frames_out = frames;
+    return out;
+}
+
+static void wr_u32(FILE *f, uint32_t v) {
+    uint8_t b[4] = { v, v >> 8, v >> 16, v >> 24 };
+    fwrite(b, 1, 4, f);
+}
+
+static void wr_u16(FILE *f, uint16_t v) {
+    uint8_t b[2] = { v, v >> 8 };
+    fwrite(b, 1, 2, f);
+}
+
+static void wav_write_header(FILE *f, uint32_t frames) {
+    uint32_t data_len = frames * 4;
+    fwrite("RIFF", 1, 4, f); wr_u32(f, 36 + data_len); fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f); wr_u32(f, 16);
+    wr_u16(f, 1); wr_u16(f, 2); wr_u32(f, MOVE_SAMPLE_RATE);
+    wr_u32(f, MOVE_SAMPLE_RATE * 4); wr_u16(f, 4); wr_u16(f, 16);
+    fwrite("data", 1, 4, f); wr_u32(f, data_len);
+}
+
+/* ---- MIDI script ----
+ * One event per line: "<time> <status> [data1] [data2]", bytes in hex.
+ * <time> is a sample frame, or seconds with an "s" suffix ("1.5s").
+ * Blank lines and "#" comments are ignored. */
+
+static int midi_cmp(const void *a, const void *b) {
+    const midi_event_t *x = a, *y = b;
+    if (x->frame != y->frame) return x->frame < y->frame ? -1 : 1;
+    return x->order - y->order;
+}
+
+static midi_event_t *midi_read(const char *path, int *count_out) {
+    FILE *f = fopen(path, "r");
+    if (!f) { perror(path); return NULL; }
+
+    int cap = 256, count = 0, lineno = 0;
+    midi_event_t *ev = malloc(cap * sizeof(*ev));
+    char line[256];
+    while (ev && fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '\n' || *p == '\r') continue;
+
+        char *end;
+        double t = strtod(p, &end);
+        if (end == p || t < 0) {
+            fprintf(stderr, "%s:%d: bad time\n", path, lineno);
+            free(ev); fclose(f);
+            return NULL;
+        }
+        if (*end == 's') { t *= MOVE_SAMPLE_RATE; end++; }
+
+        midi_event_t e = { .frame = (uint64_t)llround(t), .order = count };
+        p = end;
+        while (e.len < 3) {
+            unsigned long b = strtoul(p, &end, 16);
+            if (end == p) break;
+            e.msg[e.len++] = (uint8_t)b;
+            p = end;
+        }
+        if (e.len == 0 || !(e.msg[0] & 0x80)) {
+            fprintf(stderr, "%s:%d: expected a status byte\n", path, lineno);
+            free(ev); fclose(f);
+            return NULL;
+        }
+        if (count == cap) {
+            cap *= 2;
+            midi_event_t *grown = realloc(ev, cap * sizeof(*ev));
+            if (!grown) { free(ev); ev = NULL; break; }
+            ev = grown;
+        }
+        ev[count++] = e;
+    }
+    fclose(f);
+    if (!ev) return NULL;
+    qsort(ev, count, sizeof(*ev), midi_cmp);
+    *count_out = count;
+    return ev;
+}
+
+/* ---- Timing ---- */
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int u32_cmp(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static double pct_us(const uint32_t *sorted, uint64_t n, double p) {
+    if (n == 0) return 0.0;
+    uint64_t i = (uint64_t)(p * (double)(n - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+        "Usage: render_harness --modules DIR [options]\n"
+        "  --modules DIR      module tree containing chain/dsp.so\n"
+        "  --synth NAME       sound generator (synth:module)\n"
+        "  --fx1..--fx4 NAME  audio FX per slot (fxN:module)\n"
+        "  --patch N          load patch N instead of --synth/--fx\n"
+        "  --param KEY=VAL    extra set_param, applied in order (repeatable)\n"
+        "  --midi FILE        MIDI script (\"<frame|secs>s <hex bytes>\" per line)\n"
+        "  --in FILE.wav      input audio (mailbox audio_in, 16/24-bit or float)\n"
+        "  --tone HZ          sine input at -12 dBFS instead of --in\n"
+        "  --inject           also mix input into the chain before FX\n"
+        "  --out FILE.wav     write the mixed mailbox output\n"
+        "  --seconds S        render length (default: input length or 5 s)\n"
+        "  --blocks N         render length in 128-frame blocks\n"
+        "  --slots N          render N identical instances (1-%d, default 1)\n"
+        "  --bpm BPM          value returned by host get_bpm (default 120)\n"
+        "  --csv FILE         per-block timings in microseconds\n"
+        "  --budget-us US     exit 2 if total p99 exceeds US\n"
+        "  --verbose          print chain log output\n", MAX_SLOTS);
+}
+
+int main(int argc, char **argv) {
+    const char *modules = NULL, *midi_path = NULL, *in_path = NULL;
+    const char *out_path = NULL, *csv_path = NULL;
+    const char *keys[MAX_PARAMS], *vals[MAX_PARAMS];
+    char *owned[MAX_PARAMS];
+    int nparams = 0, nowned = 0, slots = 1, inject = 0;
+    double seconds = 0.0, tone_hz = 0.0, budget_us = 0.0;
+    uint64_t blocks = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int takes = 1;
+        if (!strcmp(a, "--modules") && v) modules = v;
+        else if (!strcmp(a, "--synth") && v && nparams < MAX_PARAMS) {
+            keys[nparams] = "synth:module"; vals[nparams++] = v;
+        } else if (!strncmp(a, "--fx", 4) && a[4] >= '1' && a[4] <= '4' && !a[5] && v &&
+                   nparams < MAX_PARAMS) {
+            static char fx_keys[4][12];
+            snprintf(fx_keys[a[4] - '1'], sizeof(fx_keys[0]), "fx%c:module", a[4]);
+            keys[nparams] = fx_keys[a[4] - '1']; vals[nparams++] = v;
+        } else if (!strcmp(a, "--patch") && v && nparams < MAX_PARAMS) {
+            keys[nparams] = "load_patch"; vals[nparams++] = v;
+        } else if (!strcmp(a, "--param") && v && nparams < MAX_PARAMS) {
+            char *kv = strdup(v);
+            char *eq = kv ? strchr(kv, '=') : NULL;
+            if (!eq) { fprintf(stderr, "--param expects KEY=VALUE\n"); return 1; }
+            *eq = '\0';
+            owned[nowned++] = kv;
+            keys[nparams] = kv; vals[nparams++] = eq + 1;
+        } else if (!strcmp(a, "--midi") && v) midi_path = v;
+        else if (!strcmp(a, "--in") && v) in_path = v;
+        else if (!strcmp(a, "--tone") && v) tone_hz = atof(v);
+        else if (!strcmp(a, "--out") && v) out_path = v;
+        else if (!strcmp(a, "--seconds") && v) seconds = atof(v);
+        else if (!strcmp(a, "--blocks") && v) blocks = strtoull(v, NULL, 10);
+        else if (!strcmp(a, "--slots") && v) slots = atoi(v);
+        else if (!strcmp(a, "--bpm") && v) bpm = (float)atof(v);
+        else if (!strcmp(a, "--csv") && v) csv_path = v;
+        else if (!strcmp(a, "--budget-us") && v) budget_us = atof(v);
+        else if (!strcmp(a, "--inject")) { inject = 1; takes = 0; }
+        else if (!strcmp(a, "--verbose")) { verbose = 1; takes = 0; }
+        else { usage(); return 1; }
+        i += takes;
+    }
+    if (!modules || slots < 1 || slots > MAX_SLOTS) { usage(); return 1; }
+
+    /* Input */
+    int16_t *input = NULL;
+    uint64_t input_frames = 0;
+    if (in_path && !(input = wav_read(in_path, &input_frames))) return 1;
+
+    midi_event_t *events = NULL;
+    int event_count = 0;
+    if (midi_path && !(events = midi_read(midi_path, &event_count))) return 1;
+
+    if (!blocks) {
+        if (seconds <= 0.0) seconds = input ? (double)input_frames / MOVE_SAMPLE_RATE : 5.0;
+        blocks = (uint64_t)ceil(seconds * MOVE_SAMPLE_RATE / FRAMES);
+    }
+    if (!blocks) blocks = 1;
+
+    /* Chain */
+    char chain_dir[1024], chain_so[1100];
+    snprintf(chain_dir, sizeof(chain_dir), "%s/chain", modules);
+    snprintf(chain_so, sizeof(chain_so), "%s/dsp.so", chain_dir);
+    void *handle = dlopen(chain_so, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) { fprintf(stderr, "dlopen %s: %s\n", chain_so, dlerror()); return 1; }
+
+    move_plugin_init_v2_fn init_v2 = (move_plugin_init_v2_fn)dlsym(handle, MOVE_PLUGIN_INIT_V2_SYMBOL);
+    chain_set_external_fx_mode_fn set_ext_fx =
+        (chain_set_external_fx_mode_fn)dlsym(handle, "chain_set_external_fx_mode");
+    chain_process_fx_fn process_fx = (chain_process_fx_fn)dlsym(handle, "chain_process_fx");
+    chain_set_inject_audio_fn set_inject =
+        (chain_set_inject_audio_fn)dlsym(handle, "chain_set_inject_audio");
+    move_plugin_on_midi_timed_fn on_midi_timed =
+        (move_plugin_on_midi_timed_fn)dlsym(handle, MOVE_PLUGIN_ON_MIDI_TIMED_SYMBOL);
+    if (!init_v2) { fprintf(stderr, "%s: no %s\n", chain_so, MOVE_PLUGIN_INIT_V2_SYMBOL); return 1; }
+    int split_fx = (set_ext_fx && process_fx);
+
+    static host_api_v1_t host;
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = MOVE_SAMPLE_RATE;
+    host.frames_per_block = FRAMES;
+    host.mapped_memory = mailbox;
+    host.audio_out_offset = MOVE_AUDIO_OUT_OFFSET;
+    host.audio_in_offset = MOVE_AUDIO_IN_OFFSET;
+    host.log = h_log;
+    host.midi_send_internal = h_midi_send;
+    host.midi_send_external = h_midi_send;
+    host.get_clock_status = h_clock_status;
+    host.get_bpm = h_get_bpm;
+    host.slot_recv_channel = h_slot_recv_channel;
+
+    plugin_api_v2_t *api = init_v2(&host);
+    if (!api) { fprintf(stderr, "chain init failed\n"); return 1; }
+
+    void *inst[MAX_SLOTS] = {0};
+    for (int s = 0; s < slots; s++) {
+        inst[s] = api->create_instance(chain_dir, NULL);
+        if (!inst[s]) { fprintf(stderr, "chain create_instance failed\n"); return 1; }
+        for (int p = 0; p < nparams; p++) api->set_param(inst[s], keys[p], vals[p]);
+        if (split_fx) set_ext_fx(inst[s], 1);
+        if (api->get_error) {
+            char err[256];
+            if (api->get_error(inst[s], err, sizeof(err)) > 0 && err[0]) {
+                fprintf(stderr, "chain error: %s\n", err);
+            }
+        }
+    }
+
+    FILE *out = NULL;
+    if (out_path) {
+        out = fopen(out_path, "wb");
+        if (!out) { perror(out_path); return 1; }
+        wav_write_header(out, 0);
+    }
+    FILE *csv = NULL;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) { perror(csv_path); return 1; }
+        fprintf(csv, "block,midi,synth,fx,mix,total\n");
+    }
+
+    uint32_t *t[T_COUNT];
+    for (int c = 0; c < T_COUNT; c++) {
+        t[c] = malloc(blocks * sizeof(uint32_t));
+        if (!t[c]) { fprintf(stderr, "out of memory\n"); return 1; }
+    }
+
+    int16_t *audio_in = (int16_t *)(mailbox + MOVE_AUDIO_IN_OFFSET);
+    int16_t *audio_out = (int16_t *)(mailbox + MOVE_AUDIO_OUT_OFFSET);
+    int16_t in_block[SAMPLES];
+    int16_t slot_buf[MAX_SLOTS][SAMPLES];
+    int32_t me_bus[SAMPLES], contrib[SAMPLES];
+    int16_t me_i16[SAMPLES];
+    float slot_gain[MAX_SLOTS];
+    for (int s = 0; s < MAX_SLOTS; s++) slot_gain[s] = 1.0f;
+    int next_event = 0;
+    double tone_phase = 0.0;
+
+    uint64_t wall0 = now_ns();
+    for (uint64_t b = 0; b < blocks; b++) {
+        uint64_t frame0 = b * FRAMES;
+
+        /* Feed input (not timed: on hardware it arrives with the mailbox) */
+        if (input) {
+            for (int i = 0; i < FRAMES; i++) {
+                uint64_t src = frame0 + i;
+                in_block[i * 2] = src < input_frames ? input[src * 2] : 0;
+                in_block[i * 2 + 1] = src < input_frames ? input[src * 2 + 1] : 0;
+            }
+        } else if (tone_hz > 0.0) {
+            for (int i = 0; i < FRAMES; i++) {
+                int16_t s = (int16_t)lrint(sin(tone_phase) * 8192.0);
+                in_block[i * 2] = in_block[i * 2 + 1] = s;
+                tone_phase += 2.0 * M_PI * tone_hz / MOVE_SAMPLE_RATE;
+                if (tone_phase > 2.0 * M_PI) tone_phase -= 2.0 * M_PI;
+            }
+        } else {
+            memset(in_block, 0, sizeof(in_block));
+        }
+        memcpy(audio_in, in_block, sizeof(in_block));
+        memset(audio_out, 0, MOVE_AUDIO_BYTES_PER_BLOCK);
+
+        uint64_t t0 = now_ns();
+        while (next_event < event_count && events[next_event].frame < frame0 + FRAMES) {
+            int offset = events[next_event].frame > frame0 ? (int)(events[next_event].frame - frame0) : 0;
+            for (int s = 0; s < slots; s++) {
+                if (on_midi_timed) {
+                    on_midi_timed(inst[s], events[next_event].msg, events[next_event].len,
+                                  MOVE_MIDI_SOURCE_INTERNAL, offset);
+                } else {
+                    api->on_midi(inst[s], events[next_event].msg, events[next_event].len,
+                                 MOVE_MIDI_SOURCE_INTERNAL);
+                }
+            }
+            next_event++;
+        }
+
+        uint64_t t1 = now_ns();
+        for (int s = 0; s < slots; s++) {
+            if (!split_fx && inject && set_inject) set_inject(inst[s], in_block, FRAMES);
+            api->render_block(inst[s], slot_buf[s], FRAMES);
+        }
+
+        uint64_t t2 = now_ns();
+        if (split_fx) {
+            for (int s = 0; s < slots; s++) {
+                if (inject) shadow_mix_add_sat_i16(slot_buf[s], in_block, SAMPLES);
+                process_fx(inst[s], slot_buf[s], FRAMES);
+            }
+        }
+
+        uint64_t t3 = now_ns();
+        memset(me_bus, 0, sizeof(me_bus));
+        for (int s = 0; s < slots; s++) {
+            if (shadow_mix_is_silent_i16(slot_buf[s], SAMPLES, 0)) continue;
+            shadow_mix_ramp_scale_i32(contrib, slot_buf[s], FRAMES, 1.0f,
+                                      &slot_gain[s], 1.0f, 0.0f);
+            shadow_mix_add_i32(me_bus, contrib, SAMPLES);
+        }
+        shadow_mix_clamp_i32_to_i16(me_i16, me_bus, SAMPLES);
+        shadow_mix_add_gain_sat_i16(audio_out, me_i16, 1.0f, SAMPLES);
+        uint64_t t4 = now_ns();
+
+        t[T_MIDI][b] = (uint32_t)(t1 - t0);
+        t[T_SYNTH][b] = (uint32_t)(t2 - t1);
+        t[T_FX][b] = (uint32_t)(t3 - t2);
+        t[T_MIX][b] = (uint32_t)(t4 - t3);
+        t[T_TOTAL][b] = (uint32_t)(t4 - t0);
+
+        if (out) fwrite(audio_out, 1, MOVE_AUDIO_BYTES_PER_BLOCK, out);
+        if (csv) {
+            fprintf(csv, "%llu", (unsigned long long)b);
+            for (int c = 0; c < T_COUNT; c++) fprintf(csv, ",%.2f", t[c][b] / 1000.0);
+            fputc('\n', csv);
+        }
+    }
+    double wall_s = (now_ns() - wall0) / 1e9;
+
+    if (out) {
+        fseek(out, 0, SEEK_SET);
+        wav_write_header(out, (uint32_t)(blocks * FRAMES));
+        fclose(out);
+    }
+    if (csv) fclose(csv);
+
+    for (int s = 0; s < slots; s++) api->destroy_instance(inst[s]);
+
+    double audio_s = (double)blocks * FRAMES / MOVE_SAMPLE_RATE;
+    printf("render_harness: %llu blocks x %d slot(s), %.2f s audio in %.3f s (%.1fx realtime)\n",
+           (unsigned long long)blocks, slots, audio_s, wall_s, wall_s > 0 ? audio_s / wall_s : 0.0);
+    printf("  fx path: %s, midi events: %d in / %lu out\n",
+           split_fx ? "split (external_fx_mode + chain_process_fx)" : "render_block only",
+           event_count, midi_out_count);
+    printf("  %-6s %9s %9s %9s %9s %9s\n", "stage", "p50 us", "p95 us", "p99 us", "max us", "p99 %");
+    double total_p99 = 0.0;
+    for (int c = 0; c < T_COUNT; c++) {
+        qsort(t[c], blocks, sizeof(uint32_t), u32_cmp);
+        double p99 = pct_us(t[c], blocks, 0.99);
+        if (c == T_TOTAL) total_p99 = p99;
+        printf("  %-6s %9.1f %9.1f %9.1f %9.1f %8.1f%%\n", t_names[c],
+               pct_us(t[c], blocks, 0.50), pct_us(t[c], blocks, 0.95), p99,
+               pct_us(t[c], blocks, 1.0), 100.0 * p99 / BUDGET_US);
+        free(t[c]);
+    }
+
+    free(events);
+    free(input);
+    for (int i = 0; i < nowned; i++) free(owned[i]);
+    dlclose(handle);
+
+    if (budget_us > 0.0 && total_p99 > budget_us) {
+        fprintf(stderr, "render_harness: total p99 %.1f us exceeds budget %.1f us\n",
+                total_p99, budget_us);
+        return 2;
+    }
+    return 0;
+}
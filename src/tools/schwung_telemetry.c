@@ -0,0 +1,227 @@
+/* schwung-telemetry — read the shim's per-stage SPI timing histograms.
+ *
+ * Usage:
+ *   schwung-telemetry             percentiles per stage since shim start
+ *   schwung-telemetry -w [SECS]   live view: percentiles of each interval
+ *   schwung-telemetry -o          recent over-budget frames, stage breakdown
+ *   schwung-telemetry -j          one JSON snapshot (histograms + overruns)
+ *
+ * Reads /schwung-telemetry (see src/host/shadow_telemetry.h) without
+ * touching the writer: counters are diffed, ring entries are copied under
+ * their seqlock. */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "host/shadow_constants.h"
+#include "host/shadow_telemetry.h"
+
+static const volatile telemetry_shm_t *open_telemetry(void)
+{
+    int fd = shm_open(SHM_SHADOW_TELEMETRY, O_RDONLY, 0);
+    if (fd < 0) {
+        perror("shm_open " SHM_SHADOW_TELEMETRY " (is the shim running?)");
+        return NULL;
+    }
+    void *p = mmap(NULL, sizeof(telemetry_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        perror("mmap");
+        return NULL;
+    }
+    const volatile telemetry_shm_t *t = p;
+    if (t->magic != TELEMETRY_MAGIC || t->version != TELEMETRY_VERSION ||
+        t->stage_count != TELEM_STAGE_COUNT || t->bucket_count != TELEMETRY_BUCKETS) {
+        fprintf(stderr, "schwung-telemetry: layout mismatch (magic %08x version %u) — "
+                        "rebuild to match the installed shim\n", t->magic, t->version);
+        return NULL;
+    }
+    return t;
+}
+
+static void snapshot(const volatile telemetry_shm_t *t, telemetry_hist_t *out)
+{
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+        out[i].count = __atomic_load_n(&t->hist[i].count, __ATOMIC_ACQUIRE);
+        out[i].sum_us = t->hist[i].sum_us;
+        out[i].max_us = t->hist[i].max_us;
+        out[i].last_us = t->hist[i].last_us;
+        for (int b = 0; b < TELEMETRY_BUCKETS; b++) out[i].buckets[b] = t->hist[i].buckets[b];
+    }
+}
+
+/* Upper edge of the bucket holding the p-th fraction of samples, capped by
+ * the observed max (so p100 prints the exact max). */
+static uint32_t percentile(const telemetry_hist_t *h, double p, uint32_t max_us)
+{
+    uint64_t total = 0;
+    for (int b = 0; b < TELEMETRY_BUCKETS; b++) total += h->buckets[b];
+    if (total == 0) return 0;
+    uint64_t want = (uint64_t)(p * (double)total + 0.5);
+    if (want < 1) want = 1;
+    uint64_t acc = 0;
+    for (int b = 0; b < TELEMETRY_BUCKETS; b++) {
+        acc += h->buckets[b];
+        if (acc >= want) {
+            uint32_t hi = (b + 1 < TELEMETRY_BUCKETS) ? telemetry_bucket_floor(b + 1) - 1 : max_us;
+            return hi < max_us ? hi : max_us;
+        }
+    }
+    return max_us;
+}
+
+static void print_table(const volatile telemetry_shm_t *t, const telemetry_hist_t *h, int interval)
+{
+    printf("%-10s %9s %8s %8s %8s %8s %8s %8s\n", "stage", "frames", "mean",
+           "p50", "p90", "p99", "p99.9", interval ? "last" : "max");
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+        if (h[i].count == 0) continue;
+        /* For intervals the true max is unknown; the p100 bucket edge stands in */
+        uint32_t max_us = interval ? percentile(&h[i], 1.0, UINT32_MAX) : h[i].max_us;
+        printf("%-10.*s %9u %8.0f %8u %8u %8u %8u %8u\n",
+               TELEMETRY_NAME_LEN, (const char *)t->stage_names[i], h[i].count,
+               (double)h[i].sum_us / h[i].count,
+               percentile(&h[i], 0.50, max_us), percentile(&h[i], 0.90, max_us),
+               percentile(&h[i], 0.99, max_us), percentile(&h[i], 0.999, max_us),
+               interval ? h[i].last_us : max_us);
+    }
+}
+
+static int cmd_summary(const volatile telemetry_shm_t *t)
+{
+    telemetry_hist_t h[TELEM_STAGE_COUNT];
+    snapshot(t, h);
+    printf("frames=%llu overruns=%llu (>%uus) budget=%uus — all times in us\n",
+           (unsigned long long)t->frames, (unsigned long long)t->overruns,
+           t->overrun_us, t->budget_us);
+    print_table(t, h, 0);
+    return 0;
+}
+
+static int cmd_watch(const volatile telemetry_shm_t *t, int secs)
+{
+    telemetry_hist_t prev[TELEM_STAGE_COUNT], cur[TELEM_STAGE_COUNT], d[TELEM_STAGE_COUNT];
+    snapshot(t, prev);
+    uint64_t prev_over = t->overruns;
+    for (;;) {
+        sleep((unsigned)secs);
+        snapshot(t, cur);
+        uint64_t over = t->overruns;
+        int reset = cur[TELEM_TOTAL].count < prev[TELEM_TOTAL].count;  /* shim restarted */
+        for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+            d[i] = cur[i];
+            if (reset) continue;
+            d[i].count -= prev[i].count;
+            d[i].sum_us -= prev[i].sum_us;
+            for (int b = 0; b < TELEMETRY_BUCKETS; b++) d[i].buckets[b] -= prev[i].buckets[b];
+        }
+        printf("\n--- %ds: %u frames, %llu overruns%s ---\n", secs, d[TELEM_TOTAL].count,
+               (unsigned long long)(reset ? over : over - prev_over), reset ? " (shim restarted)" : "");
+        print_table(t, d, 1);
+        fflush(stdout);
+        memcpy(prev, cur, sizeof(prev));
+        prev_over = over;
+    }
+    return 0;
+}
+
+/* Copy ring entry i under its seqlock. Returns 0 if it was torn or empty. */
+static int read_frame(const volatile telemetry_shm_t *t, uint32_t i, telemetry_frame_t *out)
+{
+    const volatile telemetry_frame_t *e = &t->ring[i & (TELEMETRY_OVERRUN_RING - 1)];
+    for (int attempt = 0; attempt < 4; attempt++) {
+        uint32_t s0 = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if (s0 & 1) continue;
+        out->frame = e->frame;
+        out->time_ns = e->time_ns;
+        for (int k = 0; k < TELEM_STAGE_COUNT; k++) out->stage_us[k] = e->stage_us[k];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) == s0) return s0 != 0;
+    }
+    return 0;
+}
+
+static int cmd_overruns(const volatile telemetry_shm_t *t)
+{
+    uint32_t w = __atomic_load_n(&t->ring_write, __ATOMIC_ACQUIRE);
+    uint32_t n = w < TELEMETRY_OVERRUN_RING ? w : TELEMETRY_OVERRUN_RING;
+    printf("%u most recent frames over %uus (oldest first), times in us; '-' = did not run\n",
+           n, t->overrun_us);
+    printf("%10s %12s", "frame", "t_ms");
+    for (int k = 0; k < TELEM_STAGE_COUNT; k++) printf(" %9.9s", (const char *)t->stage_names[k]);
+    printf("\n");
+    for (uint32_t i = w - n; i != w; i++) {
+        telemetry_frame_t f;
+        if (!read_frame(t, i, &f)) continue;
+        printf("%10llu %12.1f", (unsigned long long)f.frame, f.time_ns / 1e6);
+        for (int k = 0; k < TELEM_STAGE_COUNT; k++) {
+            if (f.stage_us[k] == TELEMETRY_NOT_RUN) printf(" %9s", "-");
+            else printf(" %9u", f.stage_us[k]);
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+static int cmd_json(const volatile telemetry_shm_t *t)
+{
+    telemetry_hist_t h[TELEM_STAGE_COUNT];
+    snapshot(t, h);
+    printf("{\"frames\":%llu,\"overruns\":%llu,\"budget_us\":%u,\"overrun_us\":%u,\"bucket_floor_us\":[",
+           (unsigned long long)t->frames, (unsigned long long)t->overruns, t->budget_us, t->overrun_us);
+    for (int b = 0; b < TELEMETRY_BUCKETS; b++) printf("%s%u", b ? "," : "", telemetry_bucket_floor(b));
+    printf("],\"stages\":[");
+    for (int i = 0; i < TELEM_STAGE_COUNT; i++) {
+        printf("%s{\"name\":\"%.*s\",\"count\":%u,\"sum_us\":%llu,\"max_us\":%u,\"last_us\":%u,\"buckets\":[",
+               i ? "," : "", TELEMETRY_NAME_LEN, (const char *)t->stage_names[i], h[i].count,
+               (unsigned long long)h[i].sum_us, h[i].max_us, h[i].last_us);
+        for (int b = 0; b < TELEMETRY_BUCKETS; b++) printf("%s%u", b ? "," : "", h[i].buckets[b]);
+        printf("]}");
+    }
+    printf("],\"recent_overruns\":[");
+    uint32_t w = __atomic_load_n(&t->ring_write, __ATOMIC_ACQUIRE);
+    uint32_t n = w < TELEMETRY_OVERRUN_RING ? w : TELEMETRY_OVERRUN_RING;
+    int first = 1;
+    for (uint32_t i = w - n; i != w; i++) {
+        telemetry_frame_t f;
+        if (!read_frame(t, i, &f)) continue;
+        printf("%s{\"frame\":%llu,\"time_ns\":%llu,\"stage_us\":[", first ? "" : ",",
+               (unsigned long long)f.frame, (unsigned long long)f.time_ns);
+        for (int k = 0; k < TELEM_STAGE_COUNT; k++) {
+            if (f.stage_us[k] == TELEMETRY_NOT_RUN) printf("%snull", k ? "," : "");
+            else printf("%s%u", k ? "," : "", f.stage_us[k]);
+        }
+        printf("]}");
+        first = 0;
+    }
+    printf("]}\n");
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *cmd = argc > 1 ? argv[1] : "";
+    if (!strcmp(cmd, "-h") || !strcmp(cmd, "--help")) {
+        fprintf(stderr, "Usage: %s [-w [SECS] | -o | -j]\n", argv[0]);
+        return 0;
+    }
+
+    const volatile telemetry_shm_t *t = open_telemetry();
+    if (!t) return 1;
+
+    if (!strcmp(cmd, "-w")) {
+        int secs = argc > 2 ? atoi(argv[2]) : 1;
+        return cmd_watch(t, secs > 0 ? secs : 1);
+    }
+    if (!strcmp(cmd, "-o")) return cmd_overruns(t);
+    if (!strcmp(cmd, "-j")) return cmd_json(t);
+    if (cmd[0]) {
+        fprintf(stderr, "Usage: %s [-w [SECS] | -o | -j]\n", argv[0]);
+        return 2;
+    }
+    return cmd_summary(t);
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+file="src/modules/chain/dsp/chain_host.c"
+
+if ! rg -q 'if \(strcmp\(key, "mem_stats"\) == 0\)' "$file" ||
+   ! rg -q 'static int v2_mem_stats\(chain_instance_t \*inst, char \*buf, int buf_len\)' "$file"; then
+  echo "FAIL: chain v2 get_param does not expose mem_stats" >&2
+  exit 1
+fi
+
+struct=$(awk '/^typedef struct chain_instance \{/,/^\} chain_instance_t;/' "$file")
+if printf '%s\n' "$struct" | rg -q 'patch_info_t patches\[|chain_param_info_t [a-z_]+_params\[[A-Z_]+\]\[MAX_CHAIN_PARAMS\]'; then
+  echo "FAIL: chain_instance_t embeds patch or param tables again" >&2
+  exit 1
+fi
+if printf '%s\n' "$struct" | rg -q 'ring_mutex|wav_file'; then
+  echo "FAIL: unused per-instance recording state is back in chain_instance_t" >&2
+  exit 1
+fi
+
+echo "PASS: chain_instance_t stays compact and reports mem_stats"
@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+api="src/host/plugin_api_v1.h"
+file="src/modules/chain/dsp/chain_host.c"
+fx="src/modules/audio_fx/freeverb/freeverb.c"
+
+if ! rg -q 'MOVE_PLUGIN_PARAM_EXT_V3_SYMBOL "move_plugin_param_ext_v3"' "$api"; then
+  echo "FAIL: plugin API is missing the v3 typed param extension symbol" >&2
+  exit 1
+fi
+if ! rg -q 'dlsym\(handle, MOVE_PLUGIN_PARAM_EXT_V3_SYMBOL\)' "$file"; then
+  echo "FAIL: chain host does not discover the v3 param extension via dlsym" >&2
+  exit 1
+fi
+if ! rg -q 'inst->synth_param_ext = param_ext_lookup\(handle\);' "$file"; then
+  echo "FAIL: synth load path does not look up typed param handles" >&2
+  exit 1
+fi
+if ! rg -q 'inst->fx_param_ext\[slot\] = param_ext_lookup\(handle\);' "$file"; then
+  echo "FAIL: audio FX load path does not look up typed param handles" >&2
+  exit 1
+fi
+if ! rg -q 'inst->fx_param_ext\[slot\] = NULL;' "$file"; then
+  echo "FAIL: audio FX unload path does not clear typed param handles" >&2
+  exit 1
+fi
+if ! rg -q 'p->param_gen != inst->param_ext_gen' "$file"; then
+  echo "FAIL: smoothers do not re-resolve cached ids after module swaps" >&2
+  exit 1
+fi
+if ! rg -q 'set_param_f\(inst->synth_instance, p->param_id, p->current\)' "$file"; then
+  echo "FAIL: synth smoother does not use the typed fast path" >&2
+  exit 1
+fi
+if ! rg -q 'if \(chain_mod_resolve_handle\(inst, entry\)\)' "$file"; then
+  echo "FAIL: modulation apply path does not use typed param handles" >&2
+  exit 1
+fi
+if ! rg -q 'const plugin_param_ext_v3_t\* move_plugin_param_ext_v3\(void\)' "$fx"; then
+  echo "FAIL: freeverb does not export the v3 param extension" >&2
+  exit 1
+fi
+
+echo "PASS: chain host writes smoothed/modulated params through typed handles"
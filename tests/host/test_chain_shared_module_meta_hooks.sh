@@ -0,0 +1,52 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+file="src/modules/chain/dsp/chain_host.c"
+
+if ! rg -q 'static chain_module_meta_t \*module_meta_acquire\(const char \*module_path\) \{' "$file"; then
+  echo "FAIL: missing shared module.json metadata cache" >&2
+  exit 1
+fi
+if rg -q 'parse_chain_params\((synth_path|fx_dir), inst->' "$file"; then
+  echo "FAIL: v2 slot loads still parse module.json into per-instance tables" >&2
+  exit 1
+fi
+if rg -q 'ui_hierarchy\[MAX_(AUDIO|MIDI)_FX\]\[65536\]' "$file"; then
+  echo "FAIL: per-instance 64 KB ui_hierarchy buffers are back" >&2
+  exit 1
+fi
+if ! rg -q 'chain_params_runtime_lookup\(inst, target, &params, &count, &runtime, &cap\)' "$file"; then
+  echo "FAIL: runtime chain_params must go to an instance-owned table, not the shared metadata" >&2
+  exit 1
+fi
+if awk '/^static int chain_mod_refresh_target_param_cache\(.*\{$/ { body = 1 }
+         body && /(malloc|realloc|calloc)\(/ { found = 1 }
+         body && /^}/ { body = 0 }
+         END { exit !found }' "$file" ||
+   ! rg -q 'parsed_count = \*cap;' "$file"; then
+  echo "FAIL: the audio-thread chain_params refresh must copy into the reserved table, clamped to its capacity" >&2
+  exit 1
+fi
+if ! rg -q 'chain_params_reserve_runtime\(inst, "synth"\);' "$file" ||
+   ! rg -q 'chain_params_after_set_param\(inst, "synth", subkey\);' "$file"; then
+  echo "FAIL: the runtime param table must be sized at load and again on the set_param/state path" >&2
+  exit 1
+fi
+if awk '/^    pthread_mutex_lock\(&g_(module_meta|patch_index)_lock\)/ { held = 1 }
+         /^    pthread_mutex_unlock\(&g_(module_meta|patch_index)_lock\)/ { held = 0 }
+         held && /(module_meta|patch_index)_build\(/ { found = 1 }
+         END { exit !found }' "$file"; then
+  echo "FAIL: module.json and patch files must be parsed outside the shared cache locks" >&2
+  exit 1
+fi
+if ! rg -q 'static chain_patch_index_t \*patch_index_acquire\(' "$file" ||
+   ! rg -q 'patch_index_acquire\(inst, patches_dir\)' "$file"; then
+  echo "FAIL: v2_scan_patches does not use the shared patch index" >&2
+  exit 1
+fi
+if ! rg -q 'patch_index_release\(inst->patch_index\);' "$file"; then
+  echo "FAIL: instances do not release their patch index reference" >&2
+  exit 1
+fi
+
+echo "PASS: chain instances share parsed module metadata and the patch index"
@@ -0,0 +1,118 @@
+/* Round-trip check for src/host/display_delta.c.
+ *
+ * Every delta the encoder emits must turn the previous frame into the new
+ * one under display_delta_apply() (the reference for the page's decoder),
+ * touch only changed rows, and be smaller than a keyframe - or be refused.
+ * Covers sparse edits, dense noise, single-byte changes at row edges and
+ * both frame formats. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/display_delta.h"
+
+static void fail(const char *msg, int iter) {
+    fprintf(stderr, "FAIL: %s (iteration %d)\n", msg, iter);
+    exit(1);
+}
+
+static uint32_t rng = 12345;
+static uint32_t rnd(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+/* Mutate `cur` in one of a few ways a real display changes */
+static void mutate(uint8_t *cur, int size, int kind) {
+    switch (kind) {
+    case 0: /* a few scattered bytes */
+        for (int n = rnd() % 6; n >= 0; n--) cur[rnd() % size] ^= (uint8_t)(1 + rnd() % 255);
+        break;
+    case 1: /* a text-line-sized block */
+    {
+        int row = rnd() % (size / DISPLAY_DELTA_ROW_BYTES);
+        int start = row * DISPLAY_DELTA_ROW_BYTES + rnd() % 64;
+        for (int k = 0; k < 40; k++) cur[start + k] = (uint8_t)rnd();
+        break;
+    }
+    case 2: /* everything */
+        for (int k = 0; k < size; k++) cur[k] = (uint8_t)rnd();
+        break;
+    case 3: /* first and last byte of a row */
+    {
+        int row = rnd() % (size / DISPLAY_DELTA_ROW_BYTES);
+        cur[row * DISPLAY_DELTA_ROW_BYTES] ^= 0x01;
+        cur[row * DISPLAY_DELTA_ROW_BYTES + DISPLAY_DELTA_ROW_BYTES - 1] ^= 0x80;
+        break;
+    }
+    default: /* alternating bytes, worst case for the run tokens */
+        for (int k = rnd() % 2; k < size; k += 2) cur[k] ^= 0xff;
+        break;
+    }
+}
+
+int main(void) {
+    static uint8_t prev[DISPLAY_DELTA_MAX_FRAME], cur[DISPLAY_DELTA_MAX_FRAME];
+    static uint8_t shown[DISPLAY_DELTA_MAX_FRAME], msg[DISPLAY_DELTA_MAX_MSG];
+    int shown_fmt = -1;
+    int deltas = 0, refused = 0, delta_bytes = 0;
+
+    for (int iter = 0; iter < 20000; iter++) {
+        int fmt = (iter / 5000) % 2 ? DISPLAY_DELTA_FMT_GRAY4 : DISPLAY_DELTA_FMT_MONO1;
+        int size = display_delta_frame_size(fmt);
+
+        if (iter % 5000 == 0) {
+            /* Format switch: only a keyframe gets the client across */
+            memset(cur, 0, sizeof(cur));
+            int len = display_delta_encode_key(msg, fmt, cur);
+            if (len != DISPLAY_DELTA_HDR_SIZE + size) fail("keyframe length", iter);
+            if (shown_fmt >= 0 && shown_fmt != fmt) {
+                int bad = display_delta_encode_delta(msg, fmt, cur, cur);
+                if (display_delta_apply(shown, &shown_fmt, msg, bad) == 0)
+                    fail("delta applied across a format change", iter);
+                len = display_delta_encode_key(msg, fmt, cur);
+            }
+            if (display_delta_apply(shown, &shown_fmt, msg, len) != 0) fail("keyframe apply", iter);
+            memcpy(prev, cur, size);
+            continue;
+        }
+
+        mutate(cur, size, (int)(rnd() % 5));
+        int len = display_delta_encode_delta(msg, fmt, prev, cur);
+        if (len < 0) {
+            refused++;
+            len = display_delta_encode_key(msg, fmt, cur);
+        } else {
+            deltas++;
+            delta_bytes += len;
+            if (len >= DISPLAY_DELTA_HDR_SIZE + size) fail("delta not smaller than keyframe", iter);
+            /* Unchanged rows never appear */
+            if (memcmp(prev, cur, size) == 0 && len != DISPLAY_DELTA_HDR_SIZE)
+                fail("empty delta carries rows", iter);
+        }
+        if (display_delta_apply(shown, &shown_fmt, msg, len) != 0) fail("apply rejected", iter);
+        if (shown_fmt != fmt || memcmp(shown, cur, size) != 0) fail("decoded frame differs", iter);
+        memcpy(prev, cur, size);
+    }
+
+    /* Truncated and malformed messages are rejected, not overrun */
+    memset(prev, 0, sizeof(prev));
+    memcpy(cur, prev, sizeof(cur));
+    cur[5] = 0x5a;
+    shown_fmt = DISPLAY_DELTA_FMT_MONO1;
+    int len = display_delta_encode_delta(msg, DISPLAY_DELTA_FMT_MONO1, prev, cur);
+    for (int cut = DISPLAY_DELTA_HDR_SIZE + 1; cut < len; cut++) {
+        uint8_t t[DISPLAY_DELTA_MAX_MSG];
+        memcpy(t, msg, cut);
+        t[2] = (uint8_t)(cut - DISPLAY_DELTA_HDR_SIZE);
+        t[3] = 0;
+        if (display_delta_apply(shown, &shown_fmt, t, cut) == 0) fail("truncated delta accepted", cut);
+    }
+    msg[DISPLAY_DELTA_HDR_SIZE] = 8;   /* row past the end of a mono frame */
+    if (display_delta_apply(shown, &shown_fmt, msg, len) == 0) fail("bad row accepted", 0);
+
+    printf("PASS: display delta round trip (%d deltas, avg %d bytes, %d fell back to keyframes)\n",
+           deltas, deltas ? delta_bytes / deltas : 0, refused);
+    return 0;
+}
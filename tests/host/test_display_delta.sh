@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_display_delta"
+mkdir -p build/tests
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 -Isrc \
+  tests/host/test_display_delta.c src/host/display_delta.c \
+  -o "$bin"
+
+"$bin"
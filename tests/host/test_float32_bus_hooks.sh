@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+chain="src/modules/chain/dsp/chain_host.c"
+shim="src/schwung_shim.c"
+mgmt="src/host/shadow_chain_mgmt.c"
+fx="src/modules/audio_fx/freeverb/freeverb.c"
+
+if ! rg -q 'AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL "move_audio_fx_process_block_f32"' src/host/audio_fx_api_v2.h; then
+  echo "FAIL: audio FX API is missing the float32 process symbol" >&2
+  exit 1
+fi
+if ! rg -q 'MOVE_PLUGIN_RENDER_BLOCK_F32_SYMBOL "move_plugin_render_block_f32"' src/host/plugin_api_v1.h; then
+  echo "FAIL: plugin API is missing the float32 render symbol" >&2
+  exit 1
+fi
+if ! rg -q 'dlsym\(handle, AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL\)' "$chain"; then
+  echo "FAIL: chain host does not discover float32 FX entry points" >&2
+  exit 1
+fi
+if ! rg -q 'dlsym\(handle, MOVE_PLUGIN_RENDER_BLOCK_F32_SYMBOL\)' "$chain"; then
+  echo "FAIL: chain host does not discover float32 synth entry points" >&2
+  exit 1
+fi
+if ! rg -q 'if \(chain_float_bus_wanted\(inst\)\) \{' "$chain"; then
+  echo "FAIL: chain render/process_fx paths do not switch to the float bus" >&2
+  exit 1
+fi
+if ! rg -q 'static void chain_run_fx_f32\(' "$chain"; then
+  echo "FAIL: chain host has no float FX bus" >&2
+  exit 1
+fi
+if ! rg -q 'memcpy\(inst->ext_fx_bus, bus,' "$chain" || ! rg -q 'if \(inst->ext_fx_bus_valid == frames\)' "$chain"; then
+  echo "FAIL: external FX mode clamps the synth before chain_process_fx" >&2
+  exit 1
+fi
+if ! rg -q 'dlsym\(s->handle, AUDIO_FX_PROCESS_BLOCK_F32_SYMBOL\)' "$mgmt"; then
+  echo "FAIL: master FX loader does not discover float32 entry points" >&2
+  exit 1
+fi
+if ! rg -q 'shadow_master_fx_run_f32\(me_unity, me_unity_i16\)' "$shim"; then
+  echo "FAIL: master FX chain does not run on the unclipped float ME bus" >&2
+  exit 1
+fi
+if ! rg -q '^void move_audio_fx_process_block_f32\(' "$fx"; then
+  echo "FAIL: freeverb does not export a float32 process entry point" >&2
+  exit 1
+fi
+
+echo "PASS: float32 block API is discovered and used by chain and master FX"
@@ -0,0 +1,284 @@
+/* Correctness check and micro-benchmark for the freeverb comb bank.
+ *
+ * Runs src/modules/audio_fx/freeverb/freeverb.c against a copy of the
+ * per-comb scalar engine it replaced (comb_process/allpass_process, one
+ * sample at a time) on the same input and parameters, through both the
+ * float and the int16 entry points. Both do the same arithmetic in the same
+ * order, so results must agree to float rounding (the compiler may contract
+ * multiply-adds differently). The benchmark then reports cycles (or ns when
+ * perf counters are unavailable) per 128-frame block for both engines. */
+
+#include <linux/perf_event.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host/plugin_api_v1.h"
+#include "host/audio_fx_api_v2.h"
+
+audio_fx_api_v2_t *move_audio_fx_init_v2(const host_api_v1_t *host);
+void move_audio_fx_process_block_f32(void *instance, float *audio_inout, int frames);
+
+#define FRAMES 128
+#define BLOCKS 2000
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+/* ---- Reference: the per-comb scalar engine ---- */
+
+#define REF_COMBS 8
+#define REF_ALLPASSES 4
+#define REF_MAX_DELAY 2048
+
+static const int ref_comb_l[REF_COMBS] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+static const int ref_allpass_l[REF_ALLPASSES] = { 556, 441, 341, 225 };
+
+typedef struct {
+    float buffer[REF_MAX_DELAY];
+    int bufsize, bufidx;
+    float filterstore;
+} ref_comb_t;
+
+typedef struct {
+    float buffer[REF_MAX_DELAY];
+    int bufsize, bufidx;
+} ref_allpass_t;
+
+typedef struct {
+    float feedback, damp1, damp2, wet1, wet2, dry;
+    ref_comb_t comb_l[REF_COMBS], comb_r[REF_COMBS];
+    ref_allpass_t allpass_l[REF_ALLPASSES], allpass_r[REF_ALLPASSES];
+} ref_reverb_t;
+
+static void ref_init(ref_reverb_t *r, float room, float damping, float wet, float dry, float width) {
+    memset(r, 0, sizeof(*r));
+    for (int i = 0; i < REF_COMBS; i++) {
+        r->comb_l[i].bufsize = ref_comb_l[i];
+        r->comb_r[i].bufsize = ref_comb_l[i] + 23;
+    }
+    for (int i = 0; i < REF_ALLPASSES; i++) {
+        r->allpass_l[i].bufsize = ref_allpass_l[i];
+        r->allpass_r[i].bufsize = ref_allpass_l[i] + 23;
+    }
+    r->feedback = room * 0.28f + 0.7f;
+    r->damp1 = damping * 0.4f;
+    r->damp2 = 1.0f - r->damp1;
+    r->wet1 = wet * (width / 2.0f + 0.5f);
+    r->wet2 = wet * ((1.0f - width) / 2.0f);
+    r->dry = dry;
+}
+
+static inline float ref_comb(ref_comb_t *c, float input, float feedback, float damp1, float damp2) {
+    float output = c->buffer[c->bufidx];
+    c->filterstore = (output * damp2) + (c->filterstore * damp1);
+    c->buffer[c->bufidx] = input + (c->filterstore * feedback);
+    if (++c->bufidx >= c->bufsize) c->bufidx = 0;
+    return output;
+}
+
+static inline float ref_allpass(ref_allpass_t *a, float input) {
+    float bufout = a->buffer[a->bufidx];
+    float output = -input + bufout;
+    a->buffer[a->bufidx] = input + (bufout * 0.5f);
+    if (++a->bufidx >= a->bufsize) a->bufidx = 0;
+    return output;
+}
+
+static void ref_process_f32(ref_reverb_t *r, float *io, int frames) {
+    for (int i = 0; i < frames; i++) {
+        float in_l = io[i * 2], in_r = io[i * 2 + 1];
+        float input = (in_l + in_r) * 0.5f;
+        float out_l = 0.0f, out_r = 0.0f;
+        for (int c = 0; c < REF_COMBS; c++) {
+            out_l += ref_comb(&r->comb_l[c], input, r->feedback, r->damp1, r->damp2);
+            out_r += ref_comb(&r->comb_r[c], input, r->feedback, r->damp1, r->damp2);
+        }
+        out_l *= 0.125f;
+        out_r *= 0.125f;
+        for (int a = 0; a < REF_ALLPASSES; a++) {
+            out_l = ref_allpass(&r->allpass_l[a], out_l);
+            out_r = ref_allpass(&r->allpass_r[a], out_r);
+        }
+        io[i * 2] = out_l * r->wet1 + out_r * r->wet2 + in_l * r->dry;
+        io[i * 2 + 1] = out_r * r->wet1 + out_l * r->wet2 + in_r * r->dry;
+    }
+}
+
+/* ---- Input ---- */
+
+static uint32_t rng = 0x2468ace1u;
+static float randf(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return ((int32_t)rng) / 2147483648.0f;
+}
+
+/* Noise bursts with silent gaps and an impulse, so tails ring out */
+static void fill_block(float *buf, int block) {
+    for (int i = 0; i < FRAMES; i++) {
+        int loud = (block / 50) % 2 == 0;
+        buf[i * 2] = loud ? 0.5f * randf() : 0.0f;
+        buf[i * 2 + 1] = loud ? 0.5f * randf() : 0.0f;
+    }
+    if (block == 300) buf[0] = buf[1] = 1.0f;
+}
+
+static audio_fx_api_v2_t *api;
+
+static void *new_instance(float room, float damping, float wet, float dry, float width) {
+    void *inst = api->create_instance(".", NULL);
+    if (!inst) fail("create_instance");
+    char v[32];
+    snprintf(v, sizeof(v), "%f", room);    api->set_param(inst, "room_size", v);
+    snprintf(v, sizeof(v), "%f", damping); api->set_param(inst, "damping", v);
+    snprintf(v, sizeof(v), "%f", wet);     api->set_param(inst, "wet", v);
+    snprintf(v, sizeof(v), "%f", dry);     api->set_param(inst, "dry", v);
+    snprintf(v, sizeof(v), "%f", width);   api->set_param(inst, "width", v);
+    return inst;
+}
+
+static void check_f32(float room, float damping, float width) {
+    void *inst = new_instance(room, damping, 1.0f, 0.0f, width);
+    static ref_reverb_t ref;
+    /* Same float parsing as the plugin */
+    char v[32];
+    float pr, pd, pw;
+    snprintf(v, sizeof(v), "%f", room);    pr = atof(v);
+    snprintf(v, sizeof(v), "%f", damping); pd = atof(v);
+    snprintf(v, sizeof(v), "%f", width);   pw = atof(v);
+    ref_init(&ref, pr, pd, 1.0f, 0.0f, pw);
+
+    float a[FRAMES * 2], b[FRAMES * 2];
+    double max_err = 0.0;
+    for (int blk = 0; blk < BLOCKS; blk++) {
+        fill_block(a, blk);
+        memcpy(b, a, sizeof(a));
+        /* Odd block sizes exercise the wrap splitting */
+        int n = (blk % 7 == 3) ? 37 : FRAMES;
+        move_audio_fx_process_block_f32(inst, a, n);
+        ref_process_f32(&ref, b, n);
+        for (int i = 0; i < n * 2; i++) {
+            double e = fabs((double)a[i] - (double)b[i]);
+            if (e > max_err) max_err = e;
+        }
+    }
+    if (max_err > 1e-4) {
+        fprintf(stderr, "FAIL: f32 output differs from reference by %g (room %.2f damp %.2f)\n",
+                max_err, room, damping);
+        exit(1);
+    }
+    api->destroy_instance(inst);
+}
+
+static void check_i16(void) {
+    void *inst = new_instance(0.8f, 0.3f, 0.4f, 0.6f, 1.0f);
+    static ref_reverb_t ref;
+    ref_init(&ref, 0.8f, 0.3f, 0.4f, 0.6f, 1.0f);
+
+    int16_t a[FRAMES * 2];
+    float b[FRAMES * 2], in[FRAMES * 2];
+    for (int blk = 0; blk < BLOCKS; blk++) {
+        fill_block(in, blk);
+        for (int i = 0; i < FRAMES * 2; i++) a[i] = (int16_t)(in[i] * 32767.0f);
+        for (int i = 0; i < FRAMES * 2; i++) b[i] = a[i] / 32768.0f;
+        api->process_block(inst, a, FRAMES);
+        ref_process_f32(&ref, b, FRAMES);
+        for (int i = 0; i < FRAMES * 2; i++) {
+            float v = b[i] > 1.0f ? 1.0f : b[i] < -1.0f ? -1.0f : b[i];
+            int want = (int16_t)(v * 32767.0f);
+            if (abs(a[i] - want) > 1) fail("int16 output differs from reference by more than 1 LSB");
+        }
+    }
+    api->destroy_instance(inst);
+}
+
+/* ---- Benchmark ---- */
+
+static int perf_fd = -1;
+
+static void perf_open(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* CPU cycles if perf counters are available, else ns */
+static double counter(void) {
+    if (perf_fd >= 0) {
+        uint64_t c;
+        if (read(perf_fd, &c, sizeof(c)) == sizeof(c)) return (double)c;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static float bench_in[FRAMES * 2];
+static volatile float sink;
+
+static double bench_ref(int iters) {
+    static ref_reverb_t ref;
+    ref_init(&ref, 0.5f, 0.5f, 0.3f, 0.7f, 1.0f);
+    float buf[FRAMES * 2];
+    double t0 = counter();
+    for (int it = 0; it < iters; it++) {
+        memcpy(buf, bench_in, sizeof(buf));
+        ref_process_f32(&ref, buf, FRAMES);
+        sink += buf[it & 255];
+    }
+    return (counter() - t0) / iters;
+}
+
+static double bench_bank(int iters) {
+    void *inst = new_instance(0.5f, 0.5f, 0.3f, 0.7f, 1.0f);
+    float buf[FRAMES * 2];
+    double t0 = counter();
+    for (int it = 0; it < iters; it++) {
+        memcpy(buf, bench_in, sizeof(buf));
+        move_audio_fx_process_block_f32(inst, buf, FRAMES);
+        sink += buf[it & 255];
+    }
+    double r = (counter() - t0) / iters;
+    api->destroy_instance(inst);
+    return r;
+}
+
+int main(int argc, char **argv) {
+    int iters = argc > 1 ? atoi(argv[1]) : 20000;
+
+    static host_api_v1_t host;
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = MOVE_SAMPLE_RATE;
+    host.frames_per_block = MOVE_FRAMES_PER_BLOCK;
+    api = move_audio_fx_init_v2(&host);
+    if (!api) fail("move_audio_fx_init_v2");
+
+    check_f32(0.5f, 0.5f, 1.0f);
+    check_f32(1.0f, 0.0f, 0.3f);
+    check_f32(0.0f, 1.0f, 0.0f);
+    check_i16();
+
+    printf("PASS: freeverb comb bank matches per-comb reference\n");
+
+    for (int i = 0; i < FRAMES * 2; i++) bench_in[i] = 0.5f * randf();
+    perf_open();
+    const char *unit = perf_fd >= 0 ? "cycles" : "ns";
+    bench_ref(iters / 10 + 1);   /* warm up */
+    double legacy = bench_ref(iters);
+    double bank = bench_bank(iters);
+    printf("  %d-frame block: per-comb %.0f %s, comb bank %.0f %s (%.2fx)\n",
+           FRAMES, legacy, unit, bank, unit, legacy / bank);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_freeverb_bank"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O3 \
+  -Isrc \
+  tests/host/test_freeverb_bank.c \
+  src/modules/audio_fx/freeverb/freeverb.c \
+  -o "$bin" \
+  -lm
+
+"$bin" "${FREEVERB_BENCH_ITERS:-20000}"
@@ -0,0 +1,132 @@
+/* Packed framebuffer test for src/host/js_display.c.
+ *
+ * Draws random rects, lines, circles and blits, each partly off screen,
+ * into the packed buffer and into a one-byte-per-pixel model of the old
+ * set_pixel() semantics, and checks the two agree pixel for pixel. After
+ * each operation, copying only the flagged slices onto the previous frame
+ * must reproduce the new frame exactly. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/js_display.h"
+
+/* js_display.c registers QuickJS bindings; none are called here */
+int JS_ToInt32(JSContext *ctx, int32_t *pres, JSValueConst val) { (void)ctx; (void)pres; (void)val; return -1; }
+const char *JS_ToCStringLen2(JSContext *ctx, size_t *plen, JSValueConst val, int cesu8) { (void)ctx; (void)plen; (void)val; (void)cesu8; return NULL; }
+void JS_FreeCString(JSContext *ctx, const char *ptr) { (void)ctx; (void)ptr; }
+JSValue JS_NewCFunction2(JSContext *ctx, JSCFunction *func, const char *name, int length, JSCFunctionEnum cproto, int magic) { (void)ctx; (void)func; (void)name; (void)length; (void)cproto; (void)magic; return JS_UNDEFINED; }
+int JS_SetPropertyStr(JSContext *ctx, JSValueConst this_obj, const char *prop, JSValue val) { (void)ctx; (void)this_obj; (void)prop; (void)val; return 0; }
+
+static unsigned char model[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+
+static void fail(const char *msg, int op) {
+    fprintf(stderr, "FAIL: %s (op %d)\n", msg, op);
+    exit(1);
+}
+
+static uint32_t rng = 12345;
+static int rnd(int lo, int hi) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return lo + (int)(rng % (uint32_t)(hi - lo + 1));
+}
+
+static void model_px(int x, int y, int v) {
+    if (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) model[y][x] = v ? 1 : 0;
+}
+
+static void model_line(int x0, int y0, int x1, int y1, int v) {
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int sx = x1 > x0 ? 1 : -1, sy = y1 > y0 ? 1 : -1;
+    int err = dx - dy;
+    while (1) {
+        model_px(x0, y0, v);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+}
+
+int main(void) {
+    static uint8_t shadow[DISPLAY_BUFFER_SIZE];
+    uint8_t sprite[3 * 20];
+    unsigned char sprite_px[20][20];
+
+    js_display_clear();
+    js_display_flush_slices(shadow);
+
+    for (int op = 0; op < 20000; op++) {
+        int kind = rnd(0, 4);
+        int v = rnd(0, 1);
+        int x = rnd(-20, DISPLAY_WIDTH + 4), y = rnd(-20, DISPLAY_HEIGHT + 4);
+        int w = rnd(0, 40), h = rnd(0, 30);
+
+        if (kind == 0) {
+            js_display_fill_rect(x, y, w, h, v);
+            for (int j = 0; j < h; j++)
+                for (int i = 0; i < w; i++) model_px(x + i, y + j, v);
+        } else if (kind == 1) {
+            js_display_draw_rect(x, y, w, h, v);
+            for (int j = 0; w > 0 && j < h; j++) { model_px(x, y + j, v); model_px(x + w - 1, y + j, v); }
+            for (int i = 0; h > 0 && i < w; i++) { model_px(x + i, y, v); model_px(x + i, y + h - 1, v); }
+        } else if (kind == 2) {
+            int x1 = rnd(-20, DISPLAY_WIDTH + 20), y1 = rnd(-20, DISPLAY_HEIGHT + 20);
+            if (rnd(0, 3) == 0) x1 = x;
+            else if (rnd(0, 3) == 0) y1 = y;
+            js_display_draw_line(x, y, x1, y1, v);
+            model_line(x, y, x1, y1, v);
+        } else if (kind == 3) {
+            int r = rnd(0, 12);
+            js_display_fill_circle(x, y, r, v);
+            for (int j = -r; j <= r; j++)
+                for (int i = -r; i <= r; i++)
+                    if (i * i + j * j <= r * r) model_px(x + i, y + j, v);
+        } else {
+            int sw = rnd(1, 20), sh = rnd(1, 20);
+            memset(sprite, 0, sizeof(sprite));
+            for (int j = 0; j < sh; j++)
+                for (int i = 0; i < sw; i++) {
+                    sprite_px[j][i] = (uint8_t)rnd(0, 1);
+                    if (sprite_px[j][i]) sprite[(j / 8) * sw + i] |= (uint8_t)(1u << (j & 7));
+                }
+            /* Stray bits below the last row must be ignored */
+            if (sh & 7)
+                for (int i = 0; i < sw; i++) sprite[(sh / 8) * sw + i] |= (uint8_t)(0xFFu << (sh & 7));
+            js_display_blit(sprite, sw, sh, x, y, v);
+            for (int j = 0; j < sh; j++)
+                for (int i = 0; i < sw; i++)
+                    if (sprite_px[j][i]) model_px(x + i, y + j, v);
+        }
+
+        for (int py = 0; py < DISPLAY_HEIGHT; py++)
+            for (int px = 0; px < DISPLAY_WIDTH; px++)
+                if (js_display_get_pixel(px, py) != model[py][px]) fail("pixel differs from model", op);
+
+        js_display_flush_slices(shadow);
+        if (js_display_dirty_slices != 0) fail("flush left slices dirty", op);
+        if (memcmp(shadow, js_display_screen_buffer, DISPLAY_BUFFER_SIZE) != 0)
+            fail("dirty slices missed a change", op);
+    }
+
+    /* Drawing inside one slice flags only that slice */
+    js_display_flush_slices(shadow);
+    js_display_set_pixel(0, 16, 1);            /* byte 256: slice 1 */
+    if (js_display_dirty_slices != 0x2) fail("single pixel flagged wrong slices", 0);
+    js_display_fill_rect(0, 56, 128, 8, 1);    /* bytes 896..1023: slice 5 */
+    if (js_display_dirty_slices != 0x22) fail("bottom page flagged wrong slices", 0);
+    js_display_set_pixel(-1, 0, 1);
+    js_display_fill_rect(200, 0, 4, 4, 1);
+    if (js_display_dirty_slices != 0x22) fail("off-screen drawing flagged slices", 0);
+
+    /* pack() is the frame as the OLED takes it */
+    uint8_t packed[DISPLAY_BUFFER_SIZE];
+    js_display_pack(packed);
+    if (packed[256] != 0x01 || packed[7 * 128 + 5] != 0xFF) fail("packed layout", 0);
+
+    printf("PASS: packed framebuffer matches per-pixel drawing, dirty slices cover every change\n");
+    return 0;
+}
@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_js_display_packed"
+mkdir -p "$(dirname "$bin")"
+
+# js_display.c pulls in the stb single-header libraries and QuickJS; their
+# warnings aren't ours to fix, so only the test itself builds with -Werror.
+cc -std=gnu11 -O2 -Isrc -Isrc/lib -isystem libs/quickjs/quickjs-2025-04-26 \
+  -c src/host/js_display.c -o "$bin.display.o"
+cc -std=gnu11 -Wall -Wextra -Werror -O2 -Isrc -Isrc/lib -isystem libs/quickjs/quickjs-2025-04-26 \
+  tests/host/test_js_display_packed.c "$bin.display.o" \
+  -o "$bin" -lm
+
+"$bin"
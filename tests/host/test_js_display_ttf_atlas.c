@@ -0,0 +1,125 @@
+/* TTF glyph atlas test for src/host/js_display.c.
+ *
+ * Prints strings through set_font()'s TTF path and checks the result
+ * pixel for pixel against rasterising every character with stb_truetype
+ * directly (the pre-atlas code path, plus kerning). Drawing the same text
+ * again must come from the atlas and match, and text_width() must agree
+ * with where print() leaves the pen. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host/js_display.h"
+
+/* js_display.c registers QuickJS bindings; none are called here */
+int JS_ToInt32(JSContext *ctx, int32_t *pres, JSValueConst val) { (void)ctx; (void)pres; (void)val; return -1; }
+const char *JS_ToCStringLen2(JSContext *ctx, size_t *plen, JSValueConst val, int cesu8) { (void)ctx; (void)plen; (void)val; (void)cesu8; return NULL; }
+void JS_FreeCString(JSContext *ctx, const char *ptr) { (void)ctx; (void)ptr; }
+JSValue JS_NewCFunction2(JSContext *ctx, JSCFunction *func, const char *name, int length, JSCFunctionEnum cproto, int magic) { (void)ctx; (void)func; (void)name; (void)length; (void)cproto; (void)magic; return JS_UNDEFINED; }
+int JS_SetPropertyStr(JSContext *ctx, JSValueConst this_obj, const char *prop, JSValue val) { (void)ctx; (void)this_obj; (void)prop; (void)val; return 0; }
+
+static unsigned char model[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+
+static void fail(const char *msg, const char *text) {
+    fprintf(stderr, "FAIL: %s (\"%s\")\n", msg, text);
+    exit(1);
+}
+
+/* Reference: rasterise each character on the spot; returns the pen position */
+static int model_print(const stbtt_fontinfo *info, float scale, int ascent,
+                       int x, int y, const char *s, int color) {
+    int cursor = x;
+    for (size_t i = 0; s[i]; i++) {
+        int c = (unsigned char)s[i];
+        if (i > 0) {
+            float k = stbtt_GetCodepointKernAdvance(info, (unsigned char)s[i - 1], c) * scale;
+            cursor += (int)(k + (k >= 0 ? 0.5f : -0.5f));
+        }
+        int advance, lsb, x0, y0, x1, y1;
+        stbtt_GetCodepointHMetrics(info, c, &advance, &lsb);
+        stbtt_GetCodepointBitmapBox(info, c, scale, scale, &x0, &y0, &x1, &y1);
+        int w = x1 - x0, h = y1 - y0;
+        if (w > 0 && h > 0) {
+            unsigned char *bm = malloc((size_t)w * h);
+            stbtt_MakeCodepointBitmap(info, bm, w, h, w, scale, scale, c);
+            for (int j = 0; j < h; j++)
+                for (int i2 = 0; i2 < w; i2++) {
+                    int px = cursor + x0 + i2, py = y + ascent + y0 + j;
+                    if (bm[j * w + i2] > 64 && px >= 0 && px < DISPLAY_WIDTH && py >= 0 && py < DISPLAY_HEIGHT)
+                        model[py][px] = color ? 1 : 0;
+                }
+            free(bm);
+        }
+        cursor += (int)(advance * scale);
+    }
+    return cursor;
+}
+
+static void check(const char *text) {
+    for (int py = 0; py < DISPLAY_HEIGHT; py++)
+        for (int px = 0; px < DISPLAY_WIDTH; px++)
+            if (js_display_get_pixel(px, py) != model[py][px]) fail("atlas glyphs differ from direct rasterisation", text);
+}
+
+int main(void) {
+    const char *path = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+    if (access(path, R_OK) != 0) {
+        printf("SKIP: %s not installed\n", path);
+        return 0;
+    }
+
+    static const char *texts[] = {
+        "AVATAR Ty Wo 0.25 dB",
+        "Filter Cutoff: 12.4k",
+        "Te{st} |j_g| @#%&",
+        "LFO 1 > Osc 2 Pitch",
+    };
+    static const int sizes[] = { 9, 12, 16 };
+
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); si++) {
+        if (!js_display_set_font(path, sizes[si])) fail("set_font failed", path);
+
+        FILE *f = fopen(path, "rb");
+        fseek(f, 0, SEEK_END);
+        long len = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        unsigned char *ttf = malloc(len);
+        if (fread(ttf, 1, len, f) != (size_t)len) fail("read font", path);
+        fclose(f);
+        stbtt_fontinfo info;
+        stbtt_InitFont(&info, ttf, 0);
+        float scale = stbtt_ScaleForPixelHeight(&info, sizes[si]);
+        int ascent, descent, gap;
+        stbtt_GetFontVMetrics(&info, &ascent, &descent, &gap);
+        ascent = (int)(ascent * scale);
+
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t ti = 0; ti < sizeof(texts) / sizeof(texts[0]); ti++) {
+                const char *t = texts[ti];
+                int x = (int)ti * 7 - 5, y = (int)ti * 13 - 3;
+                js_display_clear();
+                memset(model, 0, sizeof(model));
+                js_display_fill_rect(0, 20, 128, 20, 1);
+                for (int py = 20; py < 40; py++) memset(model[py], 1, DISPLAY_WIDTH);
+
+                js_display_print(x, y, t, 1);
+                js_display_print(x, y + 20, t, 0);
+                int end = model_print(&info, scale, ascent, x, y, t, 1);
+                model_print(&info, scale, ascent, x, y + 20, t, 0);
+                check(t);
+
+                if (js_display_text_width(t) != end - x) fail("text_width disagrees with print", t);
+            }
+        }
+        free(ttf);
+    }
+
+    /* Each size is its own cache entry; switching back reuses it */
+    if (!js_display_set_font(path, 12) || js_display_get_font_height() != 12) fail("size switch", path);
+    if (!js_display_set_font(path, 16) || js_display_get_font_height() != 16) fail("size switch", path);
+
+    printf("PASS: TTF atlas glyphs match direct rasterisation\n");
+    return 0;
+}
@@ -0,0 +1,142 @@
+/* Drift compensation test for src/host/shadow_drift.c.
+ *
+ * Resampler: sines read from a ring at a fixed fractional ratio must match
+ * the analytic signal at the output positions to within int16 rounding
+ * across the passband.
+ *
+ * Controller: a producer running off a clock with a fixed ppm offset
+ * delivers 125-frame packets into a ring drained in 128-frame blocks, the
+ * way link-subscriber feeds /schwung-link-in. Starting 5 ms off target,
+ * the fill must settle on target with the ratio tracking the drift, and
+ * without starving or needing a catch-up. */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/shadow_drift.h"
+
+#define FRAMES 128
+#define RING_SAMPLES 8192
+#define RING_MASK (RING_SAMPLES - 1)
+#define TARGET_FRAMES 400.0
+#define BLOCKS_PER_SEC (44100.0 / FRAMES)
+
+static int16_t ring[RING_SAMPLES];
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static double sine_snr(double freq, double ratio) {
+    double w = 2.0 * M_PI * freq / 44100.0, amp = 16000.0;
+    la_drift_t d;
+    la_drift_reset(&d);
+    d.ratio = ratio;
+    d.frac = 0.37;
+    uint32_t rp = 0;
+    long base = 0;  /* frame index of ring[rp] */
+    double sig = 0.0, err = 0.0;
+    int16_t out[FRAMES * 2];
+    for (int b = 0; b < 200; b++) {
+        int span = la_drift_frames_needed(&d, FRAMES);
+        for (int i = 0; i < span; i++) {
+            ring[(rp + 2 * i) & RING_MASK] = (int16_t)lround(amp * sin(w * (base + i)));
+            ring[(rp + 2 * i + 1) & RING_MASK] = (int16_t)lround(amp * cos(w * (base + i)));
+        }
+        double frac0 = d.frac;
+        int used = la_drift_process(&d, ring, RING_MASK, rp, out, FRAMES);
+        for (int j = 0; j < FRAMES && b > 2; j++) {
+            double t = base + LA_DRIFT_HISTORY_FRAMES + frac0 + j * ratio;
+            double el = out[2 * j] - amp * sin(w * t), er = out[2 * j + 1] - amp * cos(w * t);
+            err += el * el + er * er;
+            sig += amp * amp;
+        }
+        rp += (uint32_t)used * 2;
+        base += used;
+    }
+    return 10.0 * log10(sig / err);
+}
+
+static uint32_t rng = 4242;
+static double urand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (double)rng / 4294967296.0;
+}
+
+static void run_drift(double ppm, double start_off) {
+    la_drift_t d;
+    la_drift_reset(&d);
+    uint32_t wp = 0, rp = 0;
+    double produced = 0.0;
+    long delivered = 0;
+    int16_t out[FRAMES * 2];
+    int starve = 0;
+    double ratio_sum = 0.0, err_max = 0.0;
+    int n = 0;
+
+    wp += (uint32_t)(TARGET_FRAMES + start_off + LA_DRIFT_HISTORY_FRAMES) * 2;
+    int total = (int)(90 * BLOCKS_PER_SEC);
+    for (int b = 0; b < total; b++) {
+        produced += FRAMES * (1.0 + ppm * 1e-6);
+        while (delivered + 125 <= produced) {
+            for (int i = 0; i < 250; i++) ring[(wp + i) & RING_MASK] = (int16_t)(urand() * 2000.0);
+            wp += 250;
+            delivered += 125;
+        }
+        double avail = (wp - rp) / 2.0;
+        if (avail > 1536.0) fail("fill ran away (catch-up needed)");
+        double ratio = la_drift_control(&d, avail - LA_DRIFT_HISTORY_FRAMES - d.frac - TARGET_FRAMES);
+        if (avail < la_drift_frames_needed(&d, FRAMES)) {
+            starve++;
+            continue;
+        }
+        rp += (uint32_t)la_drift_process(&d, ring, RING_MASK, rp, out, FRAMES) * 2;
+        if (b > total - (int)(30 * BLOCKS_PER_SEC)) {
+            ratio_sum += ratio;
+            n++;
+            if (fabs(d.err_lp) > err_max) err_max = fabs(d.err_lp);
+        }
+    }
+    double mean_ppm = (ratio_sum / n - 1.0) * 1e6;
+    printf("drift %+5.0f ppm, start %+4.0f frames: tracked %+6.1f ppm, fill within %.1f frames\n",
+           ppm, start_off, mean_ppm, err_max);
+    if (starve) fail("reader starved");
+    if (fabs(mean_ppm - ppm) > 10.0) fail("ratio does not track the clock drift");
+    if (err_max > 20.0) fail("fill does not settle on target");
+}
+
+int main(void) {
+    la_drift_init_tables();
+
+    const double freqs[] = { 100.0, 1000.0, 5000.0, 10000.0, 15000.0 };
+    const double ratios[] = { 1.0, 1.0 + 100e-6, 1.0 - LA_DRIFT_RATIO_MAX };
+    for (size_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++) {
+        for (size_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+            double snr = sine_snr(freqs[f], ratios[r]);
+            if (snr < 85.0) {
+                fprintf(stderr, "%.0f Hz at ratio %.6f: SNR %.1f dB\n", freqs[f], ratios[r], snr);
+                fail("resampler accuracy");
+            }
+        }
+    }
+    printf("resampler: >85 dB SNR up to 15 kHz\n");
+
+    run_drift(100.0, 220.0);
+    run_drift(-150.0, -150.0);
+    run_drift(300.0, 0.0);
+    run_drift(-40.0, 100.0);
+
+    /* Reset returns to a 1:1 read */
+    la_drift_t d;
+    la_drift_reset(&d);
+    if (d.ratio != 1.0 || d.frac != 0.0 || la_drift_frames_needed(&d, FRAMES) != FRAMES - 1 + LA_DRIFT_TAPS)
+        fail("reset state");
+
+    printf("PASS: Link Audio drift compensation\n");
+    return 0;
+}
@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_link_audio_drift"
+mkdir -p "$(dirname "$bin")"
+
+# Default (scalar) build and the opt-in NEON build (scalar again off aarch64)
+for variant in default neon; do
+  defs=""
+  [ "$variant" = "neon" ] && defs="-DSHADOW_DRIFT_ENABLE_NEON"
+  cc -std=gnu11 -Wall -Wextra -Werror -O2 $defs -Isrc \
+    tests/host/test_link_audio_drift.c src/host/shadow_drift.c \
+    -o "$bin-$variant" -lm
+  "$bin-$variant"
+done
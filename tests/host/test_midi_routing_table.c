@@ -0,0 +1,180 @@
+/* Routing table test for shadow_chain_dispatch_midi_to_slots() and the
+ * cable-2 dispatchers in src/host/shadow_midi.c.
+ *
+ * Drives the dispatchers against a recording plugin and checks which slots
+ * get which message: channel match, THRU skip, forward remap, transpose,
+ * FX broadcast and master FX forwarding. Slot config changes take effect at
+ * the next frame tick. An inactive slot with an instance is probed with
+ * get_param at most once per probe interval, however dense the stream.
+ * Also prints per-event dispatch cost. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host/shadow_midi.h"
+
+int midi_indicator_last_channel = 0;
+int midi_indicator_active_notes = 0;
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+typedef struct {
+    int slot;
+    uint8_t msg[3];
+    int source;
+} call_t;
+
+static call_t calls[64];
+static int ncalls = 0;
+static int get_param_calls = 0;
+static int master_calls = 0;
+static int ui_updates = 0;
+static const char *loaded[4] = { "synth", "synth", "synth", "" };
+static int instance_ids[4] = { 0, 1, 2, 3 };
+
+static void p_on_midi(void *instance, const uint8_t *msg, int len, int source) {
+    (void)len;
+    if (ncalls < 64) {
+        calls[ncalls].slot = *(int *)instance;
+        memcpy(calls[ncalls].msg, msg, 3);
+        calls[ncalls].source = source;
+    }
+    ncalls++;
+}
+
+static int p_get_param(void *instance, const char *key, char *buf, int buf_len) {
+    get_param_calls++;
+    const char *v = strcmp(key, "synth_module") == 0 ? loaded[*(int *)instance] : "";
+    return snprintf(buf, buf_len, "%s", v);
+}
+
+static void master_forward(const uint8_t *msg, int len, int source) {
+    (void)msg; (void)len; (void)source;
+    master_calls++;
+}
+
+static void ui_update(int slot) { (void)slot; ui_updates++; }
+
+static plugin_api_v2_t plugin = { .on_midi = p_on_midi, .get_param = p_get_param };
+static const plugin_api_v2_t *plugin_ptr = &plugin;
+static shadow_chain_slot_t slots[SHADOW_CHAIN_INSTANCES];
+static int slot_idle[4], slot_silence[4], slot_fx_idle[4], slot_fx_silence[4];
+
+static void reset_calls(void) {
+    ncalls = 0;
+    master_calls = 0;
+}
+
+static const call_t *find(int slot, int source) {
+    for (int i = 0; i < ncalls && i < 64; i++)
+        if (calls[i].slot == slot && calls[i].source == source) return &calls[i];
+    return NULL;
+}
+
+static void note_on(uint8_t ch, uint8_t note, int skip_direct) {
+    static int log_count = 0;
+    uint8_t pkt[4] = { 0x09, (uint8_t)(0x90 | ch), note, 100 };
+    shadow_chain_dispatch_midi_to_slots(pkt, 0, &log_count, skip_direct);
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    /* 0: ch1, auto forward. 1: All + THRU. 2: ch6 -> ch10, +2 semitones.
+     * 3: ch4, instance but nothing loaded (inactive). */
+    slots[0] = (shadow_chain_slot_t){ .instance = &instance_ids[0], .channel = 0, .active = 1, .forward_channel = -1 };
+    slots[1] = (shadow_chain_slot_t){ .instance = &instance_ids[1], .channel = -1, .active = 1, .forward_channel = -2 };
+    slots[2] = (shadow_chain_slot_t){ .instance = &instance_ids[2], .channel = 5, .active = 1, .forward_channel = 9, .transpose = 2 };
+    slots[3] = (shadow_chain_slot_t){ .instance = &instance_ids[3], .channel = 3, .active = 0, .forward_channel = -1 };
+
+    int ready = 1;
+    midi_host_t host = {
+        .ui_state_update_slot = ui_update,
+        .master_fx_forward_midi = master_forward,
+        .chain_slots = slots,
+        .plugin_v2 = &plugin_ptr,
+        .shadow_inprocess_ready = &ready,
+        .slot_idle = slot_idle,
+        .slot_silence_frames = slot_silence,
+        .slot_fx_idle = slot_fx_idle,
+        .slot_fx_silence_frames = slot_fx_silence,
+    };
+    midi_routing_init(&host);
+
+    /* Channel 1: slot 0 and the THRU slot; everyone active gets the broadcast */
+    reset_calls();
+    note_on(0, 60, 0);
+    const call_t *c = find(0, MOVE_MIDI_SOURCE_EXTERNAL);
+    if (!c || c->msg[0] != 0x90 || c->msg[1] != 60) fail("slot 0 should get ch1 note");
+    c = find(1, MOVE_MIDI_SOURCE_EXTERNAL);
+    if (!c || c->msg[0] != 0x90) fail("THRU slot should get ch1 note unchanged");
+    if (find(2, MOVE_MIDI_SOURCE_EXTERNAL)) fail("slot 2 listens on ch6 only");
+    for (int s = 0; s < 3; s++)
+        if (!find(s, MOVE_MIDI_SOURCE_FX_BROADCAST)) fail("active slot missed FX broadcast");
+    if (find(3, MOVE_MIDI_SOURCE_FX_BROADCAST)) fail("inactive slot got FX broadcast");
+    if (master_calls != 1) fail("master FX forward");
+
+    /* skip_direct leaves the THRU slot to the MIDI_IN path */
+    reset_calls();
+    note_on(0, 60, 1);
+    if (find(1, MOVE_MIDI_SOURCE_EXTERNAL)) fail("skip_direct should skip THRU slot");
+    if (!find(1, MOVE_MIDI_SOURCE_FX_BROADCAST)) fail("THRU slot still gets FX broadcast");
+
+    /* Forward channel and transpose */
+    reset_calls();
+    note_on(5, 60, 0);
+    c = find(2, MOVE_MIDI_SOURCE_EXTERNAL);
+    if (!c || c->msg[0] != 0x99 || c->msg[1] != 62) fail("slot 2 should get ch10 note +2");
+
+    /* Slot 3 has an instance but nothing loaded: one probe per interval */
+    get_param_calls = 0;
+    for (int i = 0; i < 1000; i++) note_on(3, 60, 0);
+    if (get_param_calls == 0 || get_param_calls > 5)
+        fail("inactive slot should be probed once per interval, not per event");
+    if (find(3, MOVE_MIDI_SOURCE_EXTERNAL)) fail("empty slot got MIDI");
+
+    /* Something gets loaded; the next probe window activates the slot */
+    loaded[3] = "synth";
+    for (int t = 0; t < 8; t++) shadow_external_dispatch_tick();
+    reset_calls();
+    note_on(3, 60, 0);
+    if (!slots[3].active || ui_updates != 1) fail("lazy activation");
+    if (!find(3, MOVE_MIDI_SOURCE_EXTERNAL) || !find(3, MOVE_MIDI_SOURCE_FX_BROADCAST))
+        fail("newly active slot should get the event that activated it");
+
+    /* Config changes are picked up at the next frame tick */
+    slots[0].channel = 7;
+    reset_calls();
+    note_on(7, 60, 0);
+    if (find(0, MOVE_MIDI_SOURCE_EXTERNAL)) fail("table changed before the frame tick");
+    shadow_external_dispatch_tick();
+    reset_calls();
+    note_on(7, 60, 0);
+    if (!find(0, MOVE_MIDI_SOURCE_EXTERNAL)) fail("receive channel change not picked up");
+    reset_calls();
+    note_on(0, 60, 0);
+    if (find(0, MOVE_MIDI_SOURCE_EXTERNAL)) fail("old receive channel still routed");
+
+    /* Dense stream cost, all slots active */
+    const int n = 2000000;
+    double t0 = now_s();
+    for (int i = 0; i < n; i++) {
+        reset_calls();
+        note_on((uint8_t)(i & 15), 60, 1);
+    }
+    double dt = now_s() - t0;
+    printf("dispatch: %.0f ns/event (4 slots, plugin calls included)\n", dt * 1e9 / n);
+
+    printf("PASS: MIDI routing table dispatches and refreshes correctly\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+/* Timestamp -> sample offset estimator test for src/host/shadow_midi_timing.c.
+ *
+ * Simulates an XMOS clock of unknown rate and phase against SPI blocks:
+ * an event at tick t happens in block j = floor((t - phase) / rate) at
+ * offset frac * 128 and is seen by the shim in block j + 1. Events arrive
+ * at 40/s (MIDI clock at 120 BPM alone is 48/s). Once ten seconds have
+ * gone by the estimator must place nearly all events within a couple of
+ * frames, through timestamp wraparound and a clock reset. */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/shadow_midi_timing.h"
+
+#define FRAMES 128
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static uint32_t rng = 777;
+static double urand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (double)rng / 4294967296.0;
+}
+
+/* Returns the worst error (frames) over events after the first 10 seconds */
+static int run(double rate, double phase, uint32_t ts0, double events_per_sec,
+               double seconds, double *p95_out) {
+    midi_ts_clock_t c;
+    midi_ts_clock_reset(&c);
+    double t = 0.0;
+    int worst = 0, n = 0, n_bad = 0;
+    double blocks_per_sec = 44100.0 / FRAMES;
+    while (t < seconds * blocks_per_sec * rate) {
+        t += -log(1.0 - urand()) * rate * blocks_per_sec / events_per_sec;
+        double b = (t - phase) / rate;
+        if (b < 0) continue;
+        uint32_t j = (uint32_t)floor(b);
+        int truth = (int)((b - j) * FRAMES);
+        uint32_t ts = ts0 + (uint32_t)(uint64_t)t;
+        int got = midi_ts_clock_offset(&c, ts, j + 1, FRAMES);
+        if (got < 0 || got >= FRAMES) fail("offset out of range");
+        if (t < 10.0 * blocks_per_sec * rate) continue;
+        int err = abs(got - truth);
+        if (err > FRAMES / 2) err = FRAMES - err;  /* wrapped across a boundary */
+        if (err > worst) worst = err;
+        if (err > 2) n_bad++;
+        n++;
+    }
+    *p95_out = n ? 100.0 * (n - n_bad) / n : 0.0;
+    return worst;
+}
+
+int main(void) {
+    struct { const char *name; double rate; uint32_t ts0; } clocks[] = {
+        { "us clock", 1e6 * FRAMES / 44100.0, 1000 },
+        { "sample clock", FRAMES, 5 },
+        { "us clock, wraps", 1e6 * FRAMES / 44100.0, 0xFFFFFFFFu - 20000000u },
+        { "48k sample clock, drifting", 128.0 * 48000.0 / 44100.0 * 1.0001, 0 },
+    };
+    for (size_t i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++) {
+        double within2;
+        int worst = run(clocks[i].rate, urand() * clocks[i].rate * 50, clocks[i].ts0, 40.0, 120.0, &within2);
+        printf("%-28s worst=%d frames, %.1f%% within 2 frames\n", clocks[i].name, worst, within2);
+        if (within2 < 90.0) fail("offsets not sample accurate");
+        if (worst > 8) fail("offset error too large");
+    }
+
+    /* Before calibration: offset 0 (the old dispatch-on-arrival behaviour) */
+    midi_ts_clock_t c;
+    midi_ts_clock_reset(&c);
+    for (uint32_t b = 0; b < 100; b++)
+        if (midi_ts_clock_offset(&c, 1000 + b * 2902, b, FRAMES) != 0)
+            fail("uncalibrated offset should be 0");
+
+    /* A timestamp going backwards (XMOS reset) re-anchors instead of
+     * producing garbage */
+    for (uint32_t b = 100; b < 1000; b++) midi_ts_clock_offset(&c, 1000 + b * 2902, b, FRAMES);
+    if (midi_ts_clock_offset(&c, 10, 1000, FRAMES) != 0 || c.state != 1)
+        fail("clock reset not detected");
+
+    printf("PASS: MIDI timestamps map to sample offsets\n");
+    return 0;
+}
@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_midi_timing"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 -Isrc \
+  tests/host/test_midi_timing.c src/host/shadow_midi_timing.c \
+  -o "$bin" -lm
+
+"$bin"
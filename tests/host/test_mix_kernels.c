@@ -0,0 +1,237 @@
+/* Correctness check and micro-benchmark for src/host/shadow_mix.c.
+ *
+ * Every kernel is compared against a plain per-sample reference (the loops
+ * it replaced in schwung_shim.c). The benchmark then times one mix_buf-like
+ * frame — four fading slots into the ME bus, clamp, master-volume sum and
+ * silence checks — with the kernels and with the legacy scalar loops.
+ *
+ * Build twice (default scalar and -DSHADOW_MIX_ENABLE_NEON) to compare the
+ * opt-in NEON kernels with scalar on the device; see test_mix_kernels.sh. */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host/shadow_mix.h"
+
+#define FRAMES 128
+#define N (FRAMES * 2)
+#define SLOTS 4
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static int16_t sat16(int64_t v) {
+    return v > 32767 ? 32767 : v < -32768 ? -32768 : (int16_t)v;
+}
+
+static uint32_t rng = 0x12345678u;
+static int16_t rand16(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return (int16_t)(rng >> 16);
+}
+
+static void fill(int16_t *buf, int n) {
+    for (int i = 0; i < n; i++) buf[i] = rand16();
+    /* Edge values the saturating paths must handle */
+    buf[0] = 32767; buf[1] = -32768; buf[2] = -32768; buf[3] = 0;
+}
+
+static void expect_close16(const int16_t *a, const int16_t *b, int n, int tol, const char *what) {
+    for (int i = 0; i < n; i++) {
+        if (abs((int)a[i] - (int)b[i]) > tol) {
+            fprintf(stderr, "FAIL: %s mismatch at %d: %d vs %d\n", what, i, a[i], b[i]);
+            exit(1);
+        }
+    }
+}
+
+static void expect_close32(const int32_t *a, const int32_t *b, int n, int tol, const char *what) {
+    for (int i = 0; i < n; i++) {
+        if (abs(a[i] - b[i]) > tol) {
+            fprintf(stderr, "FAIL: %s mismatch at %d: %d vs %d\n", what, i, a[i], b[i]);
+            exit(1);
+        }
+    }
+}
+
+/* Legacy fade envelope (shadow_fade_advance) */
+static void fade_advance(float *g, float target, float step) {
+    if (*g < target) { *g += step; if (*g > target) *g = target; }
+    else if (*g > target) { *g -= step; if (*g < target) *g = target; }
+}
+
+static void check_kernels(void) {
+    int16_t a[N], b[N], ref[N], out[N];
+    int32_t a32[N], ref32[N], out32[N];
+    float f[N];
+
+    fill(a, N);
+    fill(b, N);
+
+    memcpy(ref, a, sizeof(ref));
+    for (int i = 0; i < N; i++) ref[i] = sat16((int32_t)ref[i] + b[i]);
+    memcpy(out, a, sizeof(out));
+    shadow_mix_add_sat_i16(out, b, N);
+    expect_close16(out, ref, N, 0, "add_sat_i16");
+
+    for (int i = 0; i < N; i++) ref[i] = sat16((int32_t)a[i] + lroundf((float)b[i] * 0.73f));
+    memcpy(out, a, sizeof(out));
+    shadow_mix_add_gain_sat_i16(out, b, 0.73f, N);
+    expect_close16(out, ref, N, 1, "add_gain_sat_i16");
+
+    for (int i = 0; i < N; i++) ref[i] = sat16(lroundf((float)b[i] * 1.7f));
+    shadow_mix_scale_i16(out, b, 1.7f, N);
+    expect_close16(out, ref, N, 1, "scale_i16");
+    memcpy(out, b, sizeof(out));
+    shadow_mix_scale_i16(out, out, 1.7f, N);
+    expect_close16(out, ref, N, 1, "scale_i16 in place");
+
+    for (int i = 0; i < N; i++) a32[i] = (int32_t)a[i] * 3;
+    for (int i = 0; i < N; i++) ref[i] = sat16((int64_t)b[i] + a32[i]);
+    memcpy(out, b, sizeof(out));
+    shadow_mix_add_i32_sat_i16(out, a32, N);
+    expect_close16(out, ref, N, 0, "add_i32_sat_i16");
+
+    for (int i = 0; i < N; i++) ref[i] = sat16(a32[i]);
+    shadow_mix_clamp_i32_to_i16(out, a32, N);
+    expect_close16(out, ref, N, 0, "clamp_i32_to_i16");
+
+    for (int i = 0; i < N; i++) ref32[i] = a32[i] + b[i];
+    memcpy(out32, a32, sizeof(out32));
+    shadow_mix_add_i16_to_i32(out32, b, N);
+    expect_close32(out32, ref32, N, 0, "add_i16_to_i32");
+
+    for (int i = 0; i < N; i++) ref32[i] = a32[i] * 2;
+    memcpy(out32, a32, sizeof(out32));
+    shadow_mix_add_i32(out32, a32, N);
+    expect_close32(out32, ref32, N, 0, "add_i32");
+
+    /* Fade ramps: up, down, finishing mid-block, steady */
+    const float starts[] = { 0.0f, 1.0f, 0.99f, 1.0f };
+    const float targets[] = { 1.0f, 0.0f, 1.0f, 1.0f };
+    for (int t = 0; t < 4; t++) {
+        float g_ref = starts[t];
+        for (int k = 0; k < FRAMES; k++) {
+            float v = 0.8f * g_ref;
+            ref32[k * 2] = lroundf((float)a[k * 2] * v);
+            ref32[k * 2 + 1] = lroundf((float)a[k * 2 + 1] * v);
+            fade_advance(&g_ref, targets[t], 1.0f / 2205.0f);
+        }
+        float g = starts[t];
+        shadow_mix_ramp_scale_i32(out32, a, FRAMES, 0.8f, &g, targets[t], 1.0f / 2205.0f);
+        expect_close32(out32, ref32, N, 1, "ramp_scale_i32");
+        if (fabsf(g - g_ref) > 1e-4f) fail("ramp_scale_i32 final gain drifted");
+        if (targets[t] == 1.0f && starts[t] == 0.99f && g != 1.0f) fail("ramp did not land on target");
+    }
+
+    for (int i = 0; i < N; i++) f[i] = (float)a[i] / 32768.0f;
+    float fo[N];
+    shadow_mix_i16_to_f32(fo, a, N);
+    for (int i = 0; i < N; i++) if (fo[i] != f[i]) fail("i16_to_f32");
+    f[5] = 3.0f; f[6] = -3.0f;
+    shadow_mix_f32_to_i16(out, f, N);
+    if (out[5] != 32767 || out[6] != -32768) fail("f32_to_i16 does not saturate");
+    for (int i = 7; i < N; i++) if (out[i] != a[i]) fail("f32_to_i16 round trip");
+
+    for (int i = 0; i < N; i++) ref[i] = sat16((int32_t)b[i] + lroundf(f[i] * 20000.0f));
+    memcpy(out, b, sizeof(out));
+    shadow_mix_add_f32_gain_sat_i16(out, f, 20000.0f, N);
+    expect_close16(out, ref, N, 1, "add_f32_gain_sat_i16");
+
+    if (shadow_mix_peak_i16(a, N) != 32768) fail("peak_i16 missed -32768");
+    int16_t quiet[N];
+    for (int i = 0; i < N; i++) quiet[i] = (int16_t)((i % 9) - 4);
+    if (shadow_mix_peak_i16(quiet, N) != 4) fail("peak_i16 on quiet block");
+    if (!shadow_mix_is_silent_i16(quiet, N, 4)) fail("is_silent_i16 false negative");
+    if (shadow_mix_is_silent_i16(quiet, N, 3)) fail("is_silent_i16 false positive");
+    quiet[N - 1] = -5;
+    if (shadow_mix_is_silent_i16(quiet, N, 4)) fail("is_silent_i16 missed tail sample");
+}
+
+/* ---- Benchmark: one mix_buf-shaped frame ---- */
+
+static int16_t slot_buf[SLOTS][N];
+static int16_t mailbox[N];
+static volatile int sink;
+
+static void frame_legacy(float *gains, float mv) {
+    int32_t me_full[N], me_unity[N];
+    memset(me_full, 0, sizeof(me_full));
+    memset(me_unity, 0, sizeof(me_unity));
+    for (int s = 0; s < SLOTS; s++) {
+        int silent = 1;
+        for (int i = 0; i < N; i++) {
+            if (slot_buf[s][i] > 8 || slot_buf[s][i] < -8) { silent = 0; break; }
+        }
+        sink += silent;
+        for (int i = 0; i < N; i++) {
+            float vol = 0.9f * gains[s];
+            int32_t contrib = (int32_t)lroundf((float)slot_buf[s][i] * vol);
+            me_full[i] += contrib;
+            me_unity[i] += contrib;
+            if (i & 1) fade_advance(&gains[s], s & 1 ? 0.0f : 1.0f, 1.0f / 2205.0f);
+        }
+    }
+    int16_t me_i16[N];
+    for (int i = 0; i < N; i++) me_i16[i] = sat16(me_unity[i]);
+    for (int i = 0; i < N; i++) {
+        int32_t summed = (int32_t)mailbox[i] + (int32_t)lroundf((float)me_i16[i] * mv);
+        mailbox[i] = sat16(summed);
+    }
+    sink += me_full[7];
+}
+
+static void frame_kernels(float *gains, float mv) {
+    int32_t me_full[N], me_unity[N], contrib[N];
+    memset(me_full, 0, sizeof(me_full));
+    memset(me_unity, 0, sizeof(me_unity));
+    for (int s = 0; s < SLOTS; s++) {
+        sink += shadow_mix_is_silent_i16(slot_buf[s], N, 8);
+        shadow_mix_ramp_scale_i32(contrib, slot_buf[s], FRAMES, 0.9f, &gains[s],
+                                  s & 1 ? 0.0f : 1.0f, 1.0f / 2205.0f);
+        shadow_mix_add_i32(me_full, contrib, N);
+        shadow_mix_add_i32(me_unity, contrib, N);
+    }
+    int16_t me_i16[N];
+    shadow_mix_clamp_i32_to_i16(me_i16, me_unity, N);
+    shadow_mix_add_gain_sat_i16(mailbox, me_i16, mv, N);
+    sink += me_full[7];
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double bench(void (*fn)(float *, float), int iters) {
+    float gains[SLOTS] = { 0.0f, 1.0f, 0.5f, 1.0f };
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        /* Restart the fades now and then so ramps stay in the mix */
+        if ((it & 255) == 0) { gains[0] = 0.0f; gains[1] = 1.0f; }
+        memset(mailbox, 0, sizeof(mailbox));
+        fn(gains, 0.7f);
+    }
+    return (now_ns() - t0) / iters;
+}
+
+int main(int argc, char **argv) {
+    check_kernels();
+
+    int iters = (argc > 1) ? atoi(argv[1]) : 20000;
+    for (int s = 0; s < SLOTS; s++) fill(slot_buf[s], N);
+
+    bench(frame_legacy, iters / 10 + 1);   /* warm up */
+    double legacy = bench(frame_legacy, iters);
+    double kern = bench(frame_kernels, iters);
+    printf("PASS: shadow_mix kernels (%s) match reference loops\n", shadow_mix_impl());
+    printf("  mix frame (%d slots, %d frames): legacy %.0f ns, kernels %.0f ns (%.2fx)\n",
+           SLOTS, FRAMES, legacy, kern, kern > 0 ? legacy / kern : 0.0);
+    return 0;
+}
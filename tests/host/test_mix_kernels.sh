@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_mix_kernels"
+mkdir -p "$(dirname "$bin")"
+
+# Default (scalar) build and the opt-in NEON build (scalar again off aarch64)
+for variant in default neon; do
+  defs=""
+  [ "$variant" = "neon" ] && defs="-DSHADOW_MIX_ENABLE_NEON"
+  cc -std=gnu11 -Wall -Wextra -Werror -O3 $defs \
+    -Isrc \
+    tests/host/test_mix_kernels.c \
+    src/host/shadow_mix.c \
+    -o "$bin-$variant" \
+    -lm
+  "$bin-$variant" "${MIX_BENCH_ITERS:-20000}"
+done
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host/shadow_patch_loader.h"
+
+#define FAIL_PATCH 99
+
+static int g_created;
+static int g_destroyed;
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static int fake_build(int slot, int patch_index, patch_loader_result_t *out) {
+    (void)slot;
+    /* Take long enough that back-to-back requests overlap a build */
+    usleep(2000);
+    if (patch_index == FAIL_PATCH) return -1;
+    int *inst = malloc(sizeof(int));
+    if (!inst) return -1;
+    *inst = patch_index;
+    __atomic_add_fetch(&g_created, 1, __ATOMIC_RELAXED);
+    out->instance = inst;
+    snprintf(out->patch_name, sizeof(out->patch_name), "Patch %d", patch_index);
+    out->receive_channel = patch_index % 17;
+    return 0;
+}
+
+static void fake_destroy(void *instance) {
+    free(instance);
+    __atomic_add_fetch(&g_destroyed, 1, __ATOMIC_RELAXED);
+}
+
+/* Poll like the SPI thread would, ~one frame at a time */
+static patch_loader_result_t *wait_take(int slot) {
+    for (int i = 0; i < 2000; i++) {
+        if (patch_loader_ready(slot)) {
+            patch_loader_result_t *r = patch_loader_take(slot);
+            if (r) return r;
+        }
+        usleep(1000);
+    }
+    return NULL;
+}
+
+static void wait_destroyed(int expected) {
+    for (int i = 0; i < 2000; i++) {
+        if (__atomic_load_n(&g_destroyed, __ATOMIC_RELAXED) == expected) return;
+        usleep(1000);
+    }
+    fail("retired instances were not destroyed");
+}
+
+int main(void) {
+    patch_loader_host_t host = {
+        .log = NULL,
+        .build = fake_build,
+        .destroy = fake_destroy,
+    };
+    patch_loader_init(&host);
+    if (patch_loader_running()) fail("running before start");
+    if (patch_loader_start() != 0) fail("start failed");
+
+    /* Plain load: result carries the built instance and metadata */
+    patch_loader_request(0, 3);
+    if (!patch_loader_pending(0)) fail("request not pending");
+    patch_loader_result_t *r = wait_take(0);
+    if (!r) fail("build never became ready");
+    if (!r->ok || r->patch_index != 3 || *(int *)r->instance != 3) fail("wrong result for slot 0");
+    if (strcmp(r->patch_name, "Patch 3") != 0) fail("patch name not carried");
+    if (r->forward_channel != PATCH_LOADER_CHANNEL_ABSENT) fail("forward channel default");
+    if (r->default_forward_channel != PATCH_LOADER_CHANNEL_ABSENT) fail("default forward channel default");
+    if (patch_loader_pending(0)) fail("still pending after take");
+    void *slot0 = r->instance;
+    patch_loader_release(r, NULL);
+
+    /* Rapid re-requests: only the newest patch may ever be swapped in */
+    for (int p = 1; p <= 8; p++) {
+        patch_loader_request(1, p);
+        usleep(500);
+    }
+    r = wait_take(1);
+    if (!r || r->patch_index != 8) fail("superseded build was delivered");
+    void *slot1 = r->instance;
+    patch_loader_release(r, NULL);
+
+    /* Swap slot 0 again; the old instance goes back for deferred destroy */
+    patch_loader_request(0, 4);
+    r = wait_take(0);
+    if (!r || r->patch_index != 4) fail("second load on slot 0");
+    void *old = slot0;
+    slot0 = r->instance;
+    patch_loader_release(r, old);
+
+    /* Cancel: nothing may be delivered */
+    patch_loader_request(2, 5);
+    patch_loader_request(2, -1);
+    usleep(20000);
+    if (patch_loader_ready(2) || patch_loader_take(2)) fail("cancelled build delivered");
+    if (patch_loader_pending(2)) fail("cancel left request pending");
+
+    /* Failed build is reported, not swallowed */
+    patch_loader_request(3, FAIL_PATCH);
+    r = wait_take(3);
+    if (!r || r->ok || r->instance) fail("failed build not reported");
+    patch_loader_release(r, r->instance);
+
+    /* A burst of retirements faster than the loader drains must not leak */
+    for (int i = 0; i < 64; i++) {
+        patch_loader_result_t *burst = calloc(1, sizeof(*burst));
+        int *inst = malloc(sizeof(int));
+        if (!burst || !inst) fail("alloc");
+        __atomic_add_fetch(&g_created, 1, __ATOMIC_RELAXED);
+        patch_loader_release(burst, inst);
+    }
+
+    /* Everything built except the two live slot instances must be destroyed */
+    wait_destroyed(__atomic_load_n(&g_created, __ATOMIC_RELAXED) - 2);
+    if (*(int *)slot0 != 4 || *(int *)slot1 != 8) fail("live instance clobbered");
+
+    printf("PASS: patch loader (%d built, %d destroyed)\n", g_created, g_destroyed);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_patch_loader"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 \
+  -Isrc \
+  tests/host/test_patch_loader.c \
+  src/host/shadow_patch_loader.c \
+  -o "$bin" \
+  -lpthread
+
+"$bin"
@@ -0,0 +1,59 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+CFLAGS="-g -O2" bash scripts/build-render-harness.sh >/dev/null
+
+out="build/render-harness/test"
+mkdir -p "$out"
+harness="build/render-harness/bin/render_harness"
+modules="build/render-harness/modules"
+
+cat > "$out/notes.txt" <<'EOF'
+# frame-or-seconds  status data...
+0       90 3c 64
+0.25s   80 3c 00
+300     b0 07 7f
+EOF
+
+# Tone through linein + freeverb, two slots, with a MIDI script
+"$harness" --modules "$modules" --synth linein --fx1 freeverb \
+  --param fx1:wet=0.4 --tone 440 --seconds 0.5 --slots 2 \
+  --midi "$out/notes.txt" --out "$out/tone.wav" --csv "$out/tone.csv" > "$out/tone.txt"
+
+grep -q "split (external_fx_mode + chain_process_fx)" "$out/tone.txt" || {
+  echo "FAIL: harness did not use the split synth/FX path" >&2; cat "$out/tone.txt" >&2; exit 1; }
+grep -q "midi events: 3 in" "$out/tone.txt" || {
+  echo "FAIL: MIDI script not dispatched" >&2; cat "$out/tone.txt" >&2; exit 1; }
+for stage in midi synth fx mix total; do
+  grep -Eq "^  $stage +[0-9]" "$out/tone.txt" || {
+    echo "FAIL: no $stage timing row" >&2; cat "$out/tone.txt" >&2; exit 1; }
+done
+
+# 0.5 s -> 173 blocks -> 22144 frames -> 88576 data bytes + 44 header
+size=$(wc -c < "$out/tone.wav")
+if [ "$size" -ne 88620 ]; then
+  echo "FAIL: unexpected output WAV size $size" >&2
+  exit 1
+fi
+[ "$(wc -l < "$out/tone.csv")" -eq 174 ] || { echo "FAIL: CSV row count" >&2; exit 1; }
+if cmp -s <(tail -c 88576 "$out/tone.wav") <(head -c 88576 /dev/zero); then
+  echo "FAIL: rendered output is silent" >&2
+  exit 1
+fi
+
+# Round-trip the render as WAV input; an impossible budget must fail with 2
+set +e
+"$harness" --modules "$modules" --synth linein --in "$out/tone.wav" \
+  --out "$out/again.wav" --budget-us 0.001 > "$out/again.txt" 2>&1
+rc=$?
+set -e
+if [ "$rc" -ne 2 ]; then
+  echo "FAIL: --budget-us did not fail the run (rc=$rc)" >&2
+  cat "$out/again.txt" >&2
+  exit 1
+fi
+[ "$(wc -c < "$out/again.wav")" -eq 88620 ] || { echo "FAIL: --in length not honoured" >&2; exit 1; }
+
+echo "PASS: render harness renders chain offline and reports stage timings"
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/shadow_render_pool.h"
+
+#define JOBS 4
+#define BATCHES 20000
+
+static int g_hits[JOBS];
+static unsigned g_batch_tag[JOBS];
+static unsigned g_current_batch;
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static void job(void *ctx, int j) {
+    unsigned batch = *(unsigned *)ctx;
+    if (j < 0 || j >= JOBS) fail("job index out of range");
+    /* A job from a stale batch would carry the wrong tag */
+    g_batch_tag[j] = batch;
+    g_hits[j]++;
+    /* Burn a little time so workers actually overlap with the caller */
+    volatile int spin = 0;
+    for (int i = 0; i < 2000; i++) spin += i;
+}
+
+int main(void) {
+    render_pool_host_t host = { .log = NULL };
+    render_pool_init(&host);
+
+    /* Serial fallback before the pool is started */
+    unsigned tag = 1;
+    render_pool_run(job, &tag, JOBS);
+    for (int j = 0; j < JOBS; j++) {
+        if (g_hits[j] != 1) fail("serial fallback did not run every job once");
+    }
+
+    if (render_pool_start(RENDER_POOL_MAX_WORKERS) <= 0) fail("no workers started");
+
+    memset(g_hits, 0, sizeof(g_hits));
+    for (g_current_batch = 2; g_current_batch < BATCHES + 2; g_current_batch++) {
+        tag = g_current_batch;
+        render_pool_run(job, &tag, JOBS);
+        for (int j = 0; j < JOBS; j++) {
+            if (g_batch_tag[j] != g_current_batch) fail("job missing or from wrong batch after join");
+        }
+    }
+    for (int j = 0; j < JOBS; j++) {
+        if (g_hits[j] != BATCHES) fail("job ran wrong number of times");
+    }
+
+    render_pool_stats_t st;
+    render_pool_take_stats(&st);
+    if (st.jobs_worker + st.jobs_caller != (unsigned)(JOBS * BATCHES)) {
+        fail("stats do not account for every job");
+    }
+
+    render_pool_stop();
+    if (render_pool_worker_count() != 0) fail("workers still running after stop");
+
+    printf("PASS: render pool runs every job exactly once per batch (worker=%u caller=%u)\n",
+           st.jobs_worker, st.jobs_caller);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_render_pool"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 \
+  -Isrc \
+  tests/host/test_render_pool.c \
+  src/host/shadow_render_pool.c \
+  -o "$bin" \
+  -lpthread
+
+"$bin"
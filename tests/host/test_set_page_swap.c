@@ -0,0 +1,163 @@
+/* Page swap and crash recovery check for src/host/shadow_set_pages.c.
+ *
+ * A switch must move the whole Sets/ directory in and out of
+ * set_pages/page_N/Sets (sets intact, current page persisted, no journal
+ * left behind), gather stashes in the old one-dir-per-set layout, and
+ * set_pages_init() must settle a switch journal left at each point a crash
+ * could interrupt it. SET_PAGES_DIR and SAMPLER_SETS_DIR point into
+ * build/tests (see test_set_page_swap.sh). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "host/shadow_set_pages.h"
+#include "host/shadow_sampler.h"
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static void test_log(const char *msg) { (void)msg; }
+
+static void mkdir_p(const char *path) {
+    char buf[512];
+    snprintf(buf, sizeof(buf), "%s", path);
+    for (char *p = buf + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(buf, 0755);
+        *p = '/';
+    }
+    mkdir(buf, 0755);
+}
+
+/* Only mkdir -p matters here; chown to ableton is skipped */
+static int test_run_command(const char *const argv[]) {
+    if (strcmp(argv[0], "mkdir") == 0 && argv[1] && argv[2]) mkdir_p(argv[2]);
+    return 0;
+}
+
+static void make_set(const char *dir, const char *uuid) {
+    char path[768];
+    snprintf(path, sizeof(path), "%s/%s/My Set", dir, uuid);
+    mkdir_p(path);
+    snprintf(path, sizeof(path), "%s/%s/My Set/Song.abl", dir, uuid);
+    FILE *f = fopen(path, "w");
+    if (!f) fail("cannot create Song.abl");
+    fputs(uuid, f);
+    fclose(f);
+}
+
+static int has_set(const char *dir, const char *uuid) {
+    char path[768];
+    snprintf(path, sizeof(path), "%s/%s/My Set/Song.abl", dir, uuid);
+    return access(path, F_OK) == 0;
+}
+
+static int count_entries(const char *dir) {
+    char cmd[600];
+    snprintf(cmd, sizeof(cmd), "ls -A '%s' 2>/dev/null | wc -l", dir);
+    FILE *p = popen(cmd, "r");
+    int n = -1;
+    if (p) {
+        if (fscanf(p, "%d", &n) != 1) n = -1;
+        pclose(p);
+    }
+    return n;
+}
+
+static void expect_page(int page, const char *what) {
+    if (set_page_read_persisted() != page) fail(what);
+    if (access(SET_PAGES_JOURNAL_PATH, F_OK) == 0) fail("journal left behind");
+}
+
+/* Journal as set_page_swap() writes it, naming page_<new>/Sets by inode */
+static void write_journal(int old_page, int new_page) {
+    char sets[512];
+    struct stat st;
+    unsigned long long ino = 0;
+    snprintf(sets, sizeof(sets), SET_PAGES_DIR "/page_%d/Sets", new_page);
+    if (stat(sets, &st) == 0) ino = (unsigned long long)st.st_ino;
+    FILE *f = fopen(SET_PAGES_JOURNAL_PATH, "w");
+    if (!f) fail("cannot write journal");
+    fprintf(f, "%d %d %llu\n", old_page, new_page, ino);
+    fclose(f);
+}
+
+int main(void) {
+    set_pages_host_t h = {
+        .log = test_log,
+        .run_command = test_run_command,
+    };
+
+    mkdir_p(SAMPLER_SETS_DIR);
+    mkdir_p(SET_PAGES_DIR);
+    make_set(SAMPLER_SETS_DIR, "aaaa");
+    make_set(SAMPLER_SETS_DIR, "bbbb");
+    set_pages_init(&h);
+
+    /* Page 1 -> never-used page 2: empty Sets/, page 1 stashed whole */
+    if (set_page_swap(0, 1) != 0) fail("swap 0 -> 1");
+    if (count_entries(SAMPLER_SETS_DIR) != 0) fail("new page not empty");
+    if (!has_set(SET_PAGES_DIR "/page_0/Sets", "aaaa") ||
+        !has_set(SET_PAGES_DIR "/page_0/Sets", "bbbb")) fail("page 0 not stashed");
+    expect_page(1, "page 1 not persisted");
+
+    /* And back, with a set made on page 2 */
+    make_set(SAMPLER_SETS_DIR, "cccc");
+    if (set_page_swap(1, 0) != 0) fail("swap 1 -> 0");
+    if (!has_set(SAMPLER_SETS_DIR, "aaaa") || !has_set(SAMPLER_SETS_DIR, "bbbb") ||
+        count_entries(SAMPLER_SETS_DIR) != 2) fail("page 0 not restored");
+    if (!has_set(SET_PAGES_DIR "/page_1/Sets", "cccc")) fail("page 1 not stashed");
+    if (access(SET_PAGES_DIR "/page_0/Sets", F_OK) == 0) fail("page 0 stash left behind");
+    expect_page(0, "page 0 not persisted");
+
+    /* A stash in the old layout (sets directly in page_2/) is adopted */
+    make_set(SET_PAGES_DIR "/page_2", "dddd");
+    if (set_page_swap(0, 2) != 0) fail("swap 0 -> 2");
+    if (!has_set(SAMPLER_SETS_DIR, "dddd") || count_entries(SAMPLER_SETS_DIR) != 1)
+        fail("legacy stash not installed");
+    expect_page(2, "page 2 not persisted");
+
+    /* Crash after the first rename: Sets/ missing, switch is finished */
+    write_journal(2, 1);
+    if (rename(SAMPLER_SETS_DIR, SET_PAGES_DIR "/page_2/Sets") != 0) fail("setup rename");
+    set_pages_init(&h);
+    if (!has_set(SAMPLER_SETS_DIR, "cccc")) fail("half switch not finished");
+    if (!has_set(SET_PAGES_DIR "/page_2/Sets", "dddd")) fail("page 2 stash lost");
+    expect_page(1, "recovered page not persisted");
+
+    /* Crash before any rename: nothing moved, stay put */
+    write_journal(1, 3);
+    set_pages_init(&h);
+    if (!has_set(SAMPLER_SETS_DIR, "cccc")) fail("untouched switch changed Sets/");
+    expect_page(1, "untouched switch changed page");
+
+    /* Crash after both renames, before the page was persisted */
+    write_journal(1, 0);
+    if (rename(SAMPLER_SETS_DIR, SET_PAGES_DIR "/page_1/Sets") != 0 ||
+        rename(SET_PAGES_DIR "/page_0/Sets", SAMPLER_SETS_DIR) != 0) fail("setup renames");
+    set_pages_init(&h);
+    if (!has_set(SAMPLER_SETS_DIR, "aaaa")) fail("completed switch undone");
+    expect_page(0, "completed switch not persisted");
+
+    /* Crash after the first rename, then Move made a fresh Sets/ and saved
+     * a set into it: the new page is still installed, keeping that set */
+    write_journal(0, 1);
+    if (rename(SAMPLER_SETS_DIR, SET_PAGES_DIR "/page_0/Sets") != 0) fail("setup rename");
+    mkdir_p(SAMPLER_SETS_DIR);
+    make_set(SAMPLER_SETS_DIR, "eeee");
+    set_pages_init(&h);
+    if (!has_set(SAMPLER_SETS_DIR, "cccc") || !has_set(SAMPLER_SETS_DIR, "eeee") ||
+        count_entries(SAMPLER_SETS_DIR) != 2) fail("recreated Sets/ taken as switched");
+    if (!has_set(SET_PAGES_DIR "/page_0/Sets", "aaaa")) fail("page 0 stash lost");
+    if (access(SET_PAGES_DIR "/page_1/Sets", F_OK) == 0) fail("page 1 stash left behind");
+    expect_page(1, "recreated Sets/ recovery not persisted");
+
+    printf("PASS: set page swap and recovery\n");
+    return 0;
+}
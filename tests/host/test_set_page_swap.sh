@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+dir="$PWD/build/tests/set_pages"
+bin="build/tests/test_set_page_swap"
+rm -rf "$dir"
+mkdir -p "$dir"
+
+cc -std=gnu11 -Wall -Wextra -Werror -Wno-format-truncation -Wno-unused-function -O2 -Isrc \
+  -DSET_PAGES_DIR="\"$dir/set_pages\"" \
+  -DSAMPLER_SETS_DIR="\"$dir/UserLibrary/Sets\"" \
+  tests/host/test_set_page_swap.c src/host/shadow_set_pages.c \
+  -o "$bin" -lpthread
+
+"$bin"
@@ -0,0 +1,89 @@
+/* Background writer check for src/host/shadow_state.c.
+ *
+ * A burst of shadow_save_state() calls must not touch the file from the
+ * caller and must land as a single write once the burst is over;
+ * shadow_flush_state() must write before returning. Fields owned by
+ * shadow_ui.js have to survive every rewrite. SHADOW_CONFIG_PATH points
+ * into build/tests (see test_shadow_state_writer.sh). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host/shadow_state.h"
+
+static shadow_chain_slot_t slots[4];
+static int solo_count;
+static int saves;
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static void test_log(const char *msg) {
+    if (strncmp(msg, "Saved slots:", 12) == 0) __atomic_add_fetch(&saves, 1, __ATOMIC_SEQ_CST);
+}
+
+static int saved(void) {
+    return __atomic_load_n(&saves, __ATOMIC_SEQ_CST);
+}
+
+static char *read_config(void) {
+    static char buf[8192];
+    FILE *f = fopen(SHADOW_CONFIG_PATH, "r");
+    if (!f) fail("config missing");
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = '\0';
+    fclose(f);
+    return buf;
+}
+
+int main(void) {
+    FILE *f = fopen(SHADOW_CONFIG_PATH, "w");
+    if (!f) fail("cannot seed config");
+    fputs("{\n  \"patches\": [{\"name\": \"Keys\", \"channel\": 1}],\n"
+          "  \"master_fx\": \"freeverb\",\n  \"slot_muted\": [0, 0, 0, 0]\n}\n", f);
+    fclose(f);
+
+    for (int i = 0; i < 4; i++) {
+        slots[i].channel = i + 1;
+        slots[i].volume = 1.0f;
+        slots[i].forward_channel = -1;
+    }
+    state_host_t host = { .log = test_log, .chain_slots = slots, .solo_count = &solo_count };
+    state_init(&host);
+
+    /* Mute drumming: 40 toggles, ending muted */
+    for (int i = 0; i < 40; i++) {
+        slots[2].muted = i & 1;
+        shadow_save_state();
+        usleep(2000);
+    }
+    if (saved() != 0) fail("save wrote during the burst");
+    if (!strstr(read_config(), "\"slot_muted\": [0, 0, 0, 0]")) fail("config changed during the burst");
+
+    usleep(600000);
+    if (saved() != 1) fail("burst did not coalesce into one write");
+    char *cfg = read_config();
+    if (!strstr(cfg, "\"slot_muted\": [0, 0, 1, 0]"))
+        fail("last value of the burst not written");
+    if (!strstr(cfg, "\"patches\": [{\"name\": \"Keys\", \"channel\": 1}]") ||
+        !strstr(cfg, "\"master_fx\": \"freeverb\""))
+        fail("fields owned by shadow_ui.js lost");
+
+    /* Flush writes before returning */
+    slots[0].volume = 0.5f;
+    shadow_flush_state();
+    if (saved() != 2) fail("flush did not write");
+    if (!strstr(read_config(), "\"slot_volumes\": [0.500, 1.000, 1.000, 1.000]")) fail("flushed volume missing");
+
+    /* Nothing left for the writer after a flush */
+    usleep(400000);
+    if (saved() != 2) fail("writer rewrote an already flushed state");
+    if (access(SHADOW_CONFIG_PATH ".tmp", F_OK) == 0) fail("tmp file left behind");
+
+    printf("PASS: shadow_save_state coalesces bursts and flushes on demand\n");
+    return 0;
+}
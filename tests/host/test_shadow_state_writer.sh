@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+dir="build/tests/shadow_state"
+bin="build/tests/test_shadow_state_writer"
+mkdir -p "$dir"
+rm -f "$dir"/*
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 -Isrc \
+  -DSHADOW_CONFIG_PATH="\"$dir/shadow_chain_config.json\"" \
+  tests/host/test_shadow_state_writer.c src/host/shadow_state.c \
+  -o "$bin" -lpthread
+
+"$bin"
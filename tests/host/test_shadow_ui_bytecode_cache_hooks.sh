@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ui="src/shadow/shadow_ui.c"
+cache="src/host/js_bytecode_cache.c"
+
+if ! rg -q 'JS_SetModuleLoaderFunc\(rt, NULL, js_bc_module_loader, NULL\)' "$ui"; then
+  echo "FAIL: shadow_ui imports bypass the bytecode cache" >&2
+  exit 1
+fi
+if rg -q 'js_load_file\(' "$ui"; then
+  echo "FAIL: shadow_ui compiles a script from source without the bytecode cache" >&2
+  exit 1
+fi
+if ! rg -q 'strcmp\(argv\[1\], "--precompile"\) == 0' "$ui" ||
+   ! rg -q 'shadow_ui" --precompile' scripts/post-update.sh; then
+  echo "FAIL: UI scripts are not precompiled at host update" >&2
+  exit 1
+fi
+if ! rg -q 'fnv1a64\(src, src_len\)' "$cache" ||
+   ! rg -q 'rename\(tmp, qbc\)' "$cache"; then
+  echo "FAIL: bytecode cache no longer hashes the source or writes atomically" >&2
+  exit 1
+fi
+if ! rg -q 'src/host/js_bytecode_cache.c' scripts/build.sh; then
+  echo "FAIL: build.sh does not link the bytecode cache into shadow_ui" >&2
+  exit 1
+fi
+
+echo "PASS: shadow_ui loads scripts through the bytecode cache"
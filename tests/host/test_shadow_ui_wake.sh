@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_shadow_ui_wake"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 -Isrc \
+  tests/host/test_shadow_ui_wake.c \
+  -o "$bin" -lpthread
+
+"$bin"
@@ -0,0 +1,321 @@
+/* Compressed skipback test: src/host/shadow_skipback_codec.c on its own,
+ * then the compressed history in src/host/shadow_sampler.c end to end.
+ *
+ * Codec: bit-exact round trip on silence, tones, noise and full-scale
+ * extremes; worst case within SKIPBACK_CODEC_MAX_BYTES; garbage input is
+ * rejected without crashing. Prints compression ratio and speed.
+ *
+ * History: frame n carries L = n & 0x7fff and R = either a hash of n (noise,
+ * about half of PCM, which still fits the store) or -L (compresses ~20x).
+ * Either way the length cap binds. Saved WAVs must hold exactly the
+ * expected frames up to the snapshot, across saves during capture and a
+ * resize. */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host/shadow_sampler.h"
+#include "host/shadow_skipback_codec.h"
+
+#define BF SKIPBACK_CODEC_BLOCK_FRAMES
+#define SR SAMPLER_SAMPLE_RATE
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static uint32_t rng = 12345;
+static uint32_t xorshift(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ---- codec ---- */
+
+static size_t roundtrip(const int16_t *pcm, const char *what) {
+    uint8_t enc[SKIPBACK_CODEC_MAX_BYTES + 16];
+    memset(enc, 0xA5, sizeof(enc));
+    size_t len = skipback_codec_encode(pcm, enc);
+    if (len == 0 || len > SKIPBACK_CODEC_MAX_BYTES) {
+        fprintf(stderr, "%s: %zu bytes\n", what, len);
+        fail("encoded size out of range");
+    }
+    for (size_t i = len; i < sizeof(enc); i++)
+        if (enc[i] != 0xA5) fail("encoder wrote past its returned length");
+    int16_t out[BF * 2];
+    if (skipback_codec_decode(enc, len, out) != 0 || memcmp(out, pcm, sizeof(out)) != 0) {
+        fprintf(stderr, "%s\n", what);
+        fail("round trip not bit-exact");
+    }
+    /* Dropping the last whole byte of real data must be caught */
+    if (len > 2 && enc[len - 1] != 0 && skipback_codec_decode(enc, len - 2, out) == 0 &&
+        memcmp(out, pcm, sizeof(out)) == 0)
+        fail("truncated block decoded");
+    return len;
+}
+
+static void test_codec(void) {
+    int16_t b[BF * 2];
+
+    memset(b, 0, sizeof(b));
+    if (roundtrip(b, "silence") > 8) fail("silence should take a few bytes");
+
+    for (int i = 0; i < BF * 2; i++) b[i] = -1234;
+    roundtrip(b, "dc");
+
+    /* Full-scale extremes: alternating rails, opposite channels (side = 65535) */
+    for (int i = 0; i < BF; i++) {
+        b[2 * i] = (i & 1) ? 32767 : -32768;
+        b[2 * i + 1] = (i & 1) ? -32768 : 32767;
+    }
+    roundtrip(b, "rails");
+    for (int i = 0; i < BF; i++) { b[2 * i] = -32768; b[2 * i + 1] = 32767; }
+    roundtrip(b, "max side");
+
+    size_t worst = 0;
+    for (int k = 0; k < 2000; k++) {
+        for (int i = 0; i < BF * 2; i++) b[i] = (int16_t)xorshift();
+        size_t len = roundtrip(b, "white noise");
+        if (len > worst) worst = len;
+    }
+
+    /* Music-ish: three partials with an envelope, a little noise, some width */
+    size_t music_bytes = 0;
+    int music_blocks = 0;
+    double t0 = now_s();
+    for (int blk = 0; blk < 3000; blk++) {
+        for (int i = 0; i < BF; i++) {
+            double t = (double)(blk * BF + i) / SR;
+            double env = 0.5 + 0.5 * sin(2 * M_PI * 0.7 * t);
+            double m = env * (9000 * sin(2 * M_PI * 220 * t) + 4000 * sin(2 * M_PI * 331 * t) +
+                              2000 * sin(2 * M_PI * 1470 * t));
+            double n = (double)((int)(xorshift() % 201) - 100);
+            b[2 * i] = (int16_t)lrint(m + n + 800 * sin(2 * M_PI * 97 * t));
+            b[2 * i + 1] = (int16_t)lrint(m - n);
+        }
+        music_bytes += roundtrip(b, "music");
+        music_blocks++;
+    }
+    double dt = now_s() - t0;
+    double ratio = (double)music_bytes / (music_blocks * BF * 4.0);
+    printf("codec: music-ish %.1f%% of PCM, noise worst %zu bytes, %.0fx realtime (enc+dec)\n",
+           ratio * 100, worst, (music_blocks * (double)BF / SR) / dt);
+    if (ratio > 0.6) fail("music-ish signal should land within the 45-60% the header promises");
+
+    /* Garbage must be rejected or decoded into range, never crash */
+    int16_t out[BF * 2];
+    uint8_t junk[SKIPBACK_CODEC_MAX_BYTES];
+    for (int k = 0; k < 20000; k++) {
+        size_t len = 1 + xorshift() % sizeof(junk);
+        for (size_t i = 0; i < len; i++) junk[i] = (uint8_t)xorshift();
+        skipback_codec_decode(junk, len, out);
+    }
+    if (skipback_codec_decode(junk, 0, out) != -1) fail("empty input accepted");
+}
+
+/* ---- compressed history through shadow_sampler.c ---- */
+
+static char saved_path[512];
+static volatile int save_finished = 0;
+
+static void stub_log(const char *msg) {
+    if (sscanf(msg, "Skipback: saved %511s", saved_path) == 1) return;
+    if (strstr(msg, "not captured") || strstr(msg, "failed to decode")) {
+        fprintf(stderr, "%s\n", msg);
+        fail("unexpected skipback loss");
+    }
+}
+
+static void stub_announce(const char *msg) {
+    if (!strcmp(msg, "Skipback saved") || !strcmp(msg, "Skipback failed") ||
+        !strcmp(msg, "No audio captured yet"))
+        __atomic_store_n(&save_finished, 1, __ATOMIC_RELEASE);
+}
+
+static void stub_overlay_sync(void) {}
+
+static int stub_run_command(const char *const argv[]) {
+    if (!strcmp(argv[0], "mkdir")) {
+        char cmd[600];
+        snprintf(cmd, sizeof(cmd), "mkdir -p '%s'", argv[2]);
+        if (system(cmd) != 0) return -1;
+    }
+    return 0;
+}
+
+static uint32_t next_frame = 0;
+static uint32_t noise_until = 0;   /* frames below this carry noise in R */
+
+static uint32_t hash32(uint32_t x) {
+    x ^= x >> 16; x *= 0x7feb352dU;
+    x ^= x >> 15; x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+static int16_t expect_r(uint32_t n) {
+    return n < noise_until ? (int16_t)hash32(n) : (int16_t)-(int16_t)(n & 0x7fff);
+}
+
+static void push_block(void) {
+    int16_t block[BF * 2];
+    for (int i = 0; i < BF; i++) {
+        uint32_t n = next_frame++;
+        block[2 * i] = (int16_t)(n & 0x7fff);
+        block[2 * i + 1] = expect_r(n);
+    }
+    skipback_capture(block);
+}
+
+/* Capture paced well above realtime, but slow enough for the encoder */
+static void push_seconds(double secs) {
+    int blocks = (int)(secs * SR / BF);
+    for (int i = 0; i < blocks; i++) {
+        push_block();
+        usleep(40);
+    }
+}
+
+/* Check the saved WAV is exactly frames [end - frames, end). Returns frames. */
+static uint32_t check_wav(uint32_t end, const char *what) {
+    FILE *f = fopen(saved_path, "rb");
+    if (!f) fail("saved WAV missing");
+    sampler_wav_header_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1) fail("WAV header");
+    int16_t *d = malloc(hdr.data_size);
+    if (!d || fread(d, 1, hdr.data_size, f) != hdr.data_size) fail("WAV data short");
+    fclose(f);
+    uint32_t frames = hdr.data_size / 4;
+    if (frames == 0 || frames > end) fail("WAV length");
+    for (uint32_t i = 0; i < frames; i++) {
+        uint32_t n = end - frames + i;
+        if (d[2 * i] != (int16_t)(n & 0x7fff) || d[2 * i + 1] != expect_r(n)) {
+            fprintf(stderr, "%s: frame %u of %u (n=%u) got %d,%d\n", what, i, frames, n,
+                    d[2 * i], d[2 * i + 1]);
+            fail("saved audio differs from what was captured");
+        }
+    }
+    free(d);
+    unlink(saved_path);
+    return frames;
+}
+
+static void save_and_wait(int keep_capturing) {
+    __atomic_store_n(&save_finished, 0, __ATOMIC_RELAXED);
+    saved_path[0] = '\0';
+    skipback_trigger_save();
+    while (!__atomic_load_n(&save_finished, __ATOMIC_ACQUIRE)) {
+        if (keep_capturing) push_block();
+        usleep(keep_capturing ? 200 : 1000);
+    }
+    if (!saved_path[0]) fail("save did not complete");
+}
+
+static volatile int capture_run = 0;
+
+static void *capture_thread(void *arg) {
+    (void)arg;
+    while (__atomic_load_n(&capture_run, __ATOMIC_ACQUIRE)) {
+        push_block();
+        usleep(100);
+    }
+    return NULL;
+}
+
+static void test_history(void) {
+    sampler_host_t host = {
+        .log = stub_log,
+        .announce = stub_announce,
+        .overlay_sync = stub_overlay_sync,
+        .run_command = stub_run_command,
+    };
+    sampler_init(&host, NULL);
+    if (system("rm -rf build/tests/skipback-codec") != 0) fail("rm");
+
+    const int secs = 2;
+    skipback_set_compressed(1);
+    skipback_init(secs);
+
+    /* Saves cover exactly the configured length, noisy (R is noise) or not;
+     * half-noise still fits the smaller-than-PCM store */
+    uint32_t setting_frames = (uint32_t)secs * SR / BF * BF;
+    noise_until = UINT32_MAX;
+    push_seconds(8);
+    usleep(100000);
+    uint32_t end = next_frame;
+    save_and_wait(0);
+    uint32_t got = check_wav(end, "noisy");
+    if (got != setting_frames) {
+        fprintf(stderr, "noisy: %u frames, expected %u\n", got, setting_frames);
+        fail("save not trimmed to the setting");
+    }
+
+    noise_until = next_frame;
+    push_seconds(8);
+    usleep(100000);
+    end = next_frame;
+    save_and_wait(0);
+    got = check_wav(end, "compressible");
+    if (got != setting_frames) {
+        fprintf(stderr, "compressible: %u frames, expected %u\n", got, setting_frames);
+        fail("save not trimmed to the setting");
+    }
+
+    /* Growing the setting keeps the history captured so far */
+    skipback_resize(secs * 2);
+    if (skipback_get_seconds() != secs * 2) fail("resize up");
+    end = next_frame;
+    save_and_wait(0);
+    got = check_wav(end, "grown");
+    if (got != setting_frames) fail("history lost when growing the setting");
+
+    /* Save while capturing, then again: the second covers the first's duration */
+    uint32_t end1 = next_frame;
+    save_and_wait(1);
+    check_wav(end1, "during save");
+    uint32_t end2 = next_frame;
+    if (end2 == end1) fail("no capture during save");
+    usleep(100000);
+    save_and_wait(0);
+    if (check_wav(end2, "after save") < end2 - end1) fail("second save misses the first's duration");
+
+    /* Shrink under concurrent capture */
+    __atomic_store_n(&capture_run, 1, __ATOMIC_RELEASE);
+    pthread_t t;
+    if (pthread_create(&t, NULL, capture_thread, NULL) != 0) fail("pthread_create");
+    usleep(50000);
+    skipback_resize(1);
+    if (skipback_get_seconds() != 1) fail("resize");
+    usleep(50000);
+    __atomic_store_n(&capture_run, 0, __ATOMIC_RELEASE);
+    pthread_join(t, NULL);
+    usleep(100000);
+    end = next_frame;
+    save_and_wait(0);
+    got = check_wav(end, "resized");
+    if (got > (uint32_t)SR) fail("resize did not shrink the history");
+
+    if (system("rm -rf build/tests/skipback-codec") != 0) fail("rm");
+}
+
+int main(void) {
+    test_codec();
+    test_history();
+    printf("PASS: skipback codec round trips and compressed history saves exactly\n");
+    return 0;
+}
@@ -0,0 +1,18 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_skipback_codec"
+mkdir -p "$(dirname "$bin")"
+
+# shadow_sampler.c trips -Wformat-truncation on its path buffers; that's
+# unrelated to the code under test.
+cc -std=gnu11 -Wall -Wextra -Werror -Wno-format-truncation -O2 \
+  -Isrc -DSKIPBACK_DIR='"build/tests/skipback-codec"' \
+  tests/host/test_skipback_codec.c \
+  src/host/shadow_sampler.c src/host/shadow_skipback_codec.c \
+  -o "$bin" \
+  -lpthread -lm
+
+"$bin"
@@ -0,0 +1,245 @@
+/* Skipback ring test for src/host/shadow_sampler.c.
+ *
+ * Feeds blocks of a running frame counter (L = n & 0x7fff, R = -L) through
+ * skipback_capture() and checks the saved WAVs:
+ *   - capture keeps running while a save is in flight, so a second save
+ *     right after the first covers the first save's duration with no hole
+ *   - a writer that falls a whole buffer behind costs dropped blocks, never
+ *     a corrupted file
+ *   - skipback_resize() on another thread keeps the ring contiguous
+ * Built with SKIPBACK_DIR pointing into build/tests. */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "host/shadow_sampler.h"
+
+#define BLOCK_FRAMES SAMPLER_FRAMES_PER_BLOCK
+#define SR SAMPLER_SAMPLE_RATE
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+/* ---- host stubs ---- */
+
+static char saved_path[512];
+static volatile int save_finished = 0;
+static volatile unsigned dropped_logged = 0;
+static volatile int mkdir_delay_ms = 0;
+
+static void stub_log(const char *msg) {
+    unsigned n;
+    if (sscanf(msg, "Skipback: saved %511s", saved_path) == 1) return;
+    if (sscanf(msg, "Skipback: %u blocks not captured", &n) == 1) dropped_logged = n;
+}
+
+static void stub_announce(const char *msg) {
+    if (!strcmp(msg, "Skipback saved") || !strcmp(msg, "Skipback failed"))
+        __atomic_store_n(&save_finished, 1, __ATOMIC_RELEASE);
+}
+
+static void stub_overlay_sync(void) {}
+
+static void mkdir_p(const char *path) {
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s", path);
+    for (char *p = tmp + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(tmp, 0755);
+        *p = '/';
+    }
+    mkdir(tmp, 0755);
+}
+
+/* mkdir stands in for a slow SD card; chown is a no-op off device. */
+static int stub_run_command(const char *const argv[]) {
+    if (!strcmp(argv[0], "mkdir")) {
+        usleep(mkdir_delay_ms * 1000);
+        mkdir_p(argv[2]);
+    }
+    return 0;
+}
+
+/* ---- signal ---- */
+
+static uint32_t next_frame = 0;
+
+static void make_block(int16_t *out) {
+    for (int i = 0; i < BLOCK_FRAMES; i++) {
+        int16_t v = (int16_t)(next_frame++ & 0x7fff);
+        out[2 * i] = v;
+        out[2 * i + 1] = (int16_t)-v;
+    }
+}
+
+static void push_block(void) {
+    int16_t block[BLOCK_FRAMES * 2];
+    make_block(block);
+    skipback_capture(block);
+}
+
+/* ---- saved file checks ---- */
+
+typedef struct {
+    uint32_t frames;
+    uint32_t first;   /* counter value (15 bits) of the first frame */
+    uint32_t last;
+    int gaps;         /* discontinuities in the counter */
+    int bad_gaps;     /* discontinuities that aren't whole dropped blocks */
+} wav_info_t;
+
+static wav_info_t read_wav(void) {
+    wav_info_t info = {0};
+    FILE *f = fopen(saved_path, "rb");
+    if (!f) fail("saved WAV missing");
+    sampler_wav_header_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1) fail("WAV header");
+    if (memcmp(hdr.data_id, "data", 4) || hdr.num_channels != 2) fail("WAV format");
+    int16_t *d = malloc(hdr.data_size);
+    if (!d || fread(d, 1, hdr.data_size, f) != hdr.data_size) fail("WAV data short");
+    fclose(f);
+    info.frames = hdr.data_size / 4;
+    for (uint32_t i = 0; i < info.frames; i++) {
+        if (d[2 * i + 1] != (int16_t)-d[2 * i]) fail("channel mismatch (torn sample)");
+        if (i == 0) continue;
+        uint32_t step = ((uint32_t)d[2 * i] - (uint32_t)d[2 * i - 2]) & 0x7fff;
+        if (step != 1) {
+            info.gaps++;
+            if ((step - 1) % BLOCK_FRAMES) info.bad_gaps++;
+        }
+    }
+    info.first = (uint32_t)d[0];
+    info.last = (uint32_t)d[2 * (info.frames - 1)];
+    free(d);
+    unlink(saved_path);
+    return info;
+}
+
+/* Trigger a save, keep capturing every `pace_us` until the writer is done. */
+static uint32_t save_while_capturing(int pace_us, int max_blocks) {
+    __atomic_store_n(&save_finished, 0, __ATOMIC_RELAXED);
+    dropped_logged = 0;
+    saved_path[0] = '\0';
+    skipback_trigger_save();
+    uint32_t pushed = 0;
+    while (!__atomic_load_n(&save_finished, __ATOMIC_ACQUIRE)) {
+        if ((int)pushed < max_blocks) {
+            push_block();
+            pushed++;
+        }
+        usleep(pace_us);
+    }
+    if (!saved_path[0]) fail("save did not complete");
+    return pushed;
+}
+
+static void clear_dir(void) {
+    if (system("rm -rf build/tests/skipback") != 0) fail("rm");
+}
+
+/* ---- resize under concurrent capture ---- */
+
+static volatile int capture_run = 0;
+
+static void *capture_thread(void *arg) {
+    (void)arg;
+    while (__atomic_load_n(&capture_run, __ATOMIC_ACQUIRE)) {
+        push_block();
+        usleep(300);
+    }
+    return NULL;
+}
+
+int main(void) {
+    sampler_host_t host = {
+        .log = stub_log,
+        .announce = stub_announce,
+        .overlay_sync = stub_overlay_sync,
+        .run_command = stub_run_command,
+    };
+    sampler_init(&host, NULL);
+    clear_dir();
+
+    const int secs = 4;
+    const uint32_t ring_frames = (uint32_t)SR * secs;
+    /* Saves leave the oldest 32 blocks as start-up room for the writer */
+    const uint32_t save_frames = ring_frames - 32 * BLOCK_FRAMES;
+    skipback_init(secs);
+    if (skipback_get_seconds() != secs) fail("init size");
+
+    /* Wrap the ring a couple of times. */
+    for (int i = 0; i < 3000; i++) push_block();
+
+    /* 1. Save with a 200ms mkdir stall while capture continues at ~4x realtime. */
+    mkdir_delay_ms = 200;
+    uint32_t end1 = next_frame;
+    uint32_t during1 = save_while_capturing(700, 100000);
+    wav_info_t a = read_wav();
+    if (a.frames != save_frames) fail("save 1: not a full buffer");
+    if (a.gaps) fail("save 1: discontinuous");
+    if (a.last != ((end1 - 1) & 0x7fff)) fail("save 1: not the snapshot end");
+    if (during1 < 100) fail("save 1: too few blocks captured during save");
+    if (dropped_logged) fail("save 1: dropped blocks with headroom available");
+
+    /* 2. Save again immediately: must include everything captured during save 1. */
+    clear_dir();
+    mkdir_delay_ms = 0;
+    uint32_t end2 = next_frame;
+    save_while_capturing(700, 100000);
+    wav_info_t b = read_wav();
+    if (b.gaps) fail("save 2: hole in history captured during save 1");
+    if (b.last != ((end2 - 1) & 0x7fff)) fail("save 2: not the snapshot end");
+    if (end2 - end1 >= save_frames) fail("test setup: save 1 took longer than the buffer");
+    uint32_t span = (b.last - b.first) & 0x7fff;
+    if (b.frames != save_frames || span != ((save_frames - 1) & 0x7fff))
+        fail("save 2: length");
+
+    /* 3. Writer stalled past its staged headroom: capture drops blocks instead
+     * of overwriting the snapshot, and the file is still exact. */
+    clear_dir();
+    mkdir_delay_ms = 400;
+    uint32_t end3 = next_frame;
+    uint32_t headroom_blocks = (uint32_t)SR * 2 / BLOCK_FRAMES + 32;
+    save_while_capturing(0, (int)headroom_blocks + 300);
+    wav_info_t c = read_wav();
+    if (c.gaps || c.frames != save_frames) fail("save 3: snapshot corrupted by capture");
+    if (c.last != ((end3 - 1) & 0x7fff)) fail("save 3: not the snapshot end");
+    if (dropped_logged < 250 || dropped_logged > 301) fail("save 3: dropped block count");
+
+    /* Refill the ring so the hole from save 3 is gone. */
+    for (uint32_t i = 0; i < ring_frames / BLOCK_FRAMES + 2; i++) push_block();
+
+    /* 4. Shrink and grow while another thread captures. */
+    clear_dir();
+    mkdir_delay_ms = 0;
+    __atomic_store_n(&capture_run, 1, __ATOMIC_RELEASE);
+    pthread_t t;
+    if (pthread_create(&t, NULL, capture_thread, NULL) != 0) fail("pthread_create");
+    usleep(50000);
+    skipback_resize(2);
+    if (skipback_get_seconds() != 2) fail("shrink");
+    usleep(50000);
+    skipback_resize(6);
+    if (skipback_get_seconds() != 6) fail("grow");
+    usleep(50000);
+    __atomic_store_n(&capture_run, 0, __ATOMIC_RELEASE);
+    pthread_join(t, NULL);
+    uint32_t end4 = next_frame;
+    save_while_capturing(0, 0);
+    wav_info_t r = read_wav();
+    /* Grown to 6s but only ~2s + the capture since was kept. */
+    if (r.frames >= (uint32_t)SR * 6 || r.frames < (uint32_t)SR * 2) fail("resize: kept length");
+    if (r.bad_gaps || r.gaps > 2) fail("resize: ring not contiguous");
+    if (r.last != ((end4 - 1) & 0x7fff)) fail("resize: not the snapshot end");
+
+    clear_dir();
+    printf("PASS: skipback captures through saves and resizes without holes\n");
+    return 0;
+}
@@ -0,0 +1,94 @@
+/* Writer-side check for src/host/shadow_telemetry.c.
+ *
+ * Drives the recorder with synthetic frames, then reads /schwung-telemetry
+ * back as the CLI and schwung-manager would: bucket edges, histogram
+ * counts, not-run stages and the overrun ring. Leaves the segment in place
+ * for test_telemetry.sh to run the CLI against; the script unlinks it. */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "host/shadow_constants.h"
+#include "host/shadow_telemetry.h"
+
+static void fail(const char *msg) {
+    fprintf(stderr, "FAIL: %s\n", msg);
+    exit(1);
+}
+
+static void check_buckets(void) {
+    int prev = -1;
+    for (uint32_t us = 0; us < 200000; us++) {
+        int b = telemetry_bucket(us);
+        if (b < prev) fail("bucket index not monotonic");
+        if (b > prev + 1) fail("bucket index skipped");
+        if (telemetry_bucket_floor(b) > us) fail("bucket floor above value");
+        if (b + 1 < TELEMETRY_BUCKETS && telemetry_bucket_floor(b + 1) <= us)
+            fail("value above next bucket floor");
+        prev = b;
+    }
+    if (prev != TELEMETRY_BUCKETS - 1) fail("top bucket not reached");
+    if (telemetry_bucket(UINT32_MAX) != TELEMETRY_BUCKETS - 1) fail("overflow bucket");
+}
+
+int main(void) {
+    check_buckets();
+
+    shm_unlink(SHM_SHADOW_TELEMETRY);
+    if (telemetry_init(NULL) != 0) fail("telemetry_init");
+
+    /* 1000 frames: totals 1000..1999us, every 100th frame blows the budget.
+     * Slot 2 synth only runs on even frames; link_read accumulates twice. */
+    for (int f = 0; f < 1000; f++) {
+        uint32_t total = (f % 100 == 99) ? 5000 + f : 1000 + f;
+        telemetry_frame_begin(1000000ULL * f);
+        telemetry_record(TELEM_PRE, 300);
+        telemetry_record(TELEM_IOCTL, total - 600);
+        telemetry_record(TELEM_POST, 300);
+        if ((f & 1) == 0) telemetry_record(TELEM_SLOT1_SYNTH, 120);
+        telemetry_record(TELEM_LINK_READ, 10);
+        telemetry_record(TELEM_LINK_READ, 15);
+        telemetry_record(TELEM_TOTAL, total);
+        telemetry_frame_end();
+    }
+
+    int fd = shm_open(SHM_SHADOW_TELEMETRY, O_RDONLY, 0);
+    if (fd < 0) fail("shm_open for reading");
+    const telemetry_shm_t *t = mmap(NULL, sizeof(*t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (t == MAP_FAILED) fail("mmap");
+
+    if (t->magic != TELEMETRY_MAGIC || t->version != TELEMETRY_VERSION) fail("header");
+    if (strcmp(t->stage_names[TELEM_MASTER_FX], "master_fx") != 0) fail("stage names");
+    if (t->frames != 1000) fail("frame count");
+    if (t->overruns != 10 || t->ring_write != 10) fail("overrun count");
+
+    const telemetry_hist_t *tot = &t->hist[TELEM_TOTAL];
+    if (tot->count != 1000 || tot->max_us != 5999) fail("total count/max");
+    uint32_t in_buckets = 0;
+    for (int b = 0; b < TELEMETRY_BUCKETS; b++) in_buckets += tot->buckets[b];
+    if (in_buckets != 1000) fail("total bucket sum");
+    if (tot->buckets[telemetry_bucket(5999)] == 0) fail("overrun bucket empty");
+
+    if (t->hist[TELEM_SLOT1_SYNTH].count != 500) fail("not-run frames counted");
+    if (t->hist[TELEM_SLOT0_SYNTH].count != 0) fail("idle stage has samples");
+    if (t->hist[TELEM_LINK_READ].max_us != 25 ||
+        t->hist[TELEM_LINK_READ].buckets[telemetry_bucket(25)] != 1000) fail("accumulated stage");
+
+    for (int i = 0; i < 10; i++) {
+        const telemetry_frame_t *e = &t->ring[i];
+        if (e->seq == 0 || (e->seq & 1)) fail("ring seqlock");
+        if (e->frame != (uint64_t)(i * 100 + 100)) fail("ring frame number");
+        if (e->stage_us[TELEM_TOTAL] != (uint32_t)(5099 + i * 100)) fail("ring total");
+        if (e->time_ns != 1000000ULL * (i * 100 + 99)) fail("ring timestamp");
+        if (e->stage_us[TELEM_SLOT1_SYNTH] != TELEMETRY_NOT_RUN) fail("ring not-run marker");
+        if (e->stage_us[TELEM_MASTER_FX] != TELEMETRY_NOT_RUN) fail("ring idle stage");
+    }
+
+    printf("PASS: telemetry histograms, not-run stages and overrun ring\n");
+    return 0;
+}
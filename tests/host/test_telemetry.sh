@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+mkdir -p build/tests
+cc -std=gnu11 -Wall -Wextra -Werror -Isrc \
+  tests/host/test_telemetry.c src/host/shadow_telemetry.c \
+  -o build/tests/test_telemetry -lrt
+cc -std=gnu11 -Wall -Wextra -Werror -Isrc \
+  src/tools/schwung_telemetry.c \
+  -o build/tests/schwung-telemetry -lrt
+
+cleanup() { rm -f /dev/shm/schwung-telemetry; }
+trap cleanup EXIT
+
+build/tests/test_telemetry
+
+summary=$(build/tests/schwung-telemetry)
+echo "$summary" | grep -q "frames=1000 overruns=10" || {
+  echo "FAIL: summary header" >&2; echo "$summary" >&2; exit 1; }
+echo "$summary" | grep -Eq "^total +1000 " || {
+  echo "FAIL: no total row" >&2; echo "$summary" >&2; exit 1; }
+if echo "$summary" | grep -q "^master_fx"; then
+  echo "FAIL: idle stage listed in summary" >&2; exit 1
+fi
+
+overruns=$(build/tests/schwung-telemetry -o)
+[ "$(echo "$overruns" | grep -Ec '^ +[0-9]+ ')" -eq 10 ] || {
+  echo "FAIL: expected 10 overrun rows" >&2; echo "$overruns" >&2; exit 1; }
+
+json=$(build/tests/schwung-telemetry -j)
+echo "$json" | grep -q '"frames":1000' || { echo "FAIL: JSON frames" >&2; exit 1; }
+echo "$json" | grep -q '"name":"s2_synth","count":500' || { echo "FAIL: JSON stage" >&2; exit 1; }
+if command -v python3 >/dev/null 2>&1; then
+  echo "$json" | python3 -c 'import json,sys; d=json.load(sys.stdin); assert len(d["recent_overruns"]) == 10'
+fi
+
+echo "PASS: schwung-telemetry reads histograms and overrun ring"
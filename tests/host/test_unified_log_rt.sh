@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+bin="build/tests/test_unified_log_rt"
+mkdir -p "$(dirname "$bin")"
+
+cc -std=gnu11 -Wall -Wextra -Werror -O2 \
+  -Isrc -Isrc/host \
+  -DUNIFIED_LOG_PATH='"build/tests/unified_log_rt.log"' \
+  -DUNIFIED_LOG_FLAG='"build/tests/unified_log_rt.on"' \
+  tests/host/test_unified_log_rt.c src/host/unified_log.c \
+  -o "$bin" \
+  -lpthread
+
+"$bin"
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+shim="src/schwung_shim.c"
+mgmt="src/host/shadow_chain_mgmt.c"
+ui="src/shadow/shadow_ui.c"
+
+if ! rg -q 'shadow_inprocess_handle_param_request\(\);' "$shim" || \
+   ! rg -q 'shadow_inprocess_drain_param_ring\(\);' "$shim"; then
+  echo "FAIL: shim does not drain the batched param ring each frame" >&2
+  exit 1
+fi
+
+if ! rg -q 'SHADOW_PARAM_RING_MAX_PER_FRAME' "$mgmt" || ! rg -q 'SHADOW_PARAM_RING_BUDGET_US' "$mgmt"; then
+  echo "FAIL: param ring drain is not bounded per frame" >&2
+  exit 1
+fi
+
+if ! rg -q 'shadow_param_dispatch\(p\);' "$mgmt"; then
+  echo "FAIL: ring requests do not share the mailbox dispatch path" >&2
+  exit 1
+fi
+
+if ! rg -q '"shadow_set_params_batch"' "$ui" || ! rg -q '"shadow_get_params_batch"' "$ui"; then
+  echo "FAIL: batch param JS API not registered" >&2
+  exit 1
+fi
+
+if ! rg -q 'JS_ExecutePendingJob\(rt, &job_ctx\)' "$ui"; then
+  echo "FAIL: shadow_ui main loop does not run promise jobs" >&2
+  exit 1
+fi
+
+# Mailbox requests must not overtake batched sets queued before them
+if ! rg -A3 'static int shadow_param_wait_idle' "$ui" | rg -q 'shadow_param_ring_flush'; then
+  echo "FAIL: shadow_param_wait_idle does not flush the param ring first" >&2
+  exit 1
+fi
+
+echo "PASS: batched param ring wired through shim, chain mgmt and shadow UI"